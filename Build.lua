@@ -19,6 +19,8 @@ workspace("DirectGL")
         include("System/Window/Build-Window.lua")
 
     group("Utilities")
+        include("Utilities/FrameRing/Build-FrameRing.lua")
+        include("Utilities/Jobs/Build-Jobs.lua")
         include("Utilities/Logging/Build-LogForge.lua")
         include("Utilities/Preconditions/Build-Preconditions.lua")
         include("Utilities/Premake/Build-Premake.lua")
@@ -39,6 +41,12 @@ workspace("DirectGL")
         include("DirectGL/DirectGL-Brushes/Build-Brushes.lua")
         include("DirectGL/DirectGL-Texture/Build-Texture.lua")
         include("DirectGL/DirectGL-Blending/Build-Blending.lua")
+        include("DirectGL/DirectGL-SoftwareRenderer/Build-SoftwareRenderer.lua")
+        include("DirectGL/DirectGL-RHI/Build-RHI.lua")
+
+    group("Tools")
+        include("Tools/Benchmarks/Build-Benchmarks.lua")
+        include("Tools/FrameRingReader/Build-FrameRingReader.lua")
 
     group("") -- Root group
         include("App/Build-App.lua")
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 module;
 
-#include <Glad/gl.h>
+#include <glad/gl.h>
 
 #include <memory>
 #include <string_view>
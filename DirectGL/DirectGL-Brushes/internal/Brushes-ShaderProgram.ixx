@@ -28,12 +28,14 @@ namespace DGL::Brushes
 
 		void UploadTexture(std::string_view name, GLuint textureUnit);
 
+		void UploadInt1(std::string_view name, int32_t x);
 		void UploadFloat1(std::string_view name, float x);
 		void UploadFloat2(std::string_view name, float x, float y);
 		void UploadFloat3(std::string_view name, float x, float y, float z);
 		void UploadFloat4(std::string_view name, float x, float y, float z, float w);
 
 		void UploadMatrix4x4(std::string_view name, const std::span<const float, 16>& matrix);
+		void UploadFloatArray(std::string_view name, std::span<const float> values);
 
 		GLuint GetRendererId() const;
 
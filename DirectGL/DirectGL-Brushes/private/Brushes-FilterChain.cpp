@@ -0,0 +1,529 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <memory>
+#include <span>
+#include <string_view>
+
+module DirectGL.Brushes;
+import DirectGL.Logging;
+
+inline static constexpr auto VERTEX_SOURCE = R"(
+#version 460 core
+
+layout (location = 0) out vec2 v_TexCoord;
+
+void main() {
+	// A single triangle covering the whole viewport
+	vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+
+	gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+	v_TexCoord = corner;
+}
+)";
+
+inline static constexpr auto BLUR_FRAGMENT_SOURCE = R"(
+#version 460 core
+
+layout (location = 0) out vec4 o_FragColor;
+layout (location = 0) in vec2 v_TexCoord;
+
+layout (binding = 0) uniform sampler2D u_Source;
+
+uniform vec2 u_TexelStep;
+uniform int u_TapCount;
+uniform float u_Offsets[16];
+uniform float u_Weights[16];
+
+void main() {
+	vec4 color = texture(u_Source, v_TexCoord) * u_Weights[0];
+
+	for (int i = 1; i < u_TapCount; ++i) {
+		vec2 offset = u_TexelStep * u_Offsets[i];
+		color += (texture(u_Source, v_TexCoord + offset) + texture(u_Source, v_TexCoord - offset)) * u_Weights[i];
+	}
+
+	o_FragColor = color;
+}
+)";
+
+inline static constexpr auto BRIGHT_PASS_FRAGMENT_SOURCE = R"(
+#version 460 core
+
+layout (location = 0) out vec4 o_FragColor;
+layout (location = 0) in vec2 v_TexCoord;
+
+layout (binding = 0) uniform sampler2D u_Source;
+
+uniform float u_Level;
+
+void main() {
+	vec4 color = texture(u_Source, v_TexCoord);
+	float luminance = dot(color.rgb, vec3(0.299, 0.587, 0.114));
+
+	// Only the part of the luminance above the level contributes to the glow
+	o_FragColor = vec4(color.rgb * (max(luminance - u_Level, 0.0) / max(luminance, 0.0001)), 1.0);
+}
+)";
+
+inline static constexpr auto COMBINE_FRAGMENT_SOURCE = R"(
+#version 460 core
+
+layout (location = 0) out vec4 o_FragColor;
+layout (location = 0) in vec2 v_TexCoord;
+
+layout (binding = 0) uniform sampler2D u_Source;
+layout (binding = 1) uniform sampler2D u_Glow;
+
+uniform float u_Intensity;
+
+void main() {
+	vec4 color = texture(u_Source, v_TexCoord);
+	o_FragColor = vec4(color.rgb + texture(u_Glow, v_TexCoord).rgb * u_Intensity, color.a);
+}
+)";
+
+inline static constexpr auto COLOR_MATRIX_FRAGMENT_SOURCE = R"(
+#version 460 core
+
+layout (location = 0) out vec4 o_FragColor;
+layout (location = 0) in vec2 v_TexCoord;
+
+layout (binding = 0) uniform sampler2D u_Source;
+
+uniform mat4 u_Matrix;
+uniform vec4 u_Offset;
+
+void main() {
+	o_FragColor = clamp(u_Matrix * texture(u_Source, v_TexCoord) + u_Offset, 0.0, 1.0);
+}
+)";
+
+inline static constexpr auto THRESHOLD_FRAGMENT_SOURCE = R"(
+#version 460 core
+
+layout (location = 0) out vec4 o_FragColor;
+layout (location = 0) in vec2 v_TexCoord;
+
+layout (binding = 0) uniform sampler2D u_Source;
+
+uniform float u_Level;
+
+void main() {
+	vec4 color = texture(u_Source, v_TexCoord);
+	float luminance = dot(color.rgb, vec3(0.299, 0.587, 0.114));
+
+	o_FragColor = vec4(vec3(step(u_Level, luminance)), color.a);
+}
+)";
+
+namespace
+{
+	using namespace DGL;
+
+	/// Matches the size of the uniform arrays of the blur shader
+	constexpr size_t MaxBlurTapCount = 16;
+
+	struct BlurKernel
+	{
+		std::array<float, MaxBlurTapCount> Offsets = {};
+		std::array<float, MaxBlurTapCount> Weights = {};
+		int32_t TapCount = 0;
+	};
+
+	/// The weights of two neighbouring texels get merged into a single fetch between
+	/// them, where the bilinear filtering of the sampler blends both in the right ratio.
+	/// This covers 30 texels on either side, a kernel reaching further gets truncated.
+	BlurKernel CalculateBlurKernel(const float sigma)
+	{
+		constexpr int32_t maxRadius = static_cast<int32_t>(MaxBlurTapCount - 1) * 2;
+		const int32_t radius = std::clamp(static_cast<int32_t>(std::ceil(sigma * 3.0f)), 1, maxRadius);
+
+		std::array<float, maxRadius + 2> weights = {};
+		float sum = 0.0f;
+
+		for (int32_t i = 0; i <= radius; ++i)
+		{
+			weights[i] = std::exp(-static_cast<float>(i * i) / (2.0f * sigma * sigma));
+			sum += i == 0 ? weights[i] : 2.0f * weights[i];
+		}
+
+		BlurKernel kernel;
+		kernel.Weights[0] = weights[0] / sum;
+		kernel.TapCount = 1;
+
+		for (int32_t i = 1; i <= radius; i += 2)
+		{
+			const float weight = weights[i] + weights[i + 1];
+			kernel.Offsets[kernel.TapCount] = (static_cast<float>(i) * weights[i] + static_cast<float>(i + 1) * weights[i + 1]) / weight;
+			kernel.Weights[kernel.TapCount] = weight / sum;
+			++kernel.TapCount;
+		}
+
+		return kernel;
+	}
+
+	uint32_t ClampDownsample(const uint32_t downsample)
+	{
+		return std::bit_floor(std::clamp(downsample, 1u, 4u));
+	}
+
+	void BlitFramebuffer(const Renderer::RenderTarget& source, const Renderer::RenderTarget& destination, const GLenum filter)
+	{
+		const Math::Uint2 sourceSize = source.GetSize();
+		const Math::Uint2 destinationSize = destination.GetSize();
+
+		glBlitNamedFramebuffer(
+			source.GetFramebufferId(), destination.GetFramebufferId(),
+			0, 0, static_cast<GLint>(sourceSize.X), static_cast<GLint>(sourceSize.Y),
+			0, 0, static_cast<GLint>(destinationSize.X), static_cast<GLint>(destinationSize.Y),
+			GL_COLOR_BUFFER_BIT, filter
+		);
+	}
+
+	std::unique_ptr<Brushes::ShaderProgram> CreateProgram(const Brushes::Shader& vertexShader, const char* fragmentSource, const std::string_view name)
+	{
+		const auto fragmentShader = Brushes::Shader::Create(fragmentSource, Brushes::ShaderType::Fragment);
+		if (not fragmentShader)
+		{
+			Logging::Error(std::format("Failed to create fragment shader for {} filter pass", name));
+			return nullptr;
+		}
+
+		auto shaderProgram = Brushes::ShaderProgram::Create(vertexShader, *fragmentShader);
+		if (not shaderProgram)
+		{
+			Logging::Error(std::format("Failed to create shader program for {} filter pass", name));
+			return nullptr;
+		}
+
+		return shaderProgram;
+	}
+}
+
+namespace DGL::Brushes
+{
+	std::string_view GetFilterName(const FilterType type)
+	{
+		switch (type)
+		{
+			case FilterType::GaussianBlur: return "GaussianBlur";
+			case FilterType::Bloom: return "Bloom";
+			case FilterType::ColorMatrix: return "ColorMatrix";
+			case FilterType::Threshold: return "Threshold";
+		}
+
+		return "Unknown";
+	}
+
+	std::unique_ptr<FilterChain> FilterChain::Create(Renderer::RenderTargetPool& renderTargetPool, Texture::SamplerCache& samplerCache)
+	{
+		const auto vertexShader = Shader::Create(VERTEX_SOURCE, ShaderType::Vertex);
+		if (not vertexShader)
+		{
+			Logging::Error("Failed to create vertex shader for filter chain");
+			return nullptr;
+		}
+
+		Programs programs = {
+			.Blur = CreateProgram(*vertexShader, BLUR_FRAGMENT_SOURCE, "blur"),
+			.BrightPass = CreateProgram(*vertexShader, BRIGHT_PASS_FRAGMENT_SOURCE, "bright"),
+			.Combine = CreateProgram(*vertexShader, COMBINE_FRAGMENT_SOURCE, "combine"),
+			.ColorMatrix = CreateProgram(*vertexShader, COLOR_MATRIX_FRAGMENT_SOURCE, "color matrix"),
+			.Threshold = CreateProgram(*vertexShader, THRESHOLD_FRAGMENT_SOURCE, "threshold"),
+		};
+
+		if (not programs.Blur or not programs.BrightPass or not programs.Combine or not programs.ColorMatrix or not programs.Threshold)
+		{
+			return nullptr;
+		}
+
+		GLuint vertexArrayId = 0;
+		glCreateVertexArrays(1, &vertexArrayId);
+
+		// Bilinear filtering is what the merged blur taps and the upsampling rely on
+		const Texture::TextureSampler& sampler = samplerCache.Get({ .FilterMode = Texture::TextureFilterMode::Linear, .WrapMode = Texture::TextureWrapMode::ClampToEdge });
+
+		return std::unique_ptr<FilterChain>(new FilterChain(std::move(programs), renderTargetPool, sampler, vertexArrayId));
+	}
+
+	FilterChain::~FilterChain()
+	{
+		for (const PendingTimings& pending : m_PendingTimings)
+		{
+			glDeleteQueries(static_cast<GLsizei>(pending.Queries.size()), pending.Queries.data());
+		}
+
+		glDeleteQueries(static_cast<GLsizei>(m_FreeQueries.size()), m_FreeQueries.data());
+		glDeleteVertexArrays(1, &m_VertexArrayId);
+	}
+
+	void FilterChain::Apply(Renderer::RenderTarget& renderTarget, const std::span<const Filter> filters)
+	{
+		const Math::Uint2 size = renderTarget.GetSize();
+		if (filters.empty() or size.X == 0 or size.Y == 0)
+		{
+			return;
+		}
+
+		CollectTimings();
+
+		// The layer applying the filters isn't necessarily the one being drawn to
+		GLint framebufferId = 0;
+		std::array<GLint, 4> viewport = {};
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebufferId);
+		glGetIntegerv(GL_VIEWPORT, viewport.data());
+
+		// The passes replace every texel of their pooled targets, blending would mix in stale contents
+		const GLboolean isBlendingEnabled = glIsEnabled(GL_BLEND);
+		const GLboolean isScissorTestEnabled = glIsEnabled(GL_SCISSOR_TEST);
+		glDisable(GL_BLEND);
+		glDisable(GL_SCISSOR_TEST);
+
+		Target image = Acquire(size);
+		BlitFramebuffer(renderTarget, *image, GL_NEAREST);
+
+		PendingTimings pending;
+		pending.Queries.reserve(filters.size());
+		pending.Types.reserve(filters.size());
+
+		for (const Filter& filter : filters)
+		{
+			const GLuint query = AcquireQuery();
+			glBeginQuery(GL_TIME_ELAPSED, query);
+
+			switch (filter.Type)
+			{
+				case FilterType::GaussianBlur: image = ApplyGaussianBlur(std::move(image), filter.Radius, filter.Downsample); break;
+				case FilterType::Bloom: image = ApplyBloom(std::move(image), filter); break;
+				case FilterType::ColorMatrix: image = ApplyColorMatrix(std::move(image), filter); break;
+				case FilterType::Threshold: image = ApplyThreshold(std::move(image), filter); break;
+			}
+
+			glEndQuery(GL_TIME_ELAPSED);
+			pending.Queries.push_back(query);
+			pending.Types.push_back(filter.Type);
+		}
+
+		BlitFramebuffer(*image, renderTarget, GL_NEAREST);
+		Release(std::move(image));
+
+		glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(framebufferId));
+		glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+		if (isBlendingEnabled) glEnable(GL_BLEND);
+		if (isScissorTestEnabled) glEnable(GL_SCISSOR_TEST);
+
+		m_PendingTimings.push_back(std::move(pending));
+	}
+
+	std::span<const FilterTiming> FilterChain::GetTimings()
+	{
+		CollectTimings();
+		return m_Timings;
+	}
+
+	FilterChain::FilterChain(Programs programs, Renderer::RenderTargetPool& renderTargetPool, const Texture::TextureSampler& sampler, const GLuint vertexArrayId):
+		m_Programs(std::move(programs)),
+		m_RenderTargetPool(&renderTargetPool),
+		m_Sampler(&sampler),
+		m_VertexArrayId(vertexArrayId)
+	{
+	}
+
+	FilterChain::Target FilterChain::ApplyGaussianBlur(Target source, const float radius, const uint32_t downsample)
+	{
+		if (radius <= 0.0f)
+		{
+			return source;
+		}
+
+		const uint32_t factor = ClampDownsample(downsample);
+		if (factor == 1)
+		{
+			return BlurSeparable(std::move(source), radius);
+		}
+
+		Target blurred = BlurSeparable(Downsample(*source, factor), radius / static_cast<float>(factor));
+
+		// Stretch the blurred image back over the full size, the linear blit smooths the upsampling
+		BlitFramebuffer(*blurred, *source, GL_LINEAR);
+		Release(std::move(blurred));
+		return source;
+	}
+
+	FilterChain::Target FilterChain::ApplyBloom(Target source, const Filter& filter)
+	{
+		const uint32_t factor = ClampDownsample(filter.Downsample);
+		Target downsampled = factor == 1 ? nullptr : Downsample(*source, factor);
+		const Renderer::OffscreenRenderTarget& brightSource = downsampled ? *downsampled : *source;
+
+		Target glow = Acquire(brightSource.GetSize());
+		m_Programs.BrightPass->UploadFloat1("u_Level", filter.Level);
+		DrawPass(*m_Programs.BrightPass, *glow, brightSource);
+
+		if (downsampled)
+		{
+			Release(std::move(downsampled));
+		}
+
+		if (filter.Radius > 0.0f)
+		{
+			glow = BlurSeparable(std::move(glow), filter.Radius / static_cast<float>(factor));
+		}
+
+		Target result = Acquire(source->GetSize());
+		m_Programs.Combine->UploadFloat1("u_Intensity", filter.Intensity);
+		DrawPass(*m_Programs.Combine, *result, *source, glow.get());
+
+		Release(std::move(glow));
+		Release(std::move(source));
+		return result;
+	}
+
+	FilterChain::Target FilterChain::ApplyColorMatrix(Target source, const Filter& filter)
+	{
+		Target result = Acquire(source->GetSize());
+		m_Programs.ColorMatrix->UploadMatrix4x4("u_Matrix", std::span<const float, 16>(filter.Matrix.GetData(), 16));
+		m_Programs.ColorMatrix->UploadFloat4("u_Offset", filter.Offset.X, filter.Offset.Y, filter.Offset.Z, filter.Offset.W);
+		DrawPass(*m_Programs.ColorMatrix, *result, *source);
+
+		Release(std::move(source));
+		return result;
+	}
+
+	FilterChain::Target FilterChain::ApplyThreshold(Target source, const Filter& filter)
+	{
+		Target result = Acquire(source->GetSize());
+		m_Programs.Threshold->UploadFloat1("u_Level", filter.Level);
+		DrawPass(*m_Programs.Threshold, *result, *source);
+
+		Release(std::move(source));
+		return result;
+	}
+
+	FilterChain::Target FilterChain::Downsample(const Renderer::OffscreenRenderTarget& source, const uint32_t factor)
+	{
+		// Halving with a linear blit averages each 2x2 block exactly, whereas
+		// a single blit by four would skip three quarters of the texels
+		Target result;
+		const Renderer::OffscreenRenderTarget* current = &source;
+
+		for (uint32_t remaining = factor; remaining > 1; remaining /= 2)
+		{
+			const Math::Uint2 size = current->GetSize();
+			Target next = Acquire(Math::Uint2(std::max(size.X / 2, 1u), std::max(size.Y / 2, 1u)));
+			BlitFramebuffer(*current, *next, GL_LINEAR);
+
+			if (result)
+			{
+				Release(std::move(result));
+			}
+
+			result = std::move(next);
+			current = result.get();
+		}
+
+		return result;
+	}
+
+	FilterChain::Target FilterChain::BlurSeparable(Target source, const float radius)
+	{
+		const BlurKernel kernel = CalculateBlurKernel(radius);
+		ShaderProgram& program = *m_Programs.Blur;
+		program.UploadInt1("u_TapCount", kernel.TapCount);
+		program.UploadFloatArray("u_Offsets", kernel.Offsets);
+		program.UploadFloatArray("u_Weights", kernel.Weights);
+
+		const Math::Uint2 size = source->GetSize();
+		Target intermediate = Acquire(size);
+
+		program.UploadFloat2("u_TexelStep", 1.0f / static_cast<float>(size.X), 0.0f);
+		DrawPass(program, *intermediate, *source);
+
+		program.UploadFloat2("u_TexelStep", 0.0f, 1.0f / static_cast<float>(size.Y));
+		DrawPass(program, *source, *intermediate);
+
+		Release(std::move(intermediate));
+		return source;
+	}
+
+	void FilterChain::DrawPass(ShaderProgram& program, const Renderer::RenderTarget& destination, const Renderer::OffscreenRenderTarget& source, const Renderer::OffscreenRenderTarget* secondSource)
+	{
+		const Math::Uint2 size = destination.GetSize();
+		glBindFramebuffer(GL_FRAMEBUFFER, destination.GetFramebufferId());
+		glViewport(0, 0, static_cast<GLsizei>(size.X), static_cast<GLsizei>(size.Y));
+
+		const std::array<GLuint, 2> textureIds = {
+			source.GetRenderTexture().GetRendererId(),
+			secondSource ? secondSource->GetRenderTexture().GetRendererId() : 0,
+		};
+
+		const std::array<GLuint, 2> samplerIds = { m_Sampler->GetRendererId(), m_Sampler->GetRendererId() };
+
+		glBindTextures(0, static_cast<GLsizei>(textureIds.size()), textureIds.data());
+		glBindSamplers(0, static_cast<GLsizei>(samplerIds.size()), samplerIds.data());
+		ShaderProgram::Activate(&program);
+
+		glBindVertexArray(m_VertexArrayId);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+	}
+
+	FilterChain::Target FilterChain::Acquire(const Math::Uint2 size)
+	{
+		return m_RenderTargetPool->Acquire(size, Renderer::RenderTargetAttachments::Color);
+	}
+
+	void FilterChain::Release(Target renderTarget)
+	{
+		// The passes have been issued already, so a chain of filters ping-pongs between two targets
+		m_RenderTargetPool->ReleaseImmediately(std::move(renderTarget));
+	}
+
+	GLuint FilterChain::AcquireQuery()
+	{
+		if (m_FreeQueries.empty())
+		{
+			GLuint query = 0;
+			glCreateQueries(GL_TIME_ELAPSED, 1, &query);
+			return query;
+		}
+
+		const GLuint query = m_FreeQueries.back();
+		m_FreeQueries.pop_back();
+		return query;
+	}
+
+	void FilterChain::CollectTimings()
+	{
+		// Queries complete in order, so the last query of a chain being available means the whole chain is
+		while (not m_PendingTimings.empty())
+		{
+			PendingTimings& pending = m_PendingTimings.front();
+
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(pending.Queries.back(), GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available == GL_FALSE)
+			{
+				break;
+			}
+
+			m_Timings.clear();
+			for (size_t i = 0; i < pending.Queries.size(); ++i)
+			{
+				GLuint64 nanoseconds = 0;
+				glGetQueryObjectui64v(pending.Queries[i], GL_QUERY_RESULT, &nanoseconds);
+				m_Timings.push_back({ .Type = pending.Types[i], .GpuMilliseconds = static_cast<double>(nanoseconds) / 1'000'000.0 });
+			}
+
+			m_FreeQueries.insert(m_FreeQueries.end(), pending.Queries.begin(), pending.Queries.end());
+			m_PendingTimings.pop_front();
+		}
+	}
+}
\ No newline at end of file
@@ -104,6 +104,14 @@ namespace DGL::Brushes
 		}
 	}
 
+	void ShaderProgram::UploadInt1(const std::string_view name, const int32_t x)
+	{
+		if (const auto location = GetUniformLocation(name); location != -1)
+		{
+			glProgramUniform1i(m_RendererId, location, x);
+		}
+	}
+
 	void ShaderProgram::UploadFloat1(const std::string_view name, const float x)
 	{
 		if (const auto location = GetUniformLocation(name); location != -1)
@@ -144,6 +152,14 @@ namespace DGL::Brushes
 		}
 	}
 
+	void ShaderProgram::UploadFloatArray(const std::string_view name, const std::span<const float> values)
+	{
+		if (const auto location = GetUniformLocation(name); location != -1)
+		{
+			glProgramUniform1fv(m_RendererId, location, static_cast<GLsizei>(values.size()), values.data());
+		}
+	}
+
 	GLuint ShaderProgram::GetRendererId() const
 	{
 		return m_RendererId;
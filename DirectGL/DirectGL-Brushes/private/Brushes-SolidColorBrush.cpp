@@ -1,6 +1,6 @@
 ﻿module;
 
-#include <Glad/gl.h>
+#include <glad/gl.h>
 #include <format>
 
 module DirectGL.Brushes;
@@ -2,6 +2,9 @@
 
 #include <glad/gl.h>
 
+#include <algorithm>
+#include <format>
+#include <string>
 #include <type_traits>
 
 module DirectGL.Brushes;
@@ -10,39 +13,74 @@ import DirectGL.Logging;
 inline static constexpr auto VERTEX_SOURCE = R"(
 #version 460 core
 
-layout (location = 0) in vec3 a_Position;
-layout (location = 1) in vec2 a_TexCoord;
+layout (location = 0) in vec3 a_TransformRow0;
+layout (location = 1) in vec3 a_TransformRow1;
+layout (location = 2) in vec4 a_TextureRect;
+layout (location = 3) in float a_Depth;
+layout (location = 4) in vec4 a_Color;
+layout (location = 5) in uint a_TextureSlot;
 
 layout (location = 0) out vec2 v_TexCoord;
+layout (location = 1) out vec4 v_Color;
+layout (location = 2) flat out uint v_TextureSlot;
 
 uniform mat4 u_ProjectionViewMatrix;
-uniform mat4 u_ModelMatrix;
+
+const vec2 CORNERS[4] = vec2[4](
+	vec2(0.0, 0.0),
+	vec2(1.0, 0.0),
+	vec2(0.0, 1.0),
+	vec2(1.0, 1.0)
+);
 
 void main() {
-	gl_Position = u_ProjectionViewMatrix * u_ModelMatrix * vec4(a_Position, 1.0);
-	v_TexCoord = a_TexCoord;
+	vec3 corner = vec3(CORNERS[gl_VertexID], 1.0);
+	vec2 position = vec2(dot(a_TransformRow0, corner), dot(a_TransformRow1, corner));
+
+	gl_Position = u_ProjectionViewMatrix * vec4(position, a_Depth, 1.0);
+	v_TexCoord = mix(a_TextureRect.xy, a_TextureRect.zw, corner.xy);
+	v_Color = a_Color;
+	v_TextureSlot = a_TextureSlot;
 }
 )";
 
-inline static constexpr auto FRAGMENT_SOURCE = R"(
+inline static constexpr auto FRAGMENT_SOURCE_HEADER = R"(
 #version 460 core
 
 layout (location = 0) out vec4 o_FragColor;
 layout (location = 0) in vec2 v_TexCoord;
+layout (location = 1) in vec4 v_Color;
+layout (location = 2) flat in uint v_TextureSlot;
+)";
 
-layout (binding = 0) uniform sampler2D u_Texture;
-uniform vec4 u_ImageTint;
-uniform float u_ImageAlpha;
-
+inline static constexpr auto FRAGMENT_SOURCE_MAIN = R"(
 void main() {
-	o_FragColor = texture(u_Texture, v_TexCoord) * u_ImageTint;
-	o_FragColor.a *= u_ImageAlpha;
+	o_FragColor = SampleTexture(v_TextureSlot, v_TexCoord) * v_Color;
 }
 )";
 
+/// Indexing a sampler array with a per-vertex value is not dynamically uniform, which
+/// GLSL doesn't allow. Instead, the slot gets resolved using a switch with one constant
+/// index per texture unit.
+static std::string BuildFragmentSource(const size_t textureSlotCount)
+{
+	std::string source = FRAGMENT_SOURCE_HEADER;
+	source += std::format("layout (binding = 0) uniform sampler2D u_Textures[{}];\n\n", textureSlotCount);
+	source += "vec4 SampleTexture(uint slot, vec2 texCoord) {\n\tswitch (slot) {\n";
+
+	for (size_t slot = 0; slot < textureSlotCount; ++slot)
+	{
+		source += std::format("\t\tcase {0}u: return texture(u_Textures[{0}], texCoord);\n", slot);
+	}
+
+	source += "\t}\n\treturn vec4(1.0, 0.0, 1.0, 1.0);\n}\n";
+	source += FRAGMENT_SOURCE_MAIN;
+	return source;
+}
+
 namespace DGL::Brushes
 {
-	std::unique_ptr<TextureBrush> TextureBrush::Create()
+	std::unique_ptr<TextureBrush> TextureBrush::Create(const size_t textureSlotCount, Texture::SamplerCache& samplerCache)
 	{
 		const auto vertexShader = Shader::Create(VERTEX_SOURCE, ShaderType::Vertex);
 		if (not vertexShader)
@@ -51,7 +89,7 @@ namespace DGL::Brushes
 			return nullptr;
 		}
 
-		const auto fragmentShader = Shader::Create(FRAGMENT_SOURCE, ShaderType::Fragment);
+		const auto fragmentShader = Shader::Create(BuildFragmentSource(textureSlotCount), ShaderType::Fragment);
 		if (not fragmentShader)
 		{
 			Logging::Error("Failed to create fragment shader for texture brush");
@@ -65,22 +103,28 @@ namespace DGL::Brushes
 			return nullptr;
 		}
 
-		return std::unique_ptr<TextureBrush>(new TextureBrush(std::move(shaderProgram)));
+		return std::unique_ptr<TextureBrush>(new TextureBrush(std::move(shaderProgram), textureSlotCount, samplerCache));
 	}
 
-	void TextureBrush::SetTexture(const Texture::Texture* texture)
+	void TextureBrush::SetSamplerState(const Texture::SamplerState& state)
 	{
-		m_Texture = texture;
+		// Picks a prebuilt sampler, the parameters of samplers never change
+		if (state != m_TextureSampler->GetState())
+		{
+			m_TextureSampler = &m_SamplerCache->Get(state);
+		}
 	}
 
-	const Texture::Texture* TextureBrush::GetTexture() const
+	const Texture::SamplerState& TextureBrush::GetSamplerState() const
 	{
-		return m_Texture;
+		return m_TextureSampler->GetState();
 	}
 
 	void TextureBrush::SetFilterMode(const Texture::TextureFilterMode filterMode)
 	{
-		m_TextureSampler->SetFilterMode(filterMode);
+		Texture::SamplerState state = m_TextureSampler->GetState();
+		state.FilterMode = filterMode;
+		SetSamplerState(state);
 	}
 
 	Texture::TextureFilterMode TextureBrush::GetFilterMode() const
@@ -90,7 +134,9 @@ namespace DGL::Brushes
 
 	void TextureBrush::SetWrapMode(const Texture::TextureWrapMode wrapMode)
 	{
-		m_TextureSampler->SetWrapMode(wrapMode);
+		Texture::SamplerState state = m_TextureSampler->GetState();
+		state.WrapMode = wrapMode;
+		SetSamplerState(state);
 	}
 
 	Texture::TextureWrapMode TextureBrush::GetWrapMode() const
@@ -98,40 +144,45 @@ namespace DGL::Brushes
 		return m_TextureSampler->GetWrapMode();
 	}
 
-	void TextureBrush::UploadUniforms(
-		const Math::Matrix4x4& projectionViewMatrix,
-		const Math::Matrix4x4& modelMatrix,
-		const Renderer::Color imageTint,
-		const uint8_t imageAlpha
-	)
+	void TextureBrush::SetAnisotropy(const float anisotropy)
 	{
-		if (m_Texture == nullptr)
-		{
-			Logging::Warning("TextureBrush: No texture set, cannot upload uniforms");
-			return;
-		}
+		Texture::SamplerState state = m_TextureSampler->GetState();
+		state.Anisotropy = anisotropy;
+		SetSamplerState(state);
+	}
 
-		m_ShaderProgram->UploadTexture("u_Texture", 0);
+	float TextureBrush::GetAnisotropy() const
+	{
+		return m_TextureSampler->GetAnisotropy();
+	}
+
+	void TextureBrush::SetBorderColor(const Math::Float4 borderColor)
+	{
+		Texture::SamplerState state = m_TextureSampler->GetState();
+		state.BorderColor = borderColor;
+		SetSamplerState(state);
+	}
+
+	Math::Float4 TextureBrush::GetBorderColor() const
+	{
+		return m_TextureSampler->GetBorderColor();
+	}
+
+	void TextureBrush::UploadUniforms(const Math::Matrix4x4& projectionViewMatrix)
+	{
 		m_ShaderProgram->UploadMatrix4x4("u_ProjectionViewMatrix", std::span<const float, 16>(projectionViewMatrix.GetData(), 16));
-		m_ShaderProgram->UploadMatrix4x4("u_ModelMatrix", std::span<const float, 16>(modelMatrix.GetData(), 16));
-		m_ShaderProgram->UploadFloat1("u_ImageAlpha", static_cast<float>(imageAlpha) / 255.0f);
-		m_ShaderProgram->UploadFloat4(
-			"u_ImageTint",
-			static_cast<float>(imageTint.R) / 255.0f,
-			static_cast<float>(imageTint.G) / 255.0f,
-			static_cast<float>(imageTint.B) / 255.0f,
-			static_cast<float>(imageTint.A) / 255.0f
-		);
-
-		glBindSampler(0, m_TextureSampler->GetRendererId());
-		glBindTextureUnit(0, m_Texture->GetRendererId());
+
+		// Every texture unit of the batch shares the same sampler
+		std::ranges::fill(m_SamplerIds, m_TextureSampler->GetRendererId());
+		glBindSamplers(0, static_cast<GLsizei>(m_SamplerIds.size()), m_SamplerIds.data());
 		ShaderProgram::Activate(m_ShaderProgram.get());
 	}
 
-	TextureBrush::TextureBrush(std::unique_ptr<ShaderProgram> shaderProgram):
+	TextureBrush::TextureBrush(std::unique_ptr<ShaderProgram> shaderProgram, const size_t textureSlotCount, Texture::SamplerCache& samplerCache):
 		m_ShaderProgram(std::move(shaderProgram)),
-		m_TextureSampler(Texture::TextureSampler::Create()),
-		m_Texture(nullptr)
+		m_SamplerCache(&samplerCache),
+		m_TextureSampler(&samplerCache.Get({})),
+		m_SamplerIds(textureSlotCount, 0)
 	{
 	}
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+﻿// Project Name : DirectGL-Brushes
+// File Name    : Brushes-Filter.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <string_view>
+
+export module DirectGL.Brushes:Filter;
+
+import DirectGL.Math;
+
+export namespace DGL::Brushes
+{
+	enum class FilterType
+	{
+		GaussianBlur,	//!< Blurs the image with a separable Gaussian kernel
+		Bloom,			//!< Adds a blurred copy of the bright areas on top of the image
+		ColorMatrix,	//!< Multiplies every color with a matrix and adds an offset
+		Threshold,		//!< Turns pixels white if their luminance reaches a level and black otherwise
+	};
+
+	/// A single step of a filter chain. Use the factory functions to create one,
+	/// every field not used by the type of the filter is ignored.
+	struct Filter
+	{
+		FilterType Type = FilterType::GaussianBlur;
+		float Radius = 0.0f;						//!< GaussianBlur, Bloom: The standard deviation of the blur in pixels of the layer
+		uint32_t Downsample = 1;					//!< GaussianBlur, Bloom: The factor the image gets shrunk by before it gets blurred. Either 1, 2 or 4
+		float Level = 0.0f;							//!< Bloom, Threshold: The luminance in [0, 1] a pixel must reach to count as bright
+		float Intensity = 0.0f;						//!< Bloom: The factor the glow gets added with
+		Math::Matrix4x4 Matrix;						//!< ColorMatrix: The matrix the normalized RGBA color gets multiplied with
+		Math::Float4 Offset;						//!< ColorMatrix: The normalized RGBA color added after the multiplication
+
+		/// @brief Blur the image. Larger radii are cheaper at a higher downsample factor,
+		///		   as the blur then runs on a quarter or sixteenth of the pixels.
+		static constexpr Filter GaussianBlur(float radius, uint32_t downsample = 2);
+		static constexpr Filter Bloom(float level, float intensity, float radius, uint32_t downsample = 4);
+		static constexpr Filter ColorMatrix(const Math::Matrix4x4& matrix, Math::Float4 offset = {});
+		static constexpr Filter Grayscale();
+		static constexpr Filter Threshold(float level);
+	};
+
+	struct FilterTiming
+	{
+		FilterType Type;
+		double GpuMilliseconds;	//!< The time the GPU spent on every pass of the filter
+	};
+
+	std::string_view GetFilterName(FilterType type);
+}
+
+namespace DGL::Brushes
+{
+	constexpr Filter Filter::GaussianBlur(const float radius, const uint32_t downsample)
+	{
+		return { .Type = FilterType::GaussianBlur, .Radius = radius, .Downsample = downsample };
+	}
+
+	constexpr Filter Filter::Bloom(const float level, const float intensity, const float radius, const uint32_t downsample)
+	{
+		return { .Type = FilterType::Bloom, .Radius = radius, .Downsample = downsample, .Level = level, .Intensity = intensity };
+	}
+
+	constexpr Filter Filter::ColorMatrix(const Math::Matrix4x4& matrix, const Math::Float4 offset)
+	{
+		return { .Type = FilterType::ColorMatrix, .Matrix = matrix, .Offset = offset };
+	}
+
+	constexpr Filter Filter::Grayscale()
+	{
+		// Rec. 601 luminance weights, alpha stays untouched
+		return ColorMatrix(Math::Matrix4x4(
+			0.299f, 0.587f, 0.114f, 0.0f,
+			0.299f, 0.587f, 0.114f, 0.0f,
+			0.299f, 0.587f, 0.114f, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		));
+	}
+
+	constexpr Filter Filter::Threshold(const float level)
+	{
+		return { .Type = FilterType::Threshold, .Level = level };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+﻿// Project Name : DirectGL-Brushes
+// File Name    : Brushes-FilterChain.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <glad/gl.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <vector>
+
+export module DirectGL.Brushes:FilterChain;
+
+import :Filter;
+import :ShaderProgram;
+
+import DirectGL.Math;
+import DirectGL.Texture;
+import DirectGL.Renderer;
+
+export namespace DGL::Brushes
+{
+	/// Applies filters to the contents of a render target using full-screen passes.
+	/// The image ping-pongs between color-only targets of the render target pool, so
+	/// a chain allocates nothing once the pool is warm. Blurs run on a downsampled copy
+	/// and merge two Gaussian taps into one bilinear fetch, which roughly quarters the
+	/// number of texture reads compared to a naive kernel at full resolution.
+	///
+	/// Every filter is wrapped in a GPU timer query. The results get collected without
+	/// waiting, so the timings lag a few frames behind.
+	class FilterChain
+	{
+	public:
+
+		/// @brief Create a filter chain.
+		/// @param renderTargetPool The pool providing the intermediate targets. Must outlive the chain.
+		/// @param samplerCache The cache providing the bilinear sampler. Must outlive the chain.
+		/// @return The filter chain or nullptr if the shaders failed to compile.
+		static std::unique_ptr<FilterChain> Create(Renderer::RenderTargetPool& renderTargetPool, Texture::SamplerCache& samplerCache);
+
+		~FilterChain();
+
+		/// @brief Filter the contents of a render target in place. The bound framebuffer and viewport
+		///		   get restored afterwards, whereas the program, vertex array and the textures and samplers
+		///		   of the units 0 and 1 are left changed. Blending must be disabled.
+		/// @param renderTarget The render target to filter.
+		/// @param filters The filters, applied in order.
+		void Apply(Renderer::RenderTarget& renderTarget, std::span<const Filter> filters);
+
+		/// @return The GPU time of every filter of the latest chain whose measurements are available.
+		std::span<const FilterTiming> GetTimings();
+
+	private:
+
+		using Target = std::unique_ptr<Renderer::OffscreenRenderTarget>;
+
+		struct Programs
+		{
+			std::unique_ptr<ShaderProgram> Blur;		//!< One direction of a separable Gaussian blur
+			std::unique_ptr<ShaderProgram> BrightPass;	//!< Keeps the colors above a luminance level
+			std::unique_ptr<ShaderProgram> Combine;		//!< Adds a scaled second texture to the first one
+			std::unique_ptr<ShaderProgram> ColorMatrix;
+			std::unique_ptr<ShaderProgram> Threshold;
+		};
+
+		struct PendingTimings
+		{
+			std::vector<GLuint> Queries;
+			std::vector<FilterType> Types;
+		};
+
+		explicit FilterChain(Programs programs, Renderer::RenderTargetPool& renderTargetPool, const Texture::TextureSampler& sampler, GLuint vertexArrayId);
+
+		Target ApplyGaussianBlur(Target source, float radius, uint32_t downsample);
+		Target ApplyBloom(Target source, const Filter& filter);
+		Target ApplyColorMatrix(Target source, const Filter& filter);
+		Target ApplyThreshold(Target source, const Filter& filter);
+
+		/// @brief Shrink an image by halving it repeatedly using linear blits.
+		Target Downsample(const Renderer::OffscreenRenderTarget& source, uint32_t factor);
+
+		/// @brief Blur an image once horizontally and once vertically, both at the size of the image.
+		Target BlurSeparable(Target source, float radius);
+
+		void DrawPass(ShaderProgram& program, const Renderer::RenderTarget& destination, const Renderer::OffscreenRenderTarget& source, const Renderer::OffscreenRenderTarget* secondSource = nullptr);
+
+		/// @brief Get an intermediate target. Its contents are stale, every pass overwrites all of its texels.
+		Target Acquire(Math::Uint2 size);
+
+		/// @brief Return an intermediate target, the next pass of the chain may reuse it right away.
+		void Release(Target renderTarget);
+
+		GLuint AcquireQuery();
+		void CollectTimings();
+
+		Programs m_Programs;
+		Renderer::RenderTargetPool* m_RenderTargetPool;
+		const Texture::TextureSampler* m_Sampler;	//!< Owned by the sampler cache
+		GLuint m_VertexArrayId;						//!< Empty, the full-screen triangle is generated from gl_VertexID
+
+		std::deque<PendingTimings> m_PendingTimings;	//!< Ordered by submission, the oldest first
+		std::vector<GLuint> m_FreeQueries;
+		std::vector<FilterTiming> m_Timings;
+
+	};
+}
\ No newline at end of file
@@ -5,7 +5,10 @@
 
 module;
 
+#include <glad/gl.h>
+
 #include <memory>
+#include <vector>
 
 export module DirectGL.Brushes:TextureBrush;
 
@@ -21,10 +24,15 @@ export namespace DGL::Brushes
 	{
 	public:
 
-		static std::unique_ptr<TextureBrush> Create();
+		/// @brief Create a texture brush sampling from an array of texture units.
+		/// @param textureSlotCount The number of texture units a single batch may use.
+		/// @param samplerCache The cache providing the samplers. Must outlive the brush.
+		/// @return The texture brush or nullptr if the shaders failed to compile.
+		static std::unique_ptr<TextureBrush> Create(size_t textureSlotCount, Texture::SamplerCache& samplerCache);
 
-		void SetTexture(const Texture::Texture* texture);
-		const Texture::Texture* GetTexture() const;
+		/// @brief Switch every sampling parameter at once, which avoids creating samplers for intermediate states.
+		void SetSamplerState(const Texture::SamplerState& state);
+		const Texture::SamplerState& GetSamplerState() const;
 
 		void SetFilterMode(Texture::TextureFilterMode filterMode);
 		Texture::TextureFilterMode GetFilterMode() const;
@@ -32,16 +40,26 @@ export namespace DGL::Brushes
 		void SetWrapMode(Texture::TextureWrapMode wrapMode);
 		Texture::TextureWrapMode GetWrapMode() const;
 
-		void UploadUniforms(const Math::Matrix4x4& projectionViewMatrix, const Math::Matrix4x4& modelMatrix, Renderer::Color imageTint, uint8_t imageAlpha);
+		void SetAnisotropy(float anisotropy);
+		float GetAnisotropy() const;
+
+		void SetBorderColor(Math::Float4 borderColor);
+		Math::Float4 GetBorderColor() const;
+
+		/// @brief Activate the brush for a batch of textured quads. The textures
+		///		   themselves are bound by the texture renderer, while the tint and
+		///		   alpha travel with every vertex.
+		/// @param projectionViewMatrix The projection-view matrix of the graphics layer.
+		void UploadUniforms(const Math::Matrix4x4& projectionViewMatrix);
 
 	private:
 
-		explicit TextureBrush(std::unique_ptr<ShaderProgram> shaderProgram);
+		explicit TextureBrush(std::unique_ptr<ShaderProgram> shaderProgram, size_t textureSlotCount, Texture::SamplerCache& samplerCache);
 
 		std::unique_ptr<ShaderProgram> m_ShaderProgram;
-		std::unique_ptr<Texture::TextureSampler> m_TextureSampler;
+		Texture::SamplerCache* m_SamplerCache;
+		const Texture::TextureSampler* m_TextureSampler;	//!< Owned by the sampler cache
+		std::vector<GLuint> m_SamplerIds;
 
-		const Texture::Texture* m_Texture;
-		
 	};
 }
\ No newline at end of file
@@ -6,4 +6,6 @@
 export module DirectGL.Brushes;
 
 export import :SolidColorBrush;
-export import :TextureBrush;
\ No newline at end of file
+export import :TextureBrush;
+export import :Filter;
+export import :FilterChain;
\ No newline at end of file
@@ -21,12 +21,16 @@ project("DirectGL-Core")
         "DirectGL-Renderer",
         "DirectGL-ShapeRenderer",
         "DirectGL-TextureRenderer",
+        "DirectGL-RHI",
+        "DirectGL-SoftwareRenderer",
 
         "DirectGL-Input",
         "DirectGL-Logging",
         "DirectGL-Math",
 
         -- Utilities
+        "FrameRing",
+        "Jobs",
         "LogForge",
         "Startup",
         "Preconditions",
@@ -51,8 +55,13 @@ project("DirectGL-Core")
 
     filter("system:windows")
         systemversion("latest")
+        defines({ "PLATFORM_WINDOWS" })
         links({ "opengl32" })
 
+    filter("system:linux")
+        defines({ "PLATFORM_HEADLESS" })
+        links({ "EGL" })
+
     filter("configurations:Debug")
         runtime("Debug")
         symbols("On")
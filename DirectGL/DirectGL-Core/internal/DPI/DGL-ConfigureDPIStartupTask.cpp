@@ -1,21 +1,26 @@
 ﻿module;
 
+#ifdef PLATFORM_WINDOWS
 #include <Windows.h>
+#endif
 
 #include <memory>
 #include <string_view>
 
 module DirectGL;
 
+#ifdef PLATFORM_WINDOWS
 using LibraryPtr = std::unique_ptr<HINSTANCE__, decltype(&FreeLibrary)>;
 
 inline LibraryPtr Load(const std::string_view libraryName)
 {
 	return LibraryPtr(LoadLibraryA(libraryName.data()), &FreeLibrary);
 }
+#endif
 
 namespace DGL
 {
+#ifdef PLATFORM_WINDOWS
 	inline bool EnableShCore()
 	{
 		const LibraryPtr shCore = Load("shcore.dll");
@@ -63,9 +68,11 @@ namespace DGL
 
 		return functionPtr() == TRUE;
 	}
+#endif
 
 	Startup::StartupTask::Continuation ConfigureDPIStartupTask::Setup()
 	{
+#ifdef PLATFORM_WINDOWS
 		if (EnableShCore())
 		{
 			Info("DPI Awareness set to Per-Monitor using shcore.dll");
@@ -80,6 +87,10 @@ namespace DGL
 
 		Warning("Couldn't set DPI Awareness");
 		return Continue; //!< DPI awareness couldn't be set, but we can continue anyway
+#else
+		Debug("DPI awareness only applies to Windows");
+		return Continue;
+#endif
 	}
 
 	void ConfigureDPIStartupTask::Teardown()
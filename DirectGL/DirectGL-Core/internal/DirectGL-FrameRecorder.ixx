@@ -0,0 +1,97 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-FrameRecorder.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+export module DirectGL:FrameRecorder;
+
+import DirectGL.Renderer;
+import DirectGL.Texture;
+
+import :GraphicsLayer;
+import :Recording;
+
+namespace DGL
+{
+	/// Records presented frames into image sequences. Frames are copied through
+	/// the asynchronous pixel readback and encoded on a pool of worker threads,
+	/// so rendering continues while the previous frames are being written.
+	class FrameRecorder
+	{
+	public:
+
+		/// @brief Create a new frame recorder.
+		/// @param workerCount The number of encoding threads.
+		static std::unique_ptr<FrameRecorder> Create(size_t workerCount);
+
+		~FrameRecorder();
+
+		/// @brief Start a new recording and reset the statistics.
+		/// @param settings Where and how to record.
+		/// @return True if the output directory could be created.
+		bool Start(const RecordingSettings& settings);
+
+		/// Stop capturing frames. Frames that have been captured already still get written.
+		void Stop();
+
+		bool IsRecording() const;
+
+		/// @brief Capture the frame drawn onto the layer. Must be called on the GL thread
+		///		   after the frame has been drawn and before it gets presented.
+		/// @param layer The layer to copy.
+		/// @param frameNumber The number used in the file name.
+		void Capture(GraphicsLayer& layer, uint64_t frameNumber);
+
+		RecordingStatistics GetStatistics() const;
+
+	private:
+
+		struct EncodeJob
+		{
+			std::filesystem::path Path;
+			Texture::ImageFileFormat Format;
+			Renderer::PixelData Frame;
+		};
+
+		FrameRecorder();
+
+		void Enqueue(EncodeJob job);
+		void RunWorker(std::stop_token stopToken);
+		void Encode(EncodeJob& job);
+
+		RecordingSettings m_Settings;
+		bool m_IsRecording;
+		uint64_t m_FrameCounter;		//!< The frames presented since the recording started, used for the interval
+		size_t m_PendingReadbacks;		//!< The frames captured but not yet delivered by the readback
+
+		std::chrono::steady_clock::time_point m_StartTime;
+		std::chrono::steady_clock::time_point m_StopTime;
+
+		mutable std::mutex m_Mutex;
+		std::condition_variable_any m_JobAvailable;
+		std::condition_variable m_JobTaken;
+		std::deque<EncodeJob> m_Jobs;
+
+		std::atomic<uint64_t> m_CapturedFrames;
+		std::atomic<uint64_t> m_EncodedFrames;
+		std::atomic<uint64_t> m_DroppedFrames;
+		std::atomic<uint64_t> m_FailedFrames;
+		std::atomic<uint64_t> m_WrittenBytes;
+		std::atomic<uint64_t> m_EncodeMicroseconds;
+
+		std::vector<std::jthread> m_Workers;
+
+	};
+}
\ No newline at end of file
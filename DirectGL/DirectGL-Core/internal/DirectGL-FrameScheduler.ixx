@@ -0,0 +1,90 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-FrameScheduler.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+export module DirectGL:FrameScheduler;
+
+import System.Window;
+
+import :FramePacing;
+
+namespace DGL
+{
+	/// Paces the main loop. With a target frame rate every frame is due one interval
+	/// after the previous one. The loop sleeps until shortly before that and spins for
+	/// the rest, since a sleep alone may overshoot by a whole scheduler tick.
+	///
+	/// Sketches that don't loop block on the event source of the window instead of
+	/// polling it, so they don't use any CPU time until input or Redraw() arrives.
+	class FrameScheduler
+	{
+	public:
+
+		static std::unique_ptr<FrameScheduler> Create();
+
+		~FrameScheduler();
+
+		/// @brief Cap the frames drawn per second.
+		/// @param framesPerSecond The target frame rate, zero removes the cap.
+		void SetTargetFrameRate(float framesPerSecond);
+		float GetTargetFrameRate() const;
+
+		/// @brief Mark the start of a frame.
+		void BeginFrame();
+
+		/// @brief Mark the end of a frame once it has been presented and wait until the next one is due.
+		void EndFrame();
+
+		/// @brief Wait for the next event of the window while the sketch doesn't loop. The first
+		///		   calls after a frame only wait for a short interval, so the readbacks of the frame
+		///		   still get delivered.
+		/// @param hasPendingWork Whether other work waits for the main thread, which keeps the wait short as well.
+		/// @return The event, or std::nullopt if the wait ended without one.
+		std::optional<System::WindowEvent> WaitForEvent(System::Window& window, bool hasPendingWork);
+
+		FrameTimingStatistics GetStatistics() const;
+
+	private:
+
+		using Clock = std::chrono::steady_clock;
+
+		FrameScheduler();
+
+		/// @brief Sleep until shortly before the deadline and spin for the rest.
+		void WaitUntil(Clock::time_point deadline);
+
+		static constexpr uint32_t SettleLoops = 3;								//!< Readbacks get delivered one or two frames after they have been issued
+		static constexpr std::chrono::milliseconds PollInterval{ 16 };
+		static constexpr double FrameRateSmoothing = 0.1;						//!< The weight of the latest interval in the measured frame rate
+
+		float m_TargetFrameRate;
+		Clock::duration m_Interval;				//!< Zero if the frame rate isn't capped
+		Clock::duration m_SpinDuration;			//!< The time before a deadline spent spinning instead of sleeping
+		void* m_Timer;							//!< The high resolution timer to sleep with, if the platform provides one
+
+		Clock::time_point m_FrameStart;
+		Clock::time_point m_NextFrame;
+		bool m_HasIdled;						//!< Whether the loop waited for events since the last frame started
+		uint32_t m_LoopsSinceFrame;
+
+		uint64_t m_Frames;
+		uint64_t m_MissedFrames;
+		uint64_t m_Intervals;
+		double m_SmoothedInterval;				//!< In seconds
+		Clock::duration m_FrameTime;
+		Clock::duration m_IntervalTime;
+		Clock::duration m_MaxInterval;
+		Clock::duration m_SleepTime;
+		Clock::duration m_SpinTime;
+		Clock::duration m_IdleTime;
+
+	};
+}
\ No newline at end of file
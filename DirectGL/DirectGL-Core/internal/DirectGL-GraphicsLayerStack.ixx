@@ -26,6 +26,12 @@ namespace DGL
 
 		GraphicsLayer& PeekLayer();
 
+		/// @brief Flush the layer on top, so layers that aren't on the stack can take over the renderers.
+		void Suspend();
+
+		/// @brief Direct the renderers to the layer on top again.
+		void Resume();
+
 	private:
 
 		MainGraphicsLayer* m_MainLayer;
@@ -6,17 +6,22 @@
 module;
 
 #include <memory>
+#include <future>
+#include <span>
 
 export module DirectGL:MainGraphicsLayer;
 
 import DirectGL.Blending;
+import DirectGL.Brushes;
 import DirectGL.Renderer;
 import DirectGL.ShapeRenderer;
 import DirectGL.Math;
 
 import :BaseGraphicsLayer;
+import :PixelBuffer;
 import :RenderStateStack;
 import :RendererFacade;
+import :Sprite;
 
 export namespace DGL
 {
@@ -26,8 +31,7 @@ export namespace DGL
 
 		static std::unique_ptr<MainGraphicsLayer> Create(
 			Math::Uint2 viewportSize,
-			RendererFacade& renderer,
-			Blending::BlendModeActivator& blendModeActivator
+			RendererFacade& renderer
 		);
 
 		void Resize(Math::Uint2 viewportSize);
@@ -70,6 +74,8 @@ export namespace DGL
 		void SetImageTint(Renderer::Color tint) override;
 		void SetImageAlpha(uint8_t alpha) override;
 		void SetImageOpacity(float opacity) override;
+		void SetImageFilterMode(Texture::TextureFilterMode filterMode) override;
+		void SetImageAnisotropy(float anisotropy) override;
 
 		void Background(Renderer::Color color) override;
 		void Rect(float x1, float y1, float x2, float y2) override;
@@ -78,16 +84,26 @@ export namespace DGL
 		void Line(float x1, float y1, float x2, float y2) override;
 		void Triangle(float x1, float y1, float x2, float y2, float x3, float y3) override;
 		void Image(const Texture::Texture& texture, float x1, float y1, float x2, float y2) override;
+		void Image(const Texture::TextureRegion& region, float x1, float y1, float x2, float y2) override;
+		void Image(const Texture::Texture& texture, const Sprite& sprite) override;
+		void Image(const Texture::Texture& texture, std::span<const Sprite> sprites) override;
+
+		void ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback) override;
+		std::future<Renderer::PixelData> ReadPixelsAsync(const Math::UintBoundary& region) override;
+		void ViewPixelsAsync(const Math::UintBoundary& region, Renderer::PixelViewCallback callback) override;
+
+		PixelBuffer& LoadPixels() override;
+		void UpdatePixels() override;
+		void ApplyFilters(std::span<const Brushes::Filter> filters) override;
 
 	private:
 
 		explicit MainGraphicsLayer(
 			Math::Uint2 viewportSize,
-			RendererFacade& renderer,
-			Blending::BlendModeActivator& blendModeActivator
+			RendererFacade& renderer
 		);
 
-		std::unique_ptr<Renderer::MainRenderTarget> m_MainRenderTarget;
+		RendererFacade* m_Renderer;
 		BaseGraphicsLayer m_GraphicsLayer;
 
 	};
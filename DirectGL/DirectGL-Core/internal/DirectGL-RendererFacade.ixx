@@ -5,14 +5,21 @@
 
 module;
 
+#include <future>
 #include <memory>
+#include <span>
+#include <vector>
 
 export module DirectGL:RendererFacade;
 
+import DirectGL.Brushes;
 import DirectGL.Math;
 import DirectGL.Renderer;
+import DirectGL.RHI;
 import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
 import DirectGL.TextureRenderer;
+import Jobs;
 
 import :DepthProvider;
 
@@ -20,19 +27,45 @@ namespace DGL
 {
 	/// @brief This class provides a simplified interface to the rendering subsystem.
 	///
-	/// It encapsulates the functionality of both the Renderer and ShapeRenderer,
-	/// PolygonRenderer as well as TextRenderer and provides a unified API for
-	/// common rendering tasks.
+	/// It tessellates shapes and lays out images on the CPU and hands the results to
+	/// a RenderDevice, which keeps the graphics layers independent of the backend.
+	///
+	/// Shapes are queued together with the pipeline and the constants they have been
+	/// drawn with. Once FlushShapes() gets called, every other command is issued or the
+	/// queue grows too large, all of them get tessellated at once, spread across the
+	/// workers of the job system, and reach the device in the order they were drawn in.
 	class RendererFacade
 	{
 	public:
 
+		/// @param jobSystem The workers tessellating the queued shapes, or nullptr to tessellate them on the calling thread.
 		explicit RendererFacade(
-			TextureRenderer::TextureRenderer& textureRenderer,
-			ShapeRenderer::ShapeRenderer& shapeRenderer,
-			ShapeRenderer::ShapeFactory& shapeFactory
+			RHI::RenderDevice& device,
+			ShapeRenderer::ShapeFactory& shapeFactory,
+			Jobs::JobSystem* jobSystem = nullptr
 		);
 
+		/// @brief Get the backend every draw call ends up in. Shapes may still be queued,
+		///		   call FlushShapes() before issuing draw commands to it directly.
+		RHI::RenderDevice& GetDevice();
+
+		/// @brief Redirect the following draw calls to another backend. Must be called
+		///		   between frames and the backend must share the resources of the previous one.
+		void SetDevice(RHI::RenderDevice& device);
+
+		/// @brief Get the tessellator of the shapes. It keeps no state, so renderers on other threads may share it.
+		ShapeRenderer::ShapeFactory& GetShapeFactory();
+
+		/// @brief Get the workers tessellating the queued shapes, if any.
+		Jobs::JobSystem* GetJobSystem();
+
+		/// @brief Direct the following draw calls to a render target.
+		void BeginPass(RHI::RenderTargetHandle renderTarget);
+
+		/// @brief Select the pipeline of the following draw calls.
+		void SetPipeline(const RHI::PipelineDescription& description);
+		void SetConstants(const RHI::DrawConstants& constants);
+
 		void FillRectangle(const Math::FloatBoundary& boundary, float depth);
 		void DrawRectangle(const Math::FloatBoundary& boundary, float strokeWeight, float depth);
 
@@ -41,13 +74,82 @@ namespace DGL
 
 		void FillTriangle(const Math::Float2& a, const Math::Float2& b, const Math::Float2& c, float depth);
 		void Line(const Math::Float2& start, const Math::Float2& end, float strokeWeight, ShapeRenderer::LineCapStyle startCap, ShapeRenderer::LineCapStyle endCap, float depth);
-		void Image(const Math::FloatBoundary& boundary, float depth);
+
+		/// @brief Tessellate the queued shapes and hand them to the device.
+		void FlushShapes();
+
+		/// @brief Queue a textured quad. Images are batched across textures and only
+		///		   reach the screen once FlushImages() gets called or the batch is full.
+		/// @param texture The texture to draw.
+		/// @param source The region of the texture in pixels. An empty region selects the whole texture.
+		/// @param destination The untransformed region the image gets drawn to.
+		/// @param origin The rotation origin relative to the top-left corner of the destination.
+		/// @param rotation The rotation around the origin.
+		/// @param transform The model matrix applied after the rotation.
+		/// @param tint The color every texel gets multiplied with.
+		/// @param depth The depth of the image.
+		void Image(
+			const Texture::Texture& texture,
+			const Math::FloatBoundary& source,
+			const Math::FloatBoundary& destination,
+			const Math::Float2& origin,
+			Math::Angle rotation,
+			const Math::Matrix4x4& transform,
+			Renderer::Color tint,
+			float depth
+		);
+		void FlushImages();
+
+		/// @brief Queue an asynchronous copy of a region of a render target.
+		///		   The callback gets invoked once the device finds the copy finished.
+		void ReadPixelsAsync(RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback);
+		std::future<Renderer::PixelData> ReadPixelsAsync(RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region);
+		void ViewPixelsAsync(RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback);
+
+		/// @brief Copy a region of a render target, waiting for the GPU to finish every command issued so far.
+		Renderer::PixelData ReadPixels(RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region);
+
+		/// @brief Replace a band of rows of a render target with pixels from system memory.
+		/// @param pixels The tightly packed RGBA8 pixels of the whole render target, starting with the top row.
+		void WritePixels(RHI::RenderTargetHandle renderTarget, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount);
+
+		/// @brief Filter the contents of a render target in place.
+		void ApplyFilters(RHI::RenderTargetHandle renderTarget, std::span<const Brushes::Filter> filters);
+
+		/// @brief Get the GPU time of every filter of the latest chain whose measurements are available.
+		std::span<const Brushes::FilterTiming> GetFilterTimings();
 
 	private:
 
-		TextureRenderer::TextureRenderer& m_TextureRenderer;
-		ShapeRenderer::ShapeRenderer& m_ShapeRenderer;
+		/// The state a queued shape has been drawn with, as indices into the queued pipelines and constants.
+		struct QueuedShape
+		{
+			size_t Pipeline;
+			size_t Constants;
+		};
+
+		/// Flushing caps the vertices tessellated ahead of the device, and with them the memory of the batch.
+		static constexpr size_t MaxQueuedVertices = 1 << 20;
+
+		void Draw(const ShapeRenderer::Vertices& vertices);
+		void Queue(const ShapeRenderer::Shape& shape);
+
+		/// @brief Hand the current pipeline and constants to the device, unless it already got them.
+		void ApplyState();
+
+		RHI::RenderDevice* m_Device;
 		ShapeRenderer::ShapeFactory& m_ShapeFactory;
+		Jobs::JobSystem* m_JobSystem;
+
+		RHI::PipelineDescription m_Pipeline;
+		RHI::DrawConstants m_Constants;
+		bool m_IsStateApplied;							//!< Whether the device got m_Pipeline and m_Constants
+		bool m_AreConstantsQueued;						//!< Whether m_Constants is the last element of m_QueuedConstants
+
+		ShapeRenderer::TessellationBatch m_Batch;
+		std::vector<QueuedShape> m_QueuedShapes;		//!< Parallel to the shapes of the batch
+		std::vector<RHI::PipelineDescription> m_QueuedPipelines;
+		std::vector<RHI::DrawConstants> m_QueuedConstants;
 
 	};
 }
\ No newline at end of file
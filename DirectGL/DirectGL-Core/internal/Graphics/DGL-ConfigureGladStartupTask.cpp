@@ -1,7 +1,10 @@
 ﻿module;
 
 #include <glad/gl.h>
-#include <glad/wgl.h>
+
+#ifdef PLATFORM_HEADLESS
+#include <EGL/egl.h>
+#endif
 
 #include <bit>
 #include <format>
@@ -13,7 +16,14 @@ namespace DGL
 {
 	Startup::StartupTask::Continuation ConfigureGladStartupTask::Setup()
 	{
-		if (not gladLoaderLoadGL())
+#ifdef PLATFORM_HEADLESS
+		// Mesa resolves core functions through EGL as well, so there is no dependency on libGL
+		const int version = gladLoadGL(std::bit_cast<GLADloadfunc>(&eglGetProcAddress));
+#else
+		const int version = gladLoaderLoadGL();
+#endif
+
+		if (version == 0)
 		{
 			Error("Failed to initialize GLAD");
 			return Abort;
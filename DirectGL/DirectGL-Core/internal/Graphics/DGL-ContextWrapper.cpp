@@ -1,6 +1,7 @@
 ﻿module;
 
 #include <format>
+#include <memory>
 
 module DirectGL;
 
@@ -19,6 +20,7 @@ namespace DGL
 			.IsDebuggingContext = true,
 			.IsCompatibilityContext = false,
 			.ParentWindow = m_WindowProvider()->GetNativeHandle(),
+			.FramebufferSize = m_WindowProvider()->GetSize(),
 			.OnError = [this](std::string_view message)
 			{
 				Error(std::format("OpenGL context error: {}", message));
@@ -53,4 +55,19 @@ namespace DGL
 	{
 		m_Context->Flush();
 	}
+
+	std::unique_ptr<System::Context> ContextWrapper::CreateSharedContext()
+	{
+		return m_Context->CreateSharedContext();
+	}
+
+	bool ContextWrapper::MakeCurrent()
+	{
+		return m_Context->MakeCurrent();
+	}
+
+	void ContextWrapper::ReleaseCurrent()
+	{
+		m_Context->ReleaseCurrent();
+	}
 }
\ No newline at end of file
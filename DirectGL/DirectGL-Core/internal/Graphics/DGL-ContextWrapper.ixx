@@ -5,7 +5,6 @@
 
 module;
 
-#include <Windows.h>
 #include <functional>
 #include <memory>
 
@@ -31,6 +30,10 @@ namespace DGL
 		void SetVerticalSyncEnabled(bool enabled) override;
 		void Flush() override;
 
+		std::unique_ptr<Context> CreateSharedContext() override;
+		bool MakeCurrent() override;
+		void ReleaseCurrent() override;
+
 	private:
 
 		WindowProvider m_WindowProvider;
@@ -1,5 +1,6 @@
 ﻿module;
 
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <format>
@@ -56,6 +57,8 @@ namespace DGL
 	}
 
 	std::optional<System::WindowEvent> WindowWrapper::PollEvent() { return m_Window->PollEvent(); }
+	std::optional<System::WindowEvent> WindowWrapper::WaitEvent(const std::chrono::milliseconds timeout) { return m_Window->WaitEvent(timeout); }
+	void WindowWrapper::Wake() { m_Window->Wake(); }
 	void WindowWrapper::SetPosition(const Math::Int2& position) { m_Window->SetPosition(position); }
 	Math::Int2 WindowWrapper::GetPosition() const { return m_Window->GetPosition(); }
 	void WindowWrapper::SetSize(const Math::Uint2& size) { m_Window->SetSize(size); }
@@ -5,6 +5,7 @@
 
 module;
 
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string_view>
@@ -28,6 +29,8 @@ namespace DGL
 		void Teardown() override;
 
 		std::optional<System::WindowEvent> PollEvent() override;
+		std::optional<System::WindowEvent> WaitEvent(std::chrono::milliseconds timeout) override;
+		void Wake() override;
 		void SetPosition(const Math::Int2& position) override;
 		Math::Int2 GetPosition() const override;
 		void SetSize(const Math::Uint2& size) override;
@@ -1,7 +1,10 @@
 ﻿module;
 
+#include <future>
 #include <memory>
 #include <algorithm>
+#include <span>
+#include <utility>
 
 module DirectGL;
 
@@ -9,20 +12,31 @@ import :BaseGraphicsLayer;
 
 namespace DGL
 {
-	BaseGraphicsLayer::BaseGraphicsLayer(RendererFacade& renderer, const Math::Uint2 viewportSize, Blending::BlendModeActivator& blendModeActivator, std::unique_ptr<DepthProvider> depthProvider) :
+	BaseGraphicsLayer::BaseGraphicsLayer(RendererFacade& renderer, const RHI::RenderTargetHandle renderTarget, const Math::Uint2 viewportSize, std::unique_ptr<DepthProvider> depthProvider) :
 		m_Renderer(&renderer),
-		m_BlendModeActivator(&blendModeActivator),
-		m_SolidFillBrush(Brushes::SolidColorBrush::Create(Colors::White)),
-		m_SolidStrokeBrush(Brushes::SolidColorBrush::Create(Colors::White)),
-		m_TextureFillBrush(Brushes::TextureBrush::Create()),
+		m_RenderTarget(renderTarget),
 		m_DepthProvider(std::move(depthProvider)),
 		m_Viewport(Math::FloatBoundary::FromLTWH(0.0f, 0.0f, static_cast<float>(viewportSize.X), static_cast<float>(viewportSize.Y))),
-		m_ProjectionMatrix(Math::Matrix4x4::Orthographic(m_Viewport, -1.0f, 1.0f))
+		m_ProjectionMatrix(Math::Matrix4x4::Orthographic(m_Viewport, -1.0f, 1.0f)),
+		m_ContentVersion(0),
+		m_HasPendingImages(false),
+		m_PendingImageBlendMode(Blending::BlendModes::Alpha),
+		m_PendingImageFilterMode(Texture::TextureFilterMode::Linear),
+		m_PendingImageAnisotropy(1.0f)
 	{
 	}
 
+	void BaseGraphicsLayer::SetRenderer(RendererFacade& renderer)
+	{
+		Submit();
+		m_Renderer = &renderer;
+	}
+
 	void BaseGraphicsLayer::SetViewport(const Math::FloatBoundary viewport)
 	{
+		// Pending images have been placed using the previous projection
+		Flush();
+
 		m_Viewport = viewport;
 		m_ProjectionMatrix = Math::Matrix4x4::Orthographic(m_Viewport, -1.0f, 1.0f);
 	}
@@ -40,7 +54,29 @@ namespace DGL
 
 	void BaseGraphicsLayer::EndDraw()
 	{
-		// Nothing to do for now
+		Submit();
+	}
+
+	void BaseGraphicsLayer::Activate()
+	{
+		m_Renderer->BeginPass(m_RenderTarget);
+	}
+
+	void BaseGraphicsLayer::Flush()
+	{
+		if (not m_HasPendingImages)
+		{
+			return;
+		}
+
+		m_Renderer->FlushImages();
+		m_HasPendingImages = false;
+	}
+
+	void BaseGraphicsLayer::Submit()
+	{
+		Flush();
+		m_Renderer->FlushShapes();
 	}
 
 	void BaseGraphicsLayer::PushState()
@@ -167,44 +203,59 @@ namespace DGL
 		PeekState().ImageAlpha = static_cast<uint8_t>(std::clamp(opacity * 255.0f, 0.0f, 255.0f));
 	}
 
+	void BaseGraphicsLayer::SetImageFilterMode(const Texture::TextureFilterMode filterMode)
+	{
+		PeekState().ImageFilterMode = filterMode;
+	}
+
+	void BaseGraphicsLayer::SetImageAnisotropy(const float anisotropy)
+	{
+		PeekState().ImageAnisotropy = anisotropy;
+	}
+
 	void BaseGraphicsLayer::Background(const Renderer::Color color)
 	{
+		Flush();
+
 		// Render the rectangle with the specified background color
-		m_BlendModeActivator->Activate(Blending::BlendModes::Opaque);
-		m_SolidFillBrush->SetColor(color);
-		m_SolidFillBrush->UploadUniforms(m_ProjectionMatrix, Math::Matrix4x4::Identity);
+		m_Renderer->SetPipeline({ .Kind = RHI::PipelineKind::SolidColor, .BlendMode = Blending::BlendModes::Opaque });
+		m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = Math::Matrix4x4::Identity, .Color = color });
 		m_Renderer->FillRectangle(m_Viewport, IncrementAndGetDepth());
 	}
 
 	void BaseGraphicsLayer::Rect(const float x1, const float y1, const float x2, const float y2)
 	{
+		// Images queued so far have to be drawn first
+		Flush();
+
 		// Get the current render state
 		auto& state = PeekState();
 
 		// Compute the boundary of the rectangle
 		const auto boundary = state.RectMode(x1, y1, x2, y2);
 
-		m_BlendModeActivator->Activate(state.BlendMode);
+		m_Renderer->SetPipeline({ .Kind = RHI::PipelineKind::SolidColor, .BlendMode = state.BlendMode });
 
 		// Only render if the fill is enabled
 		if (state.IsFillEnabled)
 		{
-			m_SolidFillBrush->SetColor(state.FillColor);
-			m_SolidFillBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform());
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = state.TransformationStack.PeekTransform(), .Color = state.FillColor });
 			m_Renderer->FillRectangle(boundary, IncrementAndGetDepth());
 		}
 
 		// Only render if the stroke is enabled and the stroke weight is greater than zero
 		if (state.IsStrokeEnabled and state.StrokeWeight > 0.0f)
 		{
-			m_SolidStrokeBrush->SetColor(state.StrokeColor);
-			m_SolidStrokeBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform());
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = state.TransformationStack.PeekTransform(), .Color = state.StrokeColor });
 			m_Renderer->DrawRectangle(boundary, state.StrokeWeight, IncrementAndGetDepth());
 		}
 	}
 
 	void BaseGraphicsLayer::Ellipse(const float x1, const float y1, const float x2, const float y2)
 	{
+		// Images queued so far have to be drawn first
+		Flush();
+
 		// Get the current render state
 		auto& state = PeekState();
 
@@ -217,27 +268,28 @@ namespace DGL
 		const auto segments = state.SegmentCountMode(radius);
 		if (segments <= 0) return;
 
-		m_BlendModeActivator->Activate(state.BlendMode);
+		m_Renderer->SetPipeline({ .Kind = RHI::PipelineKind::SolidColor, .BlendMode = state.BlendMode });
 
 		// Only render if the fill is enabled
 		if (state.IsFillEnabled)
 		{
-			m_SolidFillBrush->SetColor(state.FillColor);
-			m_SolidFillBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform());
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = state.TransformationStack.PeekTransform(), .Color = state.FillColor });
 			m_Renderer->FillEllipse(center, radius, segments, IncrementAndGetDepth());
 		}
 
 		// Only render if the stroke is enabled and the stroke weight is greater than zero
 		if (state.IsStrokeEnabled and state.StrokeWeight > 0.0f)
 		{
-			m_SolidStrokeBrush->SetColor(state.StrokeColor);
-			m_SolidStrokeBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform());
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = state.TransformationStack.PeekTransform(), .Color = state.StrokeColor });
 			m_Renderer->DrawEllipse(center, radius, segments, state.StrokeWeight, IncrementAndGetDepth());
 		}
 	}
 
 	void BaseGraphicsLayer::Point(const float x, const float y)
 	{
+		// Images queued so far have to be drawn first
+		Flush();
+
 		// Get the current render state
 		auto& state = PeekState();
 
@@ -252,40 +304,43 @@ namespace DGL
 			const auto center = boundary.Center();
 			const auto segments = state.SegmentCountMode(radius);
 
-			m_BlendModeActivator->Activate(state.BlendMode);
-			m_SolidStrokeBrush->SetColor(state.StrokeColor);
-			m_SolidStrokeBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform());
+			m_Renderer->SetPipeline({ .Kind = RHI::PipelineKind::SolidColor, .BlendMode = state.BlendMode });
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = state.TransformationStack.PeekTransform(), .Color = state.StrokeColor });
 			m_Renderer->FillEllipse(center, radius, segments, IncrementAndGetDepth());
 		}
 	}
 
 	void BaseGraphicsLayer::Line(const float x1, const float y1, const float x2, const float y2)
 	{
+		// Images queued so far have to be drawn first
+		Flush();
+
 		// Get the current render state
 		auto& state = PeekState();
 
 		// Only render if the stroke is enabled and the stroke weight is greater than zero
 		if (state.IsStrokeEnabled and state.StrokeWeight > 0.0f)
 		{
-			m_BlendModeActivator->Activate(state.BlendMode);
-			m_SolidStrokeBrush->SetColor(state.StrokeColor);
-			m_SolidStrokeBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform());
+			m_Renderer->SetPipeline({ .Kind = RHI::PipelineKind::SolidColor, .BlendMode = state.BlendMode });
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = state.TransformationStack.PeekTransform(), .Color = state.StrokeColor });
 			m_Renderer->Line({ x1, y1 }, { x2, y2 }, state.StrokeWeight, state.StartCap, state.EndCap, IncrementAndGetDepth());
 		}
 	}
 
 	void BaseGraphicsLayer::Triangle(const float x1, const float y1, const float x2, const float y2, const float x3, const float y3)
 	{
+		// Images queued so far have to be drawn first
+		Flush();
+
 		// Get the current render state
 		auto& state = PeekState();
 
-		m_BlendModeActivator->Activate(state.BlendMode);
+		m_Renderer->SetPipeline({ .Kind = RHI::PipelineKind::SolidColor, .BlendMode = state.BlendMode });
 
 		// Only render if the fill is enabled
 		if (state.IsFillEnabled)
 		{
-			m_SolidFillBrush->SetColor(state.FillColor);
-			m_SolidFillBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform());
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix, .Model = state.TransformationStack.PeekTransform(), .Color = state.FillColor });
 			m_Renderer->FillTriangle(Math::Float2{ x1, y1 }, Math::Float2{ x2, y2 }, Math::Float2{ x3, y3 }, IncrementAndGetDepth());
 		}
 
@@ -293,6 +348,122 @@ namespace DGL
 	}
 
 	void BaseGraphicsLayer::Image(const Texture::Texture& texture, const float x1, const float y1, const float x2, const float y2)
+	{
+		DrawImage(texture, Math::FloatBoundary(), x1, y1, x2, y2);
+	}
+
+	void BaseGraphicsLayer::Image(const Texture::TextureRegion& region, const float x1, const float y1, const float x2, const float y2)
+	{
+		if (region.Source == nullptr)
+		{
+			return;
+		}
+
+		// Regions count their rows from the start of the texture data, while the source
+		// rectangle is measured from the top of the image as it appears on screen
+		const Math::Uint2 textureSize = region.Source->GetSize();
+		const Math::UintBoundary& bounds = region.Bounds;
+		const bool isBottomUp = region.Source->GetOrigin() == Texture::TextureOrigin::BottomLeft;
+		const auto source = Math::FloatBoundary::FromLTWH(
+			static_cast<float>(bounds.Left),
+			static_cast<float>(isBottomUp ? textureSize.Y - bounds.Bottom() : bounds.Top),
+			static_cast<float>(bounds.Width),
+			static_cast<float>(bounds.Height)
+		);
+
+		DrawImage(*region.Source, source, x1, y1, x2, y2);
+	}
+
+	void BaseGraphicsLayer::Image(const Texture::Texture& texture, const Sprite& sprite)
+	{
+		Image(texture, std::span<const Sprite>(&sprite, 1));
+	}
+
+	void BaseGraphicsLayer::Image(const Texture::Texture& texture, const std::span<const Sprite> sprites)
+	{
+		// Get the current render state
+		auto& state = PeekState();
+
+		BeginImageBatch(state);
+
+		const Math::Matrix4x4& transform = state.TransformationStack.PeekTransform();
+		for (const Sprite& sprite : sprites)
+		{
+			m_Renderer->Image(texture, sprite.Source, sprite.Destination, sprite.Origin, sprite.Rotation, transform, sprite.Tint, IncrementAndGetDepth());
+		}
+	}
+
+	void BaseGraphicsLayer::ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback)
+	{
+		// Pending images have to reach the render target before it gets copied
+		Flush();
+		m_Renderer->ReadPixelsAsync(m_RenderTarget, region, std::move(callback));
+	}
+
+	std::future<Renderer::PixelData> BaseGraphicsLayer::ReadPixelsAsync(const Math::UintBoundary& region)
+	{
+		Flush();
+		return m_Renderer->ReadPixelsAsync(m_RenderTarget, region);
+	}
+
+	void BaseGraphicsLayer::ViewPixelsAsync(const Math::UintBoundary& region, Renderer::PixelViewCallback callback)
+	{
+		Flush();
+		m_Renderer->ViewPixelsAsync(m_RenderTarget, region, std::move(callback));
+	}
+
+	PixelBuffer& BaseGraphicsLayer::LoadPixels()
+	{
+		Flush();
+
+		const Math::Uint2 size = m_Renderer->GetDevice().GetRenderTargetSize(m_RenderTarget);
+		Renderer::PixelData data = m_Renderer->ReadPixels(m_RenderTarget, Math::UintBoundary::FromLTWH(0, 0, size.X, size.Y));
+
+		m_PixelBuffer.Reset(size, std::move(data.Pixels));
+		return m_PixelBuffer;
+	}
+
+	void BaseGraphicsLayer::UpdatePixels()
+	{
+		if (not m_PixelBuffer.IsDirty())
+		{
+			return;
+		}
+
+		// The render target may have been resized since the pixels were loaded
+		if (m_PixelBuffer.GetSize() != m_Renderer->GetDevice().GetRenderTargetSize(m_RenderTarget))
+		{
+			Logging::Error("UpdatePixels() called after the layer has been resized, call LoadPixels() again.");
+			m_PixelBuffer.ClearDirtyRows();
+			return;
+		}
+
+		// Images queued before have to be drawn first, so the pixels end up on top
+		Flush();
+
+		// The mutable pixel view would mark every row dirty, so the range has to be read through the const one
+		const uint32_t firstRow = m_PixelBuffer.GetFirstDirtyRow();
+		const uint32_t rowCount = m_PixelBuffer.GetDirtyRowCount();
+		m_Renderer->WritePixels(m_RenderTarget, std::as_const(m_PixelBuffer).GetPixels().data(), firstRow, rowCount);
+		m_PixelBuffer.ClearDirtyRows();
+		++m_ContentVersion;
+	}
+
+	void BaseGraphicsLayer::ApplyFilters(const std::span<const Brushes::Filter> filters)
+	{
+		if (filters.empty())
+		{
+			return;
+		}
+
+		// The filters work on the finished image, so queued images have to land first
+		Flush();
+
+		m_Renderer->ApplyFilters(m_RenderTarget, filters);
+		++m_ContentVersion;
+	}
+
+	void BaseGraphicsLayer::DrawImage(const Texture::Texture& texture, const Math::FloatBoundary& source, const float x1, const float y1, const float x2, const float y2)
 	{
 		// Get the current render state
 		auto& state = PeekState();
@@ -300,14 +471,59 @@ namespace DGL
 		// Compute the boundary of the image
 		const auto boundary = state.ImageMode(x1, y1, x2, y2);
 
-		m_BlendModeActivator->Activate(state.BlendMode);
-		m_TextureFillBrush->SetTexture(&texture);
-		m_TextureFillBrush->UploadUniforms(m_ProjectionMatrix, state.TransformationStack.PeekTransform(), state.ImageTint, state.ImageAlpha);
-		m_Renderer->Image(boundary, IncrementAndGetDepth());
+		BeginImageBatch(state);
+
+		// The image alpha gets folded into the tint, which travels with every sprite
+		const auto alpha = static_cast<uint8_t>(static_cast<uint32_t>(state.ImageTint.A) * state.ImageAlpha / 255u);
+		m_Renderer->Image(
+			texture,
+			source,
+			boundary,
+			Math::Float2{ 0.0f, 0.0f },
+			Math::Angle::Zero,
+			state.TransformationStack.PeekTransform(),
+			state.ImageTint.WithAlpha(alpha),
+			IncrementAndGetDepth()
+		);
 	}
 
-	float BaseGraphicsLayer::IncrementAndGetDepth() const
+	void BaseGraphicsLayer::BeginImageBatch(const RenderState& state)
 	{
+		// The blend mode and the sampler are part of the pipeline state and can't change within a batch
+		const bool isCompatible = m_PendingImageBlendMode == state.BlendMode
+			and m_PendingImageFilterMode == state.ImageFilterMode
+			and m_PendingImageAnisotropy == state.ImageAnisotropy;
+
+		if (m_HasPendingImages and not isCompatible)
+		{
+			Flush();
+		}
+
+		// The first image of a batch binds the pipeline for all following images
+		if (not m_HasPendingImages)
+		{
+			m_Renderer->SetPipeline({
+				.Kind = RHI::PipelineKind::Sprite,
+				.BlendMode = state.BlendMode,
+				.Sampler = { .FilterMode = state.ImageFilterMode, .Anisotropy = state.ImageAnisotropy },
+			});
+			m_Renderer->SetConstants({ .ProjectionView = m_ProjectionMatrix });
+			m_PendingImageBlendMode = state.BlendMode;
+			m_PendingImageFilterMode = state.ImageFilterMode;
+			m_PendingImageAnisotropy = state.ImageAnisotropy;
+			m_HasPendingImages = true;
+		}
+	}
+
+	uint64_t BaseGraphicsLayer::GetContentVersion() const
+	{
+		return m_ContentVersion;
+	}
+
+	float BaseGraphicsLayer::IncrementAndGetDepth()
+	{
+		++m_ContentVersion;
+
 		// Get the current depth
 		const float depth = m_DepthProvider->GetDepth();
 
@@ -0,0 +1,71 @@
+﻿module;
+
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+
+module DirectGL;
+
+import :FrameOutput;
+
+namespace DGL
+{
+	std::unique_ptr<FrameOutput> FrameOutput::Create(const std::string_view name, const Math::Uint2 maxFrameSize, const uint32_t slotCount)
+	{
+		const size_t slotCapacity = static_cast<size_t>(maxFrameSize.X) * maxFrameSize.Y * 4;
+
+		auto writer = FrameRing::FrameRingWriter::Create(name, slotCount, slotCapacity);
+		if (writer == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto state = std::make_shared<State>();
+		state->Writer = std::move(writer);
+
+		return std::unique_ptr<FrameOutput>(new FrameOutput(std::move(state)));
+	}
+
+	void FrameOutput::Submit(GraphicsLayer& layer)
+	{
+		const Math::FloatBoundary& viewport = layer.GetViewport();
+		const auto region = Math::UintBoundary::FromLTWH(0, 0, static_cast<uint32_t>(viewport.Width), static_cast<uint32_t>(viewport.Height));
+
+		m_State->SubmittedFrames.fetch_add(1, std::memory_order_relaxed);
+
+		layer.ViewPixelsAsync(region, [state = m_State](const Renderer::PixelView& view)
+		{
+			const std::span<uint8_t> pixels = state->Writer->BeginFrame(view.Region.Width, view.Region.Height);
+			if (pixels.empty())
+			{
+				state->OversizedFrames.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			// The only copy of the frame, flipping the rows on the way
+			const size_t stride = view.GetStride();
+			for (uint32_t row = 0; row < view.Region.Height; ++row)
+			{
+				std::memcpy(pixels.data() + row * stride, view.GetRow(row), stride);
+			}
+
+			state->Writer->EndFrame();
+			state->WrittenFrames.fetch_add(1, std::memory_order_relaxed);
+		});
+	}
+
+	FrameOutputStatistics FrameOutput::GetStatistics() const
+	{
+		return {
+			.SubmittedFrames = m_State->SubmittedFrames.load(std::memory_order_relaxed),
+			.WrittenFrames = m_State->WrittenFrames.load(std::memory_order_relaxed),
+			.OversizedFrames = m_State->OversizedFrames.load(std::memory_order_relaxed),
+		};
+	}
+
+	FrameOutput::FrameOutput(std::shared_ptr<State> state):
+		m_State(std::move(state))
+	{
+	}
+}
\ No newline at end of file
@@ -0,0 +1,255 @@
+﻿module;
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+module DirectGL;
+
+import :FrameRecorder;
+
+namespace DGL
+{
+	std::unique_ptr<FrameRecorder> FrameRecorder::Create(const size_t workerCount)
+	{
+		auto recorder = std::unique_ptr<FrameRecorder>(new FrameRecorder());
+
+		for (size_t i = 0; i < std::max<size_t>(workerCount, 1); ++i)
+		{
+			recorder->m_Workers.emplace_back([raw = recorder.get()](const std::stop_token stopToken) { raw->RunWorker(stopToken); });
+		}
+
+		return recorder;
+	}
+
+	FrameRecorder::~FrameRecorder()
+	{
+		// The workers finish the queued frames before they exit
+		for (std::jthread& worker : m_Workers)
+		{
+			worker.request_stop();
+		}
+
+		m_Workers.clear();
+	}
+
+	bool FrameRecorder::Start(const RecordingSettings& settings)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(settings.Directory, error);
+
+		if (error)
+		{
+			Logging::Error(std::format("Failed to create the recording directory {}: {}", settings.Directory.string(), error.message()));
+			return false;
+		}
+
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Settings = settings;
+			m_Settings.FrameInterval = std::max(settings.FrameInterval, 1u);
+			m_Settings.QueueCapacity = std::max<size_t>(settings.QueueCapacity, 1);
+		}
+
+		m_IsRecording = true;
+		m_FrameCounter = 0;
+		m_StartTime = std::chrono::steady_clock::now();
+
+		m_CapturedFrames.store(0, std::memory_order_relaxed);
+		m_EncodedFrames.store(0, std::memory_order_relaxed);
+		m_DroppedFrames.store(0, std::memory_order_relaxed);
+		m_FailedFrames.store(0, std::memory_order_relaxed);
+		m_WrittenBytes.store(0, std::memory_order_relaxed);
+		m_EncodeMicroseconds.store(0, std::memory_order_relaxed);
+
+		Logging::Info(std::format("Recording frames to {}", settings.Directory.string()));
+		return true;
+	}
+
+	void FrameRecorder::Stop()
+	{
+		if (not m_IsRecording)
+		{
+			return;
+		}
+
+		m_IsRecording = false;
+		m_StopTime = std::chrono::steady_clock::now();
+
+		const RecordingStatistics statistics = GetStatistics();
+		Logging::Info(std::format(
+			"Recording stopped: {} frames captured, {} dropped, {:.1f} frames encoded per second",
+			statistics.CapturedFrames, statistics.DroppedFrames, statistics.EncodedFramesPerSecond
+		));
+	}
+
+	bool FrameRecorder::IsRecording() const
+	{
+		return m_IsRecording;
+	}
+
+	void FrameRecorder::Capture(GraphicsLayer& layer, const uint64_t frameNumber)
+	{
+		if (not m_IsRecording or m_FrameCounter++ % m_Settings.FrameInterval != 0)
+		{
+			return;
+		}
+
+		if (m_Settings.OverflowPolicy == RecordingOverflowPolicy::DropFrames)
+		{
+			// Frames that are still being read back count against the capacity,
+			// otherwise a slow encoder would let the readbacks pile up
+			std::scoped_lock lock(m_Mutex);
+			if (m_PendingReadbacks + m_Jobs.size() >= m_Settings.QueueCapacity)
+			{
+				m_DroppedFrames.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+		}
+
+		const Math::FloatBoundary& viewport = layer.GetViewport();
+		const auto region = Math::UintBoundary::FromLTWH(0, 0, static_cast<uint32_t>(viewport.Width), static_cast<uint32_t>(viewport.Height));
+
+		EncodeJob job = {
+			.Path = m_Settings.Directory / std::format("{}{:06}{}", m_Settings.FilePrefix, frameNumber, Texture::GetFileExtension(m_Settings.Format)),
+			.Format = m_Settings.Format,
+			.Frame = {},
+		};
+
+		{
+			std::scoped_lock lock(m_Mutex);
+			++m_PendingReadbacks;
+		}
+
+		m_CapturedFrames.fetch_add(1, std::memory_order_relaxed);
+
+		layer.ReadPixelsAsync(region, [this, job = std::move(job)](Renderer::PixelData&& frame) mutable
+		{
+			job.Frame = std::move(frame);
+			Enqueue(std::move(job));
+		});
+	}
+
+	RecordingStatistics FrameRecorder::GetStatistics() const
+	{
+		RecordingStatistics statistics = {
+			.CapturedFrames = m_CapturedFrames.load(std::memory_order_relaxed),
+			.EncodedFrames = m_EncodedFrames.load(std::memory_order_relaxed),
+			.DroppedFrames = m_DroppedFrames.load(std::memory_order_relaxed),
+			.FailedFrames = m_FailedFrames.load(std::memory_order_relaxed),
+			.WrittenBytes = m_WrittenBytes.load(std::memory_order_relaxed),
+		};
+
+		{
+			std::scoped_lock lock(m_Mutex);
+			statistics.QueuedFrames = m_PendingReadbacks + m_Jobs.size();
+		}
+
+		const auto end = m_IsRecording ? std::chrono::steady_clock::now() : m_StopTime;
+		const std::chrono::duration<double> elapsed = end - m_StartTime;
+		const uint64_t processedFrames = statistics.EncodedFrames + statistics.FailedFrames;
+
+		if (elapsed.count() > 0.0)
+		{
+			statistics.EncodedFramesPerSecond = static_cast<double>(statistics.EncodedFrames) / elapsed.count();
+		}
+
+		if (processedFrames > 0)
+		{
+			statistics.AverageEncodeTime = std::chrono::microseconds(m_EncodeMicroseconds.load(std::memory_order_relaxed) / processedFrames);
+		}
+
+		return statistics;
+	}
+
+	FrameRecorder::FrameRecorder():
+		m_IsRecording(false),
+		m_FrameCounter(0),
+		m_PendingReadbacks(0),
+		m_CapturedFrames(0),
+		m_EncodedFrames(0),
+		m_DroppedFrames(0),
+		m_FailedFrames(0),
+		m_WrittenBytes(0),
+		m_EncodeMicroseconds(0)
+	{
+	}
+
+	void FrameRecorder::Enqueue(EncodeJob job)
+	{
+		{
+			std::unique_lock lock(m_Mutex);
+			--m_PendingReadbacks;
+
+			if (m_Settings.OverflowPolicy == RecordingOverflowPolicy::Block)
+			{
+				// Stall the main loop until a worker takes a frame off the queue
+				m_JobTaken.wait(lock, [this] { return m_Jobs.size() < m_Settings.QueueCapacity; });
+			}
+
+			m_Jobs.push_back(std::move(job));
+		}
+
+		m_JobAvailable.notify_one();
+	}
+
+	void FrameRecorder::RunWorker(const std::stop_token stopToken)
+	{
+		while (true)
+		{
+			EncodeJob job;
+
+			{
+				std::unique_lock lock(m_Mutex);
+				if (not m_JobAvailable.wait(lock, stopToken, [this] { return not m_Jobs.empty(); }))
+				{
+					return;
+				}
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+			}
+
+			m_JobTaken.notify_one();
+			Encode(job);
+		}
+	}
+
+	void FrameRecorder::Encode(EncodeJob& job)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		// The window is presented opaque, whatever blending left in the alpha channel must not end up in the files
+		std::vector<uint8_t>& pixels = job.Frame.Pixels;
+		for (size_t i = 3; i < pixels.size(); i += 4)
+		{
+			pixels[i] = 255;
+		}
+
+		const Math::Uint2 size = { job.Frame.Region.Width, job.Frame.Region.Height };
+		const std::vector<uint8_t> file = Texture::EncodeImage(job.Format, size, pixels.data());
+
+		std::ofstream stream(job.Path, std::ios::binary);
+		stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+
+		if (stream.good())
+		{
+			m_EncodedFrames.fetch_add(1, std::memory_order_relaxed);
+			m_WrittenBytes.fetch_add(file.size(), std::memory_order_relaxed);
+		}
+		else
+		{
+			m_FailedFrames.fetch_add(1, std::memory_order_relaxed);
+			Logging::Error(std::format("Failed to write the recorded frame {}", job.Path.string()));
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		m_EncodeMicroseconds.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+﻿module;
+
+#ifdef PLATFORM_WINDOWS
+#include <Windows.h>
+#endif
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+
+module DirectGL;
+
+namespace DGL
+{
+	std::unique_ptr<FrameScheduler> FrameScheduler::Create()
+	{
+		return std::unique_ptr<FrameScheduler>(new FrameScheduler());
+	}
+
+	FrameScheduler::~FrameScheduler()
+	{
+#ifdef PLATFORM_WINDOWS
+		if (m_Timer != nullptr)
+		{
+			CloseHandle(m_Timer);
+		}
+#endif
+	}
+
+	void FrameScheduler::SetTargetFrameRate(const float framesPerSecond)
+	{
+		m_TargetFrameRate = framesPerSecond > 0.0f ? framesPerSecond : 0.0f;
+		m_Interval = m_TargetFrameRate > 0.0f
+			? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_TargetFrameRate))
+			: Clock::duration::zero();
+
+		// The next frame follows the new interval instead of the old one
+		m_NextFrame = m_FrameStart;
+	}
+
+	float FrameScheduler::GetTargetFrameRate() const
+	{
+		return m_TargetFrameRate;
+	}
+
+	void FrameScheduler::BeginFrame()
+	{
+		const auto now = Clock::now();
+
+		// Time spent waiting for events isn't part of the frame rate
+		if (m_Frames > 0 and not m_HasIdled)
+		{
+			const auto interval = now - m_FrameStart;
+			const double seconds = std::chrono::duration<double>(interval).count();
+
+			m_IntervalTime += interval;
+			m_MaxInterval = interval > m_MaxInterval ? interval : m_MaxInterval;
+			m_SmoothedInterval = m_Intervals == 0 ? seconds : m_SmoothedInterval + (seconds - m_SmoothedInterval) * FrameRateSmoothing;
+			++m_Intervals;
+		}
+		else
+		{
+			// A frame after a pause doesn't have to catch up with the frames it skipped
+			m_NextFrame = now;
+		}
+
+		m_FrameStart = now;
+		m_HasIdled = false;
+		m_LoopsSinceFrame = 0;
+	}
+
+	void FrameScheduler::EndFrame()
+	{
+		const auto now = Clock::now();
+		m_FrameTime += now - m_FrameStart;
+		++m_Frames;
+
+		if (m_Interval == Clock::duration::zero())
+		{
+			return;
+		}
+
+		// Deadlines follow each other at a fixed rate, so an early frame doesn't delay the ones after it
+		m_NextFrame += m_Interval;
+		if (now >= m_NextFrame)
+		{
+			++m_MissedFrames;
+			m_NextFrame = now;
+			return;
+		}
+
+		WaitUntil(m_NextFrame);
+	}
+
+	std::optional<System::WindowEvent> FrameScheduler::WaitForEvent(System::Window& window, const bool hasPendingWork)
+	{
+		const bool isSettling = m_LoopsSinceFrame < SettleLoops;
+		if (isSettling)
+		{
+			++m_LoopsSinceFrame;
+		}
+
+		const auto timeout = isSettling or hasPendingWork ? PollInterval : std::chrono::milliseconds::max();
+
+		const auto start = Clock::now();
+		std::optional<System::WindowEvent> event = window.WaitEvent(timeout);
+		m_IdleTime += Clock::now() - start;
+		m_HasIdled = true;
+
+		return event;
+	}
+
+	FrameTimingStatistics FrameScheduler::GetStatistics() const
+	{
+		using std::chrono::duration_cast;
+		using std::chrono::microseconds;
+
+		FrameTimingStatistics statistics;
+		statistics.Frames = m_Frames;
+		statistics.MissedFrames = m_MissedFrames;
+		statistics.TargetFrameRate = m_TargetFrameRate;
+		statistics.MaxFrameInterval = duration_cast<microseconds>(m_MaxInterval);
+		statistics.SleepTime = duration_cast<microseconds>(m_SleepTime);
+		statistics.SpinTime = duration_cast<microseconds>(m_SpinTime);
+		statistics.IdleTime = duration_cast<microseconds>(m_IdleTime);
+
+		if (m_Frames > 0)
+		{
+			statistics.AverageFrameTime = duration_cast<microseconds>(m_FrameTime / m_Frames);
+		}
+
+		if (m_Intervals > 0)
+		{
+			statistics.AverageFrameInterval = duration_cast<microseconds>(m_IntervalTime / m_Intervals);
+			statistics.FrameRate = m_SmoothedInterval > 0.0 ? static_cast<float>(1.0 / m_SmoothedInterval) : 0.0f;
+		}
+
+		return statistics;
+	}
+
+	FrameScheduler::FrameScheduler()
+	:	m_TargetFrameRate(0.0f),
+		m_Interval(Clock::duration::zero()),
+		m_SpinDuration(std::chrono::microseconds(200)),
+		m_Timer(nullptr),
+		m_HasIdled(false),
+		m_LoopsSinceFrame(0),
+		m_Frames(0),
+		m_MissedFrames(0),
+		m_Intervals(0),
+		m_SmoothedInterval(0.0),
+		m_FrameTime(Clock::duration::zero()),
+		m_IntervalTime(Clock::duration::zero()),
+		m_MaxInterval(Clock::duration::zero()),
+		m_SleepTime(Clock::duration::zero()),
+		m_SpinTime(Clock::duration::zero()),
+		m_IdleTime(Clock::duration::zero())
+	{
+#ifdef PLATFORM_WINDOWS
+		// Regular sleeps only wake up with the system timer, which usually ticks every 15.6 ms
+		m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		m_SpinDuration = m_Timer != nullptr ? std::chrono::microseconds(1000) : std::chrono::microseconds(2000);
+#endif
+	}
+
+	void FrameScheduler::WaitUntil(const Clock::time_point deadline)
+	{
+		auto now = Clock::now();
+		const auto wakeUp = deadline - m_SpinDuration;
+
+		if (now < wakeUp)
+		{
+#ifdef PLATFORM_WINDOWS
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -static_cast<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(wakeUp - now).count() / 100);	// Relative, in units of 100 ns
+
+			if (m_Timer != nullptr and SetWaitableTimerEx(m_Timer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+			{
+				WaitForSingleObject(m_Timer, INFINITE);
+			}
+			else
+			{
+				std::this_thread::sleep_until(wakeUp);
+			}
+#else
+			std::this_thread::sleep_until(wakeUp);
+#endif
+
+			const auto woken = Clock::now();
+			m_SleepTime += woken - now;
+			now = woken;
+		}
+
+		const auto spinStart = now;
+		while (now < deadline)
+		{
+			std::this_thread::yield();
+			now = Clock::now();
+		}
+
+		m_SpinTime += now - spinStart;
+	}
+}
\ No newline at end of file
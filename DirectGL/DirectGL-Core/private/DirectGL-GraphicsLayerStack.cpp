@@ -12,14 +12,7 @@ namespace DGL
 	void GraphicsLayerStack::PushLayer(OffscreenGraphicsLayer* layer)
 	{
 		// Suspend the current layer
-		if (not m_OffscreenLayers.empty())
-		{
-			m_OffscreenLayers.top()->Suspend();
-		}
-		else
-		{
-			m_MainLayer->Suspend();
-		}
+		Suspend();
 
 		// Push & Activate
 		m_OffscreenLayers.push(layer);
@@ -36,23 +29,40 @@ namespace DGL
 		}
 
 		// Resume the previous layer
+		Resume();
+	}
+
+	GraphicsLayer& GraphicsLayerStack::PeekLayer()
+	{
+		if (m_OffscreenLayers.empty())
+		{
+			return *m_MainLayer;
+		}
+
+		return *m_OffscreenLayers.top();
+	}
+
+	void GraphicsLayerStack::Suspend()
+	{
 		if (not m_OffscreenLayers.empty())
 		{
-			m_OffscreenLayers.top()->Resume();
+			m_OffscreenLayers.top()->Suspend();
 		}
 		else
 		{
-			m_MainLayer->Resume();
+			m_MainLayer->Suspend();
 		}
 	}
 
-	GraphicsLayer& GraphicsLayerStack::PeekLayer()
+	void GraphicsLayerStack::Resume()
 	{
-		if (m_OffscreenLayers.empty())
+		if (not m_OffscreenLayers.empty())
 		{
-			return *m_MainLayer;
+			m_OffscreenLayers.top()->Resume();
+		}
+		else
+		{
+			m_MainLayer->Resume();
 		}
-
-		return *m_OffscreenLayers.top();
 	}
 }
\ No newline at end of file
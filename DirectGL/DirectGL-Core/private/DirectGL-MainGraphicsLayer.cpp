@@ -1,6 +1,8 @@
 ﻿module;
 
 #include <memory>
+#include <future>
+#include <span>
 
 module DirectGL;
 
@@ -10,22 +12,21 @@ namespace DGL
 {
 	std::unique_ptr<MainGraphicsLayer> MainGraphicsLayer::Create(
 		const Math::Uint2 viewportSize,
-		RendererFacade& renderer,
-		Blending::BlendModeActivator& blendModeActivator
+		RendererFacade& renderer
 	) {
-		return std::unique_ptr<MainGraphicsLayer>(new MainGraphicsLayer(viewportSize, renderer, blendModeActivator));
+		return std::unique_ptr<MainGraphicsLayer>(new MainGraphicsLayer(viewportSize, renderer));
 	}
 
 	void MainGraphicsLayer::Resize(const Math::Uint2 viewportSize)
 	{
-		m_MainRenderTarget->SetViewport(Math::UintBoundary::FromLTWH(0, 0, viewportSize.X, viewportSize.Y));
+		m_Renderer->GetDevice().ResizeDefaultRenderTarget(viewportSize);
 		m_GraphicsLayer.SetViewport(Math::FloatBoundary::FromLTWH(0.0f, 0.0f, static_cast<float>(viewportSize.X), static_cast<float>(viewportSize.Y)));
 	}
 
 	void MainGraphicsLayer::BeginDraw()
 	{
 		m_GraphicsLayer.BeginDraw();
-		m_MainRenderTarget->Activate();
+		m_GraphicsLayer.Activate();
 	}
 
 	void MainGraphicsLayer::EndDraw()
@@ -35,12 +36,13 @@ namespace DGL
 
 	void MainGraphicsLayer::Resume()
 	{
-		m_MainRenderTarget->Activate();
+		m_GraphicsLayer.Activate();
 	}
 
 	void MainGraphicsLayer::Suspend()
 	{
-		// Nothing to do for now
+		// Another layer is about to take over the shared renderers
+		m_GraphicsLayer.Submit();
 	}
 
 	const Math::FloatBoundary& MainGraphicsLayer::GetViewport() const { return m_GraphicsLayer.GetViewport(); }
@@ -75,6 +77,8 @@ namespace DGL
 	void MainGraphicsLayer::SetImageTint(const Renderer::Color tint) { m_GraphicsLayer.SetImageTint(tint); }
 	void MainGraphicsLayer::SetImageAlpha(const uint8_t alpha) { m_GraphicsLayer.SetImageAlpha(alpha); }
 	void MainGraphicsLayer::SetImageOpacity(const float opacity) { m_GraphicsLayer.SetImageOpacity(opacity); }
+	void MainGraphicsLayer::SetImageFilterMode(const Texture::TextureFilterMode filterMode) { m_GraphicsLayer.SetImageFilterMode(filterMode); }
+	void MainGraphicsLayer::SetImageAnisotropy(const float anisotropy) { m_GraphicsLayer.SetImageAnisotropy(anisotropy); }
 
 	void MainGraphicsLayer::Background(const Renderer::Color color) { m_GraphicsLayer.Background(color); }
 	void MainGraphicsLayer::Rect(const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayer.Rect(x1, y1, x2, y2); }
@@ -83,23 +87,25 @@ namespace DGL
 	void MainGraphicsLayer::Line(const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayer.Line(x1, y1, x2, y2); }
 	void MainGraphicsLayer::Triangle(const float x1, const float y1, const float x2, const float y2, const float x3, const float y3) { m_GraphicsLayer.Triangle(x1, y1, x2, y2, x3, y3); }
 	void MainGraphicsLayer::Image(const Texture::Texture& texture, const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayer.Image(texture, x1, y1, x2, y2); }
+	void MainGraphicsLayer::Image(const Texture::TextureRegion& region, const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayer.Image(region, x1, y1, x2, y2); }
+	void MainGraphicsLayer::Image(const Texture::Texture& texture, const Sprite& sprite) { m_GraphicsLayer.Image(texture, sprite); }
+	void MainGraphicsLayer::Image(const Texture::Texture& texture, const std::span<const Sprite> sprites) { m_GraphicsLayer.Image(texture, sprites); }
+
+	void MainGraphicsLayer::ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback) { m_GraphicsLayer.ReadPixelsAsync(region, std::move(callback)); }
+	std::future<Renderer::PixelData> MainGraphicsLayer::ReadPixelsAsync(const Math::UintBoundary& region) { return m_GraphicsLayer.ReadPixelsAsync(region); }
+	void MainGraphicsLayer::ViewPixelsAsync(const Math::UintBoundary& region, Renderer::PixelViewCallback callback) { m_GraphicsLayer.ViewPixelsAsync(region, std::move(callback)); }
+	PixelBuffer& MainGraphicsLayer::LoadPixels() { return m_GraphicsLayer.LoadPixels(); }
+	void MainGraphicsLayer::UpdatePixels() { m_GraphicsLayer.UpdatePixels(); }
+	void MainGraphicsLayer::ApplyFilters(const std::span<const Brushes::Filter> filters) { m_GraphicsLayer.ApplyFilters(filters); }
 
 	MainGraphicsLayer::MainGraphicsLayer(
 		const Math::Uint2 viewportSize,
-		RendererFacade& renderer,
-		Blending::BlendModeActivator& blendModeActivator
-	):	m_MainRenderTarget(
-			Renderer::MainRenderTarget::Create(
-				Math::UintBoundary::FromLTWH(
-					0, 0,
-					viewportSize.X, viewportSize.Y
-				)
-			)
-		),
+		RendererFacade& renderer
+	):	m_Renderer(&renderer),
 		m_GraphicsLayer(
 			renderer,
+			renderer.GetDevice().GetDefaultRenderTarget(),
 			viewportSize,
-			blendModeActivator,
 			std::make_unique<IncrementalDepthProvider>(0.0f, 1.0f / 20'000.0f)
 		)
 	{
@@ -2,11 +2,16 @@
 
 #include <glad/gl.h>
 
+#include <algorithm>
 #include <memory>
+#include <future>
+#include <span>
 #include <type_traits>
 
 module DirectGL;
 
+import Preconditions;
+
 import :OffscreenGraphicsLayer;
 
 namespace DGL
@@ -14,15 +19,20 @@ namespace DGL
 	std::unique_ptr<OffscreenGraphicsLayer> OffscreenGraphicsLayer::Create(
 		const Math::Uint2 viewportSize,
 		RendererFacade& renderer,
-		Blending::BlendModeActivator& blendModeActivator
+		const Renderer::RenderTargetAttachments attachments
 	) {
-		return std::unique_ptr<OffscreenGraphicsLayer>(new OffscreenGraphicsLayer(viewportSize, renderer, blendModeActivator));
+		return std::unique_ptr<OffscreenGraphicsLayer>(new OffscreenGraphicsLayer(viewportSize, renderer, attachments));
+	}
+
+	OffscreenGraphicsLayer::~OffscreenGraphicsLayer()
+	{
+		m_Renderer->GetDevice().DestroyRenderTarget(m_RenderTarget);
 	}
 
 	void OffscreenGraphicsLayer::BeginDraw()
 	{
 		m_GraphicsLayerImpl.BeginDraw();
-		m_RenderTarget->Activate();
+		m_GraphicsLayerImpl.Activate();
 	}
 
 	void OffscreenGraphicsLayer::EndDraw()
@@ -32,17 +42,112 @@ namespace DGL
 
 	void OffscreenGraphicsLayer::Resume()
 	{
-		m_RenderTarget->Activate();
+		m_GraphicsLayerImpl.Activate();
 	}
 
 	void OffscreenGraphicsLayer::Suspend()
 	{
-		// Nothing to do for now
+		// Another layer is about to take over the shared renderers
+		m_GraphicsLayerImpl.Submit();
+	}
+
+	void OffscreenGraphicsLayer::BeginRecording()
+	{
+		// The device drawn through changes while capturing commands or running a render thread
+		RHI::RenderDevice& device = m_Renderer->GetDevice();
+		if (m_RecordingDevice == nullptr or m_RecordingDevice->GetResourceDevice() != &device)
+		{
+			m_RecordingDevice = RHI::RecordingDevice::Create(&device);
+			m_RecordingRenderer = std::make_unique<RendererFacade>(*m_RecordingDevice, m_Renderer->GetShapeFactory(), m_Renderer->GetJobSystem());
+		}
+
+		m_GraphicsLayerImpl.SetRenderer(*m_RecordingRenderer);
+		m_IsRecording = true;
+
+		BeginDraw();
+	}
+
+	void OffscreenGraphicsLayer::EndRecording()
+	{
+		EndDraw();
+	}
+
+	void OffscreenGraphicsLayer::SubmitRecording()
+	{
+		if (not m_IsRecording)
+		{
+			return;
+		}
+
+		m_GraphicsLayerImpl.SetRenderer(*m_Renderer);
+		m_IsRecording = false;
+
+		// Keep the memory of the list, the layer most likely gets recorded again next frame
+		m_RecordingDevice->Submit();
+		m_RecordingDevice->Clear();
+	}
+
+	bool OffscreenGraphicsLayer::IsRecording() const
+	{
+		return m_IsRecording;
 	}
 
 	const Texture::Texture& OffscreenGraphicsLayer::GetRenderTexture() const
 	{
-		return m_RenderTarget->GetRenderTexture();
+		const Texture::Texture* texture = m_Renderer->GetDevice().GetRenderTexture(m_RenderTarget);
+		System::Require(texture != nullptr, [] { return "The render device keeps the layer in system memory, it can't be drawn as a texture"; });
+
+		return *texture;
+	}
+
+	uint64_t OffscreenGraphicsLayer::GetContentVersion() const
+	{
+		return m_GraphicsLayerImpl.GetContentVersion();
+	}
+
+	void OffscreenGraphicsLayer::Invalidate()
+	{
+		m_IsValid = false;
+	}
+
+	void OffscreenGraphicsLayer::Validate()
+	{
+		m_IsValid = true;
+
+		for (Dependency& dependency : m_Dependencies)
+		{
+			dependency.ContentVersion = dependency.Source->GetContentVersion();
+		}
+	}
+
+	bool OffscreenGraphicsLayer::IsStale() const
+	{
+		return not m_IsValid or std::ranges::any_of(m_Dependencies, [](const Dependency& dependency)
+		{
+			return dependency.Source->GetContentVersion() != dependency.ContentVersion;
+		});
+	}
+
+	void OffscreenGraphicsLayer::AddDependency(const OffscreenGraphicsLayer& source)
+	{
+		if (DependsOn(source))
+		{
+			return;
+		}
+
+		// The contents don't reflect the new dependency yet
+		m_Dependencies.push_back({ .Source = &source, .ContentVersion = source.GetContentVersion() });
+		m_IsValid = false;
+	}
+
+	void OffscreenGraphicsLayer::RemoveDependency(const OffscreenGraphicsLayer& source)
+	{
+		std::erase_if(m_Dependencies, [&source](const Dependency& dependency) { return dependency.Source == &source; });
+	}
+
+	bool OffscreenGraphicsLayer::DependsOn(const OffscreenGraphicsLayer& source) const
+	{
+		return std::ranges::any_of(m_Dependencies, [&source](const Dependency& dependency) { return dependency.Source == &source; });
 	}
 
 	const Math::FloatBoundary& OffscreenGraphicsLayer::GetViewport() const
@@ -80,6 +185,8 @@ namespace DGL
 	void OffscreenGraphicsLayer::SetImageTint(const Renderer::Color tint) { m_GraphicsLayerImpl.SetImageTint(tint); }
 	void OffscreenGraphicsLayer::SetImageAlpha(const uint8_t alpha) { m_GraphicsLayerImpl.SetImageAlpha(alpha); }
 	void OffscreenGraphicsLayer::SetImageOpacity(const float opacity) { m_GraphicsLayerImpl.SetImageOpacity(opacity); }
+	void OffscreenGraphicsLayer::SetImageFilterMode(const Texture::TextureFilterMode filterMode) { m_GraphicsLayerImpl.SetImageFilterMode(filterMode); }
+	void OffscreenGraphicsLayer::SetImageAnisotropy(const float anisotropy) { m_GraphicsLayerImpl.SetImageAnisotropy(anisotropy); }
 
 	void OffscreenGraphicsLayer::Background(const Renderer::Color color) { m_GraphicsLayerImpl.Background(color); }
 	void OffscreenGraphicsLayer::Rect(const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayerImpl.Rect(x1, y1, x2, y2); }
@@ -88,13 +195,32 @@ namespace DGL
 	void OffscreenGraphicsLayer::Line(const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayerImpl.Line(x1, y1, x2, y2); }
 	void OffscreenGraphicsLayer::Triangle(const float x1, const float y1, const float x2, const float y2, const float x3, const float y3) { m_GraphicsLayerImpl.Triangle(x1, y1, x2, y2, x3, y3); }
 	void OffscreenGraphicsLayer::Image(const Texture::Texture& texture, const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayerImpl.Image(texture, x1, y1, x2, y2); }
+	void OffscreenGraphicsLayer::Image(const Texture::TextureRegion& region, const float x1, const float y1, const float x2, const float y2) { m_GraphicsLayerImpl.Image(region, x1, y1, x2, y2); }
+	void OffscreenGraphicsLayer::Image(const Texture::Texture& texture, const Sprite& sprite) { m_GraphicsLayerImpl.Image(texture, sprite); }
+	void OffscreenGraphicsLayer::Image(const Texture::Texture& texture, const std::span<const Sprite> sprites) { m_GraphicsLayerImpl.Image(texture, sprites); }
+
+	void OffscreenGraphicsLayer::ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback) { m_GraphicsLayerImpl.ReadPixelsAsync(region, std::move(callback)); }
+	std::future<Renderer::PixelData> OffscreenGraphicsLayer::ReadPixelsAsync(const Math::UintBoundary& region) { return m_GraphicsLayerImpl.ReadPixelsAsync(region); }
+	void OffscreenGraphicsLayer::ViewPixelsAsync(const Math::UintBoundary& region, Renderer::PixelViewCallback callback) { m_GraphicsLayerImpl.ViewPixelsAsync(region, std::move(callback)); }
+	PixelBuffer& OffscreenGraphicsLayer::LoadPixels()
+	{
+		// The readback would replay the commands into the render device off the GL thread
+		System::Require(not m_IsRecording, [] { return "LoadPixels() isn't available while the layer is recorded, use ReadPixelsAsync()"; });
+		return m_GraphicsLayerImpl.LoadPixels();
+	}
+
+	void OffscreenGraphicsLayer::UpdatePixels() { m_GraphicsLayerImpl.UpdatePixels(); }
+	void OffscreenGraphicsLayer::ApplyFilters(const std::span<const Brushes::Filter> filters) { m_GraphicsLayerImpl.ApplyFilters(filters); }
 
 	OffscreenGraphicsLayer::OffscreenGraphicsLayer(
 		const Math::Uint2 viewportSize,
 		RendererFacade& renderer,
-		Blending::BlendModeActivator& blendModeActivator
-	) :	m_RenderTarget(Renderer::OffscreenRenderTarget::Create(viewportSize)),
-		m_GraphicsLayerImpl(renderer, viewportSize, blendModeActivator, std::make_unique<IncrementalDepthProvider>(0.0f, 1.0f / 20'000.0f))
+		const Renderer::RenderTargetAttachments attachments
+	) :	m_Renderer(&renderer),
+		m_RenderTarget(renderer.GetDevice().CreateRenderTarget(viewportSize, attachments)),
+		m_GraphicsLayerImpl(renderer, m_RenderTarget, viewportSize, std::make_unique<IncrementalDepthProvider>(0.0f, 1.0f / 20'000.0f)),
+		m_IsRecording(false),
+		m_IsValid(false)
 	{
 	}
 }
@@ -0,0 +1,230 @@
+﻿module;
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <utility>
+
+module DirectGL;
+
+import DirectGL.Texture;
+import Preconditions;
+
+import :PixelBuffer;
+
+namespace DGL
+{
+	namespace
+	{
+		/// Below this number of pixels the operations run on the calling thread, as scheduling
+		/// the bands would take longer than the work itself.
+		inline static constexpr size_t PARALLEL_PIXEL_THRESHOLD = 256 * 1024;
+
+		/// The number of pixels per band, small enough for the workers to balance uneven bands.
+		inline static constexpr size_t BAND_PIXEL_COUNT = 64 * 1024;
+
+		/// @brief Split rows into bands and process them on the workers of the job system.
+		/// @param rowCount The number of rows.
+		/// @param rowWidth The number of pixels per row.
+		/// @param function Invoked with the first row and the number of rows of each band.
+		template <typename TFunction>
+		void ForEachRowBand(const uint32_t rowCount, const uint32_t rowWidth, const TFunction& function)
+		{
+			const size_t pixelCount = static_cast<size_t>(rowCount) * rowWidth;
+			if (pixelCount < PARALLEL_PIXEL_THRESHOLD or rowWidth == 0)
+			{
+				function(0u, rowCount);
+				return;
+			}
+
+			const size_t bandHeight = std::max<size_t>(BAND_PIXEL_COUNT / rowWidth, 1);
+			GetJobSystem().ParallelFor(rowCount, bandHeight, [&function](const size_t begin, const size_t end)
+			{
+				function(static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin));
+			});
+		}
+
+		Texture::Rgba8 ToRgba8(const Renderer::Color color)
+		{
+			return { color.R, color.G, color.B, color.A };
+		}
+	}
+
+	PixelBuffer::PixelBuffer():
+		m_Size(0, 0),
+		m_DirtyBegin(0),
+		m_DirtyEnd(0)
+	{
+	}
+
+	void PixelBuffer::Reset(const Math::Uint2 size, std::vector<uint8_t> pixels)
+	{
+		System::Require(pixels.size() == static_cast<size_t>(size.X) * size.Y * 4, [] { return "The pixels don't match the size of the buffer"; });
+
+		m_Size = size;
+		m_Pixels = std::move(pixels);
+		ClearDirtyRows();
+	}
+
+	Math::Uint2 PixelBuffer::GetSize() const
+	{
+		return m_Size;
+	}
+
+	size_t PixelBuffer::GetStride() const
+	{
+		return static_cast<size_t>(m_Size.X) * 4;
+	}
+
+	std::span<uint8_t> PixelBuffer::GetPixels()
+	{
+		MarkDirty(0, m_Size.Y);
+		return m_Pixels;
+	}
+
+	std::span<const uint8_t> PixelBuffer::GetPixels() const
+	{
+		return m_Pixels;
+	}
+
+	std::span<uint8_t> PixelBuffer::GetRow(const uint32_t row)
+	{
+		System::Require(row < m_Size.Y, [] { return "The row exceeds the buffer"; });
+
+		MarkDirty(row, 1);
+		return std::span<uint8_t>(m_Pixels).subspan(row * GetStride(), GetStride());
+	}
+
+	std::span<const uint8_t> PixelBuffer::GetRow(const uint32_t row) const
+	{
+		System::Require(row < m_Size.Y, [] { return "The row exceeds the buffer"; });
+		return std::span<const uint8_t>(m_Pixels).subspan(row * GetStride(), GetStride());
+	}
+
+	Renderer::Color PixelBuffer::GetPixel(const uint32_t x, const uint32_t y) const
+	{
+		System::Require(x < m_Size.X and y < m_Size.Y, [] { return "The pixel exceeds the buffer"; });
+
+		const uint8_t* pixel = m_Pixels.data() + y * GetStride() + x * 4;
+		return Renderer::Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+	}
+
+	void PixelBuffer::SetPixel(const uint32_t x, const uint32_t y, const Renderer::Color color)
+	{
+		System::Require(x < m_Size.X and y < m_Size.Y, [] { return "The pixel exceeds the buffer"; });
+
+		const Texture::Rgba8 value = ToRgba8(color);
+		std::memcpy(m_Pixels.data() + y * GetStride() + x * 4, value.data(), value.size());
+		MarkDirty(y, 1);
+	}
+
+	void PixelBuffer::Fill(const Renderer::Color color)
+	{
+		ForEachRowBand(m_Size.Y, m_Size.X, [this, value = ToRgba8(color)](const uint32_t firstRow, const uint32_t rowCount)
+		{
+			Texture::FillPixels(std::span<uint8_t>(m_Pixels).subspan(firstRow * GetStride(), rowCount * GetStride()), value);
+		});
+
+		MarkDirty(0, m_Size.Y);
+	}
+
+	void PixelBuffer::Blend(const std::span<const uint8_t> pixels, const Math::Uint2 size, const Math::Int2 position, const Renderer::Color tint)
+	{
+		System::Require(pixels.size() >= static_cast<size_t>(size.X) * size.Y * 4, [] { return "The pixels don't match the size of the image"; });
+
+		// Clip the image to the buffer
+		const int64_t left = std::max<int64_t>(position.X, 0);
+		const int64_t top = std::max<int64_t>(position.Y, 0);
+		const int64_t right = std::min<int64_t>(static_cast<int64_t>(position.X) + size.X, m_Size.X);
+		const int64_t bottom = std::min<int64_t>(static_cast<int64_t>(position.Y) + size.Y, m_Size.Y);
+
+		if (left >= right or top >= bottom)
+		{
+			return;
+		}
+
+		const auto width = static_cast<uint32_t>(right - left);
+		const auto height = static_cast<uint32_t>(bottom - top);
+		const size_t sourceStride = static_cast<size_t>(size.X) * 4;
+		const size_t sourceLeft = static_cast<size_t>(left - position.X) * 4;
+		const size_t sourceTop = static_cast<size_t>(top - position.Y);
+
+		ForEachRowBand(height, width, [&, value = ToRgba8(tint)](const uint32_t firstRow, const uint32_t rowCount)
+		{
+			for (uint32_t row = firstRow; row < firstRow + rowCount; ++row)
+			{
+				uint8_t* target = m_Pixels.data() + (top + row) * GetStride() + left * 4;
+				const uint8_t* source = pixels.data() + (sourceTop + row) * sourceStride + sourceLeft;
+
+				Texture::BlendPixelsTinted({ target, width * 4u }, { source, width * 4u }, value);
+			}
+		});
+
+		MarkDirty(static_cast<uint32_t>(top), height);
+	}
+
+	void PixelBuffer::Threshold(const uint8_t threshold)
+	{
+		ForEachRowBand(m_Size.Y, m_Size.X, [this, threshold](const uint32_t firstRow, const uint32_t rowCount)
+		{
+			Texture::ThresholdPixels(std::span<uint8_t>(m_Pixels).subspan(firstRow * GetStride(), rowCount * GetStride()), threshold);
+		});
+
+		MarkDirty(0, m_Size.Y);
+	}
+
+	void PixelBuffer::Convolve(const std::span<const float> kernel, const uint32_t kernelSize)
+	{
+		System::Require(kernelSize % 2 == 1, [] { return "The size of the kernel must be odd"; });
+		System::Require(kernel.size() == static_cast<size_t>(kernelSize) * kernelSize, [] { return "The kernel must hold kernelSize * kernelSize weights"; });
+
+		m_Scratch.resize(m_Pixels.size());
+
+		ForEachRowBand(m_Size.Y, m_Size.X * kernelSize * kernelSize, [&](const uint32_t firstRow, const uint32_t rowCount)
+		{
+			Texture::ConvolvePixels(m_Size, m_Pixels.data(), m_Scratch.data(), kernel, kernelSize, firstRow, rowCount);
+		});
+
+		m_Pixels.swap(m_Scratch);
+		MarkDirty(0, m_Size.Y);
+	}
+
+	bool PixelBuffer::IsDirty() const
+	{
+		return m_DirtyBegin < m_DirtyEnd;
+	}
+
+	uint32_t PixelBuffer::GetFirstDirtyRow() const
+	{
+		return m_DirtyBegin;
+	}
+
+	uint32_t PixelBuffer::GetDirtyRowCount() const
+	{
+		return m_DirtyEnd - m_DirtyBegin;
+	}
+
+	void PixelBuffer::ClearDirtyRows()
+	{
+		m_DirtyBegin = 0;
+		m_DirtyEnd = 0;
+	}
+
+	void PixelBuffer::MarkDirty(const uint32_t firstRow, const uint32_t rowCount)
+	{
+		if (rowCount == 0)
+		{
+			return;
+		}
+
+		if (not IsDirty())
+		{
+			m_DirtyBegin = firstRow;
+			m_DirtyEnd = firstRow + rowCount;
+			return;
+		}
+
+		m_DirtyBegin = std::min(m_DirtyBegin, firstRow);
+		m_DirtyEnd = std::max(m_DirtyEnd, firstRow + rowCount);
+	}
+}
\ No newline at end of file
@@ -1,61 +1,301 @@
 ﻿module;
 
+#include <cmath>
+#include <future>
 #include <memory>
+#include <span>
+#include <vector>
 
 module DirectGL;
 
 namespace DGL
 {
-	
-	RendererFacade::RendererFacade(
-		TextureRenderer::TextureRenderer& textureRenderer,
-		ShapeRenderer::ShapeRenderer& shapeRenderer,
-		ShapeRenderer::ShapeFactory& shapeFactory
-	):	m_TextureRenderer(textureRenderer),
-		m_ShapeRenderer(shapeRenderer),
-		m_ShapeFactory(shapeFactory)
+	RendererFacade::RendererFacade(RHI::RenderDevice& device, ShapeRenderer::ShapeFactory& shapeFactory, Jobs::JobSystem* jobSystem):
+		m_Device(&device),
+		m_ShapeFactory(shapeFactory),
+		m_JobSystem(jobSystem),
+		m_IsStateApplied(false),
+		m_AreConstantsQueued(false)
 	{
 	}
 
+	RHI::RenderDevice& RendererFacade::GetDevice()
+	{
+		return *m_Device;
+	}
+
+	void RendererFacade::SetDevice(RHI::RenderDevice& device)
+	{
+		FlushShapes();
+		m_Device = &device;
+		m_IsStateApplied = false;
+	}
+
+	ShapeRenderer::ShapeFactory& RendererFacade::GetShapeFactory()
+	{
+		return m_ShapeFactory;
+	}
+
+	Jobs::JobSystem* RendererFacade::GetJobSystem()
+	{
+		return m_JobSystem;
+	}
+
+	void RendererFacade::BeginPass(const RHI::RenderTargetHandle renderTarget)
+	{
+		FlushShapes();
+		m_Device->BeginPass(renderTarget);
+		m_IsStateApplied = false;
+	}
+
+	void RendererFacade::SetPipeline(const RHI::PipelineDescription& description)
+	{
+		m_Pipeline = description;
+		m_IsStateApplied = false;
+	}
+
+	void RendererFacade::SetConstants(const RHI::DrawConstants& constants)
+	{
+		m_Constants = constants;
+		m_IsStateApplied = false;
+		m_AreConstantsQueued = false;
+	}
+
 	void RendererFacade::FillRectangle(const Math::FloatBoundary& boundary, const float depth)
 	{
-		const auto vertices = m_ShapeFactory.GetFilledRectangle(boundary, depth);
-		m_ShapeRenderer.Render(vertices);
+		Queue(ShapeRenderer::Shape::FilledRectangle(boundary, depth));
 	}
 
 	void RendererFacade::DrawRectangle(const Math::FloatBoundary& boundary, const float strokeWeight, const float depth)
 	{
-		const auto vertices = m_ShapeFactory.GetOutlinedRectangle(boundary, strokeWeight, depth);
-		m_ShapeRenderer.Render(vertices);
+		Queue(ShapeRenderer::Shape::OutlinedRectangle(boundary, strokeWeight, depth));
 	}
 
 	void RendererFacade::FillEllipse(const Math::Float2& center, const Math::Radius& radius, const size_t segments, const float depth)
 	{
-		const auto vertices = m_ShapeFactory.GetFilledEllipse(center, radius, segments, depth);
-		m_ShapeRenderer.Render(vertices);
+		Queue(ShapeRenderer::Shape::FilledEllipse(center, radius, static_cast<uint32_t>(segments), depth));
 	}
 
 	void RendererFacade::DrawEllipse(const Math::Float2& center, const Math::Radius& radius, const size_t segments, const float strokeWeight, const float depth)
 	{
-		const auto vertices = m_ShapeFactory.GetOutlinedEllipse(center, radius, segments, strokeWeight, depth);
-		m_ShapeRenderer.Render(vertices);
+		Queue(ShapeRenderer::Shape::OutlinedEllipse(center, radius, static_cast<uint32_t>(segments), strokeWeight, depth));
 	}
 
 	void RendererFacade::FillTriangle(const Math::Float2& a, const Math::Float2& b, const Math::Float2& c, const float depth)
 	{
-		const auto vertices = m_ShapeFactory.GetFilledTriangle(a, b, c, depth);
-		m_ShapeRenderer.Render(vertices);
+		Queue(ShapeRenderer::Shape::FilledTriangle(a, b, c, depth));
 	}
 
 	void RendererFacade::Line(const Math::Float2& start, const Math::Float2& end, const float strokeWeight, const ShapeRenderer::LineCapStyle startCap, const ShapeRenderer::LineCapStyle endCap, const float depth)
 	{
+		FlushShapes();
+		ApplyState();
+
 		const auto vertices = m_ShapeFactory.GetLine(start, end, strokeWeight, startCap, endCap, depth);
-		m_ShapeRenderer.Render(vertices);
+		Draw(vertices);
+	}
+
+	void RendererFacade::FlushShapes()
+	{
+		if (m_Batch.IsEmpty())
+		{
+			return;
+		}
+
+		m_Batch.Tessellate(m_JobSystem);
+
+		// The batch goes to the device in one piece, the shapes only draw their part of it
+		m_Device->UploadVertices(m_Batch.GetPositions(), m_Batch.GetIndices());
+
+		// Replay the shapes in the order they were drawn in, only the state changes between them
+		constexpr size_t None = static_cast<size_t>(-1);
+		size_t pipeline = None;
+		size_t constants = None;
+
+		for (size_t i = 0; i < m_QueuedShapes.size(); ++i)
+		{
+			const QueuedShape& shape = m_QueuedShapes[i];
+
+			if (shape.Pipeline != pipeline)
+			{
+				pipeline = shape.Pipeline;
+				m_Device->SetPipeline(m_Device->GetPipeline(m_QueuedPipelines[pipeline]));
+			}
+
+			if (shape.Constants != constants)
+			{
+				constants = shape.Constants;
+				m_Device->SetConstants(m_QueuedConstants[constants]);
+			}
+
+			m_Device->DrawVertexRange({
+				.FirstVertex = static_cast<uint32_t>(m_Batch.GetFirstVertex(i)),
+				.VertexCount = static_cast<uint32_t>(m_Batch.GetPositions(i).size()),
+				.FirstIndex = static_cast<uint32_t>(m_Batch.GetFirstIndex(i)),
+				.IndexCount = static_cast<uint32_t>(m_Batch.GetIndices(i).size()),
+				.Type = m_Batch.GetType(i),
+			});
+		}
+
+		m_Batch.Clear();
+		m_QueuedShapes.clear();
+		m_QueuedPipelines.clear();
+		m_QueuedConstants.clear();
+		m_IsStateApplied = false;
+		m_AreConstantsQueued = false;
+	}
+
+	void RendererFacade::Image(
+		const Texture::Texture& texture,
+		const Math::FloatBoundary& source,
+		const Math::FloatBoundary& destination,
+		const Math::Float2& origin,
+		const Math::Angle rotation,
+		const Math::Matrix4x4& transform,
+		const Renderer::Color tint,
+		const float depth
+	)
+	{
+		const Math::Uint2 textureSize = texture.GetSize();
+		if (textureSize.X == 0 or textureSize.Y == 0)
+		{
+			return;
+		}
+
+		// Shapes drawn before have to reach the device first, images are batched there
+		FlushShapes();
+		ApplyState();
+
+		// Textures stored bottom-up map the top edge of the source onto the higher v coordinate
+		const bool isBottomUp = texture.GetOrigin() == Texture::TextureOrigin::BottomLeft;
+		const auto width = static_cast<float>(textureSize.X);
+		const auto height = static_cast<float>(textureSize.Y);
+		const Math::FloatBoundary region = source.Width > 0.0f and source.Height > 0.0f
+			? source
+			: Math::FloatBoundary::FromLTWH(0.0f, 0.0f, width, height);
+
+		// Scale the unit quad to the destination and rotate it around the origin
+		const float cosA = std::cos(rotation.AsRadians());
+		const float sinA = std::sin(rotation.AsRadians());
+		const float translationX = destination.Left + origin.X - cosA * origin.X + sinA * origin.Y;
+		const float translationY = destination.Top + origin.Y - sinA * origin.X - cosA * origin.Y;
+
+		const float l00 = cosA * destination.Width, l01 = -sinA * destination.Height;
+		const float l10 = sinA * destination.Width, l11 = cosA * destination.Height;
+
+		// Concatenate with the 2D part of the model matrix
+		const float* m = transform.GetData();
+
+		m_Device->DrawSprite(m_Device->GetTextureHandle(texture), TextureRenderer::SpriteInstance {
+			.M00 = m[0] * l00 + m[4] * l10,
+			.M01 = m[0] * l01 + m[4] * l11,
+			.M02 = m[0] * translationX + m[4] * translationY + m[12],
+			.M10 = m[1] * l00 + m[5] * l10,
+			.M11 = m[1] * l01 + m[5] * l11,
+			.M12 = m[1] * translationX + m[5] * translationY + m[13],
+			.U0 = region.Left / width,
+			.V0 = isBottomUp ? 1.0f - region.Top / height : region.Top / height,
+			.U1 = region.Right() / width,
+			.V1 = isBottomUp ? 1.0f - region.Bottom() / height : region.Bottom() / height,
+			.Depth = depth,
+			.R = tint.R,
+			.G = tint.G,
+			.B = tint.B,
+			.A = tint.A,
+			.TextureSlot = 0,
+		});
+	}
+
+	void RendererFacade::FlushImages()
+	{
+		FlushShapes();
+		m_Device->FlushSprites();
+	}
+
+	void RendererFacade::ReadPixelsAsync(const RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback)
+	{
+		FlushShapes();
+		m_Device->ReadPixelsAsync(renderTarget, region, std::move(callback));
+	}
+
+	std::future<Renderer::PixelData> RendererFacade::ReadPixelsAsync(const RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		FlushShapes();
+		return m_Device->ReadPixelsAsync(renderTarget, region);
+	}
+
+	void RendererFacade::ViewPixelsAsync(const RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback)
+	{
+		FlushShapes();
+		m_Device->ViewPixelsAsync(renderTarget, region, std::move(callback));
+	}
+
+	Renderer::PixelData RendererFacade::ReadPixels(const RHI::RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		FlushShapes();
+		return m_Device->ReadPixels(renderTarget, region);
 	}
 
-	void RendererFacade::Image(const Math::FloatBoundary& boundary, const float depth)
+	void RendererFacade::WritePixels(const RHI::RenderTargetHandle renderTarget, const uint8_t* pixels, const uint32_t firstRow, const uint32_t rowCount)
 	{
-		m_TextureRenderer.Render(boundary.Left, boundary.Top, boundary.Width, boundary.Height, depth);
+		FlushShapes();
+		m_Device->WritePixels(renderTarget, pixels, firstRow, rowCount);
+		m_IsStateApplied = false;
+	}
+
+	void RendererFacade::ApplyFilters(const RHI::RenderTargetHandle renderTarget, const std::span<const Brushes::Filter> filters)
+	{
+		FlushShapes();
+		m_Device->ApplyFilters(renderTarget, filters);
+		m_IsStateApplied = false;
+	}
+
+	std::span<const Brushes::FilterTiming> RendererFacade::GetFilterTimings()
+	{
+		return m_Device->GetFilterTimings();
+	}
+
+	void RendererFacade::Draw(const ShapeRenderer::Vertices& vertices)
+	{
+		m_Device->DrawVertices(vertices.Positions, vertices.Indices, vertices.Type);
+	}
+
+	void RendererFacade::Queue(const ShapeRenderer::Shape& shape)
+	{
+		// Shapes drawn with the same state share its copy
+		if (m_QueuedPipelines.empty() or m_QueuedPipelines.back() != m_Pipeline)
+		{
+			m_QueuedPipelines.push_back(m_Pipeline);
+		}
+
+		if (not m_AreConstantsQueued)
+		{
+			m_QueuedConstants.push_back(m_Constants);
+			m_AreConstantsQueued = true;
+		}
+
+		m_Batch.Add(shape);
+		m_QueuedShapes.push_back(QueuedShape{
+			.Pipeline = m_QueuedPipelines.size() - 1,
+			.Constants = m_QueuedConstants.size() - 1,
+		});
+
+		if (m_Batch.GetVertexCount() >= MaxQueuedVertices)
+		{
+			FlushShapes();
+		}
+	}
+
+	void RendererFacade::ApplyState()
+	{
+		if (m_IsStateApplied)
+		{
+			return;
+		}
+
+		m_Device->SetPipeline(m_Device->GetPipeline(m_Pipeline));
+		m_Device->SetConstants(m_Constants);
+		m_IsStateApplied = true;
 	}
 
 }
\ No newline at end of file
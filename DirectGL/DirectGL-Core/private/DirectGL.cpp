@@ -1,12 +1,19 @@
 ﻿module;
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <filesystem>
+#include <future>
+#include <thread>
+#include <span>
+#include <utility>
+#include <vector>
 
-#include <Glad/gl.h>
+#include <glad/gl.h>
 
 module DirectGL;
 
@@ -14,6 +21,7 @@ import System.Monitor;
 
 import Startup;
 import LogForge;
+import Preconditions;
 
 import DirectGL.Renderer;
 
@@ -24,6 +32,113 @@ using namespace System;
 /// </summary>
 namespace DGL
 {
+	namespace
+	{
+		/// The layer the drawing functions target on a thread running RecordLayers()
+		thread_local GraphicsLayer* RecordingLayer = nullptr;
+
+		/// @brief The layer stack and the render device belong to the GL thread, RecordLayers() only lets its threads draw their own layer.
+		void RequireNotRecording(const std::string_view function)
+		{
+			System::Require(RecordingLayer == nullptr, [function] { return std::string(function) + " can't be called while recording a layer"; });
+		}
+
+		/// @brief Order layers, so every one comes after the layers it depends on. Cycles keep the given order.
+		std::vector<OffscreenGraphicsLayer*> SortByDependencies(std::vector<OffscreenGraphicsLayer*> layers)
+		{
+			std::vector<OffscreenGraphicsLayer*> sorted;
+			sorted.reserve(layers.size());
+
+			while (not layers.empty())
+			{
+				const auto isReady = [&layers](const OffscreenGraphicsLayer* layer)
+				{
+					return std::ranges::none_of(layers, [layer](const OffscreenGraphicsLayer* source) { return layer->DependsOn(*source); });
+				};
+
+				auto it = std::ranges::find_if(layers, isReady);
+				if (it == layers.end())
+				{
+					Warning("The recorded layers depend on each other in a cycle");
+					it = layers.begin();
+				}
+
+				sorted.push_back(*it);
+				layers.erase(it);
+			}
+
+			return sorted;
+		}
+
+		/// @brief Get the device the frames get drawn through, unless commands are being captured.
+		RHI::RenderDevice& GetFrameDevice()
+		{
+			if (Library.ThreadedDevice != nullptr)
+			{
+				return *Library.ThreadedDevice;
+			}
+
+			return *Library.RenderDevice;
+		}
+
+		bool StartRenderThread(const uint32_t maxFramesInFlight)
+		{
+			Library.UploadContext = Library.Context->CreateSharedContext();
+			if (Library.UploadContext == nullptr)
+			{
+				Warning("Couldn't create a shared context, the frames are rendered on the main thread");
+				return false;
+			}
+
+			// The render thread takes over the context of the window, the main thread keeps uploading textures into the shared one
+			Library.Context->ReleaseCurrent();
+			Library.ThreadedDevice = RHI::ThreadedDevice::Create(*Library.RenderDevice, maxFramesInFlight, {
+				.Attach = [] { Library.Context->MakeCurrent(); },
+				.Present = [] { Library.Context->Flush(); },
+				.Detach = [] { Library.Context->ReleaseCurrent(); },
+			});
+
+			Library.UploadContext->MakeCurrent();
+			Library.RecordingDevice = RHI::RecordingDevice::Create(Library.ThreadedDevice.get());
+			Library.RendererFacade->SetDevice(*Library.ThreadedDevice);
+			Library.TextureCache->SetFramesInFlight(maxFramesInFlight);
+
+			Info(std::format("Rendering on a render thread with up to {} frames in flight", maxFramesInFlight));
+			return true;
+		}
+
+		void StartSoftwareRenderer()
+		{
+			// Nothing has been drawn yet, so the OpenGL device can be replaced as a whole. It goes first to restore the texture deleter it installed
+			Library.RenderDevice.reset();
+
+			auto softwareDevice = RHI::SoftwareDevice::Create(Library.Window->GetSize(), Library.JobSystem.get(), *Library.PixelWriter);
+			Library.SoftwareDevice = softwareDevice.get();
+			Library.RenderDevice = std::move(softwareDevice);
+
+			Library.RecordingDevice = RHI::RecordingDevice::Create(Library.RenderDevice.get());
+			Library.RendererFacade->SetDevice(*Library.RenderDevice);
+
+			Info(std::format("Rasterising the frames on the CPU using {} workers", Library.JobSystem->GetWorkerCount()));
+		}
+
+		void StopRenderThread()
+		{
+			Library.RendererFacade->SetDevice(*Library.RenderDevice);
+			Library.RecordingDevice = RHI::RecordingDevice::Create(Library.RenderDevice.get());
+			Library.TextureCache->SetFramesInFlight(0);
+
+			// Presents the frames in flight and hands the context back
+			Library.ThreadedDevice.reset();
+
+			// The uploads have to be complete before the context of the window uses the textures
+			glFinish();
+			Library.UploadContext->ReleaseCurrent();
+			Library.UploadContext.reset();
+			Library.Context->MakeCurrent();
+		}
+	}
+
 	void LaunchImpl(const std::function<std::unique_ptr<Sketch>()>& factory)
 	{
 		Library.Logger = std::make_unique<Logging::AsyncLogger>(std::make_unique<LogForge::DefaultLogger>(
@@ -32,7 +147,11 @@ namespace DGL
 			std::make_unique<LogForge::ConsoleLogOutput>()
 		));
 
+#ifdef PLATFORM_HEADLESS
+		Library.MonitorProvider = std::make_shared<MonitorProviderCache>(std::make_shared<HeadlessMonitorProvider>());
+#else
 		Library.MonitorProvider = std::make_shared<MonitorProviderCache>(std::make_shared<Win32MonitorProvider>());
+#endif
 		Library.Context = std::make_unique<ContextWrapper>([] { return Library.Window.get(); });
 		Library.Window = std::make_unique<WindowWrapper>(Library.MonitorProvider);
 
@@ -49,23 +168,70 @@ namespace DGL
 			Library.BlendModeActivator = std::make_unique<Blending::CachingBlendModeActivator>(*defaultActivator);
 			Library.ShapeFactory = std::make_unique<ShapeRenderer::ShapeFactory>();
 			Library.ShapeRenderer = ShapeRenderer::ShapeRenderer::Create(10'000, 10'000);
-			Library.TextureRenderer = TextureRenderer::TextureRenderer::Create();
+			Library.TextureRenderer = TextureRenderer::TextureRenderer::Create(32'768, TextureRenderer::TextureSlotTable::QueryMaxCapacity());
+			if (Library.TextureRenderer == nullptr)
+			{
+				Error("Couldn't map the streaming buffer of the texture renderer");
+				return;
+			}
 
-			Library.RendererFacade = std::make_unique<RendererFacade>(
-				*Library.TextureRenderer,
-				*Library.ShapeRenderer,
-				*Library.ShapeFactory
-			);
+			Library.PixelReadback = Renderer::PixelReadback::Create();
+			Library.PixelWriter = Renderer::PixelWriter::Create();
+			Library.SamplerCache = Texture::SamplerCache::Create();
+			Library.RenderTargetPool = Renderer::RenderTargetPool::Create();
+			Library.FilterChain = Brushes::FilterChain::Create(*Library.RenderTargetPool, *Library.SamplerCache);
 
-			Library.MainGraphicsLayer = MainGraphicsLayer::Create(
+			Library.RenderDevice = RHI::OpenGLDevice::Create(
 				Library.Window->GetSize(),
-				*Library.RendererFacade,
-				*Library.BlendModeActivator
+				*Library.ShapeRenderer,
+				*Library.TextureRenderer,
+				*Library.BlendModeActivator,
+				*Library.PixelReadback,
+				*Library.PixelWriter,
+				*Library.SamplerCache,
+				*Library.RenderTargetPool,
+				*Library.FilterChain
 			);
 
+			if (Library.RenderDevice == nullptr)
+			{
+				Error("Couldn't create the render device");
+				return;
+			}
+
+			// The main thread takes part in parallel loops, so it doesn't need a worker of its own
+			Library.JobSystem = Jobs::JobSystem::Create(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+
+			// A main loop waiting for events has to run the jobs that need the context as well
+			Library.JobSystem->SetMainThreadNotification([] { Library.Window->Wake(); });
+
+			Library.RecordingDevice = RHI::RecordingDevice::Create(Library.RenderDevice.get());
+			Library.RendererFacade = std::make_unique<RendererFacade>(*Library.RenderDevice, *Library.ShapeFactory, Library.JobSystem.get());
+			Library.MainGraphicsLayer = MainGraphicsLayer::Create(Library.Window->GetSize(), *Library.RendererFacade);
+
 			Library.GraphicsLayerStack = std::make_unique<GraphicsLayerStack>(Library.MainGraphicsLayer.get());
 
+			// Leave one core to the main thread, the decoders mostly wait for the disk anyway
+			const size_t decoderCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8) - 1;
+			Library.TextureLoader = Texture::TextureLoader::Create(decoderCount, 64 * 1024 * 1024);
+			if (Library.TextureLoader == nullptr)
+			{
+				Error("Couldn't create the texture loader");
+				return;
+			}
+
+			Library.TextureCache = Texture::TextureCache::Create(*Library.TextureLoader);
+			Library.FrameRecorder = FrameRecorder::Create(std::max<size_t>(std::thread::hardware_concurrency() / 2, 1));
+			Library.FrameScheduler = FrameScheduler::Create();
+
 			Library.Sketch = factory();
+
+			// The layers created by Setup() already get their render targets from the device
+			if (Library.Sketch != nullptr and Library.IsSoftwareRendererRequested)
+			{
+				StartSoftwareRenderer();
+			}
+
 			if (Library.Sketch == nullptr or not Library.Sketch->Setup())
 			{
 				Error("Couldn't setup the sketch");
@@ -74,6 +240,50 @@ namespace DGL
 
 			Library.Window->SetVisible(true);
 
+			if (Library.RenderThreadFrames > 0 and Library.SoftwareDevice != nullptr)
+			{
+				Warning("The software renderer rasterises on the worker threads, the frames aren't submitted on a render thread");
+			}
+			else if (Library.RenderThreadFrames > 0)
+			{
+				StartRenderThread(Library.RenderThreadFrames);
+			}
+
+			const auto processEvent = [](const WindowEvent& event)
+			{
+				event.Visit(
+					[](const WindowEvent::Closed&)
+					{
+						Info("Window close event received");
+						Quit();
+					},
+					[&](const WindowEvent::Resized& resizeEvent)
+					{
+						Library.MainGraphicsLayer->Resize({ resizeEvent.Width, resizeEvent.Height });
+						Redraw(); //!< Request a redraw after the window has been resized.
+						Info(std::format("Window has been resized: {}, {}", resizeEvent.Width, resizeEvent.Height));
+					},
+					[&](const WindowEvent::KeyReleased& keyEvent)
+					{
+						if (keyEvent.Key == KeyboardKey::F5)
+						{
+							Info("Restart requested via F5");
+							Restart();
+						}
+						else if (keyEvent.Key == KeyboardKey::Escape)
+						{
+							Info("Quit requested via Escape");
+							Quit();
+						}
+					},
+					[](const auto&) {}
+				);
+
+				// Forward the event to the input listener as well as the sketch
+				Library.InputListener.Process(event);
+				Library.Sketch->Event(event);
+			};
+
 			std::chrono::duration<float> deltaTime{ 0.0f };
 			auto lastFrameTime = std::chrono::high_resolution_clock::now();
 			while (not Library.CloseRequested)
@@ -81,65 +291,148 @@ namespace DGL
 				// Before we process events, we need to update the input listener
 				Library.InputListener.Update();
 
+				// A sketch that doesn't loop sleeps until an event, Redraw() or a job for the main thread wakes it up
+				const bool isIdle = Library.IsPaused and Library.FrameCount > 0 and not Library.UserRequestedRedraw;
+				if (isIdle)
+				{
+					const bool hasPendingWork = Library.TextureLoader->GetPendingCount() > 0 or Library.JobSystem->HasMainThreadJobs();
+					if (const auto event = Library.FrameScheduler->WaitForEvent(*Library.Window, hasPendingWork))
+					{
+						processEvent(*event);
+					}
+				}
+
 				// Poll all events from the window
 				while (const auto event = Library.Window->PollEvent())
 				{
-					event->Visit(
-						[](const WindowEvent::Closed&)
-						{
-							Info("Window close event received");
-							Quit();
-						},
-						[&](const WindowEvent::Resized& resizeEvent)
-						{
-							Library.MainGraphicsLayer->Resize({ resizeEvent.Width, resizeEvent.Height });
-							Redraw(); //!< Request a redraw after the window has been resized.
-							Info(std::format("Window has been resized: {}, {}", resizeEvent.Width, resizeEvent.Height));
-						},
-						[&](const WindowEvent::KeyReleased& keyEvent)
-						{
-							if (keyEvent.Key == KeyboardKey::F5)
-							{
-								Info("Restart requested via F5");
-								Restart();
-							}
-							else if (keyEvent.Key == KeyboardKey::Escape)
-							{
-								Info("Quit requested via Escape");
-								Quit();
-							}
-						},
-						[](const auto&) {}
-					);
+					processEvent(*event);
+				}
+
+				// Evict cached textures that exceed the budget while no draw calls reference them
+				Library.TextureCache->Update();
 
-					// Forward the event to the input listener as well as the sketch
-					Library.InputListener.Process(*event);
-					Library.Sketch->Event(*event);
+				// Finish the uploads of textures that have been decoded in the background
+				if (Library.TextureLoader->GetPendingCount() > 0)
+				{
+					Library.TextureLoader->ProcessUploads(Library.TextureUploadBudget);
 				}
 
+				// Run the jobs that need the context, e.g. uploads scheduled by the workers
+				Library.JobSystem->RunMainThreadJobs();
+
 				// Let the user render the next frame
-				if (not Library.IsPaused or Library.FrameCount == 0 or Library.UserRequestedRedraw)
+				const bool isDrawing = not Library.IsPaused or Library.FrameCount == 0 or Library.UserRequestedRedraw;
+				if (isDrawing)
 				{
 					// Note that this needs to happen before we call the Draw function
 					Library.UserRequestedRedraw = false;
+					Library.FrameScheduler->BeginFrame();
+
+					// A frame gets either recorded or drawn directly as a whole, so a command capture takes effect on the next one
+					if (Library.IsCapturingCommands)
+					{
+						Library.RendererFacade->SetDevice(*Library.RecordingDevice);
+					}
+					else
+					{
+						Library.RendererFacade->SetDevice(GetFrameDevice());
+					}
 
 					Library.MainGraphicsLayer->BeginDraw();
 					Library.Sketch->Draw(deltaTime.count());
 					Library.MainGraphicsLayer->EndDraw();
 
-					// Present the rendered frame on screen
-					Library.Context->Flush();
+					// Copy the frame before it gets presented, the recorder receives it once the copy finished
+					Library.FrameRecorder->Capture(*Library.MainGraphicsLayer, Library.FrameCount);
+
+					if (Library.FrameOutput != nullptr)
+					{
+						Library.FrameOutput->Submit(*Library.MainGraphicsLayer);
+					}
+
+					if (&Library.RendererFacade->GetDevice() == Library.RecordingDevice.get())
+					{
+						Library.RecordingDevice->Submit();
+						RHI::CommandList commands = Library.RecordingDevice->TakeCommands();
+
+						if (Library.IsCapturingCommands)
+						{
+							Library.CommandStatistics += commands.GetStatistics();
+							if (Library.CommandCaptureSettings.KeepFrames and Library.CommandCaptureSettings.MaxFrames > 0)
+							{
+								if (Library.CapturedCommands.size() == Library.CommandCaptureSettings.MaxFrames)
+								{
+									Library.CapturedCommands.erase(Library.CapturedCommands.begin());
+								}
+
+								Library.CapturedCommands.push_back(std::move(commands));
+							}
+						}
+					}
+
+					for (const RHI::CommandList& commands : Library.PendingReplays)
+					{
+						commands.Replay(GetFrameDevice());
+					}
+
+					Library.PendingReplays.clear();
+
+					// Present the rendered frame on screen, the render thread does so while the next frame gets drawn
+					if (Library.ThreadedDevice != nullptr)
+					{
+						Library.ThreadedDevice->SubmitFrame();
+					}
+					else
+					{
+						if (Library.SoftwareDevice != nullptr)
+						{
+							Library.SoftwareDevice->Present();
+						}
+
+						Library.Context->Flush();
+					}
 
 					const auto now = std::chrono::high_resolution_clock::now();
 					deltaTime = now - lastFrameTime;
 					lastFrameTime = now;
 				}
 
+				// Deliver finished pixel readbacks and recycle the render targets released a few frames ago
+				Library.RendererFacade->GetDevice().EndFrame();
+
+				// Hold the target frame rate
+				if (isDrawing)
+				{
+					Library.FrameScheduler->EndFrame();
+				}
+
 				// Increment the number of frames processed
 				++Library.FrameCount;
 			}
 
+			if (Library.ThreadedDevice != nullptr)
+			{
+				StopRenderThread();
+			}
+
+			// Render targets released from now on get destroyed right away
+			Library.RendererFacade->SetDevice(*Library.RenderDevice);
 			Library.Sketch->Destroy();
+
+			// Shapes drawn by Destroy() get tessellated on the workers too
+			Library.RendererFacade->FlushShapes();
+
+			// The software device rasterises on the workers, so nothing may be left queued once they are gone
+			if (Library.SoftwareDevice != nullptr)
+			{
+				Library.SoftwareDevice->EndFrame();
+			}
+
+			// Queued jobs of the sketch get discarded, running ones may still refer to it
+			Library.JobSystem.reset();
+
+			// Layers owned by the sketch return their render targets to the device, which has to be alive meanwhile
+			Library.Sketch.reset();
 		});
 	}
 
@@ -237,10 +530,27 @@ namespace DGL
 	void NoLoop() { Library.IsPaused = true; }
 	void ToggleLoop() { Library.IsPaused = not Library.IsPaused; }
 	bool IsLooping() { return not Library.IsPaused; }
-	void Redraw() { Library.UserRequestedRedraw = true; }
+
+	void Redraw()
+	{
+		// The flag belongs to the main thread, other threads hand it over through a job that wakes the loop up
+		if (Library.JobSystem != nullptr and not Library.JobSystem->IsMainThread())
+		{
+			Library.JobSystem->Schedule([] { Library.UserRequestedRedraw = true; }, {}, JobAffinity::MainThread);
+			return;
+		}
+
+		Library.UserRequestedRedraw = true;
+	}
+
+	void SetFrameRate(const float framesPerSecond) { Library.FrameScheduler->SetTargetFrameRate(framesPerSecond); }
+	float GetFrameRate() { return Library.FrameScheduler->GetTargetFrameRate(); }
+	FrameTimingStatistics GetFrameTimingStatistics() { return Library.FrameScheduler->GetStatistics(); }
 
 	void PushLayer(GraphicsLayer* layer)
 	{
+		RequireNotRecording("PushLayer()");
+
 		if (const auto offscreenLayer = dynamic_cast<OffscreenGraphicsLayer*>(layer))
 		{
 			Library.GraphicsLayerStack->PushLayer(offscreenLayer);
@@ -250,19 +560,215 @@ namespace DGL
 		}
 	}
 
-	void PopLayer() { Library.GraphicsLayerStack->PopLayer(); }
-	GraphicsLayer& PeekLayer() { return Library.GraphicsLayerStack->PeekLayer(); }
+	void PopLayer()
+	{
+		RequireNotRecording("PopLayer()");
+		Library.GraphicsLayerStack->PopLayer();
+	}
+
+	bool DrawCached(GraphicsLayer& layer, const std::function<void()>& draw)
+	{
+		RequireNotRecording("DrawCached()");
+
+		const auto offscreenLayer = dynamic_cast<OffscreenGraphicsLayer*>(&layer);
+		if (offscreenLayer == nullptr)
+		{
+			Logging::Error("Only offscreen graphics layers keep their contents between frames");
+			return false;
+		}
+
+		if (not offscreenLayer->IsStale())
+		{
+			return false;
+		}
+
+		Library.GraphicsLayerStack->PushLayer(offscreenLayer);
+		draw();
+		Library.GraphicsLayerStack->PopLayer();
+
+		offscreenLayer->Validate();
+		return true;
+	}
 
-	std::unique_ptr<GraphicsLayer> CreateGraphics(const uint32_t width, const uint32_t height)
+	void RecordLayers(const std::span<GraphicsLayer* const> layers, const std::function<void(GraphicsLayer&)>& record)
+	{
+		RequireNotRecording("RecordLayers()");
+
+		std::vector<OffscreenGraphicsLayer*> offscreenLayers;
+		offscreenLayers.reserve(layers.size());
+
+		for (GraphicsLayer* layer : layers)
+		{
+			if (const auto offscreenLayer = dynamic_cast<OffscreenGraphicsLayer*>(layer))
+			{
+				offscreenLayers.push_back(offscreenLayer);
+			}
+			else
+			{
+				Logging::Error("Only offscreen graphics layers can be recorded on worker threads");
+			}
+		}
+
+		if (offscreenLayers.empty())
+		{
+			return;
+		}
+
+		// The images queued by the current layer have to land before the recorded passes
+		Library.GraphicsLayerStack->Suspend();
+
+		for (OffscreenGraphicsLayer* layer : offscreenLayers)
+		{
+			layer->BeginRecording();
+		}
+
+		// A layer per chunk, the calling thread records some of them as well
+		Library.JobSystem->ParallelFor(offscreenLayers.size(), 1, [&](const size_t begin, const size_t end)
+		{
+			for (size_t index = begin; index < end; ++index)
+			{
+				OffscreenGraphicsLayer& layer = *offscreenLayers[index];
+
+				// A thread waiting for jobs within record() may pick up the next layer meanwhile
+				GraphicsLayer* const previousLayer = std::exchange(RecordingLayer, &layer);
+				record(layer);
+				layer.EndRecording();
+				RecordingLayer = previousLayer;
+			}
+		});
+
+		// Layers composited into others have to be drawn before them
+		for (OffscreenGraphicsLayer* layer : SortByDependencies(std::move(offscreenLayers)))
+		{
+			layer->SubmitRecording();
+		}
+
+		Library.GraphicsLayerStack->Resume();
+	}
+
+	GraphicsLayer& PeekLayer()
+	{
+		// Worker threads of RecordLayers() draw into their own layer
+		if (RecordingLayer != nullptr)
+		{
+			return *RecordingLayer;
+		}
+
+		return Library.GraphicsLayerStack->PeekLayer();
+	}
+
+	std::unique_ptr<GraphicsLayer> CreateGraphics(const uint32_t width, const uint32_t height, const Renderer::RenderTargetAttachments attachments)
 	{
 		return OffscreenGraphicsLayer::Create(
 			{ width, height },
 			*Library.RendererFacade,
-			*Library.BlendModeActivator
+			attachments
 		);
 	}
 
+	std::shared_ptr<Texture::AsyncTexture> LoadTextureAsync(const std::filesystem::path& path, const Texture::TextureLoadSettings& settings)
+	{
+		return Library.TextureLoader->LoadAsync(path, settings);
+	}
+
+	void SetTextureUploadBudget(const std::chrono::microseconds budget)
+	{
+		Library.TextureUploadBudget = budget;
+	}
+
+	std::shared_ptr<Texture::CachedTexture> AcquireTexture(const std::filesystem::path& path, const Texture::TextureLoadSettings& settings)
+	{
+		return Library.TextureCache->Acquire(path, settings);
+	}
+
+	void SetTextureMemoryBudget(const size_t budget)
+	{
+		Library.TextureCache->SetBudget(budget);
+	}
+
+	Texture::TextureCacheStatistics GetTextureCacheStatistics()
+	{
+		return Library.TextureCache->GetStatistics();
+	}
+
+	Texture::TextureMemoryStatistics GetTextureMemoryStatistics()
+	{
+		return Texture::GetTextureMemoryStatistics();
+	}
+
 	const Math::FloatBoundary& GetViewport() { return PeekLayer().GetViewport(); }
+	void ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback) { PeekLayer().ReadPixelsAsync(region, std::move(callback)); }
+	std::future<Renderer::PixelData> ReadPixelsAsync(const Math::UintBoundary& region) { return PeekLayer().ReadPixelsAsync(region); }
+	PixelBuffer& LoadPixels() { return PeekLayer().LoadPixels(); }
+	void UpdatePixels() { PeekLayer().UpdatePixels(); }
+	void ApplyFilters(const std::span<const Filter> filters) { PeekLayer().ApplyFilters(filters); }
+	void ApplyFilter(const Filter& filter) { PeekLayer().ApplyFilters(std::span(&filter, 1)); }
+	std::span<const FilterTiming> GetFilterTimings() { return Library.RendererFacade->GetFilterTimings(); }
+
+	bool StartRecording(const RecordingSettings& settings) { return Library.FrameRecorder->Start(settings); }
+	void StopRecording() { Library.FrameRecorder->Stop(); }
+	bool IsRecording() { return Library.FrameRecorder->IsRecording(); }
+	RecordingStatistics GetRecordingStatistics() { return Library.FrameRecorder->GetStatistics(); }
+
+	bool OpenFrameOutput(const std::string_view name, const uint32_t slotCount)
+	{
+		Library.FrameOutput = FrameOutput::Create(name, Library.Window->GetSize(), slotCount);
+		if (Library.FrameOutput == nullptr)
+		{
+			Logging::Error(std::format("Failed to create the frame output {}", name));
+			return false;
+		}
+
+		return true;
+	}
+
+	void CloseFrameOutput() { Library.FrameOutput.reset(); }
+	Renderer::RenderTargetPoolStatistics GetRenderTargetPoolStatistics()
+	{
+		if (Library.ThreadedDevice == nullptr)
+		{
+			return Library.RenderTargetPool->GetStatistics();
+		}
+
+		// The pool is used by the render thread
+		Renderer::RenderTargetPoolStatistics statistics;
+		Library.ThreadedDevice->Invoke([&statistics](RHI::RenderDevice&) { statistics = Library.RenderTargetPool->GetStatistics(); });
+		return statistics;
+	}
+
+	bool StartCommandCapture(const CommandCaptureSettings& settings)
+	{
+		if (Library.IsCapturingCommands)
+		{
+			Logging::Error("The commands are already being captured");
+			return false;
+		}
+
+		Library.CommandCaptureSettings = settings;
+		Library.CommandStatistics = {};
+		Library.CapturedCommands.clear();
+		Library.IsCapturingCommands = true;
+		return true;
+	}
+
+	std::vector<CommandList> StopCommandCapture()
+	{
+		Library.IsCapturingCommands = false;
+		return std::exchange(Library.CapturedCommands, {});
+	}
+
+	bool IsCapturingCommands() { return Library.IsCapturingCommands; }
+	CommandStatistics GetCommandCaptureStatistics() { return Library.CommandStatistics; }
+	void ReplayCommands(CommandList commands) { Library.PendingReplays.push_back(std::move(commands)); }
+
+	void UseRenderThread(const uint32_t maxFramesInFlight) { Library.RenderThreadFrames = std::max<uint32_t>(maxFramesInFlight, 1); }
+	bool IsRenderThreadRunning() { return Library.ThreadedDevice != nullptr; }
+	RenderThreadStatistics GetRenderThreadStatistics() { return Library.ThreadedDevice != nullptr ? Library.ThreadedDevice->GetStatistics() : RenderThreadStatistics(); }
+	void UseSoftwareRenderer() { Library.IsSoftwareRendererRequested = true; }
+	bool IsSoftwareRendererRunning() { return Library.SoftwareDevice != nullptr; }
+	JobSystem& GetJobSystem() { return *Library.JobSystem; }
+	JobStatistics GetJobStatistics() { return Library.JobSystem->GetStatistics(); }
+	FrameOutputStatistics GetFrameOutputStatistics() { return Library.FrameOutput != nullptr ? Library.FrameOutput->GetStatistics() : FrameOutputStatistics(); }
 
 	void PushState() { PeekLayer().PushState(); }
 	void PopState() { PeekLayer().PopState(); }
@@ -294,6 +800,8 @@ namespace DGL
 	void SetImageTint(const Renderer::Color tint) { PeekLayer().SetImageTint(tint); }
 	void SetImageAlpha(const uint8_t alpha) { PeekLayer().SetImageAlpha(alpha); }
 	void SetImageOpacity(const float opacity) { PeekLayer().SetImageOpacity(opacity); }
+	void SetImageFilterMode(const Texture::TextureFilterMode filterMode) { PeekLayer().SetImageFilterMode(filterMode); }
+	void SetImageAnisotropy(const float anisotropy) { PeekLayer().SetImageAnisotropy(anisotropy); }
 
 	void Background(const Renderer::Color color) { PeekLayer().Background(color); }
 	void Rect(const float x1, const float y1, const float x2, const float y2) { PeekLayer().Rect(x1, y1, x2, y2); }
@@ -304,4 +812,7 @@ namespace DGL
 	void Line(const float x1, const float y1, const float x2, const float y2) { PeekLayer().Line(x1, y1, x2, y2); }
 	void Triangle(const float x1, const float y1, const float x2, const float y2, const float x3, const float y3) { PeekLayer().Triangle(x1, y1, x2, y2, x3, y3); }
 	void Image(const Texture::Texture& texture, const float x1, const float y1, const float x2, const float y2) { PeekLayer().Image(texture, x1, y1, x2, y2); }
+	void Image(const Texture::TextureRegion& region, const float x1, const float y1, const float x2, const float y2) { PeekLayer().Image(region, x1, y1, x2, y2); }
+	void Image(const Texture::Texture& texture, const Sprite& sprite) { PeekLayer().Image(texture, sprite); }
+	void Image(const Texture::Texture& texture, const std::span<const Sprite> sprites) { PeekLayer().Image(texture, sprites); }
 }
\ No newline at end of file
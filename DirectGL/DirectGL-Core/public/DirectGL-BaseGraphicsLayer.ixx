@@ -5,7 +5,9 @@
 
 module;
 
+#include <future>
 #include <memory>
+#include <span>
 
 export module DirectGL:BaseGraphicsLayer;
 
@@ -13,10 +15,13 @@ import DirectGL.Math;
 import DirectGL.Renderer;
 import DirectGL.Brushes;
 import DirectGL.Blending;
+import DirectGL.RHI;
 
 import :RendererFacade;
 import :RenderStateStack;
 import :GraphicsLayer;
+import :PixelBuffer;
+import :Sprite;
 import :DepthProvider;
 
 export namespace DGL
@@ -27,17 +32,34 @@ export namespace DGL
 
 		explicit BaseGraphicsLayer(
 			RendererFacade& renderer,
+			RHI::RenderTargetHandle renderTarget,
 			Math::Uint2 viewportSize,
-			Blending::BlendModeActivator& blendModeActivator,
 			std::unique_ptr<DepthProvider> depthProvider
 		);
 
+		/// @brief Draw through another renderer from now on, e.g. one recording the draw calls on another thread.
+		///		   The images waiting in the batch get drawn through the previous renderer first.
+		void SetRenderer(RendererFacade& renderer);
+
 		void SetViewport(Math::FloatBoundary viewport);
 		const Math::FloatBoundary& GetViewport() const override;
 
 		void BeginDraw();
 		void EndDraw();
 
+		/// @brief Direct the following draw calls of the renderer to the render target of this layer.
+		void Activate();
+
+		/// @brief Draw all images that are still waiting in the current batch.
+		///
+		/// Images are batched across consecutive Image() calls. Any other draw call,
+		/// a change of the blend mode as well as suspending or ending the layer
+		/// flushes the batch to preserve the draw order.
+		void Flush();
+
+		/// @brief Hand everything drawn so far to the device, the images as well as the shapes queued by the renderer.
+		void Submit();
+
 		void PushState() override;
 		void PopState() override;
 		RenderState& PeekState() override;
@@ -68,6 +90,8 @@ export namespace DGL
 		void SetImageTint(Renderer::Color tint) override;
 		void SetImageAlpha(uint8_t alpha) override;
 		void SetImageOpacity(float opacity) override;
+		void SetImageFilterMode(Texture::TextureFilterMode filterMode) override;
+		void SetImageAnisotropy(float anisotropy) override;
 
 		void Background(Renderer::Color color) override;
 		void Rect(float x1, float y1, float x2, float y2) override;
@@ -76,24 +100,47 @@ export namespace DGL
 		void Line(float x1, float y1, float x2, float y2) override;
 		void Triangle(float x1, float y1, float x2, float y2, float x3, float y3) override;
 		void Image(const Texture::Texture& texture, float x1, float y1, float x2, float y2) override;
+		void Image(const Texture::TextureRegion& region, float x1, float y1, float x2, float y2) override;
+		void Image(const Texture::Texture& texture, const Sprite& sprite) override;
+		void Image(const Texture::Texture& texture, std::span<const Sprite> sprites) override;
+
+		void ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback) override;
+		std::future<Renderer::PixelData> ReadPixelsAsync(const Math::UintBoundary& region) override;
+		void ViewPixelsAsync(const Math::UintBoundary& region, Renderer::PixelViewCallback callback) override;
+
+		/// @return A number that increases whenever a draw call lands in the layer.
+		uint64_t GetContentVersion() const;
+
+		PixelBuffer& LoadPixels() override;
+		void UpdatePixels() override;
+		void ApplyFilters(std::span<const Brushes::Filter> filters) override;
 
 	private:
 
-		float IncrementAndGetDepth() const;
+		/// @brief Get the depth of the next primitive. Every primitive goes through here, which makes it the place to bump the content version.
+		float IncrementAndGetDepth();
 
-		RendererFacade* m_Renderer;
-		Blending::BlendModeActivator* m_BlendModeActivator;
+		void DrawImage(const Texture::Texture& texture, const Math::FloatBoundary& source, float x1, float y1, float x2, float y2);
 
-		std::unique_ptr<Brushes::SolidColorBrush> m_SolidFillBrush;
-		std::unique_ptr<Brushes::SolidColorBrush> m_SolidStrokeBrush;
+		/// @brief Bind the sprite pipeline unless a batch with the same blend mode and sampling is already running.
+		void BeginImageBatch(const RenderState& state);
+
+		RendererFacade* m_Renderer;
+		RHI::RenderTargetHandle m_RenderTarget;
 
-		std::unique_ptr<Brushes::TextureBrush> m_TextureFillBrush;
 		std::unique_ptr<DepthProvider> m_DepthProvider;
 
 		RenderStateStack m_RenderStates;
+		PixelBuffer m_PixelBuffer;
 
 		Math::FloatBoundary m_Viewport;
 		Math::Matrix4x4 m_ProjectionMatrix;
+		uint64_t m_ContentVersion;
+
+		bool m_HasPendingImages;
+		Blending::BlendMode m_PendingImageBlendMode;
+		Texture::TextureFilterMode m_PendingImageFilterMode;
+		float m_PendingImageAnisotropy;
 
 	};
 }
\ No newline at end of file
@@ -0,0 +1,25 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-CommandCapture.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstddef>
+
+export module DirectGL:CommandCapture;
+
+import DirectGL.RHI;
+
+export namespace DGL
+{
+	using CommandList = RHI::CommandList;
+	using CommandStatistics = RHI::CommandStatistics;
+	using CommandType = RHI::CommandType;
+
+	struct CommandCaptureSettings
+	{
+		bool KeepFrames = true;		//!< Keep the commands of every frame, so they can be inspected or replayed after the capture stopped
+		size_t MaxFrames = 600;		//!< The number of frames kept at most. Older frames get dropped, but still count towards the statistics
+	};
+}
\ No newline at end of file
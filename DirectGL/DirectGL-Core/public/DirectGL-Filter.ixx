@@ -0,0 +1,16 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-Filter.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL:Filter;
+
+import DirectGL.Brushes;
+
+export namespace DGL
+{
+	using Filter = Brushes::Filter;
+	using FilterType = Brushes::FilterType;
+	using FilterTiming = Brushes::FilterTiming;
+	using Brushes::GetFilterName;
+}
\ No newline at end of file
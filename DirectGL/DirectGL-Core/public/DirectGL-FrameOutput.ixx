@@ -0,0 +1,67 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-FrameOutput.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+export module DirectGL:FrameOutput;
+
+import DirectGL.Math;
+import FrameRing;
+
+import :GraphicsLayer;
+
+export namespace DGL
+{
+	struct FrameOutputStatistics
+	{
+		uint64_t SubmittedFrames = 0;	//!< The frames read back from the layers
+		uint64_t WrittenFrames = 0;		//!< The frames published to the readers
+		uint64_t OversizedFrames = 0;	//!< The frames skipped because they exceeded the slot capacity
+	};
+
+	/// Publishes frames of graphics layers into a shared memory ring, from which
+	/// another process can consume them, e.g. an encoder for streaming. The pixels
+	/// are copied from the readback buffer into the ring directly, so every frame
+	/// gets copied once. Readers that fall behind lose frames instead of stalling the sketch.
+	class FrameOutput
+	{
+	public:
+
+		/// @brief Create the shared memory ring.
+		/// @param name The name readers open the ring with, e.g. via FrameRing::FrameRingReader::Open.
+		/// @param maxFrameSize The largest frame in pixels the ring can hold.
+		/// @param slotCount The number of frames the ring holds.
+		/// @return The frame output or nullptr if the ring couldn't be created.
+		static std::unique_ptr<FrameOutput> Create(std::string_view name, Math::Uint2 maxFrameSize, uint32_t slotCount = 4);
+
+		/// @brief Publish everything drawn onto the layer so far. The frame reaches the ring
+		///		   once its readback finished, which usually takes one or two frames.
+		/// @param layer The main layer or any offscreen layer.
+		void Submit(GraphicsLayer& layer);
+
+		FrameOutputStatistics GetStatistics() const;
+
+	private:
+
+		/// Shared with the pending readbacks, which may finish after the output has been destroyed.
+		struct State
+		{
+			std::unique_ptr<FrameRing::FrameRingWriter> Writer;
+			std::atomic<uint64_t> SubmittedFrames;
+			std::atomic<uint64_t> WrittenFrames;
+			std::atomic<uint64_t> OversizedFrames;
+		};
+
+		explicit FrameOutput(std::shared_ptr<State> state);
+
+		std::shared_ptr<State> m_State;
+
+	};
+}
\ No newline at end of file
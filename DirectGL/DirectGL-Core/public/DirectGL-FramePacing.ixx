@@ -0,0 +1,28 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-FramePacing.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <chrono>
+#include <cstdint>
+
+export module DirectGL:FramePacing;
+
+export namespace DGL
+{
+	struct FrameTimingStatistics
+	{
+		uint64_t Frames = 0;								//!< The frames drawn
+		uint64_t MissedFrames = 0;							//!< The frames that took longer than the target frame rate allows
+		float TargetFrameRate = 0.0f;						//!< The frames per second the loop is capped at, zero if it isn't
+		float FrameRate = 0.0f;								//!< The frames per second measured across the recent frames
+		std::chrono::microseconds AverageFrameTime = {};	//!< The time from the start of a frame until it has been presented
+		std::chrono::microseconds AverageFrameInterval = {};	//!< The time between the starts of consecutive frames, without the time spent idle in between
+		std::chrono::microseconds MaxFrameInterval = {};	//!< The longest time between the starts of consecutive frames, without the time spent idle in between
+		std::chrono::microseconds SleepTime = {};			//!< The time spent sleeping to hold the target frame rate
+		std::chrono::microseconds SpinTime = {};			//!< The time spent spinning for the last moments before a frame is due
+		std::chrono::microseconds IdleTime = {};			//!< The time spent waiting for events while the sketch doesn't loop
+	};
+}
\ No newline at end of file
@@ -3,16 +3,24 @@
 // Author       : Felix Busch
 // Created Date : 2025/10/10
 
+module;
+
+#include <future>
+#include <span>
+
 export module DirectGL:GraphicsLayer;
 
 import DirectGL.Math;
 import DirectGL.Blending;
+import DirectGL.Brushes;
 import DirectGL.Renderer;
 import DirectGL.Texture;
 
 import :BlendMode;
 import :RenderState;
 import :DrawMode;
+import :PixelBuffer;
+import :Sprite;
 
 export namespace DGL
 {
@@ -52,6 +60,8 @@ export namespace DGL
 		virtual void SetImageTint(Renderer::Color tint) = 0;
 		virtual void SetImageAlpha(uint8_t alpha) = 0;
 		virtual void SetImageOpacity(float opacity) = 0;
+		virtual void SetImageFilterMode(Texture::TextureFilterMode filterMode) = 0;
+		virtual void SetImageAnisotropy(float anisotropy) = 0;
 
 		virtual void Background(Renderer::Color color) = 0;
 		virtual void Rect(float x1, float y1, float x2, float y2) = 0;
@@ -60,5 +70,31 @@ export namespace DGL
 		virtual void Line(float x1, float y1, float x2, float y2) = 0;
 		virtual void Triangle(float x1, float y1, float x2, float y2, float x3, float y3) = 0;
 		virtual void Image(const Texture::Texture& texture, float x1, float y1, float x2, float y2) = 0;
+		virtual void Image(const Texture::TextureRegion& region, float x1, float y1, float x2, float y2) = 0;
+		virtual void Image(const Texture::Texture& texture, const Sprite& sprite) = 0;
+		virtual void Image(const Texture::Texture& texture, std::span<const Sprite> sprites) = 0;
+
+		/// @brief Copy a region of the layer without stalling the GPU. Everything drawn so far
+		///		   ends up in the copy, which gets delivered one or two frames later.
+		/// @param region The region in pixels, measured from the top-left corner of the layer.
+		/// @param callback Receives the pixels on the main thread.
+		virtual void ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback) = 0;
+		virtual std::future<Renderer::PixelData> ReadPixelsAsync(const Math::UintBoundary& region) = 0;
+
+		/// @brief Like ReadPixelsAsync, but the callback gets a view of the readback buffer instead of a copy.
+		///		   The view is only valid during the callback, which saves a copy when the pixels get moved on anyway.
+		virtual void ViewPixelsAsync(const Math::UintBoundary& region, Renderer::PixelViewCallback callback) = 0;
+
+		/// @brief Read the pixels of the layer into system memory for manipulation on the CPU.
+		///		   Unlike ReadPixelsAsync, this waits for the GPU to finish drawing, so use it sparingly.
+		/// @return The pixels of the layer. The buffer is owned by the layer and reused by the next call.
+		virtual PixelBuffer& LoadPixels() = 0;
+
+		/// @brief Write the rows of the pixel buffer that changed since LoadPixels() back to the layer.
+		virtual void UpdatePixels() = 0;
+
+		/// @brief Run post-processing filters over everything drawn to the layer so far.
+		/// @param filters The filters, applied in order. See GetFilterTimings() for what each one costs.
+		virtual void ApplyFilters(std::span<const Brushes::Filter> filters) = 0;
 	};
 }
\ No newline at end of file
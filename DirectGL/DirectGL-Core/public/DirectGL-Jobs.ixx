@@ -0,0 +1,17 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-Jobs.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL:Jobs;
+
+import Jobs;
+
+export namespace DGL
+{
+	using JobSystem = Jobs::JobSystem;
+	using JobHandle = Jobs::JobHandle;
+	using JobAffinity = Jobs::JobAffinity;
+	using JobStatistics = Jobs::JobStatistics;
+	using WorkerStatistics = Jobs::WorkerStatistics;
+}
\ No newline at end of file
@@ -6,16 +6,24 @@
 module;
 
 #include <memory>
+#include <future>
+#include <span>
+#include <vector>
 
 export module DirectGL:OffscreenGraphicsLayer;
 
 import DirectGL.Blending;
+import DirectGL.Brushes;
 import DirectGL.Renderer;
 import DirectGL.Math;
+import DirectGL.RHI;
 import DirectGL.Texture;
 
 import :BaseGraphicsLayer;
+import :PixelBuffer;
+import :RendererFacade;
 import :RenderStateStack;
+import :Sprite;
 
 export namespace DGL
 {
@@ -23,20 +31,65 @@ export namespace DGL
 	{
 	public:
 
+		/// @brief Create a new offscreen layer. Its render target gets created by the render device of the renderer.
+		/// @param attachments Whether the render target gets a depth/stencil buffer besides the color texture.
 		static std::unique_ptr<OffscreenGraphicsLayer> Create(
 			Math::Uint2 viewportSize,
 			RendererFacade& renderer,
-			Blending::BlendModeActivator& blendModeActivator
+			Renderer::RenderTargetAttachments attachments = Renderer::RenderTargetAttachments::ColorDepthStencil
 		);
 
+		/// @brief Destroy the render target, which returns it to the pool of the OpenGL device.
+		~OffscreenGraphicsLayer() override;
+
 		void BeginDraw();
 		void EndDraw();
 
 		void Resume();
 		void Suspend();
 
+		/// @brief Record the following draw calls into a command list of the layer, so another
+		///		   thread can draw the layer while other layers get recorded elsewhere. Begins
+		///		   drawing the layer. Call on the GL thread.
+		///
+		/// Only one thread at a time may draw the layer. While recording, LoadPixels() isn't
+		/// available and the GL thread must not draw through the render device, since the
+		/// recording looks up render targets and textures of it.
+		void BeginRecording();
+
+		/// @brief Finish drawing the layer. Call on the thread that recorded it.
+		void EndRecording();
+
+		/// @brief Submit the recorded commands to the render device and draw through the
+		///		   renderer again. Call on the GL thread once EndRecording() returned.
+		void SubmitRecording();
+
+		bool IsRecording() const;
+
+		/// @brief Get the color attachment of the render target. Requires a backend keeping it in a texture.
 		const Texture::Texture& GetRenderTexture() const;
 
+		/// @return A number that increases whenever a draw call lands in the layer.
+		uint64_t GetContentVersion() const;
+
+		/// @brief Mark the contents as outdated, so the next DrawCached() redraws the layer.
+		void Invalidate();
+
+		/// @brief Mark the contents as up to date and remember the versions of the dependencies.
+		///		   DrawCached() calls this after drawing the layer.
+		void Validate();
+
+		/// @return Whether the layer has to be redrawn: it hasn't been validated yet, got
+		///			invalidated or the contents of one of its dependencies changed.
+		bool IsStale() const;
+
+		/// @brief Let the contents of this layer depend on another one, e.g. because it gets
+		///		   composited into this layer. Changes to the source make this layer stale.
+		/// @param source The layer this one depends on. Must outlive the dependency.
+		void AddDependency(const OffscreenGraphicsLayer& source);
+		void RemoveDependency(const OffscreenGraphicsLayer& source);
+		bool DependsOn(const OffscreenGraphicsLayer& source) const;
+
 		const Math::FloatBoundary& GetViewport() const override;
 
 		void PushState() override;
@@ -69,6 +122,8 @@ export namespace DGL
 		void SetImageTint(Renderer::Color tint) override;
 		void SetImageAlpha(uint8_t alpha) override;
 		void SetImageOpacity(float opacity) override;
+		void SetImageFilterMode(Texture::TextureFilterMode filterMode) override;
+		void SetImageAnisotropy(float anisotropy) override;
 
 		void Background(Renderer::Color color) override;
 		void Rect(float x1, float y1, float x2, float y2) override;
@@ -77,17 +132,42 @@ export namespace DGL
 		void Line(float x1, float y1, float x2, float y2) override;
 		void Triangle(float x1, float y1, float x2, float y2, float x3, float y3) override;
 		void Image(const Texture::Texture& texture, float x1, float y1, float x2, float y2) override;
+		void Image(const Texture::TextureRegion& region, float x1, float y1, float x2, float y2) override;
+		void Image(const Texture::Texture& texture, const Sprite& sprite) override;
+		void Image(const Texture::Texture& texture, std::span<const Sprite> sprites) override;
+
+		void ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback) override;
+		std::future<Renderer::PixelData> ReadPixelsAsync(const Math::UintBoundary& region) override;
+		void ViewPixelsAsync(const Math::UintBoundary& region, Renderer::PixelViewCallback callback) override;
+
+		PixelBuffer& LoadPixels() override;
+		void UpdatePixels() override;
+		void ApplyFilters(std::span<const Brushes::Filter> filters) override;
 
 	private:
 
 		explicit OffscreenGraphicsLayer(
 			Math::Uint2 viewportSize,
 			RendererFacade& renderer,
-			Blending::BlendModeActivator& blendModeActivator
+			Renderer::RenderTargetAttachments attachments
 		);
 
-		std::unique_ptr<Renderer::OffscreenRenderTarget> m_RenderTarget;
+		struct Dependency
+		{
+			const OffscreenGraphicsLayer* Source;
+			uint64_t ContentVersion;	//!< The version of the source when this layer got validated
+		};
+
+		RendererFacade* m_Renderer;
+		RHI::RenderTargetHandle m_RenderTarget;
 		BaseGraphicsLayer m_GraphicsLayerImpl;
 
+		std::unique_ptr<RHI::RecordingDevice> m_RecordingDevice;	//!< Records the draw calls between BeginRecording() and SubmitRecording()
+		std::unique_ptr<RendererFacade> m_RecordingRenderer;		//!< Tessellates the recorded draw calls on the recording thread
+		bool m_IsRecording;
+
+		bool m_IsValid;
+		std::vector<Dependency> m_Dependencies;
+
 	};
 }
\ No newline at end of file
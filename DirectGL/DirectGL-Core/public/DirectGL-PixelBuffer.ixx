@@ -0,0 +1,89 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-PixelBuffer.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module DirectGL:PixelBuffer;
+
+import DirectGL.Math;
+import DirectGL.Renderer;
+
+export namespace DGL
+{
+	/// The pixels of a graphics layer in system memory, obtained by GraphicsLayer::LoadPixels().
+	/// Pixels are tightly packed RGBA8, starting with the top row. Every write marks the rows it
+	/// touches as dirty, so GraphicsLayer::UpdatePixels() only has to upload the modified band.
+	///
+	/// The bulk operations process four pixels per instruction where SSE2 is available and split
+	/// large buffers into bands of rows that get processed on multiple threads.
+	class PixelBuffer
+	{
+	public:
+
+		PixelBuffer();
+
+		/// @brief Replace the pixels, e.g. by those read back from a layer. Nothing is dirty afterwards.
+		/// @param size The size of the pixels.
+		/// @param pixels The tightly packed RGBA8 pixels, starting with the top row.
+		void Reset(Math::Uint2 size, std::vector<uint8_t> pixels);
+
+		Math::Uint2 GetSize() const;
+
+		/// @return The size of a row in bytes.
+		size_t GetStride() const;
+
+		/// @brief Get the pixels for writing. Marks every row as dirty.
+		std::span<uint8_t> GetPixels();
+		std::span<const uint8_t> GetPixels() const;
+
+		/// @brief Get a row for writing. Marks the row as dirty.
+		/// @param row The row, counted from the top.
+		std::span<uint8_t> GetRow(uint32_t row);
+		std::span<const uint8_t> GetRow(uint32_t row) const;
+
+		Renderer::Color GetPixel(uint32_t x, uint32_t y) const;
+		void SetPixel(uint32_t x, uint32_t y, Renderer::Color color);
+
+		/// @brief Set every pixel to the same color.
+		void Fill(Renderer::Color color);
+
+		/// @brief Blend an image over the pixels, like GraphicsLayer::Image() does with the default blend mode.
+		/// @param pixels The tightly packed RGBA8 pixels of the image, starting with the top row.
+		/// @param size The size of the image.
+		/// @param position The top-left corner of the image. Parts outside the buffer are clipped.
+		/// @param tint The color every pixel of the image gets multiplied with, including its alpha.
+		void Blend(std::span<const uint8_t> pixels, Math::Uint2 size, Math::Int2 position, Renderer::Color tint = Renderer::Color());
+
+		/// @brief Turn pixels white if their luminance reaches the threshold and black otherwise. Alpha is preserved.
+		void Threshold(uint8_t threshold);
+
+		/// @brief Convolve the pixels with a square kernel, e.g. to blur or sharpen them. Edges are clamped.
+		/// @param kernel The weights of the kernel, row by row.
+		/// @param kernelSize The width and height of the kernel. Must be odd.
+		void Convolve(std::span<const float> kernel, uint32_t kernelSize);
+
+		/// @return Whether any row has been written since the last call to Reset() or ClearDirtyRows().
+		bool IsDirty() const;
+		uint32_t GetFirstDirtyRow() const;
+		uint32_t GetDirtyRowCount() const;
+		void ClearDirtyRows();
+
+	private:
+
+		void MarkDirty(uint32_t firstRow, uint32_t rowCount);
+
+		Math::Uint2 m_Size;
+		std::vector<uint8_t> m_Pixels;
+		std::vector<uint8_t> m_Scratch;		//!< The destination of convolutions, kept to avoid reallocating it
+
+		uint32_t m_DirtyBegin;
+		uint32_t m_DirtyEnd;
+
+	};
+}
\ No newline at end of file
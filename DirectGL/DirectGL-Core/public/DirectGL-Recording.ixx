@@ -0,0 +1,46 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-Recording.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+export module DirectGL:Recording;
+
+import DirectGL.Texture;
+
+export namespace DGL
+{
+	enum class RecordingOverflowPolicy
+	{
+		DropFrames,	//!< Skip frames while the encoders are busy, rendering keeps its speed
+		Block,		//!< Wait for the encoders, every frame gets recorded but rendering slows down
+	};
+
+	struct RecordingSettings
+	{
+		std::filesystem::path Directory = "Recording";					//!< The directory the frames are written to. It gets created if needed
+		std::string FilePrefix = "Frame";								//!< The file name of each frame is the prefix followed by the frame number
+		Texture::ImageFileFormat Format = Texture::ImageFileFormat::Qoi;	//!< The file format of the frames
+		uint32_t FrameInterval = 1;										//!< Record every Nth presented frame
+		size_t QueueCapacity = 8;										//!< The number of frames that may wait for their encoding
+		RecordingOverflowPolicy OverflowPolicy = RecordingOverflowPolicy::DropFrames;	//!< What happens when the queue is full
+	};
+
+	struct RecordingStatistics
+	{
+		uint64_t CapturedFrames = 0;				//!< The frames read back from the window
+		uint64_t EncodedFrames = 0;					//!< The frames written to disk
+		uint64_t DroppedFrames = 0;					//!< The frames skipped because the queue was full
+		uint64_t FailedFrames = 0;					//!< The frames that couldn't be written
+		uint64_t WrittenBytes = 0;					//!< The size of the written files
+		size_t QueuedFrames = 0;					//!< The frames being read back or waiting for their encoding
+		double EncodedFramesPerSecond = 0.0;		//!< The encoder throughput since the recording started
+		std::chrono::microseconds AverageEncodeTime = {};	//!< The time a worker needs to encode and write a frame
+	};
+}
\ No newline at end of file
@@ -10,6 +10,7 @@ export module DirectGL:RenderState;
 import DirectGL.Renderer;
 import DirectGL.Blending;
 import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
 
 import :TransformationStack;
 import :DrawMode;
@@ -27,6 +28,8 @@ export namespace DGL
 
 		Renderer::Color ImageTint;
 		uint8_t ImageAlpha;
+		Texture::TextureFilterMode ImageFilterMode;
+		float ImageAnisotropy;
 
 		Blending::BlendMode BlendMode;
 		RectMode ImageMode;
@@ -50,6 +53,8 @@ namespace DGL
 		StrokeColor(255, 255, 255),
 		StrokeWeight(1.0f),
 		ImageAlpha(255),
+		ImageFilterMode(Texture::TextureFilterMode::Linear),
+		ImageAnisotropy(1.0f),
 		IsFillEnabled(true),
 		IsStrokeEnabled(true),
 		BlendMode(Blending::BlendModes::Alpha),
@@ -0,0 +1,13 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-RenderThread.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL:RenderThread;
+
+import DirectGL.RHI;
+
+export namespace DGL
+{
+	using RenderThreadStatistics = RHI::RenderThreadStatistics;
+}
\ No newline at end of file
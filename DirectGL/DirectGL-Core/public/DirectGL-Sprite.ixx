@@ -0,0 +1,25 @@
+﻿// Project Name : DirectGL-Core
+// File Name    : DirectGL-Sprite.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL:Sprite;
+
+import DirectGL.Math;
+import DirectGL.Renderer;
+
+export namespace DGL
+{
+	/// A sprite describes a single instance of a texture drawn by
+	/// GraphicsLayer::Image(). Unlike the other Image() overloads the
+	/// sprite carries its own tint and is not affected by the image mode,
+	/// which makes it suitable for sprite sheets and tile maps.
+	struct Sprite
+	{
+		Math::FloatBoundary Source;									//!< The region of the texture in pixels. An empty region selects the whole texture
+		Math::FloatBoundary Destination;							//!< The region of the layer the sprite gets drawn to
+		Math::Float2 Origin = { 0.0f, 0.0f };						//!< The rotation origin, relative to the top-left corner of the destination
+		Math::Angle Rotation = Math::Angle::Zero;					//!< The rotation around the origin
+		Renderer::Color Tint = Renderer::Colors::White;				//!< The color every texel gets multiplied with, including the alpha
+	};
+}
\ No newline at end of file
@@ -5,6 +5,10 @@ module;
 #include <string>
 #include <string_view>
 #include <chrono>
+#include <filesystem>
+#include <future>
+#include <span>
+#include <vector>
 
 export module DirectGL;
 
@@ -29,6 +33,11 @@ import DirectGL.Renderer;
 import DirectGL.ShapeRenderer;
 import DirectGL.TextureRenderer;
 import DirectGL.Blending;
+import DirectGL.Brushes;
+import DirectGL.Texture;
+import DirectGL.RHI;
+import System.Context;
+import Jobs;
 
 /////////////////////////////// - IMPORTS - ///////////////////////////////
 ///																		///
@@ -107,10 +116,19 @@ export namespace DGL
 
 export import :BlendMode;
 export import :Color;
+export import :CommandCapture;
 export import :DrawMode;
+export import :Filter;
+export import :FrameOutput;
+export import :FramePacing;
 export import :GraphicsLayer;
+export import :Jobs;
 export import :OffscreenGraphicsLayer;
+export import :PixelBuffer;
+export import :Recording;
+export import :RenderThread;
 export import :RenderState;
+export import :Sprite;
 export import :Texture;
 
 export namespace DGL
@@ -119,7 +137,11 @@ export namespace DGL
 	void NoLoop();
 	void ToggleLoop();
 	bool IsLooping();
-	void Redraw();
+	void Redraw();																					//!< Draw the next frame while not looping. May be called from any thread, it wakes up the idle main loop
+
+	void SetFrameRate(float framesPerSecond);														//!< Cap the frames drawn per second, zero draws them as fast as possible
+	float GetFrameRate();																			//!< Get the frame rate the loop is capped at, zero if it isn't
+	FrameTimingStatistics GetFrameTimingStatistics();												//!< Get the measured frame rate and the time spent drawing, sleeping and idling
 
 	void PushState();
 	void PopState();
@@ -129,8 +151,44 @@ export namespace DGL
 	void PopLayer();
 	GraphicsLayer& PeekLayer();
 
-	std::unique_ptr<GraphicsLayer> CreateGraphics(uint32_t width, uint32_t height);
+	std::unique_ptr<GraphicsLayer> CreateGraphics(uint32_t width, uint32_t height, Renderer::RenderTargetAttachments attachments = Renderer::RenderTargetAttachments::ColorDepthStencil);
+	bool DrawCached(GraphicsLayer& layer, const std::function<void()>& draw);	//!< Push an offscreen layer and draw it only if it is stale, see OffscreenGraphicsLayer::IsStale(). Returns whether it was drawn
+	void RecordLayers(std::span<GraphicsLayer* const> layers, const std::function<void(GraphicsLayer&)>& record);	//!< Draw offscreen layers on worker threads, each into a command list of its own, and submit them in dependency order. The drawing functions target the layer of the calling thread, layers can't be pushed meanwhile
+
+	std::shared_ptr<Texture::AsyncTexture> LoadTextureAsync(const std::filesystem::path& path, const Texture::TextureLoadSettings& settings = {});	//!< Decode an image in the background. The texture becomes ready after its upload on a later frame
+	void SetTextureUploadBudget(std::chrono::microseconds budget);									//!< Set the time per frame that may be spent uploading textures loaded via LoadTextureAsync
+	std::shared_ptr<Texture::CachedTexture> AcquireTexture(const std::filesystem::path& path, const Texture::TextureLoadSettings& settings = {});	//!< Get a cached texture, shared by every caller using the same file. Call Use() on it each frame it gets drawn
+	void SetTextureMemoryBudget(size_t budget);														//!< Set the video memory in bytes the cached textures may occupy before they get evicted
+	Texture::TextureCacheStatistics GetTextureCacheStatistics();									//!< Get the residency of the cached textures
+	Texture::TextureMemoryStatistics GetTextureMemoryStatistics();									//!< Get the live video memory per category
 	const Math::FloatBoundary& GetViewport();
+	void ReadPixelsAsync(const Math::UintBoundary& region, Renderer::PixelCallback callback);		//!< Copy a region of the active layer without stalling. The callback runs one or two frames later
+	std::future<Renderer::PixelData> ReadPixelsAsync(const Math::UintBoundary& region);			//!< Copy a region of the active layer without stalling. The future becomes ready one or two frames later
+	PixelBuffer& LoadPixels();																		//!< Read the pixels of the active layer into system memory, waiting for the GPU
+	void UpdatePixels();																			//!< Write the modified rows of the pixel buffer back to the active layer
+	void ApplyFilters(std::span<const Filter> filters);											//!< Run post-processing filters over everything drawn to the active layer so far
+	void ApplyFilter(const Filter& filter);															//!< Run a single post-processing filter over everything drawn to the active layer so far
+	std::span<const FilterTiming> GetFilterTimings();												//!< Get the GPU time of every filter of the latest chain whose measurements are available, usually a few frames old
+	bool StartRecording(const RecordingSettings& settings = {});										//!< Write every presented frame into an image sequence
+	void StopRecording();																			//!< Stop recording, the captured frames are still written in the background
+	bool IsRecording();																				//!< Get whether the presented frames are being recorded
+	RecordingStatistics GetRecordingStatistics();													//!< Get the encoder throughput and the dropped frames of the current recording
+	bool OpenFrameOutput(std::string_view name, uint32_t slotCount = 4);							//!< Publish every presented frame into a shared memory ring for another process. Frames larger than the window at this point are skipped
+	void CloseFrameOutput();																		//!< Stop publishing frames and remove the shared memory ring
+	FrameOutputStatistics GetFrameOutputStatistics();												//!< Get the number of published frames
+	Renderer::RenderTargetPoolStatistics GetRenderTargetPoolStatistics();							//!< Get the hit rate and the memory held by the pool recycling the targets of offscreen layers
+	bool StartCommandCapture(const CommandCaptureSettings& settings = {});							//!< Record the backend commands of every following frame, while still drawing them
+	std::vector<CommandList> StopCommandCapture();													//!< Stop capturing commands and get the frames kept so far. The frame being drawn isn't part of it
+	bool IsCapturingCommands();																		//!< Get whether the backend commands are being captured
+	CommandStatistics GetCommandCaptureStatistics();												//!< Get the draw calls, state changes and uploaded bytes of every frame captured so far
+	void ReplayCommands(CommandList commands);														//!< Draw captured commands on top of the current frame once the sketch finished drawing it. Their readbacks get delivered again
+	void UseRenderThread(uint32_t maxFramesInFlight = 2);											//!< Submit and present every frame on a render thread while the next one gets drawn. Takes effect once called from Sketch::Setup()
+	bool IsRenderThreadRunning();																	//!< Get whether the frames are submitted on a render thread
+	RenderThreadStatistics GetRenderThreadStatistics();												//!< Get the frame time of the render thread and the time drawing waited for it
+	void UseSoftwareRenderer();																		//!< Rasterise the frames on the CPU using the worker threads. Takes effect once called from the constructor of the sketch, offscreen layers can't be drawn as textures and filters are skipped
+	bool IsSoftwareRendererRunning();																//!< Get whether the frames are rasterised on the CPU
+	JobSystem& GetJobSystem();																		//!< Get the worker threads shared by the library and the sketch. Jobs with main thread affinity run once per frame, before Draw()
+	JobStatistics GetJobStatistics();																//!< Get the jobs every worker ran and stole and the time it spent idle
 
 	void PushTransform();
 	void PopTransform();
@@ -158,6 +216,8 @@ export namespace DGL
 	void SetImageTint(Renderer::Color tint);
 	void SetImageAlpha(uint8_t alpha);
 	void SetImageOpacity(float opacity);
+	void SetImageFilterMode(Texture::TextureFilterMode filterMode);
+	void SetImageAnisotropy(float anisotropy);
 
 	void Background(Renderer::Color color);
 	void Rect(float x1, float y1, float x2, float y2);
@@ -168,6 +228,9 @@ export namespace DGL
 	void Line(float x1, float y1, float x2, float y2);
 	void Triangle(float x1, float y1, float x2, float y2, float x3, float y3);
 	void Image(const Texture::Texture& texture, float x1, float y1, float x2, float y2);
+	void Image(const Texture::TextureRegion& region, float x1, float y1, float x2, float y2);
+	void Image(const Texture::Texture& texture, const Sprite& sprite);
+	void Image(const Texture::Texture& texture, std::span<const Sprite> sprites);
 }
 
 //////////////////////////////// - Non-API - //////////////////////////////
@@ -192,6 +255,8 @@ import :InputListener;
 import :MainGraphicsLayer;
 import :RendererFacade;
 import :DepthProvider;
+import :FrameRecorder;
+import :FrameScheduler;
 
 enum struct ExitType
 {
@@ -212,12 +277,39 @@ struct DirectGLLibrary
 
 	std::unique_ptr<DGL::Blending::BlendModeActivator> BlendModeActivator;
 
+	std::unique_ptr<Jobs::JobSystem>						JobSystem;				//!< The worker threads shared by the library and the sketch
+
 	std::unique_ptr<DGL::ShapeRenderer::ShapeFactory>		ShapeFactory;			//!< The shape factory to use
 	std::unique_ptr<DGL::ShapeRenderer::ShapeRenderer>		ShapeRenderer;			//!< The shape renderer to use for primitive drawing
 	std::unique_ptr<DGL::TextureRenderer::TextureRenderer>	TextureRenderer;		//!< The texture renderer to use for textured drawing
+	std::unique_ptr<DGL::Renderer::PixelReadback>			PixelReadback;			//!< The readback queue shared by every graphics layer
+	std::unique_ptr<DGL::Renderer::PixelWriter>				PixelWriter;			//!< Writes pixel buffers back to the graphics layers
+	std::unique_ptr<DGL::Texture::SamplerCache>				SamplerCache;			//!< The samplers shared by every graphics layer
+	std::unique_ptr<DGL::Renderer::RenderTargetPool>		RenderTargetPool;		//!< Recycles the render targets of offscreen layers
+	std::unique_ptr<DGL::Brushes::FilterChain>				FilterChain;			//!< Runs the post-processing filters of every graphics layer
+	std::unique_ptr<DGL::RHI::RenderDevice>					RenderDevice;			//!< The backend every graphics layer draws through
+	std::unique_ptr<DGL::RHI::RecordingDevice>				RecordingDevice;		//!< Records the commands of the graphics layers while capturing, on top of the render device
+	std::unique_ptr<DGL::RHI::ThreadedDevice>				ThreadedDevice;			//!< Runs the render device on a render thread of its own, if requested
+	DGL::RHI::SoftwareDevice*								SoftwareDevice = nullptr;	//!< The render device, if it rasterises on the CPU
+	std::unique_ptr<System::Context>						UploadContext;			//!< Shares its objects with the context of the render thread, so the main thread can keep creating textures
 	std::unique_ptr<DGL::RendererFacade> 					RendererFacade;			//!< The renderer facade to use for rendering
 	std::unique_ptr<DGL::MainGraphicsLayer>					MainGraphicsLayer;		//!< The main graphics layer to use for rendering
 	std::unique_ptr<DGL::GraphicsLayerStack>				GraphicsLayerStack;		//!< The graphics layer stack to use for managing graphics layers
+	std::unique_ptr<DGL::Texture::TextureLoader>			TextureLoader;			//!< The loader decoding textures in the background
+	std::unique_ptr<DGL::Texture::TextureCache>				TextureCache;			//!< The cache deduplicating and evicting textures loaded from files
+	std::unique_ptr<DGL::FrameRecorder>						FrameRecorder;			//!< The recorder writing presented frames to disk
+	std::unique_ptr<DGL::FrameOutput>						FrameOutput;			//!< The shared memory ring presented frames are published to, if opened
+	std::unique_ptr<DGL::FrameScheduler>					FrameScheduler;			//!< Paces the main loop and lets it sleep while the sketch doesn't loop
+
+	std::chrono::microseconds	TextureUploadBudget = std::chrono::milliseconds(2);	//!< The time per frame that may be spent uploading textures
+
+	DGL::CommandCaptureSettings				CommandCaptureSettings;		//!< The settings of the running command capture
+	bool									IsCapturingCommands = false;	//!< Whether the frames get drawn through the recording device
+	std::vector<DGL::RHI::CommandList>		CapturedCommands;			//!< The commands of the frames kept by the running command capture
+	DGL::RHI::CommandStatistics				CommandStatistics;			//!< The statistics of every frame of the running command capture
+	std::vector<DGL::RHI::CommandList>		PendingReplays;				//!< The commands to draw on top of the current frame
+	uint32_t								RenderThreadFrames = 0;		//!< The frames in flight requested by UseRenderThread(), zero renders on the main thread
+	bool									IsSoftwareRendererRequested = false;	//!< Whether UseSoftwareRenderer() has been called
 
 	ExitType		ExitType = ExitType::Quit;		//!< The exit code to return on application shutdown
 	int				ExitCode = 0;					//!< The return code to return on application shutdown
@@ -0,0 +1,42 @@
+project("DirectGL-RHI")
+	kind("StaticLib")
+	language("C++")
+	cppdialect("C++23")
+	targetdir("%{wks.location}/build/bin/" .. OutputDir .. "/%{prj.name}")
+	objdir("%{wks.location}/build/bin-int/" .. OutputDir .. "/%{prj.name}")
+
+	files({
+		"private/**.cpp",
+		"public/**.ixx",
+	})
+
+	links({
+		"DirectGL-Blending",
+		"DirectGL-Brushes",
+		"DirectGL-Logging",
+		"DirectGL-Math",
+		"DirectGL-Renderer",
+		"DirectGL-ShapeRenderer",
+		"DirectGL-SoftwareRenderer",
+		"DirectGL-Texture",
+		"DirectGL-TextureRenderer",
+
+		"Glad",
+		"Jobs",
+		"Preconditions",
+	})
+
+	includedirs({
+		"%{wks.location}/Libraries/Glad/include",
+	})
+
+	filter("system:windows")
+		systemversion("latest")
+
+	filter("configurations:Debug")
+		runtime("Debug")
+		symbols("On")
+
+	filter("configurations:Release")
+		runtime("Release")
+		optimize("On")
\ No newline at end of file
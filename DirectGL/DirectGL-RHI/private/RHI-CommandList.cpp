@@ -0,0 +1,496 @@
+﻿module;
+
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+module DirectGL.RHI;
+
+namespace DGL::RHI
+{
+	namespace
+	{
+		/// The low byte of a header holds the CommandType, the remaining bits a small
+		/// value of the command, like the number of sprites of a DrawSprites command.
+		constexpr uint32_t CommandTypeBits = 8;
+		constexpr uint32_t CommandTypeMask = (1u << CommandTypeBits) - 1;
+		constexpr uint32_t MaxHeaderValue = (1u << (32 - CommandTypeBits)) - 1;
+
+		constexpr size_t GetWordCount(const size_t byteCount)
+		{
+			return (byteCount + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+		}
+
+		template <typename T>
+		T Read(const std::vector<uint32_t>& words, size_t& word)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			T value;
+			std::memcpy(&value, words.data() + word, sizeof(T));
+			word += GetWordCount(sizeof(T));
+			return value;
+		}
+
+		void Count(CommandStatistics& statistics, const CommandType type)
+		{
+			++statistics.Calls[static_cast<size_t>(type)];
+		}
+	}
+
+	uint64_t CommandStatistics::GetCallCount() const
+	{
+		return std::accumulate(Calls.begin(), Calls.end(), uint64_t(0));
+	}
+
+	uint64_t CommandStatistics::GetCallCount(const CommandType type) const
+	{
+		return Calls[static_cast<size_t>(type)];
+	}
+
+	CommandStatistics& CommandStatistics::operator += (const CommandStatistics& other)
+	{
+		for (size_t i = 0; i < Calls.size(); ++i)
+		{
+			Calls[i] += other.Calls[i];
+		}
+
+		PassChanges += other.PassChanges;
+		PipelineChanges += other.PipelineChanges;
+		ConstantChanges += other.ConstantChanges;
+		Vertices += other.Vertices;
+		Indices += other.Indices;
+		Sprites += other.Sprites;
+		UploadedBytes += other.UploadedBytes;
+		return *this;
+	}
+
+	void CommandList::BeginPass(const RenderTargetHandle renderTarget, const PassTarget target)
+	{
+		Count(m_Statistics, CommandType::BeginPass);
+		++m_Statistics.PassChanges;
+
+		// Every backend rebinds its pipeline when the pass changes
+		ResetState();
+
+		WriteHeader(CommandType::BeginPass, static_cast<uint32_t>(target));
+		Write(renderTarget.Id);
+	}
+
+	void CommandList::SetPipeline(const PipelineDescription& description)
+	{
+		Count(m_Statistics, CommandType::SetPipeline);
+		if (m_Pipeline == description)
+		{
+			return;
+		}
+
+		++m_Statistics.PipelineChanges;
+		m_Pipeline = description;
+
+		// The constants belong to the pipeline they were set for
+		m_Constants.reset();
+
+		WriteHeader(CommandType::SetPipeline);
+		Write(description);
+	}
+
+	void CommandList::SetConstants(const DrawConstants& constants)
+	{
+		Count(m_Statistics, CommandType::SetConstants);
+		if (m_Constants.has_value() and std::memcmp(&*m_Constants, &constants, sizeof(DrawConstants)) == 0)
+		{
+			return;
+		}
+
+		++m_Statistics.ConstantChanges;
+		m_Statistics.UploadedBytes += sizeof(DrawConstants);
+		m_Constants = constants;
+
+		WriteHeader(CommandType::SetConstants);
+		Write(constants);
+	}
+
+	void CommandList::DrawVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices, const ShapeRenderer::PrimitiveType type)
+	{
+		Count(m_Statistics, CommandType::DrawVertices);
+		m_Statistics.Vertices += positions.size();
+		m_Statistics.Indices += indices.size();
+		m_Statistics.UploadedBytes += positions.size_bytes() + indices.size_bytes();
+
+		WriteHeader(CommandType::DrawVertices, static_cast<uint32_t>(type));
+		WriteVertices(positions, indices);
+	}
+
+	void CommandList::UploadVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices)
+	{
+		Count(m_Statistics, CommandType::UploadVertices);
+		m_Statistics.Vertices += positions.size();
+		m_Statistics.Indices += indices.size();
+		m_Statistics.UploadedBytes += positions.size_bytes() + indices.size_bytes();
+
+		WriteHeader(CommandType::UploadVertices);
+		WriteVertices(positions, indices);
+	}
+
+	void CommandList::DrawVertexRange(const VertexRange& range)
+	{
+		Count(m_Statistics, CommandType::DrawVertexRange);
+
+		WriteHeader(CommandType::DrawVertexRange);
+		Write(range);
+	}
+
+	void CommandList::DrawSprite(const TextureHandle texture, const TextureRenderer::SpriteInstance& sprite)
+	{
+		Count(m_Statistics, CommandType::DrawSprites);
+		++m_Statistics.Sprites;
+		m_Statistics.UploadedBytes += sizeof(TextureRenderer::SpriteInstance);
+
+		// Consecutive sprites share a header, which counts them
+		if (m_SpriteRun.has_value() and (m_Words[*m_SpriteRun] >> CommandTypeBits) < MaxHeaderValue)
+		{
+			m_Words[*m_SpriteRun] += 1u << CommandTypeBits;
+		}
+		else
+		{
+			WriteHeader(CommandType::DrawSprites, 1);
+			m_SpriteRun = m_Words.size() - 1;
+		}
+
+		Write(texture.Id);
+		Write(sprite);
+	}
+
+	void CommandList::FlushSprites()
+	{
+		Count(m_Statistics, CommandType::FlushSprites);
+		WriteHeader(CommandType::FlushSprites);
+	}
+
+	void CommandList::ReadPixelsAsync(const RenderTargetHandle renderTarget, const PassTarget target, const Math::UintBoundary& region, Renderer::PixelCallback callback)
+	{
+		Count(m_Statistics, CommandType::ReadPixels);
+
+		WriteHeader(CommandType::ReadPixels, static_cast<uint32_t>(target));
+		Write(renderTarget.Id);
+		Write(region);
+		Write(static_cast<uint32_t>(m_PixelCallbacks.size()));
+		m_PixelCallbacks.push_back(std::move(callback));
+	}
+
+	void CommandList::ViewPixelsAsync(const RenderTargetHandle renderTarget, const PassTarget target, const Math::UintBoundary& region, Renderer::PixelViewCallback callback)
+	{
+		Count(m_Statistics, CommandType::ViewPixels);
+
+		WriteHeader(CommandType::ViewPixels, static_cast<uint32_t>(target));
+		Write(renderTarget.Id);
+		Write(region);
+		Write(static_cast<uint32_t>(m_ViewCallbacks.size()));
+		m_ViewCallbacks.push_back(std::move(callback));
+	}
+
+	void CommandList::WritePixels(const RenderTargetHandle renderTarget, const PassTarget target, const uint32_t width, const uint8_t* pixels, const uint32_t firstRow, const uint32_t rowCount)
+	{
+		Count(m_Statistics, CommandType::WritePixels);
+
+		const size_t byteCount = size_t(width) * rowCount * 4;
+		m_Statistics.UploadedBytes += byteCount;
+
+		// Writing pixels may change the state of the backend behind our back
+		ResetState();
+
+		WriteHeader(CommandType::WritePixels, static_cast<uint32_t>(target));
+		Write(renderTarget.Id);
+		Write(width);
+		Write(firstRow);
+		Write(rowCount);
+
+		const size_t first = m_Words.size();
+		m_Words.resize(first + GetWordCount(byteCount));
+		std::memcpy(m_Words.data() + first, pixels + size_t(width) * firstRow * 4, byteCount);
+	}
+
+	void CommandList::ApplyFilters(const RenderTargetHandle renderTarget, const PassTarget target, const std::span<const Brushes::Filter> filters)
+	{
+		Count(m_Statistics, CommandType::ApplyFilters);
+		m_Statistics.UploadedBytes += filters.size_bytes();
+
+		// The filter passes use their own pipelines and framebuffers
+		ResetState();
+
+		WriteHeader(CommandType::ApplyFilters, static_cast<uint32_t>(target));
+		Write(renderTarget.Id);
+		Write(static_cast<uint32_t>(filters.size()));
+
+		for (const Brushes::Filter& filter : filters)
+		{
+			Write(filter);
+		}
+	}
+
+	void CommandList::Replay(RenderDevice& device, const size_t firstByte) const
+	{
+		const auto resolve = [&device](const PassTarget target, const uint32_t id) -> RenderTargetHandle
+		{
+			return target == PassTarget::Default ? device.GetDefaultRenderTarget() : RenderTargetHandle{ id };
+		};
+
+		// Commands of a pass whose render target only existed while recording have nowhere to go
+		bool skipPass = false;
+
+		size_t word = firstByte / sizeof(uint32_t);
+		while (word < m_Words.size())
+		{
+			const uint32_t header = m_Words[word++];
+			const auto type = static_cast<CommandType>(header & CommandTypeMask);
+			const uint32_t value = header >> CommandTypeBits;
+
+			switch (type)
+			{
+				case CommandType::BeginPass:
+				{
+					const auto target = static_cast<PassTarget>(value);
+					const auto id = Read<uint32_t>(m_Words, word);
+
+					skipPass = target == PassTarget::Emulated;
+					if (not skipPass)
+					{
+						device.BeginPass(resolve(target, id));
+					}
+					break;
+				}
+
+				case CommandType::SetPipeline:
+				{
+					const auto description = Read<PipelineDescription>(m_Words, word);
+					if (not skipPass)
+					{
+						device.SetPipeline(device.GetPipeline(description));
+					}
+					break;
+				}
+
+				case CommandType::SetConstants:
+				{
+					const auto constants = Read<DrawConstants>(m_Words, word);
+					if (not skipPass)
+					{
+						device.SetConstants(constants);
+					}
+					break;
+				}
+
+				case CommandType::DrawVertices:
+				{
+					const auto [positions, indices] = ReadVertices(word);
+
+					if (not skipPass)
+					{
+						device.DrawVertices(positions, indices, static_cast<ShapeRenderer::PrimitiveType>(value));
+					}
+					break;
+				}
+
+				case CommandType::UploadVertices:
+				{
+					const auto [positions, indices] = ReadVertices(word);
+
+					if (not skipPass)
+					{
+						device.UploadVertices(positions, indices);
+					}
+					break;
+				}
+
+				case CommandType::DrawVertexRange:
+				{
+					const auto range = Read<VertexRange>(m_Words, word);
+					if (not skipPass)
+					{
+						device.DrawVertexRange(range);
+					}
+					break;
+				}
+
+				case CommandType::DrawSprites:
+				{
+					for (uint32_t i = 0; i < value; ++i)
+					{
+						const auto texture = Read<uint32_t>(m_Words, word);
+						const auto sprite = Read<TextureRenderer::SpriteInstance>(m_Words, word);
+
+						if (not skipPass)
+						{
+							device.DrawSprite({ texture }, sprite);
+						}
+					}
+					break;
+				}
+
+				case CommandType::FlushSprites:
+				{
+					if (not skipPass)
+					{
+						device.FlushSprites();
+					}
+					break;
+				}
+
+				case CommandType::ReadPixels:
+				{
+					const auto target = static_cast<PassTarget>(value);
+					const auto id = Read<uint32_t>(m_Words, word);
+					const auto region = Read<Math::UintBoundary>(m_Words, word);
+					const auto callback = Read<uint32_t>(m_Words, word);
+
+					if (target != PassTarget::Emulated)
+					{
+						device.ReadPixelsAsync(resolve(target, id), region, m_PixelCallbacks[callback]);
+					}
+					break;
+				}
+
+				case CommandType::ViewPixels:
+				{
+					const auto target = static_cast<PassTarget>(value);
+					const auto id = Read<uint32_t>(m_Words, word);
+					const auto region = Read<Math::UintBoundary>(m_Words, word);
+					const auto callback = Read<uint32_t>(m_Words, word);
+
+					if (target != PassTarget::Emulated)
+					{
+						device.ViewPixelsAsync(resolve(target, id), region, m_ViewCallbacks[callback]);
+					}
+					break;
+				}
+
+				case CommandType::WritePixels:
+				{
+					const auto target = static_cast<PassTarget>(value);
+					const auto id = Read<uint32_t>(m_Words, word);
+					const auto width = Read<uint32_t>(m_Words, word);
+					const auto firstRow = Read<uint32_t>(m_Words, word);
+					const auto rowCount = Read<uint32_t>(m_Words, word);
+
+					const size_t rowBytes = size_t(width) * 4;
+					const auto band = std::bit_cast<const uint8_t*>(m_Words.data() + word);
+					word += GetWordCount(rowBytes * rowCount);
+
+					if (target != PassTarget::Emulated)
+					{
+						// The device expects the pixels of the whole target, of which only the band gets read
+						std::vector<uint8_t> pixels(rowBytes * (firstRow + rowCount));
+						std::memcpy(pixels.data() + rowBytes * firstRow, band, rowBytes * rowCount);
+						device.WritePixels(resolve(target, id), pixels.data(), firstRow, rowCount);
+					}
+					break;
+				}
+
+				case CommandType::ApplyFilters:
+				{
+					const auto target = static_cast<PassTarget>(value);
+					const auto id = Read<uint32_t>(m_Words, word);
+					const auto count = Read<uint32_t>(m_Words, word);
+
+					std::vector<Brushes::Filter> filters;
+					filters.reserve(count);
+
+					for (uint32_t i = 0; i < count; ++i)
+					{
+						filters.push_back(Read<Brushes::Filter>(m_Words, word));
+					}
+
+					if (target != PassTarget::Emulated)
+					{
+						device.ApplyFilters(resolve(target, id), filters);
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	size_t CommandList::Mark()
+	{
+		// Sprites recorded after the mark must not be appended to a command before it
+		m_SpriteRun.reset();
+		return GetByteSize();
+	}
+
+	void CommandList::Clear()
+	{
+		m_Words.clear();
+		m_PixelCallbacks.clear();
+		m_ViewCallbacks.clear();
+		m_Statistics = {};
+		ResetState();
+	}
+
+	bool CommandList::IsEmpty() const
+	{
+		return m_Words.empty();
+	}
+
+	size_t CommandList::GetByteSize() const
+	{
+		return m_Words.size() * sizeof(uint32_t);
+	}
+
+	const CommandStatistics& CommandList::GetStatistics() const
+	{
+		return m_Statistics;
+	}
+
+	template <typename T>
+	void CommandList::Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		const size_t first = m_Words.size();
+		m_Words.resize(first + GetWordCount(sizeof(T)));
+		std::memcpy(m_Words.data() + first, &value, sizeof(T));
+	}
+
+	void CommandList::WriteHeader(const CommandType type, const uint32_t value)
+	{
+		// Any command in between ends the current run of sprites
+		m_SpriteRun.reset();
+		m_Words.push_back(static_cast<uint32_t>(type) | (value << CommandTypeBits));
+	}
+
+	void CommandList::WriteVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices)
+	{
+		Write(static_cast<uint32_t>(positions.size()));
+		Write(static_cast<uint32_t>(indices.size()));
+
+		static_assert(sizeof(Math::Float3) % sizeof(uint32_t) == 0);
+		const size_t first = m_Words.size();
+		m_Words.resize(first + GetWordCount(positions.size_bytes()) + indices.size());
+		std::memcpy(m_Words.data() + first, positions.data(), positions.size_bytes());
+		std::memcpy(m_Words.data() + first + GetWordCount(positions.size_bytes()), indices.data(), indices.size_bytes());
+	}
+
+	std::pair<std::span<const Math::Float3>, std::span<const uint32_t>> CommandList::ReadVertices(size_t& word) const
+	{
+		const auto positionCount = Read<uint32_t>(m_Words, word);
+		const auto indexCount = Read<uint32_t>(m_Words, word);
+
+		const auto positions = std::bit_cast<const Math::Float3*>(m_Words.data() + word);
+		word += GetWordCount(positionCount * sizeof(Math::Float3));
+		const uint32_t* indices = m_Words.data() + word;
+		word += indexCount;
+
+		return { { positions, positionCount }, { indices, indexCount } };
+	}
+
+	void CommandList::ResetState()
+	{
+		m_Pipeline.reset();
+		m_Constants.reset();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,312 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <bit>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+module DirectGL.RHI;
+
+import DirectGL.Logging;
+
+namespace DGL::RHI
+{
+	namespace
+	{
+		/// The default framebuffer takes the first id, offscreen targets follow.
+		constexpr uint32_t MainRenderTargetId = 1;
+		constexpr uint32_t FirstOffscreenRenderTargetId = 2;
+	}
+
+	std::unique_ptr<OpenGLDevice> OpenGLDevice::Create(
+		const Math::Uint2 windowSize,
+		ShapeRenderer::ShapeRenderer& shapeRenderer,
+		TextureRenderer::TextureRenderer& textureRenderer,
+		Blending::BlendModeActivator& blendModeActivator,
+		Renderer::PixelReadback& pixelReadback,
+		Renderer::PixelWriter& pixelWriter,
+		Texture::SamplerCache& samplerCache,
+		Renderer::RenderTargetPool& renderTargetPool,
+		Brushes::FilterChain& filterChain
+	) {
+		auto solidColorBrush = Brushes::SolidColorBrush::Create(Renderer::Colors::White);
+		if (solidColorBrush == nullptr)
+		{
+			Logging::Error("Failed to create the brush of the solid color pipelines");
+			return nullptr;
+		}
+
+		auto textureBrush = Brushes::TextureBrush::Create(textureRenderer.GetTextureSlotCount(), samplerCache);
+		if (textureBrush == nullptr)
+		{
+			Logging::Error("Failed to create the brush of the sprite pipelines");
+			return nullptr;
+		}
+
+		return std::unique_ptr<OpenGLDevice>(new OpenGLDevice(
+			windowSize,
+			shapeRenderer,
+			textureRenderer,
+			blendModeActivator,
+			pixelReadback,
+			pixelWriter,
+			renderTargetPool,
+			filterChain,
+			std::move(solidColorBrush),
+			std::move(textureBrush)
+		));
+	}
+
+	RenderTargetHandle OpenGLDevice::GetDefaultRenderTarget() const
+	{
+		return { MainRenderTargetId };
+	}
+
+	void OpenGLDevice::ResizeDefaultRenderTarget(const Math::Uint2 size)
+	{
+		m_MainRenderTarget->SetViewport(Math::UintBoundary::FromLTWH(0, 0, size.X, size.Y));
+	}
+
+	RenderTargetHandle OpenGLDevice::CreateRenderTarget(const Math::Uint2 size, const Renderer::RenderTargetAttachments attachments)
+	{
+		std::unique_ptr<Renderer::OffscreenRenderTarget> renderTarget = m_RenderTargetPool.Acquire(size, attachments);
+		if (renderTarget == nullptr)
+		{
+			return {};
+		}
+
+		uint32_t slot;
+		if (not m_FreeRenderTargets.empty())
+		{
+			slot = m_FreeRenderTargets.back();
+			m_FreeRenderTargets.pop_back();
+			m_RenderTargets[slot] = std::move(renderTarget);
+		}
+		else
+		{
+			slot = static_cast<uint32_t>(m_RenderTargets.size());
+			m_RenderTargets.push_back(std::move(renderTarget));
+		}
+
+		return { slot + FirstOffscreenRenderTargetId };
+	}
+
+	void OpenGLDevice::DestroyRenderTarget(const RenderTargetHandle renderTarget)
+	{
+		if (renderTarget.Id < FirstOffscreenRenderTargetId)
+		{
+			return;
+		}
+
+		// The pool keeps the framebuffer until the GPU finished the commands reading it
+		const uint32_t slot = renderTarget.Id - FirstOffscreenRenderTargetId;
+		m_RenderTargetPool.Release(std::move(m_RenderTargets[slot]));
+		m_FreeRenderTargets.push_back(slot);
+	}
+
+	Math::Uint2 OpenGLDevice::GetRenderTargetSize(const RenderTargetHandle renderTarget) const
+	{
+		return GetRenderTarget(renderTarget).GetSize();
+	}
+
+	const Texture::Texture* OpenGLDevice::GetRenderTexture(const RenderTargetHandle renderTarget) const
+	{
+		if (renderTarget.Id < FirstOffscreenRenderTargetId)
+		{
+			return nullptr;
+		}
+
+		return &m_RenderTargets[renderTarget.Id - FirstOffscreenRenderTargetId]->GetRenderTexture();
+	}
+
+	TextureHandle OpenGLDevice::GetTextureHandle(const Texture::Texture& texture)
+	{
+		return { texture.GetRendererId() };
+	}
+
+	PipelineHandle OpenGLDevice::GetPipeline(const PipelineDescription& description)
+	{
+		// There are only a handful of pipelines in use, a linear search beats hashing the blend mode
+		const auto it = std::ranges::find(m_Pipelines, description);
+		if (it != m_Pipelines.end())
+		{
+			return { static_cast<uint32_t>(it - m_Pipelines.begin()) + 1 };
+		}
+
+		m_Pipelines.push_back(description);
+		return { static_cast<uint32_t>(m_Pipelines.size()) };
+	}
+
+	void OpenGLDevice::BeginPass(const RenderTargetHandle renderTarget)
+	{
+		GetRenderTarget(renderTarget).Activate();
+	}
+
+	void OpenGLDevice::SetPipeline(const PipelineHandle pipeline)
+	{
+		const PipelineDescription& description = m_Pipelines[pipeline.Id - 1];
+
+		m_BlendModeActivator.Activate(description.BlendMode);
+		m_CurrentPipelineKind = description.Kind;
+
+		if (description.Kind == PipelineKind::Sprite)
+		{
+			m_TextureBrush->SetSamplerState(description.Sampler);
+		}
+	}
+
+	void OpenGLDevice::SetConstants(const DrawConstants& constants)
+	{
+		// Uploading the uniforms also binds the shader program of the brush
+		switch (m_CurrentPipelineKind)
+		{
+			case PipelineKind::SolidColor:
+				m_SolidColorBrush->SetColor(constants.Color);
+				m_SolidColorBrush->UploadUniforms(constants.ProjectionView, constants.Model);
+				break;
+
+			case PipelineKind::Sprite:
+				m_TextureBrush->UploadUniforms(constants.ProjectionView);
+				break;
+		}
+	}
+
+	void OpenGLDevice::DrawVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices, const ShapeRenderer::PrimitiveType type)
+	{
+		const auto rawPositions = std::bit_cast<const float*>(positions.data());
+		m_ShapeRenderer.Render(std::span{ rawPositions, positions.size() * 3 }, indices, type);
+	}
+
+	void OpenGLDevice::UploadVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices)
+	{
+		const auto rawPositions = std::bit_cast<const float*>(positions.data());
+		m_ShapeRenderer.Upload(std::span{ rawPositions, positions.size() * 3 }, indices);
+	}
+
+	void OpenGLDevice::DrawVertexRange(const VertexRange& range)
+	{
+		m_ShapeRenderer.Draw(range.FirstVertex, range.VertexCount, range.FirstIndex, range.IndexCount, range.Type);
+	}
+
+	void OpenGLDevice::DrawSprite(const TextureHandle texture, const TextureRenderer::SpriteInstance& sprite)
+	{
+		m_TextureRenderer.Submit(texture.Id, sprite);
+	}
+
+	void OpenGLDevice::FlushSprites()
+	{
+		m_TextureRenderer.Flush();
+	}
+
+	void OpenGLDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback)
+	{
+		m_PixelReadback.Request(GetRenderTarget(renderTarget), region, std::move(callback));
+	}
+
+	std::future<Renderer::PixelData> OpenGLDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		return m_PixelReadback.Request(GetRenderTarget(renderTarget), region);
+	}
+
+	void OpenGLDevice::ViewPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback)
+	{
+		m_PixelReadback.RequestView(GetRenderTarget(renderTarget), region, std::move(callback));
+	}
+
+	Renderer::PixelData OpenGLDevice::ReadPixels(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		std::future<Renderer::PixelData> pixels = m_PixelReadback.Request(GetRenderTarget(renderTarget), region);
+		m_PixelReadback.Finish();
+
+		return pixels.get();
+	}
+
+	void OpenGLDevice::WritePixels(const RenderTargetHandle renderTarget, const uint8_t* pixels, const uint32_t firstRow, const uint32_t rowCount)
+	{
+		m_PixelWriter.Write(GetRenderTarget(renderTarget), pixels, firstRow, rowCount);
+	}
+
+	void OpenGLDevice::ApplyFilters(const RenderTargetHandle renderTarget, const std::span<const Brushes::Filter> filters)
+	{
+		// Every pass replaces the texels of its target instead of blending onto them
+		m_BlendModeActivator.Activate(Blending::BlendModes::Opaque);
+		m_FilterChain.Apply(GetRenderTarget(renderTarget), filters);
+	}
+
+	std::span<const Brushes::FilterTiming> OpenGLDevice::GetFilterTimings()
+	{
+		return m_FilterChain.GetTimings();
+	}
+
+	void OpenGLDevice::EndFrame()
+	{
+		// Deliver the pixel readbacks whose copies have been finished by the GPU
+		m_PixelReadback.Poll();
+
+		// Render targets released during this frame become reusable a few frames later
+		m_RenderTargetPool.EndFrame();
+
+		// The draw calls of the frame have been submitted, the context keeps the storage alive for the GPU
+		std::vector<uint32_t> retiredTextures;
+
+		{
+			std::scoped_lock lock(m_RetiredTextureMutex);
+			retiredTextures.swap(m_RetiredTextures);
+		}
+
+		glDeleteTextures(static_cast<GLsizei>(retiredTextures.size()), retiredTextures.data());
+	}
+
+	OpenGLDevice::OpenGLDevice(
+		const Math::Uint2 windowSize,
+		ShapeRenderer::ShapeRenderer& shapeRenderer,
+		TextureRenderer::TextureRenderer& textureRenderer,
+		Blending::BlendModeActivator& blendModeActivator,
+		Renderer::PixelReadback& pixelReadback,
+		Renderer::PixelWriter& pixelWriter,
+		Renderer::RenderTargetPool& renderTargetPool,
+		Brushes::FilterChain& filterChain,
+		std::unique_ptr<Brushes::SolidColorBrush> solidColorBrush,
+		std::unique_ptr<Brushes::TextureBrush> textureBrush
+	):	m_ShapeRenderer(shapeRenderer),
+		m_TextureRenderer(textureRenderer),
+		m_BlendModeActivator(blendModeActivator),
+		m_PixelReadback(pixelReadback),
+		m_PixelWriter(pixelWriter),
+		m_RenderTargetPool(renderTargetPool),
+		m_FilterChain(filterChain),
+		m_SolidColorBrush(std::move(solidColorBrush)),
+		m_TextureBrush(std::move(textureBrush)),
+		m_MainRenderTarget(Renderer::MainRenderTarget::Create(Math::UintBoundary::FromLTWH(0, 0, windowSize.X, windowSize.Y))),
+		m_CurrentPipelineKind(PipelineKind::SolidColor)
+	{
+		// Resized atlas pages and evicted textures may still have sprites queued in the texture renderer
+		m_PreviousTextureDeleter = Texture::SetTextureDeleter([this](const uint32_t textureId)
+		{
+			std::scoped_lock lock(m_RetiredTextureMutex);
+			m_RetiredTextures.push_back(textureId);
+		});
+	}
+
+	OpenGLDevice::~OpenGLDevice()
+	{
+		Texture::SetTextureDeleter(std::move(m_PreviousTextureDeleter));
+		glDeleteTextures(static_cast<GLsizei>(m_RetiredTextures.size()), m_RetiredTextures.data());
+	}
+
+	Renderer::RenderTarget& OpenGLDevice::GetRenderTarget(const RenderTargetHandle renderTarget) const
+	{
+		if (renderTarget.Id < FirstOffscreenRenderTargetId)
+		{
+			return *m_MainRenderTarget;
+		}
+
+		return *m_RenderTargets[renderTarget.Id - FirstOffscreenRenderTargetId];
+	}
+}
\ No newline at end of file
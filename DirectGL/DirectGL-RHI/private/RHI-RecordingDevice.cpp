@@ -0,0 +1,290 @@
+﻿module;
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+module DirectGL.RHI;
+
+namespace DGL::RHI
+{
+	namespace
+	{
+		/// The emulated default render target takes the first id, offscreen targets follow.
+		constexpr uint32_t DefaultRenderTargetId = 1;
+
+		/// Replaying a list several times delivers a readback several times, a future only takes the first one.
+		struct PixelPromise
+		{
+			std::promise<Renderer::PixelData> Promise;
+			bool IsFulfilled = false;
+		};
+	}
+
+	std::unique_ptr<RecordingDevice> RecordingDevice::Create(RenderDevice* resourceDevice, const Math::Uint2 defaultSize)
+	{
+		return std::unique_ptr<RecordingDevice>(new RecordingDevice(resourceDevice, defaultSize));
+	}
+
+	RenderTargetHandle RecordingDevice::GetDefaultRenderTarget() const
+	{
+		if (m_ResourceDevice != nullptr)
+		{
+			return m_ResourceDevice->GetDefaultRenderTarget();
+		}
+
+		return { DefaultRenderTargetId };
+	}
+
+	void RecordingDevice::ResizeDefaultRenderTarget(const Math::Uint2 size)
+	{
+		if (m_ResourceDevice != nullptr)
+		{
+			m_ResourceDevice->ResizeDefaultRenderTarget(size);
+			return;
+		}
+
+		m_RenderTargetSizes[DefaultRenderTargetId - 1] = size;
+	}
+
+	RenderTargetHandle RecordingDevice::CreateRenderTarget(const Math::Uint2 size, const Renderer::RenderTargetAttachments attachments)
+	{
+		if (m_ResourceDevice != nullptr)
+		{
+			return m_ResourceDevice->CreateRenderTarget(size, attachments);
+		}
+
+		if (not m_FreeRenderTargets.empty())
+		{
+			const uint32_t id = m_FreeRenderTargets.back();
+			m_FreeRenderTargets.pop_back();
+			m_RenderTargetSizes[id - 1] = size;
+			return { id };
+		}
+
+		m_RenderTargetSizes.push_back(size);
+		return { static_cast<uint32_t>(m_RenderTargetSizes.size()) };
+	}
+
+	void RecordingDevice::DestroyRenderTarget(const RenderTargetHandle renderTarget)
+	{
+		if (m_ResourceDevice != nullptr)
+		{
+			// Commands recorded before may still refer to it
+			m_ReleasedRenderTargets.push_back(renderTarget);
+			return;
+		}
+
+		if (renderTarget.Id > DefaultRenderTargetId)
+		{
+			m_FreeRenderTargets.push_back(renderTarget.Id);
+		}
+	}
+
+	Math::Uint2 RecordingDevice::GetRenderTargetSize(const RenderTargetHandle renderTarget) const
+	{
+		if (m_ResourceDevice != nullptr)
+		{
+			return m_ResourceDevice->GetRenderTargetSize(renderTarget);
+		}
+
+		return m_RenderTargetSizes[renderTarget.Id - 1];
+	}
+
+	const Texture::Texture* RecordingDevice::GetRenderTexture(const RenderTargetHandle renderTarget) const
+	{
+		return m_ResourceDevice != nullptr ? m_ResourceDevice->GetRenderTexture(renderTarget) : nullptr;
+	}
+
+	TextureHandle RecordingDevice::GetTextureHandle(const Texture::Texture& texture)
+	{
+		if (m_ResourceDevice != nullptr)
+		{
+			return m_ResourceDevice->GetTextureHandle(texture);
+		}
+
+		return { texture.GetRendererId() };
+	}
+
+	PipelineHandle RecordingDevice::GetPipeline(const PipelineDescription& description)
+	{
+		// The commands store the description, the device replaying them looks up its own pipeline
+		const auto it = std::ranges::find(m_Pipelines, description);
+		if (it != m_Pipelines.end())
+		{
+			return { static_cast<uint32_t>(it - m_Pipelines.begin()) + 1 };
+		}
+
+		m_Pipelines.push_back(description);
+		return { static_cast<uint32_t>(m_Pipelines.size()) };
+	}
+
+	void RecordingDevice::BeginPass(const RenderTargetHandle renderTarget)
+	{
+		m_Commands.BeginPass(renderTarget, GetPassTarget(renderTarget));
+	}
+
+	void RecordingDevice::SetPipeline(const PipelineHandle pipeline)
+	{
+		m_Commands.SetPipeline(m_Pipelines[pipeline.Id - 1]);
+	}
+
+	void RecordingDevice::SetConstants(const DrawConstants& constants)
+	{
+		m_Commands.SetConstants(constants);
+	}
+
+	void RecordingDevice::DrawVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices, const ShapeRenderer::PrimitiveType type)
+	{
+		m_Commands.DrawVertices(positions, indices, type);
+	}
+
+	void RecordingDevice::UploadVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices)
+	{
+		m_Commands.UploadVertices(positions, indices);
+	}
+
+	void RecordingDevice::DrawVertexRange(const VertexRange& range)
+	{
+		m_Commands.DrawVertexRange(range);
+	}
+
+	void RecordingDevice::DrawSprite(const TextureHandle texture, const TextureRenderer::SpriteInstance& sprite)
+	{
+		m_Commands.DrawSprite(texture, sprite);
+	}
+
+	void RecordingDevice::FlushSprites()
+	{
+		m_Commands.FlushSprites();
+	}
+
+	void RecordingDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback)
+	{
+		m_Commands.ReadPixelsAsync(renderTarget, GetPassTarget(renderTarget), region, std::move(callback));
+	}
+
+	std::future<Renderer::PixelData> RecordingDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		const auto promise = std::make_shared<PixelPromise>();
+		std::future<Renderer::PixelData> pixels = promise->Promise.get_future();
+
+		m_Commands.ReadPixelsAsync(renderTarget, GetPassTarget(renderTarget), region, [promise](Renderer::PixelData&& data)
+		{
+			if (not promise->IsFulfilled)
+			{
+				promise->IsFulfilled = true;
+				promise->Promise.set_value(std::move(data));
+			}
+		});
+
+		return pixels;
+	}
+
+	void RecordingDevice::ViewPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback)
+	{
+		m_Commands.ViewPixelsAsync(renderTarget, GetPassTarget(renderTarget), region, std::move(callback));
+	}
+
+	Renderer::PixelData RecordingDevice::ReadPixels(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		if (m_ResourceDevice == nullptr)
+		{
+			return { region, std::vector<uint8_t>(static_cast<size_t>(region.Width) * region.Height * 4) };
+		}
+
+		// The pixels have to contain everything drawn so far
+		Submit();
+		return m_ResourceDevice->ReadPixels(renderTarget, region);
+	}
+
+	void RecordingDevice::WritePixels(const RenderTargetHandle renderTarget, const uint8_t* pixels, const uint32_t firstRow, const uint32_t rowCount)
+	{
+		const uint32_t width = GetRenderTargetSize(renderTarget).X;
+		m_Commands.WritePixels(renderTarget, GetPassTarget(renderTarget), width, pixels, firstRow, rowCount);
+	}
+
+	void RecordingDevice::ApplyFilters(const RenderTargetHandle renderTarget, const std::span<const Brushes::Filter> filters)
+	{
+		m_Commands.ApplyFilters(renderTarget, GetPassTarget(renderTarget), filters);
+	}
+
+	std::span<const Brushes::FilterTiming> RecordingDevice::GetFilterTimings()
+	{
+		if (m_ResourceDevice != nullptr)
+		{
+			return m_ResourceDevice->GetFilterTimings();
+		}
+
+		return {};
+	}
+
+	void RecordingDevice::EndFrame()
+	{
+		if (m_ResourceDevice == nullptr)
+		{
+			return;
+		}
+
+		for (const RenderTargetHandle renderTarget : m_ReleasedRenderTargets)
+		{
+			m_ResourceDevice->DestroyRenderTarget(renderTarget);
+		}
+
+		m_ReleasedRenderTargets.clear();
+		m_ResourceDevice->EndFrame();
+	}
+
+	void RecordingDevice::Submit()
+	{
+		if (m_ResourceDevice == nullptr)
+		{
+			return;
+		}
+
+		m_Commands.Replay(*m_ResourceDevice, m_SubmittedBytes);
+		m_SubmittedBytes = m_Commands.Mark();
+	}
+
+	CommandList RecordingDevice::TakeCommands()
+	{
+		m_SubmittedBytes = 0;
+		return std::exchange(m_Commands, {});
+	}
+
+	void RecordingDevice::Clear()
+	{
+		m_Commands.Clear();
+		m_SubmittedBytes = 0;
+	}
+
+	const CommandList& RecordingDevice::GetCommands() const
+	{
+		return m_Commands;
+	}
+
+	RenderDevice* RecordingDevice::GetResourceDevice() const
+	{
+		return m_ResourceDevice;
+	}
+
+	RecordingDevice::RecordingDevice(RenderDevice* resourceDevice, const Math::Uint2 defaultSize)
+	:	m_ResourceDevice(resourceDevice),
+		m_SubmittedBytes(0),
+		m_RenderTargetSizes({ defaultSize })
+	{
+	}
+
+	PassTarget RecordingDevice::GetPassTarget(const RenderTargetHandle renderTarget) const
+	{
+		if (renderTarget == GetDefaultRenderTarget())
+		{
+			return PassTarget::Default;
+		}
+
+		return m_ResourceDevice != nullptr ? PassTarget::Device : PassTarget::Emulated;
+	}
+}
\ No newline at end of file
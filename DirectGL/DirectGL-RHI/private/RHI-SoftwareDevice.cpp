@@ -0,0 +1,416 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+module DirectGL.RHI;
+
+import DirectGL.Logging;
+
+namespace DGL::RHI
+{
+	namespace
+	{
+		/// The default framebuffer takes the first id, offscreen targets follow.
+		constexpr uint32_t MainRenderTargetId = 1;
+		constexpr uint32_t FirstOffscreenRenderTargetId = 2;
+
+		/// The revision of a texture whose texels haven't been copied yet.
+		constexpr uint64_t NotCopied = std::numeric_limits<uint64_t>::max();
+	}
+
+	std::unique_ptr<SoftwareDevice> SoftwareDevice::Create(const Math::Uint2 windowSize, Jobs::JobSystem* jobSystem, Renderer::PixelWriter& pixelWriter)
+	{
+		return std::unique_ptr<SoftwareDevice>(new SoftwareDevice(windowSize, SoftwareRenderer::TileRasterizer::Create(jobSystem), pixelWriter));
+	}
+
+	SoftwareDevice::SoftwareDevice(const Math::Uint2 windowSize, std::unique_ptr<SoftwareRenderer::TileRasterizer> rasterizer, Renderer::PixelWriter& pixelWriter):
+		m_Rasterizer(std::move(rasterizer)),
+		m_PixelWriter(pixelWriter),
+		m_MainRenderTarget(Renderer::MainRenderTarget::Create(Math::UintBoundary::FromLTWH(0, 0, windowSize.X, windowSize.Y))),
+		m_MainFramebuffer(SoftwareRenderer::SoftwareFramebuffer::Create(windowSize)),
+		m_PassFramebuffer(nullptr),
+		m_SpriteTexture(nullptr),
+		m_NextTextureId(1),
+		m_HasWarnedAboutFilters(false)
+	{
+		// Deleted textures must not be sampled through a stale copy once their id gets reused
+		m_PreviousTextureDeleter = Texture::SetTextureDeleter([this](const uint32_t textureId)
+		{
+			RetireTexture(textureId);
+
+			if (m_PreviousTextureDeleter)
+			{
+				m_PreviousTextureDeleter(textureId);
+			}
+			else
+			{
+				glDeleteTextures(1, &textureId);
+			}
+		});
+	}
+
+	SoftwareDevice::~SoftwareDevice()
+	{
+		Texture::SetTextureDeleter(std::move(m_PreviousTextureDeleter));
+	}
+
+	void SoftwareDevice::Present()
+	{
+		Flush();
+
+		const Math::Uint2 size = m_MainFramebuffer->GetSize();
+		const Renderer::PixelData frame = m_MainFramebuffer->ReadPixels(Math::UintBoundary::FromLTWH(0, 0, size.X, size.Y));
+		m_PixelWriter.Write(*m_MainRenderTarget, frame.Pixels.data(), 0, size.Y);
+	}
+
+	SoftwareRenderer::RasterizerStatistics SoftwareDevice::GetStatistics() const
+	{
+		return m_Rasterizer->GetStatistics();
+	}
+
+	RenderTargetHandle SoftwareDevice::GetDefaultRenderTarget() const
+	{
+		return { MainRenderTargetId };
+	}
+
+	void SoftwareDevice::ResizeDefaultRenderTarget(const Math::Uint2 size)
+	{
+		if (m_PassFramebuffer == m_MainFramebuffer.get())
+		{
+			SubmitSprites();
+			m_Rasterizer->SetFramebuffer(nullptr);
+			m_PassFramebuffer = nullptr;
+		}
+
+		m_MainFramebuffer = SoftwareRenderer::SoftwareFramebuffer::Create(size);
+		m_MainRenderTarget->SetViewport(Math::UintBoundary::FromLTWH(0, 0, size.X, size.Y));
+	}
+
+	RenderTargetHandle SoftwareDevice::CreateRenderTarget(const Math::Uint2 size, Renderer::RenderTargetAttachments)
+	{
+		// Every framebuffer has a depth buffer, the attachments only matter to the GPU's memory
+		std::unique_ptr<SoftwareRenderer::SoftwareFramebuffer> renderTarget = SoftwareRenderer::SoftwareFramebuffer::Create(size);
+
+		uint32_t slot;
+		if (not m_FreeRenderTargets.empty())
+		{
+			slot = m_FreeRenderTargets.back();
+			m_FreeRenderTargets.pop_back();
+			m_RenderTargets[slot] = std::move(renderTarget);
+		}
+		else
+		{
+			slot = static_cast<uint32_t>(m_RenderTargets.size());
+			m_RenderTargets.push_back(std::move(renderTarget));
+		}
+
+		return { slot + FirstOffscreenRenderTargetId };
+	}
+
+	void SoftwareDevice::DestroyRenderTarget(const RenderTargetHandle renderTarget)
+	{
+		if (renderTarget.Id < FirstOffscreenRenderTargetId)
+		{
+			return;
+		}
+
+		const uint32_t slot = renderTarget.Id - FirstOffscreenRenderTargetId;
+		if (m_PassFramebuffer == m_RenderTargets[slot].get())
+		{
+			// Finish the primitives queued for the framebuffer before it goes away
+			SubmitSprites();
+			m_Rasterizer->SetFramebuffer(nullptr);
+			m_PassFramebuffer = nullptr;
+		}
+
+		m_RenderTargets[slot].reset();
+		m_FreeRenderTargets.push_back(slot);
+	}
+
+	Math::Uint2 SoftwareDevice::GetRenderTargetSize(const RenderTargetHandle renderTarget) const
+	{
+		return GetFramebuffer(renderTarget).GetSize();
+	}
+
+	const Texture::Texture* SoftwareDevice::GetRenderTexture(RenderTargetHandle) const
+	{
+		return nullptr;
+	}
+
+	TextureHandle SoftwareDevice::GetTextureHandle(const Texture::Texture& texture)
+	{
+		// Only registers the texture, its texels get copied by the first sprite drawn on the thread owning the device
+		std::scoped_lock lock(m_TextureMutex);
+
+		const auto [it, isNew] = m_TextureIds.try_emplace(texture.GetRendererId(), m_NextTextureId);
+		if (isNew)
+		{
+			m_Textures.emplace(m_NextTextureId, TextureEntry { .Source = &texture, .Revision = NotCopied, .Texels = nullptr });
+			++m_NextTextureId;
+		}
+
+		return { it->second };
+	}
+
+	PipelineHandle SoftwareDevice::GetPipeline(const PipelineDescription& description)
+	{
+		const auto it = std::ranges::find(m_Pipelines, description);
+		if (it != m_Pipelines.end())
+		{
+			return { static_cast<uint32_t>(it - m_Pipelines.begin()) + 1 };
+		}
+
+		m_Pipelines.push_back(description);
+		return { static_cast<uint32_t>(m_Pipelines.size()) };
+	}
+
+	void SoftwareDevice::BeginPass(const RenderTargetHandle renderTarget)
+	{
+		SubmitSprites();
+
+		// Switching the framebuffer rasterises the primitives queued for the previous one
+		m_PassFramebuffer = &GetFramebuffer(renderTarget);
+		m_Rasterizer->SetFramebuffer(m_PassFramebuffer);
+	}
+
+	void SoftwareDevice::SetPipeline(const PipelineHandle pipeline)
+	{
+		SubmitSprites();
+		m_Pipeline = m_Pipelines[pipeline.Id - 1];
+	}
+
+	void SoftwareDevice::SetConstants(const DrawConstants& constants)
+	{
+		SubmitSprites();
+		m_Constants = constants;
+	}
+
+	void SoftwareDevice::DrawVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices, const ShapeRenderer::PrimitiveType type)
+	{
+		m_Rasterizer->DrawShape(positions, indices, type, m_Constants.Color, {
+			.Transform = m_Constants.ProjectionView * m_Constants.Model,
+			.BlendMode = m_Pipeline.BlendMode,
+		});
+	}
+
+	void SoftwareDevice::UploadVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices)
+	{
+		m_UploadedPositions.assign(positions.begin(), positions.end());
+		m_UploadedIndices.assign(indices.begin(), indices.end());
+	}
+
+	void SoftwareDevice::DrawVertexRange(const VertexRange& range)
+	{
+		// The indices of a range count from its first vertex, just like the rasteriser expects them
+		const auto positions = std::span<const Math::Float3>(m_UploadedPositions).subspan(range.FirstVertex, range.VertexCount);
+		const auto indices = std::span<const uint32_t>(m_UploadedIndices).subspan(range.FirstIndex, range.IndexCount);
+		DrawVertices(positions, indices, range.Type);
+	}
+
+	void SoftwareDevice::DrawSprite(const TextureHandle texture, const TextureRenderer::SpriteInstance& sprite)
+	{
+		const SoftwareRenderer::SoftwareTexture* texels = ResolveTexture(texture);
+		if (texels == nullptr)
+		{
+			return;
+		}
+
+		if (texels != m_SpriteTexture)
+		{
+			SubmitSprites();
+			m_SpriteTexture = texels;
+		}
+
+		m_Sprites.push_back(sprite);
+	}
+
+	void SoftwareDevice::FlushSprites()
+	{
+		// The tiles get rasterised once their pixels are needed
+		SubmitSprites();
+	}
+
+	void SoftwareDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback)
+	{
+		Flush();
+		m_PendingReadbacks.push_back([callback = std::move(callback), pixels = GetFramebuffer(renderTarget).ReadPixels(region)]() mutable
+		{
+			callback(std::move(pixels));
+		});
+	}
+
+	std::future<Renderer::PixelData> SoftwareDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		std::promise<Renderer::PixelData> promise;
+		promise.set_value(ReadPixels(renderTarget, region));
+		return promise.get_future();
+	}
+
+	void SoftwareDevice::ViewPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback)
+	{
+		Renderer::PixelData pixels = ReadPixels(renderTarget, region);
+
+		// Views store the rows bottom to top, like OpenGL reads them
+		const size_t stride = static_cast<size_t>(pixels.Region.Width) * 4;
+		for (uint32_t row = 0; row < pixels.Region.Height / 2; ++row)
+		{
+			const auto top = pixels.Pixels.begin() + static_cast<ptrdiff_t>(row * stride);
+			const auto bottom = pixels.Pixels.begin() + static_cast<ptrdiff_t>((pixels.Region.Height - 1 - row) * stride);
+			std::swap_ranges(top, top + static_cast<ptrdiff_t>(stride), bottom);
+		}
+
+		m_PendingReadbacks.push_back([callback = std::move(callback), pixels = std::move(pixels)]
+		{
+			callback(Renderer::PixelView { .Region = pixels.Region, .Pixels = pixels.Pixels.data() });
+		});
+	}
+
+	Renderer::PixelData SoftwareDevice::ReadPixels(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		Flush();
+		return GetFramebuffer(renderTarget).ReadPixels(region);
+	}
+
+	void SoftwareDevice::WritePixels(const RenderTargetHandle renderTarget, const uint8_t* pixels, const uint32_t firstRow, const uint32_t rowCount)
+	{
+		// The primitives drawn so far have to land before they get overwritten
+		Flush();
+
+		SoftwareRenderer::SoftwareFramebuffer& framebuffer = GetFramebuffer(renderTarget);
+		const Math::Uint2 size = framebuffer.GetSize();
+		const uint32_t lastRow = std::min(firstRow + rowCount, size.Y);
+		const size_t rowSize = static_cast<size_t>(size.X) * 4;
+
+		for (uint32_t row = firstRow; row < lastRow; ++row)
+		{
+			std::memcpy(framebuffer.GetColors() + static_cast<size_t>(row) * framebuffer.GetStride(), pixels + row * rowSize, rowSize);
+		}
+	}
+
+	void SoftwareDevice::ApplyFilters(RenderTargetHandle, const std::span<const Brushes::Filter> filters)
+	{
+		if (not filters.empty() and not m_HasWarnedAboutFilters)
+		{
+			Logging::Warning("The software device doesn't support filters, they are skipped");
+			m_HasWarnedAboutFilters = true;
+		}
+	}
+
+	std::span<const Brushes::FilterTiming> SoftwareDevice::GetFilterTimings()
+	{
+		return {};
+	}
+
+	void SoftwareDevice::EndFrame()
+	{
+		Flush();
+
+		// Callbacks may request new readbacks, which are delivered by the next frame
+		std::vector<std::function<void()>> readbacks;
+		readbacks.swap(m_PendingReadbacks);
+
+		for (const std::function<void()>& readback : readbacks)
+		{
+			readback();
+		}
+	}
+
+	SoftwareRenderer::SoftwareFramebuffer& SoftwareDevice::GetFramebuffer(const RenderTargetHandle renderTarget) const
+	{
+		if (renderTarget.Id < FirstOffscreenRenderTargetId)
+		{
+			return *m_MainFramebuffer;
+		}
+
+		return *m_RenderTargets[renderTarget.Id - FirstOffscreenRenderTargetId];
+	}
+
+	const SoftwareRenderer::SoftwareTexture* SoftwareDevice::ResolveTexture(const TextureHandle texture)
+	{
+		std::scoped_lock lock(m_TextureMutex);
+
+		const auto it = m_Textures.find(texture.Id);
+		if (it == m_Textures.end())
+		{
+			return nullptr;
+		}
+
+		TextureEntry& entry = it->second;
+		const uint64_t revision = entry.Source->GetRevision();
+
+		if (entry.Revision != revision)
+		{
+			// Sprites queued before the update still sample the previous texels
+			if (entry.Texels != nullptr)
+			{
+				m_RetiredTextures.push_back(std::move(entry.Texels));
+			}
+
+			entry.Texels = SoftwareRenderer::SoftwareTexture::Create(entry.Source->Download());
+			entry.Revision = revision;
+
+			if (entry.Texels == nullptr)
+			{
+				Logging::Warning("The software device can't sample block compressed textures, their sprites are skipped");
+			}
+		}
+
+		return entry.Texels.get();
+	}
+
+	void SoftwareDevice::SubmitSprites()
+	{
+		if (m_Sprites.empty())
+		{
+			return;
+		}
+
+		m_Rasterizer->DrawSprites(m_Sprites, *m_SpriteTexture, m_Pipeline.Sampler.FilterMode.Magnification, {
+			.Transform = m_Constants.ProjectionView,
+			.BlendMode = m_Pipeline.BlendMode,
+		});
+
+		m_Sprites.clear();
+	}
+
+	void SoftwareDevice::Flush()
+	{
+		SubmitSprites();
+		m_Rasterizer->Flush();
+
+		std::scoped_lock lock(m_TextureMutex);
+		m_RetiredTextures.clear();
+	}
+
+	void SoftwareDevice::RetireTexture(const uint32_t textureId)
+	{
+		std::scoped_lock lock(m_TextureMutex);
+
+		const auto id = m_TextureIds.find(textureId);
+		if (id == m_TextureIds.end())
+		{
+			return;
+		}
+
+		const auto it = m_Textures.find(id->second);
+		if (it->second.Texels != nullptr)
+		{
+			m_RetiredTextures.push_back(std::move(it->second.Texels));
+		}
+
+		m_Textures.erase(it);
+		m_TextureIds.erase(id);
+	}
+}
\ No newline at end of file
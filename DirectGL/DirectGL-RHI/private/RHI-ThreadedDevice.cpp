@@ -0,0 +1,483 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+module DirectGL.RHI;
+
+namespace DGL::RHI
+{
+	RenderThread::RenderThread(std::function<void()> onStart, std::function<void()> onExit):
+		m_OnStart(std::move(onStart)),
+		m_OnExit(std::move(onExit)),
+		m_Thread([this](const std::stop_token stopToken) { Run(stopToken); })
+	{
+	}
+
+	RenderThread::~RenderThread()
+	{
+		// The tasks posted so far still run before the thread exits
+		m_Thread.request_stop();
+		m_Thread.join();
+	}
+
+	void RenderThread::Post(std::function<void()> task)
+	{
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Tasks.push_back(std::move(task));
+		}
+
+		m_TaskAvailable.notify_one();
+	}
+
+	void RenderThread::Invoke(const std::function<void()>& task)
+	{
+		std::promise<void> finished;
+		const std::future<void> done = finished.get_future();
+
+		Post([&task, &finished]
+		{
+			task();
+			finished.set_value();
+		});
+
+		done.wait();
+	}
+
+	void RenderThread::Run(const std::stop_token stopToken)
+	{
+		if (m_OnStart)
+		{
+			m_OnStart();
+		}
+
+		while (true)
+		{
+			std::function<void()> task;
+
+			{
+				std::unique_lock lock(m_Mutex);
+				if (not m_TaskAvailable.wait(lock, stopToken, [this] { return not m_Tasks.empty(); }))
+				{
+					break;
+				}
+
+				task = std::move(m_Tasks.front());
+				m_Tasks.pop_front();
+			}
+
+			task();
+		}
+
+		if (m_OnExit)
+		{
+			m_OnExit();
+		}
+	}
+
+	std::unique_ptr<ThreadedDevice> ThreadedDevice::Create(RenderDevice& device, const uint32_t maxFramesInFlight, RenderThreadCallbacks callbacks)
+	{
+		return std::unique_ptr<ThreadedDevice>(new ThreadedDevice(device, std::max<uint32_t>(maxFramesInFlight, 1), std::move(callbacks)));
+	}
+
+	ThreadedDevice::~ThreadedDevice()
+	{
+		Texture::SetTextureDeleter(m_DeviceTextureDeleter);
+
+		// Joins the render thread once it finished the frames in flight and released the retired resources
+		m_RenderThread->Post([this, textures = std::exchange(m_RetiredTextures, {}), renderTargets = std::exchange(m_ReleasedRenderTargets, {})]
+		{
+			ReleaseRenderTargets(renderTargets);
+			ReleaseTextures(textures);
+		});
+
+		m_RenderThread.reset();
+	}
+
+	RenderTargetHandle ThreadedDevice::GetDefaultRenderTarget() const
+	{
+		return m_DefaultRenderTarget;
+	}
+
+	void ThreadedDevice::ResizeDefaultRenderTarget(const Math::Uint2 size)
+	{
+		Invoke([size](RenderDevice& device) { device.ResizeDefaultRenderTarget(size); });
+
+		std::scoped_lock lock(m_RenderTargetMutex);
+		m_RenderTargets[m_DefaultRenderTarget.Id].Size = size;
+	}
+
+	RenderTargetHandle ThreadedDevice::CreateRenderTarget(const Math::Uint2 size, const Renderer::RenderTargetAttachments attachments)
+	{
+		RenderTargetHandle renderTarget;
+		const Texture::Texture* renderTexture = nullptr;
+
+		Invoke([&](RenderDevice& device)
+		{
+			renderTarget = device.CreateRenderTarget(size, attachments);
+			if (renderTarget.IsValid())
+			{
+				renderTexture = device.GetRenderTexture(renderTarget);
+			}
+		});
+
+		if (renderTarget.IsValid())
+		{
+			std::scoped_lock lock(m_RenderTargetMutex);
+			m_RenderTargets[renderTarget.Id] = { size, renderTexture };
+		}
+
+		return renderTarget;
+	}
+
+	void ThreadedDevice::DestroyRenderTarget(const RenderTargetHandle renderTarget)
+	{
+		// The commands recorded so far may still draw to it. Destroying it right away would also
+		// let CreateRenderTarget() hand its slot to a new render target those commands then draw to.
+		std::scoped_lock lock(m_RenderTargetMutex);
+		m_RenderTargets.erase(renderTarget.Id);
+		m_ReleasedRenderTargets.push_back(renderTarget);
+	}
+
+	Math::Uint2 ThreadedDevice::GetRenderTargetSize(const RenderTargetHandle renderTarget) const
+	{
+		return GetRenderTargetInfo(renderTarget).Size;
+	}
+
+	const Texture::Texture* ThreadedDevice::GetRenderTexture(const RenderTargetHandle renderTarget) const
+	{
+		return GetRenderTargetInfo(renderTarget).RenderTexture;
+	}
+
+	TextureHandle ThreadedDevice::GetTextureHandle(const Texture::Texture& texture)
+	{
+		return m_Device.GetTextureHandle(texture);
+	}
+
+	PipelineHandle ThreadedDevice::GetPipeline(const PipelineDescription& description)
+	{
+		// The commands store the description, the render thread looks up the pipeline of the device
+		const auto it = std::ranges::find(m_Pipelines, description);
+		if (it != m_Pipelines.end())
+		{
+			return { static_cast<uint32_t>(it - m_Pipelines.begin()) + 1 };
+		}
+
+		m_Pipelines.push_back(description);
+		return { static_cast<uint32_t>(m_Pipelines.size()) };
+	}
+
+	void ThreadedDevice::BeginPass(const RenderTargetHandle renderTarget)
+	{
+		m_Commands.BeginPass(renderTarget, GetPassTarget(renderTarget));
+	}
+
+	void ThreadedDevice::SetPipeline(const PipelineHandle pipeline)
+	{
+		m_Commands.SetPipeline(m_Pipelines[pipeline.Id - 1]);
+	}
+
+	void ThreadedDevice::SetConstants(const DrawConstants& constants)
+	{
+		m_Commands.SetConstants(constants);
+	}
+
+	void ThreadedDevice::DrawVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices, const ShapeRenderer::PrimitiveType type)
+	{
+		m_Commands.DrawVertices(positions, indices, type);
+	}
+
+	void ThreadedDevice::UploadVertices(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices)
+	{
+		m_Commands.UploadVertices(positions, indices);
+	}
+
+	void ThreadedDevice::DrawVertexRange(const VertexRange& range)
+	{
+		m_Commands.DrawVertexRange(range);
+	}
+
+	void ThreadedDevice::DrawSprite(const TextureHandle texture, const TextureRenderer::SpriteInstance& sprite)
+	{
+		m_Commands.DrawSprite(texture, sprite);
+	}
+
+	void ThreadedDevice::FlushSprites()
+	{
+		m_Commands.FlushSprites();
+	}
+
+	void ThreadedDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback)
+	{
+		m_Commands.ReadPixelsAsync(renderTarget, GetPassTarget(renderTarget), region, [this, callback = std::move(callback)](Renderer::PixelData&& pixels)
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Deliveries.push_back([callback, pixels = std::move(pixels)]() mutable { callback(std::move(pixels)); });
+		});
+	}
+
+	std::future<Renderer::PixelData> ThreadedDevice::ReadPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		// Futures may be fulfilled by any thread
+		const auto promise = std::make_shared<std::promise<Renderer::PixelData>>();
+		std::future<Renderer::PixelData> pixels = promise->get_future();
+
+		m_Commands.ReadPixelsAsync(renderTarget, GetPassTarget(renderTarget), region, [promise](Renderer::PixelData&& data)
+		{
+			promise->set_value(std::move(data));
+		});
+
+		return pixels;
+	}
+
+	void ThreadedDevice::ViewPixelsAsync(const RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback)
+	{
+		m_Commands.ViewPixelsAsync(renderTarget, GetPassTarget(renderTarget), region, [this, callback = std::move(callback)](const Renderer::PixelView& view)
+		{
+			// The view only lives during the callback, so the pixels are copied for the recording thread
+			std::vector<uint8_t> pixels(view.Pixels, view.Pixels + view.GetStride() * view.Region.Height);
+
+			std::scoped_lock lock(m_Mutex);
+			m_Deliveries.push_back([callback, region = view.Region, pixels = std::move(pixels)]
+			{
+				callback(Renderer::PixelView{ region, pixels.data() });
+			});
+		});
+	}
+
+	Renderer::PixelData ThreadedDevice::ReadPixels(const RenderTargetHandle renderTarget, const Math::UintBoundary& region)
+	{
+		PostCommands(false);
+
+		Renderer::PixelData pixels;
+		Invoke([&](RenderDevice& device) { pixels = device.ReadPixels(renderTarget, region); });
+		return pixels;
+	}
+
+	void ThreadedDevice::WritePixels(const RenderTargetHandle renderTarget, const uint8_t* pixels, const uint32_t firstRow, const uint32_t rowCount)
+	{
+		m_Commands.WritePixels(renderTarget, GetPassTarget(renderTarget), GetRenderTargetSize(renderTarget).X, pixels, firstRow, rowCount);
+	}
+
+	void ThreadedDevice::ApplyFilters(const RenderTargetHandle renderTarget, const std::span<const Brushes::Filter> filters)
+	{
+		m_Commands.ApplyFilters(renderTarget, GetPassTarget(renderTarget), filters);
+	}
+
+	std::span<const Brushes::FilterTiming> ThreadedDevice::GetFilterTimings()
+	{
+		Invoke([this](RenderDevice& device)
+		{
+			const std::span<const Brushes::FilterTiming> timings = device.GetFilterTimings();
+			m_FilterTimings.assign(timings.begin(), timings.end());
+		});
+
+		return m_FilterTimings;
+	}
+
+	void ThreadedDevice::EndFrame()
+	{
+		// Without a frame the readbacks of the device still have to be polled
+		if (not m_FrameSubmitted)
+		{
+			m_RenderThread->Post([this] { m_Device.EndFrame(); });
+		}
+
+		m_FrameSubmitted = false;
+		std::vector<std::function<void()>> deliveries;
+
+		{
+			std::scoped_lock lock(m_Mutex);
+			deliveries.swap(m_Deliveries);
+		}
+
+		for (const std::function<void()>& delivery : deliveries)
+		{
+			delivery();
+		}
+	}
+
+	void ThreadedDevice::SubmitFrame()
+	{
+		const auto stallStart = std::chrono::steady_clock::now();
+
+		{
+			std::unique_lock lock(m_Mutex);
+			m_FrameCompleted.wait(lock, [this] { return m_SubmittedFrames - m_CompletedFrames < m_MaxFramesInFlight; });
+		}
+
+		m_StallTime += std::chrono::steady_clock::now() - stallStart;
+
+		PostCommands(true);
+		++m_SubmittedFrames;
+		m_FrameSubmitted = true;
+	}
+
+	void ThreadedDevice::WaitIdle()
+	{
+		std::unique_lock lock(m_Mutex);
+		m_FrameCompleted.wait(lock, [this] { return m_CompletedFrames == m_SubmittedFrames; });
+	}
+
+	void ThreadedDevice::Invoke(const std::function<void(RenderDevice&)>& function)
+	{
+		++m_Invocations;
+		m_RenderThread->Invoke([this, &function] { function(m_Device); });
+	}
+
+	RenderThreadStatistics ThreadedDevice::GetStatistics() const
+	{
+		std::scoped_lock lock(m_Mutex);
+
+		RenderThreadStatistics statistics;
+		statistics.SubmittedFrames = m_SubmittedFrames;
+		statistics.CompletedFrames = m_CompletedFrames;
+		statistics.Invocations = m_Invocations;
+
+		if (m_CompletedFrames > 0)
+		{
+			statistics.AverageFrameTime = std::chrono::duration_cast<std::chrono::microseconds>(m_FrameTime / m_CompletedFrames);
+		}
+
+		if (m_SubmittedFrames > 0)
+		{
+			statistics.AverageStallTime = std::chrono::duration_cast<std::chrono::microseconds>(m_StallTime / m_SubmittedFrames);
+		}
+
+		return statistics;
+	}
+
+	ThreadedDevice::ThreadedDevice(RenderDevice& device, const uint32_t maxFramesInFlight, RenderThreadCallbacks callbacks):
+		m_Device(device),
+		m_Callbacks(std::move(callbacks)),
+		m_MaxFramesInFlight(maxFramesInFlight),
+		m_DefaultRenderTarget(device.GetDefaultRenderTarget()),
+		m_SubmittedFrames(0),
+		m_FrameSubmitted(false),
+		m_Invocations(0),
+		m_StallTime(0),
+		m_CompletedFrames(0),
+		m_FrameTime(0)
+	{
+		// The render thread doesn't run yet, so the device may still be asked directly
+		m_RenderTargets[m_DefaultRenderTarget.Id] = { device.GetRenderTargetSize(m_DefaultRenderTarget), nullptr };
+		m_RenderThread = std::make_unique<RenderThread>(m_Callbacks.Attach, m_Callbacks.Detach);
+
+		m_DeviceTextureDeleter = Texture::SetTextureDeleter([this](const uint32_t textureId)
+		{
+			std::scoped_lock lock(m_RetiredTextureMutex);
+			m_RetiredTextures.push_back(textureId);
+		});
+	}
+
+	void ThreadedDevice::PostCommands(const bool present)
+	{
+		// Everything the recording context uploaded so far has to be visible to the render thread
+		const GLsync uploads = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+
+		// The commands may still use the textures and render targets released while recording them
+		std::vector<uint32_t> retiredTextures;
+		std::vector<RenderTargetHandle> releasedRenderTargets;
+
+		{
+			std::scoped_lock lock(m_RetiredTextureMutex);
+			retiredTextures.swap(m_RetiredTextures);
+		}
+
+		{
+			std::scoped_lock lock(m_RenderTargetMutex);
+			releasedRenderTargets.swap(m_ReleasedRenderTargets);
+		}
+
+		m_RenderThread->Post([this, commands = std::exchange(m_Commands, {}), uploads, present, retiredTextures = std::move(retiredTextures), releasedRenderTargets = std::move(releasedRenderTargets)]
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			glWaitSync(uploads, 0, GL_TIMEOUT_IGNORED);
+			glDeleteSync(uploads);
+
+			commands.Replay(m_Device);
+			ReleaseRenderTargets(releasedRenderTargets);
+			ReleaseTextures(retiredTextures);
+
+			if (not present)
+			{
+				return;
+			}
+
+			m_Callbacks.Present();
+			m_Device.EndFrame();
+
+			{
+				std::scoped_lock lock(m_Mutex);
+				++m_CompletedFrames;
+				m_FrameTime += std::chrono::steady_clock::now() - start;
+			}
+
+			m_FrameCompleted.notify_all();
+		});
+	}
+
+	ThreadedDevice::RenderTargetInfo ThreadedDevice::GetRenderTargetInfo(const RenderTargetHandle renderTarget) const
+	{
+		{
+			std::scoped_lock lock(m_RenderTargetMutex);
+			if (const auto it = m_RenderTargets.find(renderTarget.Id); it != m_RenderTargets.end())
+			{
+				return it->second;
+			}
+		}
+
+		// Render targets created before the render thread started are looked up once. The lock isn't
+		// held meanwhile, so lookups of known render targets on other threads don't wait for the render thread.
+		RenderTargetInfo info;
+		++m_Invocations;
+		m_RenderThread->Invoke([this, renderTarget, &info]
+		{
+			info = { m_Device.GetRenderTargetSize(renderTarget), m_Device.GetRenderTexture(renderTarget) };
+		});
+
+		std::scoped_lock lock(m_RenderTargetMutex);
+		return m_RenderTargets.try_emplace(renderTarget.Id, info).first->second;
+	}
+
+	void ThreadedDevice::ReleaseTextures(const std::span<const uint32_t> textures) const
+	{
+		// The device may keep them until it ended the frame, the context keeps the storage alive for the GPU anyway
+		for (const uint32_t texture : textures)
+		{
+			if (m_DeviceTextureDeleter)
+			{
+				m_DeviceTextureDeleter(texture);
+			}
+			else
+			{
+				glDeleteTextures(1, &texture);
+			}
+		}
+	}
+
+	void ThreadedDevice::ReleaseRenderTargets(const std::span<const RenderTargetHandle> renderTargets) const
+	{
+		for (const RenderTargetHandle renderTarget : renderTargets)
+		{
+			m_Device.DestroyRenderTarget(renderTarget);
+		}
+	}
+
+	PassTarget ThreadedDevice::GetPassTarget(const RenderTargetHandle renderTarget) const
+	{
+		return renderTarget == m_DefaultRenderTarget ? PassTarget::Default : PassTarget::Device;
+	}
+}
\ No newline at end of file
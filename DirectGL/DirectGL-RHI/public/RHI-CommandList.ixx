@@ -0,0 +1,141 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-CommandList.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+export module DirectGL.RHI:CommandList;
+
+import DirectGL.Brushes;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.ShapeRenderer;
+import DirectGL.TextureRenderer;
+
+import :Handles;
+import :Pipeline;
+import :RenderDevice;
+
+export namespace DGL::RHI
+{
+	enum class CommandType : uint8_t
+	{
+		BeginPass,
+		SetPipeline,
+		SetConstants,
+		DrawVertices,
+		UploadVertices,
+		DrawVertexRange,
+		DrawSprites,
+		FlushSprites,
+		ReadPixels,
+		ViewPixels,
+		WritePixels,
+		ApplyFilters,
+	};
+
+	inline constexpr size_t CommandTypeCount = static_cast<size_t>(CommandType::ApplyFilters) + 1;
+
+	/// How the render target of a pass is found when the list gets replayed.
+	enum class PassTarget : uint8_t
+	{
+		Default,	//!< The default render target of the device the list gets replayed to
+		Device,		//!< A render target created by the device the list gets replayed to
+		Emulated,	//!< A render target that only existed while recording. The pass gets skipped on replay
+	};
+
+	struct CommandStatistics
+	{
+		std::array<uint64_t, CommandTypeCount> Calls = {};	//!< The calls per CommandType, including redundant state changes that didn't get stored
+		uint64_t PassChanges = 0;		//!< The stored BeginPass commands
+		uint64_t PipelineChanges = 0;	//!< The stored SetPipeline commands, which differed from the pipeline before
+		uint64_t ConstantChanges = 0;	//!< The stored SetConstants commands, which differed from the constants before
+		uint64_t Vertices = 0;
+		uint64_t Indices = 0;
+		uint64_t Sprites = 0;
+		uint64_t UploadedBytes = 0;		//!< The constants, geometry, sprites and pixels a backend has to upload
+
+		uint64_t GetCallCount() const;
+		uint64_t GetCallCount(CommandType type) const;
+
+		CommandStatistics& operator += (const CommandStatistics& other);
+	};
+
+	/// A compact binary recording of the commands issued to a RenderDevice. Every
+	/// command is stored as a 32 bit header followed by its payload, padded to whole
+	/// words, so geometry can be handed to the replaying device without copying it.
+	///
+	/// Redundant pipeline and constant changes are dropped while recording and
+	/// consecutive sprites are merged into a single command. Pixel callbacks can't
+	/// be serialised and are kept next to the commands instead.
+	class CommandList
+	{
+	public:
+
+		void BeginPass(RenderTargetHandle renderTarget, PassTarget target);
+		void SetPipeline(const PipelineDescription& description);
+		void SetConstants(const DrawConstants& constants);
+		void DrawVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices, ShapeRenderer::PrimitiveType type);
+		void UploadVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices);
+		void DrawVertexRange(const VertexRange& range);
+		void DrawSprite(TextureHandle texture, const TextureRenderer::SpriteInstance& sprite);
+		void FlushSprites();
+
+		/// @brief Record an asynchronous readback. The callback gets handed to the device on every replay.
+		void ReadPixelsAsync(RenderTargetHandle renderTarget, PassTarget target, const Math::UintBoundary& region, Renderer::PixelCallback callback);
+		void ViewPixelsAsync(RenderTargetHandle renderTarget, PassTarget target, const Math::UintBoundary& region, Renderer::PixelViewCallback callback);
+
+		/// @brief Record a write of pixels. Only the written rows get copied into the list.
+		/// @param width The width of the render target in pixels.
+		void WritePixels(RenderTargetHandle renderTarget, PassTarget target, uint32_t width, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount);
+		void ApplyFilters(RenderTargetHandle renderTarget, PassTarget target, std::span<const Brushes::Filter> filters);
+
+		/// @brief Issue the commands to a device, in the order they were recorded.
+		/// @param device The device to replay to. Handles of PassTarget::Device must belong to it.
+		/// @param firstByte Where to start, as returned by Mark().
+		void Replay(RenderDevice& device, size_t firstByte = 0) const;
+
+		/// @brief Get the current end of the list. Commands recorded later never change the commands before it.
+		size_t Mark();
+
+		void Clear();
+		bool IsEmpty() const;
+
+		/// @return The size of the encoded commands, not counting the pixel callbacks.
+		size_t GetByteSize() const;
+		const CommandStatistics& GetStatistics() const;
+
+	private:
+
+		template <typename T>
+		void Write(const T& value);
+		void WriteHeader(CommandType type, uint32_t value = 0);
+
+		/// @brief Store the counts of positions and indices followed by the data itself.
+		void WriteVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices);
+
+		/// @brief Get the vertices stored by WriteVertices() without copying them, and advance past them.
+		std::pair<std::span<const Math::Float3>, std::span<const uint32_t>> ReadVertices(size_t& word) const;
+
+		/// @brief Forget the pipeline and constants, so the next ones get stored even if they are equal.
+		void ResetState();
+
+		std::vector<uint32_t> m_Words;
+		std::vector<Renderer::PixelCallback> m_PixelCallbacks;
+		std::vector<Renderer::PixelViewCallback> m_ViewCallbacks;
+		CommandStatistics m_Statistics;
+
+		std::optional<PipelineDescription> m_Pipeline;	//!< The latest stored pipeline
+		std::optional<DrawConstants> m_Constants;		//!< The latest stored constants
+		std::optional<size_t> m_SpriteRun;				//!< The header of the DrawSprites command new sprites get appended to
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-Handles.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+
+export module DirectGL.RHI:Handles;
+
+/// Resources of a RenderDevice are referred to by small handles instead of
+/// pointers to backend objects. A handle only has a meaning for the device that
+/// returned it; an id of zero never refers to a resource.
+export namespace DGL::RHI
+{
+	/// A texture that can be sampled by PipelineKind::Sprite.
+	struct TextureHandle
+	{
+		uint32_t Id = 0;
+
+		constexpr bool IsValid() const { return Id != 0; }
+		constexpr bool operator == (const TextureHandle&) const = default;
+	};
+
+	/// A framebuffer draw calls can be directed to with RenderDevice::BeginPass().
+	struct RenderTargetHandle
+	{
+		uint32_t Id = 0;
+
+		constexpr bool IsValid() const { return Id != 0; }
+		constexpr bool operator == (const RenderTargetHandle&) const = default;
+	};
+
+	/// The shaders, blend state and sampler used by the following draw calls.
+	struct PipelineHandle
+	{
+		uint32_t Id = 0;
+
+		constexpr bool IsValid() const { return Id != 0; }
+		constexpr bool operator == (const PipelineHandle&) const = default;
+	};
+}
\ No newline at end of file
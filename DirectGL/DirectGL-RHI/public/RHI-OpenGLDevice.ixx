@@ -0,0 +1,128 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-OpenGLDevice.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+export module DirectGL.RHI:OpenGLDevice;
+
+import DirectGL.Blending;
+import DirectGL.Brushes;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
+import DirectGL.TextureRenderer;
+
+import :Handles;
+import :Pipeline;
+import :RenderDevice;
+
+export namespace DGL::RHI
+{
+	/// The OpenGL 4.6 backend. It drives the existing renderers, brushes and pixel
+	/// transfer queues, which have to outlive the device. Offscreen render targets
+	/// come from the render target pool; texture handles are the names of the
+	/// OpenGL textures. Textures deleted during a frame are kept until EndFrame(),
+	/// as the renderers may still have sprites of them queued.
+	class OpenGLDevice : public RenderDevice
+	{
+	public:
+
+		/// @brief Create the device and the brushes of its pipelines.
+		/// @param windowSize The size of the default framebuffer.
+		/// @return The device or nullptr if the shaders failed to compile.
+		static std::unique_ptr<OpenGLDevice> Create(
+			Math::Uint2 windowSize,
+			ShapeRenderer::ShapeRenderer& shapeRenderer,
+			TextureRenderer::TextureRenderer& textureRenderer,
+			Blending::BlendModeActivator& blendModeActivator,
+			Renderer::PixelReadback& pixelReadback,
+			Renderer::PixelWriter& pixelWriter,
+			Texture::SamplerCache& samplerCache,
+			Renderer::RenderTargetPool& renderTargetPool,
+			Brushes::FilterChain& filterChain
+		);
+
+		/// @brief Delete the textures retired since the latest frame.
+		~OpenGLDevice() override;
+
+		RenderTargetHandle GetDefaultRenderTarget() const override;
+		void ResizeDefaultRenderTarget(Math::Uint2 size) override;
+
+		RenderTargetHandle CreateRenderTarget(Math::Uint2 size, Renderer::RenderTargetAttachments attachments) override;
+		void DestroyRenderTarget(RenderTargetHandle renderTarget) override;
+		Math::Uint2 GetRenderTargetSize(RenderTargetHandle renderTarget) const override;
+		const Texture::Texture* GetRenderTexture(RenderTargetHandle renderTarget) const override;
+
+		TextureHandle GetTextureHandle(const Texture::Texture& texture) override;
+		PipelineHandle GetPipeline(const PipelineDescription& description) override;
+
+		void BeginPass(RenderTargetHandle renderTarget) override;
+		void SetPipeline(PipelineHandle pipeline) override;
+		void SetConstants(const DrawConstants& constants) override;
+		void DrawVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices, ShapeRenderer::PrimitiveType type) override;
+		void UploadVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices) override;
+		void DrawVertexRange(const VertexRange& range) override;
+		void DrawSprite(TextureHandle texture, const TextureRenderer::SpriteInstance& sprite) override;
+		void FlushSprites() override;
+
+		void ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback) override;
+		std::future<Renderer::PixelData> ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void ViewPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback) override;
+		Renderer::PixelData ReadPixels(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void WritePixels(RenderTargetHandle renderTarget, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount) override;
+		void ApplyFilters(RenderTargetHandle renderTarget, std::span<const Brushes::Filter> filters) override;
+		std::span<const Brushes::FilterTiming> GetFilterTimings() override;
+
+		void EndFrame() override;
+
+	private:
+
+		explicit OpenGLDevice(
+			Math::Uint2 windowSize,
+			ShapeRenderer::ShapeRenderer& shapeRenderer,
+			TextureRenderer::TextureRenderer& textureRenderer,
+			Blending::BlendModeActivator& blendModeActivator,
+			Renderer::PixelReadback& pixelReadback,
+			Renderer::PixelWriter& pixelWriter,
+			Renderer::RenderTargetPool& renderTargetPool,
+			Brushes::FilterChain& filterChain,
+			std::unique_ptr<Brushes::SolidColorBrush> solidColorBrush,
+			std::unique_ptr<Brushes::TextureBrush> textureBrush
+		);
+
+		Renderer::RenderTarget& GetRenderTarget(RenderTargetHandle renderTarget) const;
+
+		ShapeRenderer::ShapeRenderer& m_ShapeRenderer;
+		TextureRenderer::TextureRenderer& m_TextureRenderer;
+		Blending::BlendModeActivator& m_BlendModeActivator;
+		Renderer::PixelReadback& m_PixelReadback;
+		Renderer::PixelWriter& m_PixelWriter;
+		Renderer::RenderTargetPool& m_RenderTargetPool;
+		Brushes::FilterChain& m_FilterChain;
+
+		std::unique_ptr<Brushes::SolidColorBrush> m_SolidColorBrush;
+		std::unique_ptr<Brushes::TextureBrush> m_TextureBrush;
+
+		std::unique_ptr<Renderer::MainRenderTarget> m_MainRenderTarget;
+		std::vector<std::unique_ptr<Renderer::OffscreenRenderTarget>> m_RenderTargets;	//!< Indexed by the id minus two, empty slots are free
+		std::vector<uint32_t> m_FreeRenderTargets;
+
+		std::vector<PipelineDescription> m_Pipelines;	//!< Indexed by the id minus one
+		PipelineKind m_CurrentPipelineKind;
+
+		std::mutex m_RetiredTextureMutex;
+		std::vector<uint32_t> m_RetiredTextures;			//!< Deleted by EndFrame(), once the queued draw calls have been submitted
+		Texture::TextureDeleter m_PreviousTextureDeleter;
+
+	};
+}
\ No newline at end of file
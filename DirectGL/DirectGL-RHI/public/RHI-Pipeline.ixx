@@ -0,0 +1,40 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-Pipeline.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL.RHI:Pipeline;
+
+import DirectGL.Blending;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.Texture;
+
+export namespace DGL::RHI
+{
+	enum class PipelineKind
+	{
+		SolidColor,		//!< Fills the vertices of RenderDevice::DrawVertices() with DrawConstants::Color
+		Sprite,			//!< Draws the textured quads of RenderDevice::DrawSprite()
+	};
+
+	/// Everything a backend needs to build a pipeline. Devices hand out the same
+	/// handle for equal descriptions, so describing the state of every draw call
+	/// doesn't create new pipelines.
+	struct PipelineDescription
+	{
+		PipelineKind Kind = PipelineKind::SolidColor;
+		Blending::BlendMode BlendMode = Blending::BlendModes::Alpha;
+		Texture::SamplerState Sampler;		//!< How PipelineKind::Sprite samples its textures, ignored otherwise
+
+		constexpr bool operator == (const PipelineDescription&) const = default;
+	};
+
+	/// The values shared by the draw calls following RenderDevice::SetConstants().
+	struct DrawConstants
+	{
+		Math::Matrix4x4 ProjectionView = Math::Matrix4x4::Identity;
+		Math::Matrix4x4 Model = Math::Matrix4x4::Identity;	//!< Ignored by PipelineKind::Sprite, whose instances carry their own transform
+		Renderer::Color Color;								//!< Ignored by PipelineKind::Sprite, whose instances carry their own tint
+	};
+}
\ No newline at end of file
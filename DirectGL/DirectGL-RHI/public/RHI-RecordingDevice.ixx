@@ -0,0 +1,113 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-RecordingDevice.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <span>
+#include <vector>
+
+export module DirectGL.RHI:RecordingDevice;
+
+import DirectGL.Brushes;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
+import DirectGL.TextureRenderer;
+
+import :CommandList;
+import :Handles;
+import :Pipeline;
+import :RenderDevice;
+
+export namespace DGL::RHI
+{
+	/// A backend that records the submitted commands into a CommandList instead of
+	/// executing them. Resources are created by a resource device, whose handles
+	/// the recorded commands refer to, so the list can be submitted to it later on.
+	///
+	/// Without a resource device, the recording device emulates the render targets
+	/// on its own. Nothing reaches a GPU then, which allows measuring the cost of
+	/// recording a frame and the traffic it would cause without any driver involved.
+	/// Offscreen render targets don't have a texture in that case and readbacks
+	/// return zeroed pixels.
+	class RecordingDevice : public RenderDevice
+	{
+	public:
+
+		/// @brief Create the device.
+		/// @param resourceDevice The device creating the resources and receiving the submitted commands, or nullptr to emulate them.
+		/// @param defaultSize The size of the emulated default render target. Ignored if there is a resource device.
+		static std::unique_ptr<RecordingDevice> Create(RenderDevice* resourceDevice, Math::Uint2 defaultSize = {});
+
+		RenderTargetHandle GetDefaultRenderTarget() const override;
+		void ResizeDefaultRenderTarget(Math::Uint2 size) override;
+
+		RenderTargetHandle CreateRenderTarget(Math::Uint2 size, Renderer::RenderTargetAttachments attachments) override;
+		void DestroyRenderTarget(RenderTargetHandle renderTarget) override;
+		Math::Uint2 GetRenderTargetSize(RenderTargetHandle renderTarget) const override;
+		const Texture::Texture* GetRenderTexture(RenderTargetHandle renderTarget) const override;
+
+		TextureHandle GetTextureHandle(const Texture::Texture& texture) override;
+		PipelineHandle GetPipeline(const PipelineDescription& description) override;
+
+		void BeginPass(RenderTargetHandle renderTarget) override;
+		void SetPipeline(PipelineHandle pipeline) override;
+		void SetConstants(const DrawConstants& constants) override;
+		void DrawVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices, ShapeRenderer::PrimitiveType type) override;
+		void UploadVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices) override;
+		void DrawVertexRange(const VertexRange& range) override;
+		void DrawSprite(TextureHandle texture, const TextureRenderer::SpriteInstance& sprite) override;
+		void FlushSprites() override;
+
+		/// @brief Record a readback. It gets requested from the resource device when the commands are submitted.
+		void ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback) override;
+		std::future<Renderer::PixelData> ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void ViewPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback) override;
+
+		/// @brief Submit the recorded commands and read the pixels from the resource device.
+		Renderer::PixelData ReadPixels(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void WritePixels(RenderTargetHandle renderTarget, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount) override;
+		void ApplyFilters(RenderTargetHandle renderTarget, std::span<const Brushes::Filter> filters) override;
+		std::span<const Brushes::FilterTiming> GetFilterTimings() override;
+
+		/// @brief Destroy the render targets released during the frame and forward the call to the resource device.
+		void EndFrame() override;
+
+		/// @brief Replay the commands recorded since the last submission to the resource device.
+		void Submit();
+
+		/// @brief Hand out the recorded commands and start a new list. Commands not
+		///		   submitted until then never reach the resource device.
+		CommandList TakeCommands();
+
+		/// @brief Discard the recorded commands but keep their memory for the next ones.
+		void Clear();
+		const CommandList& GetCommands() const;
+
+		RenderDevice* GetResourceDevice() const;
+
+	private:
+
+		explicit RecordingDevice(RenderDevice* resourceDevice, Math::Uint2 defaultSize);
+
+		/// @brief Get how the commands refer to a render target, so they can be replayed to another device.
+		PassTarget GetPassTarget(RenderTargetHandle renderTarget) const;
+
+		RenderDevice* m_ResourceDevice;
+		CommandList m_Commands;
+		size_t m_SubmittedBytes;	//!< The part of the commands replayed to the resource device
+
+		std::vector<PipelineDescription> m_Pipelines;			//!< Indexed by the id minus one
+		std::vector<RenderTargetHandle> m_ReleasedRenderTargets;	//!< Destroyed once the commands referring to them have been submitted
+
+		std::vector<Math::Uint2> m_RenderTargetSizes;	//!< The emulated render targets, indexed by the id minus one. The default one comes first
+		std::vector<uint32_t> m_FreeRenderTargets;
+
+	};
+}
\ No newline at end of file
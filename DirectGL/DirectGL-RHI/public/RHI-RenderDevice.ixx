@@ -0,0 +1,123 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-RenderDevice.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <future>
+#include <span>
+
+export module DirectGL.RHI:RenderDevice;
+
+import DirectGL.Brushes;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
+import DirectGL.TextureRenderer;
+
+import :Handles;
+import :Pipeline;
+
+export namespace DGL::RHI
+{
+	/// A shape within the vertices passed to RenderDevice::UploadVertices().
+	struct VertexRange
+	{
+		uint32_t FirstVertex = 0;	//!< The vertex the indices of the range count from
+		uint32_t VertexCount = 0;
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;	//!< Zero draws the vertices of the range in order
+		ShapeRenderer::PrimitiveType Type = ShapeRenderer::PrimitiveType::Triangles;
+	};
+
+	/// The interface between the graphics layers and a rendering backend. Layers only
+	/// describe what to draw; the device owns the render targets, pipelines and
+	/// streaming buffers needed to do so. Geometry and sprites get copied into the
+	/// buffers of the device by the draw calls, so the caller may reuse its memory
+	/// right away.
+	///
+	/// Every method must be called on the thread owning the device, except for
+	/// GetTextureHandle(), which must not depend on the state of the device.
+	class RenderDevice
+	{
+	public:
+
+		virtual ~RenderDevice() = default;
+
+		/// @brief Get the render target presenting to the window.
+		virtual RenderTargetHandle GetDefaultRenderTarget() const = 0;
+
+		/// @brief Adapt the render target of the window after the window has been resized.
+		virtual void ResizeDefaultRenderTarget(Math::Uint2 size) = 0;
+
+		/// @brief Create an offscreen render target whose color attachment can be drawn as a texture.
+		/// @return The render target or an invalid handle if the backend failed to create it.
+		virtual RenderTargetHandle CreateRenderTarget(Math::Uint2 size, Renderer::RenderTargetAttachments attachments) = 0;
+
+		/// @brief Destroy an offscreen render target. Commands already submitted still complete.
+		virtual void DestroyRenderTarget(RenderTargetHandle renderTarget) = 0;
+
+		virtual Math::Uint2 GetRenderTargetSize(RenderTargetHandle renderTarget) const = 0;
+
+		/// @return The color attachment of an offscreen render target or nullptr if the backend doesn't keep it in a texture.
+		virtual const Texture::Texture* GetRenderTexture(RenderTargetHandle renderTarget) const = 0;
+
+		/// @brief Get the handle sprites refer to a texture by. Stays valid as long as the texture lives.
+		virtual TextureHandle GetTextureHandle(const Texture::Texture& texture) = 0;
+
+		/// @brief Get the pipeline for a description. Equal descriptions return the same handle.
+		virtual PipelineHandle GetPipeline(const PipelineDescription& description) = 0;
+
+		/// @brief Direct the following draw calls to a render target.
+		virtual void BeginPass(RenderTargetHandle renderTarget) = 0;
+
+		/// @brief Select the pipeline of the following draw calls. Sprites still waiting
+		///		   for FlushSprites() have to be flushed before switching.
+		virtual void SetPipeline(PipelineHandle pipeline) = 0;
+
+		/// @brief Set the constants of the following draw calls. Must follow SetPipeline().
+		virtual void SetConstants(const DrawConstants& constants) = 0;
+
+		/// @brief Draw a shape using PipelineKind::SolidColor.
+		/// @param indices The indices into the positions. An empty span draws the positions in order.
+		virtual void DrawVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices, ShapeRenderer::PrimitiveType type) = 0;
+
+		/// @brief Upload the vertices of many shapes at once, to be drawn by DrawVertexRange().
+		///		   They stay available until the next UploadVertices() or DrawVertices().
+		/// @param indices The indices of all shapes, each shape counting from its first vertex.
+		virtual void UploadVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices) = 0;
+
+		/// @brief Draw a shape of the uploaded vertices using PipelineKind::SolidColor.
+		virtual void DrawVertexRange(const VertexRange& range) = 0;
+
+		/// @brief Queue a textured quad using PipelineKind::Sprite. Sprites get batched
+		///		   until FlushSprites() is called or the batch is full.
+		virtual void DrawSprite(TextureHandle texture, const TextureRenderer::SpriteInstance& sprite) = 0;
+		virtual void FlushSprites() = 0;
+
+		/// @brief Queue an asynchronous copy of a region of a render target.
+		///		   The callback gets invoked by a later EndFrame() once the copy finished.
+		virtual void ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback) = 0;
+		virtual std::future<Renderer::PixelData> ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region) = 0;
+		virtual void ViewPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback) = 0;
+
+		/// @brief Copy a region of a render target, waiting for every command submitted so far.
+		virtual Renderer::PixelData ReadPixels(RenderTargetHandle renderTarget, const Math::UintBoundary& region) = 0;
+
+		/// @brief Replace a band of rows of a render target with pixels from system memory.
+		/// @param pixels The tightly packed RGBA8 pixels of the whole render target, starting with the top row.
+		virtual void WritePixels(RenderTargetHandle renderTarget, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount) = 0;
+
+		/// @brief Filter the contents of a render target in place.
+		virtual void ApplyFilters(RenderTargetHandle renderTarget, std::span<const Brushes::Filter> filters) = 0;
+
+		/// @brief Get the GPU time of every filter of the latest chain whose measurements are available.
+		virtual std::span<const Brushes::FilterTiming> GetFilterTimings() = 0;
+
+		/// @brief Called once per frame after presenting. Delivers finished readbacks and recycles released resources.
+		virtual void EndFrame() = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-SoftwareDevice.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+export module DirectGL.RHI:SoftwareDevice;
+
+import DirectGL.Brushes;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.ShapeRenderer;
+import DirectGL.SoftwareRenderer;
+import DirectGL.Texture;
+import DirectGL.TextureRenderer;
+import Jobs;
+
+import :Handles;
+import :Pipeline;
+import :RenderDevice;
+
+export namespace DGL::RHI
+{
+	/// The CPU backend. Every render target is a framebuffer in system memory, which
+	/// the tile rasteriser draws into using the workers of the job system. Present()
+	/// copies the default render target into the window through the pixel writer.
+	///
+	/// Texture handles are ids of the device. The texels of a texture get copied into
+	/// system memory the first time one of its sprites is drawn and again whenever its
+	/// revision changes. Offscreen render targets have no texture to draw them with and
+	/// filters aren't supported.
+	class SoftwareDevice : public RenderDevice
+	{
+	public:
+
+		/// @brief Create the device.
+		/// @param windowSize The size of the default render target.
+		/// @param jobSystem The workers rasterising the tiles, or nullptr to rasterise them on the calling thread.
+		/// @param pixelWriter Presents the default render target. Must outlive the device.
+		static std::unique_ptr<SoftwareDevice> Create(Math::Uint2 windowSize, Jobs::JobSystem* jobSystem, Renderer::PixelWriter& pixelWriter);
+
+		/// @brief Forward the deletion of textures to the deleter installed before the device.
+		~SoftwareDevice() override;
+
+		/// @brief Rasterise every queued primitive and copy the default render target into the window.
+		void Present();
+
+		/// @brief Get the statistics of the tiles rasterised by the latest flush.
+		SoftwareRenderer::RasterizerStatistics GetStatistics() const;
+
+		RenderTargetHandle GetDefaultRenderTarget() const override;
+		void ResizeDefaultRenderTarget(Math::Uint2 size) override;
+
+		RenderTargetHandle CreateRenderTarget(Math::Uint2 size, Renderer::RenderTargetAttachments attachments) override;
+		void DestroyRenderTarget(RenderTargetHandle renderTarget) override;
+		Math::Uint2 GetRenderTargetSize(RenderTargetHandle renderTarget) const override;
+		const Texture::Texture* GetRenderTexture(RenderTargetHandle renderTarget) const override;
+
+		TextureHandle GetTextureHandle(const Texture::Texture& texture) override;
+		PipelineHandle GetPipeline(const PipelineDescription& description) override;
+
+		void BeginPass(RenderTargetHandle renderTarget) override;
+		void SetPipeline(PipelineHandle pipeline) override;
+		void SetConstants(const DrawConstants& constants) override;
+		void DrawVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices, ShapeRenderer::PrimitiveType type) override;
+		void UploadVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices) override;
+		void DrawVertexRange(const VertexRange& range) override;
+		void DrawSprite(TextureHandle texture, const TextureRenderer::SpriteInstance& sprite) override;
+		void FlushSprites() override;
+
+		void ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback) override;
+		std::future<Renderer::PixelData> ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void ViewPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback) override;
+		Renderer::PixelData ReadPixels(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void WritePixels(RenderTargetHandle renderTarget, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount) override;
+		void ApplyFilters(RenderTargetHandle renderTarget, std::span<const Brushes::Filter> filters) override;
+		std::span<const Brushes::FilterTiming> GetFilterTimings() override;
+
+		void EndFrame() override;
+
+	private:
+
+		/// A texture sprites refer to, keyed by the id of its handle.
+		struct TextureEntry
+		{
+			const Texture::Texture* Source;									//!< The entry gets removed once the texture is deleted
+			uint64_t Revision;												//!< The revision of the source the texels have been copied from
+			std::unique_ptr<SoftwareRenderer::SoftwareTexture> Texels;		//!< nullptr if the texels can't be sampled, e.g. because they are block compressed
+		};
+
+		explicit SoftwareDevice(Math::Uint2 windowSize, std::unique_ptr<SoftwareRenderer::TileRasterizer> rasterizer, Renderer::PixelWriter& pixelWriter);
+
+		SoftwareRenderer::SoftwareFramebuffer& GetFramebuffer(RenderTargetHandle renderTarget) const;
+
+		/// @brief Get the texels of a texture, copying them from the source if they are missing or outdated.
+		/// @return The texels or nullptr if the handle is unknown or the texture can't be sampled.
+		const SoftwareRenderer::SoftwareTexture* ResolveTexture(TextureHandle texture);
+
+		/// @brief Hand the queued sprites to the rasteriser.
+		void SubmitSprites();
+
+		/// @brief Rasterise every queued primitive and release the texels of deleted textures.
+		void Flush();
+
+		/// @brief Forget the texels of an OpenGL texture that got deleted.
+		void RetireTexture(uint32_t textureId);
+
+		std::unique_ptr<SoftwareRenderer::TileRasterizer> m_Rasterizer;
+		Renderer::PixelWriter& m_PixelWriter;
+
+		std::unique_ptr<Renderer::MainRenderTarget> m_MainRenderTarget;
+		std::unique_ptr<SoftwareRenderer::SoftwareFramebuffer> m_MainFramebuffer;
+		std::vector<std::unique_ptr<SoftwareRenderer::SoftwareFramebuffer>> m_RenderTargets;	//!< Indexed by the id minus two, empty slots are free
+		std::vector<uint32_t> m_FreeRenderTargets;
+		SoftwareRenderer::SoftwareFramebuffer* m_PassFramebuffer;		//!< The framebuffer selected by BeginPass()
+
+		std::vector<PipelineDescription> m_Pipelines;	//!< Indexed by the id minus one
+		PipelineDescription m_Pipeline;
+		DrawConstants m_Constants;
+
+		std::vector<Math::Float3> m_UploadedPositions;
+		std::vector<uint32_t> m_UploadedIndices;
+
+		std::vector<TextureRenderer::SpriteInstance> m_Sprites;		//!< The sprites of the same texture waiting for SubmitSprites()
+		const SoftwareRenderer::SoftwareTexture* m_SpriteTexture;
+
+		std::vector<std::function<void()>> m_PendingReadbacks;		//!< The callbacks delivered by the next EndFrame()
+
+		std::mutex m_TextureMutex;										//!< Guards the textures, handles get requested by recording threads
+		std::unordered_map<uint32_t, TextureEntry> m_Textures;
+		std::unordered_map<uint32_t, uint32_t> m_TextureIds;			//!< The id of the handle of every OpenGL texture
+		std::vector<std::unique_ptr<SoftwareRenderer::SoftwareTexture>> m_RetiredTextures;	//!< Kept until the next flush, the rasteriser may still sample them
+		uint32_t m_NextTextureId;
+		Texture::TextureDeleter m_PreviousTextureDeleter;
+
+		bool m_HasWarnedAboutFilters;
+
+	};
+}
\ No newline at end of file
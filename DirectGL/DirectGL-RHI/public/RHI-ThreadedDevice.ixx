@@ -0,0 +1,211 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI-ThreadedDevice.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+export module DirectGL.RHI:ThreadedDevice;
+
+import DirectGL.Brushes;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
+import DirectGL.TextureRenderer;
+
+import :CommandList;
+import :Handles;
+import :Pipeline;
+import :RenderDevice;
+
+namespace DGL::RHI
+{
+	/// A thread running tasks in the order they were posted.
+	class RenderThread
+	{
+	public:
+
+		explicit RenderThread(std::function<void()> onStart, std::function<void()> onExit);
+		~RenderThread();
+
+		void Post(std::function<void()> task);
+
+		/// @brief Run a task on the thread and wait until it finished.
+		void Invoke(const std::function<void()>& task);
+
+	private:
+
+		void Run(std::stop_token stopToken);
+
+		std::function<void()> m_OnStart;
+		std::function<void()> m_OnExit;
+
+		std::mutex m_Mutex;
+		std::condition_variable_any m_TaskAvailable;
+		std::deque<std::function<void()>> m_Tasks;
+
+		std::jthread m_Thread;
+
+	};
+}
+
+export namespace DGL::RHI
+{
+	/// The hooks a ThreadedDevice runs on its render thread.
+	struct RenderThreadCallbacks
+	{
+		std::function<void()> Attach;	//!< Make the context of the device current, runs before anything else
+		std::function<void()> Present;	//!< Present the default render target once a frame has been submitted
+		std::function<void()> Detach;	//!< Release the context of the device before the thread exits
+	};
+
+	struct RenderThreadStatistics
+	{
+		uint64_t SubmittedFrames = 0;			//!< The frames handed to the render thread
+		uint64_t CompletedFrames = 0;			//!< The frames submitted to the device and presented
+		uint64_t Invocations = 0;				//!< The resource calls the recording thread had to wait for
+		std::chrono::microseconds AverageFrameTime = {};	//!< The time the render thread needs to submit and present a frame
+		std::chrono::microseconds AverageStallTime = {};	//!< The time the recording thread waits for a frame to leave the flight
+	};
+
+	/// Runs a device on a render thread of its own, which owns its context. The
+	/// recording thread records frame N into a CommandList while the render thread
+	/// still submits frame N-1, so the time spent drawing and the time spent in the
+	/// driver overlap. At most a given number of frames is in flight; recording
+	/// the next one waits until the oldest has been presented.
+	///
+	/// Resources are created on the render thread, the recording thread waits for
+	/// those calls. It may create textures in a context sharing its objects with the
+	/// context of the device: every frame carries a fence of the recording context,
+	/// which the render thread waits for before it reads the textures. Textures
+	/// deleted meanwhile stay alive until the render thread submitted the frame
+	/// recorded at the time. Readbacks get delivered on the recording thread by EndFrame().
+	class ThreadedDevice : public RenderDevice
+	{
+	public:
+
+		/// @brief Start the render thread.
+		/// @param device The device to run. It must not be used by any other thread and has to outlive this object.
+		/// @param maxFramesInFlight The number of frames recorded ahead of the one being presented, at least one.
+		static std::unique_ptr<ThreadedDevice> Create(RenderDevice& device, uint32_t maxFramesInFlight, RenderThreadCallbacks callbacks);
+
+		/// @brief Finish the submitted frames and stop the render thread.
+		~ThreadedDevice() override;
+
+		RenderTargetHandle GetDefaultRenderTarget() const override;
+		void ResizeDefaultRenderTarget(Math::Uint2 size) override;
+
+		RenderTargetHandle CreateRenderTarget(Math::Uint2 size, Renderer::RenderTargetAttachments attachments) override;
+		void DestroyRenderTarget(RenderTargetHandle renderTarget) override;
+		Math::Uint2 GetRenderTargetSize(RenderTargetHandle renderTarget) const override;
+		const Texture::Texture* GetRenderTexture(RenderTargetHandle renderTarget) const override;
+
+		TextureHandle GetTextureHandle(const Texture::Texture& texture) override;
+		PipelineHandle GetPipeline(const PipelineDescription& description) override;
+
+		void BeginPass(RenderTargetHandle renderTarget) override;
+		void SetPipeline(PipelineHandle pipeline) override;
+		void SetConstants(const DrawConstants& constants) override;
+		void DrawVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices, ShapeRenderer::PrimitiveType type) override;
+		void UploadVertices(std::span<const Math::Float3> positions, std::span<const uint32_t> indices) override;
+		void DrawVertexRange(const VertexRange& range) override;
+		void DrawSprite(TextureHandle texture, const TextureRenderer::SpriteInstance& sprite) override;
+		void FlushSprites() override;
+
+		void ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelCallback callback) override;
+		std::future<Renderer::PixelData> ReadPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void ViewPixelsAsync(RenderTargetHandle renderTarget, const Math::UintBoundary& region, Renderer::PixelViewCallback callback) override;
+
+		/// @brief Wait until the render thread submitted everything recorded so far and read the pixels.
+		Renderer::PixelData ReadPixels(RenderTargetHandle renderTarget, const Math::UintBoundary& region) override;
+		void WritePixels(RenderTargetHandle renderTarget, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount) override;
+		void ApplyFilters(RenderTargetHandle renderTarget, std::span<const Brushes::Filter> filters) override;
+		std::span<const Brushes::FilterTiming> GetFilterTimings() override;
+
+		/// @brief Deliver the readbacks the render thread finished. The device itself ends
+		///		   its frames on the render thread, after presenting them.
+		void EndFrame() override;
+
+		/// @brief Hand the commands recorded since the previous frame to the render thread,
+		///		   which submits and presents them. Waits while too many frames are in flight.
+		void SubmitFrame();
+
+		/// @brief Wait until the render thread presented every submitted frame.
+		void WaitIdle();
+
+		/// @brief Run a function on the render thread, where the device and its context may be used, and wait for it.
+		void Invoke(const std::function<void(RenderDevice&)>& function);
+
+		RenderThreadStatistics GetStatistics() const;
+
+	private:
+
+		struct RenderTargetInfo
+		{
+			Math::Uint2 Size;
+			const Texture::Texture* RenderTexture = nullptr;
+		};
+
+		explicit ThreadedDevice(RenderDevice& device, uint32_t maxFramesInFlight, RenderThreadCallbacks callbacks);
+
+		/// @brief Post the commands recorded so far to the render thread.
+		/// @param present Whether they complete a frame, which gets presented afterwards.
+		void PostCommands(bool present);
+
+		RenderTargetInfo GetRenderTargetInfo(RenderTargetHandle renderTarget) const;
+		PassTarget GetPassTarget(RenderTargetHandle renderTarget) const;
+
+		/// @brief Hand textures deleted by the recording thread to the device. Runs on the render thread.
+		void ReleaseTextures(std::span<const uint32_t> textures) const;
+
+		/// @brief Destroy the render targets released by the recording thread. Runs on the render thread.
+		void ReleaseRenderTargets(std::span<const RenderTargetHandle> renderTargets) const;
+
+		RenderDevice& m_Device;
+		RenderThreadCallbacks m_Callbacks;
+		uint32_t m_MaxFramesInFlight;
+		RenderTargetHandle m_DefaultRenderTarget;
+
+		// Only used by the recording thread
+		CommandList m_Commands;
+		std::vector<PipelineDescription> m_Pipelines;								//!< Indexed by the id minus one
+		mutable std::unordered_map<uint32_t, RenderTargetInfo> m_RenderTargets;	//!< The sizes and textures of the render targets, so drawing doesn't wait for the render thread
+		mutable std::mutex m_RenderTargetMutex;									//!< Guards m_RenderTargets and m_ReleasedRenderTargets, graphics layers recording on worker threads look them up
+		std::vector<RenderTargetHandle> m_ReleasedRenderTargets;					//!< Destroyed by the render thread after the commands recorded so far
+		std::vector<Brushes::FilterTiming> m_FilterTimings;
+		uint64_t m_SubmittedFrames;
+		bool m_FrameSubmitted;		//!< Whether a frame has been submitted since the latest EndFrame()
+		mutable std::atomic<uint64_t> m_Invocations;	//!< Also counts the lookups of worker threads
+		std::chrono::steady_clock::duration m_StallTime;
+
+		// Shared with the render thread
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_FrameCompleted;
+		uint64_t m_CompletedFrames;
+		std::chrono::steady_clock::duration m_FrameTime;
+		std::vector<std::function<void()>> m_Deliveries;	//!< The readbacks finished by the render thread, waiting for EndFrame()
+
+		// Filled by any thread deleting a texture
+		std::mutex m_RetiredTextureMutex;
+		std::vector<uint32_t> m_RetiredTextures;	//!< Released by the render thread after the commands recorded so far
+		Texture::TextureDeleter m_DeviceTextureDeleter;	//!< The deleter of the device, used by the render thread
+
+		std::unique_ptr<RenderThread> m_RenderThread;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+﻿// Project Name : DirectGL-RHI
+// File Name    : RHI.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL.RHI;
+
+export import :Handles;
+export import :Pipeline;
+export import :RenderDevice;
+export import :OpenGLDevice;
+export import :CommandList;
+export import :RecordingDevice;
+export import :ThreadedDevice;
+export import :SoftwareDevice;
\ No newline at end of file
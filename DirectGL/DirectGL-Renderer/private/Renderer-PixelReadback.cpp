@@ -0,0 +1,200 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <memory>
+
+module DirectGL.Renderer;
+
+import DirectGL.Logging;
+
+namespace DGL::Renderer
+{
+	std::unique_ptr<PixelReadback> PixelReadback::Create()
+	{
+		return std::unique_ptr<PixelReadback>(new PixelReadback());
+	}
+
+	PixelReadback::~PixelReadback()
+	{
+		for (Slot& slot : m_Slots)
+		{
+			if (slot.Fence != nullptr) glDeleteSync(slot.Fence);
+			if (slot.BufferId != 0) glDeleteBuffers(1, &slot.BufferId);
+		}
+	}
+
+	void PixelReadback::Request(const RenderTarget& renderTarget, const Math::UintBoundary& region, PixelCallback callback)
+	{
+		RequestView(renderTarget, region, [callback = std::move(callback)](const PixelView& view)
+		{
+			PixelData data = { .Region = view.Region, .Pixels = {} };
+
+			// Flip the rows, so the top row comes first
+			const size_t stride = view.GetStride();
+			data.Pixels.resize(stride * view.Region.Height);
+
+			for (uint32_t row = 0; row < view.Region.Height; ++row)
+			{
+				std::memcpy(data.Pixels.data() + row * stride, view.GetRow(row), stride);
+			}
+
+			callback(std::move(data));
+		});
+	}
+
+	std::future<PixelData> PixelReadback::Request(const RenderTarget& renderTarget, const Math::UintBoundary& region)
+	{
+		// std::function requires copyable targets, so the promise gets shared
+		auto promise = std::make_shared<std::promise<PixelData>>();
+		std::future<PixelData> future = promise->get_future();
+
+		Request(renderTarget, region, [promise](PixelData&& data) { promise->set_value(std::move(data)); });
+		return future;
+	}
+
+	void PixelReadback::RequestView(const RenderTarget& renderTarget, const Math::UintBoundary& region, PixelViewCallback callback)
+	{
+		const Math::Uint2 size = renderTarget.GetSize();
+		const uint32_t left = std::min(region.Left, size.X);
+		const uint32_t top = std::min(region.Top, size.Y);
+		const uint32_t width = std::min(region.Width, size.X - left);
+		const uint32_t height = std::min(region.Height, size.Y - top);
+
+		const auto clampedRegion = Math::UintBoundary::FromLTWH(left, top, width, height);
+
+		if (width == 0 or height == 0)
+		{
+			callback(PixelView { .Region = clampedRegion, .Pixels = nullptr });
+			return;
+		}
+
+		const size_t byteCount = static_cast<size_t>(width) * height * 4;
+		const size_t slotIndex = AcquireSlot(byteCount);
+		Slot& slot = m_Slots[slotIndex];
+
+		// The framebuffer origin is the bottom-left corner
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, renderTarget.GetFramebufferId());
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.BufferId);
+		glReadPixels(
+			static_cast<GLint>(left), static_cast<GLint>(size.Y - top - height),
+			static_cast<GLsizei>(width), static_cast<GLsizei>(height),
+			GL_RGBA, GL_UNSIGNED_BYTE, nullptr
+		);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.Region = clampedRegion;
+		slot.Callback = std::move(callback);
+		m_PendingSlots.push_back(slotIndex);
+	}
+
+	size_t PixelReadback::Poll()
+	{
+		size_t delivered = 0;
+
+		while (not m_PendingSlots.empty())
+		{
+			const size_t slotIndex = m_PendingSlots.front();
+			Slot& slot = m_Slots[slotIndex];
+
+			const GLenum status = glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			if (status != GL_ALREADY_SIGNALED and status != GL_CONDITION_SATISFIED)
+			{
+				break;
+			}
+
+			glDeleteSync(slot.Fence);
+			slot.Fence = nullptr;
+			m_PendingSlots.pop_front();
+
+			// The callback may request new copies, which can reallocate the slots.
+			// The slot only becomes free afterwards, so its buffer can't be reused meanwhile.
+			const PixelView view = { .Region = slot.Region, .Pixels = slot.MappedData };
+			const PixelViewCallback callback = std::move(slot.Callback);
+
+			callback(view);
+			m_FreeSlots.push_back(slotIndex);
+			++delivered;
+		}
+
+		return delivered;
+	}
+
+	void PixelReadback::Finish()
+	{
+		constexpr GLuint64 timeout = 1'000'000'000;
+
+		while (not m_PendingSlots.empty())
+		{
+			// Fences signal in order, so the newest one covers every copy before it
+			const GLsync fence = m_Slots[m_PendingSlots.back()].Fence;
+
+			GLenum status = GL_TIMEOUT_EXPIRED;
+			while (status == GL_TIMEOUT_EXPIRED)
+			{
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+			}
+
+			if (status == GL_WAIT_FAILED)
+			{
+				Logging::Error("PixelReadback::Finish() failed to wait for the pending copies.");
+				return;
+			}
+
+			Poll();
+		}
+	}
+
+	size_t PixelReadback::GetPendingCount() const
+	{
+		return m_PendingSlots.size();
+	}
+
+	size_t PixelReadback::AcquireSlot(const size_t byteCount)
+	{
+		// Prefer the smallest free buffer that is large enough
+		auto best = m_FreeSlots.end();
+		for (auto it = m_FreeSlots.begin(); it != m_FreeSlots.end(); ++it)
+		{
+			const size_t capacity = m_Slots[*it].Capacity;
+			if (capacity >= byteCount and (best == m_FreeSlots.end() or capacity < m_Slots[*best].Capacity))
+			{
+				best = it;
+			}
+		}
+
+		if (best != m_FreeSlots.end())
+		{
+			const size_t slotIndex = *best;
+			m_FreeSlots.erase(best);
+			return slotIndex;
+		}
+
+		// Otherwise grow a free buffer or add a new one, buffer storage is immutable
+		size_t slotIndex = m_Slots.size();
+		if (not m_FreeSlots.empty())
+		{
+			slotIndex = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			glDeleteBuffers(1, &m_Slots[slotIndex].BufferId);
+		}
+		else
+		{
+			m_Slots.emplace_back();
+		}
+
+		Slot& slot = m_Slots[slotIndex];
+		constexpr GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glCreateBuffers(1, &slot.BufferId);
+		glNamedBufferStorage(slot.BufferId, static_cast<GLsizeiptr>(byteCount), nullptr, flags);
+		slot.MappedData = static_cast<uint8_t*>(glMapNamedBufferRange(slot.BufferId, 0, static_cast<GLsizeiptr>(byteCount), flags));
+		slot.Capacity = byteCount;
+
+		return slotIndex;
+	}
+}
\ No newline at end of file
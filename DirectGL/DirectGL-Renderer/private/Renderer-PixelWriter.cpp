@@ -0,0 +1,58 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <memory>
+
+module DirectGL.Renderer;
+
+namespace DGL::Renderer
+{
+	std::unique_ptr<PixelWriter> PixelWriter::Create()
+	{
+		return std::unique_ptr<PixelWriter>(new PixelWriter());
+	}
+
+	PixelWriter::~PixelWriter()
+	{
+		if (m_FramebufferId != 0) glDeleteFramebuffers(1, &m_FramebufferId);
+	}
+
+	void PixelWriter::Write(const RenderTarget& renderTarget, const uint8_t* pixels, const uint32_t firstRow, const uint32_t rowCount)
+	{
+		const Math::Uint2 size = renderTarget.GetSize();
+		const uint32_t top = std::min(firstRow, size.Y);
+		const uint32_t height = std::min(rowCount, size.Y - top);
+
+		if (size.X == 0 or height == 0)
+		{
+			return;
+		}
+
+		// The texture follows the size of the render target, its texels are overwritten anyway
+		if (m_Texture == nullptr or m_Texture->GetSize() != size)
+		{
+			m_Texture = Texture::Texture::Create(size, nullptr);
+			m_Texture->SetCategory(Texture::TextureCategory::RenderTarget);
+			glNamedFramebufferTexture(m_FramebufferId, GL_COLOR_ATTACHMENT0, m_Texture->GetRendererId(), 0);
+		}
+
+		const size_t stride = static_cast<size_t>(size.X) * 4;
+		m_Texture->Update(Math::UintBoundary::FromLTWH(0, top, size.X, height), pixels + top * stride, stride);
+
+		// The texture stores the top row first, whereas the framebuffer origin is the bottom-left corner
+		glBlitNamedFramebuffer(
+			m_FramebufferId, renderTarget.GetFramebufferId(),
+			0, static_cast<GLint>(top), static_cast<GLint>(size.X), static_cast<GLint>(top + height),
+			0, static_cast<GLint>(size.Y - top), static_cast<GLint>(size.X), static_cast<GLint>(size.Y - top - height),
+			GL_COLOR_BUFFER_BIT, GL_NEAREST
+		);
+	}
+
+	PixelWriter::PixelWriter():
+		m_FramebufferId(0)
+	{
+		glCreateFramebuffers(1, &m_FramebufferId);
+	}
+}
\ No newline at end of file
@@ -35,6 +35,16 @@ namespace DGL::Renderer
 	//	Logging::Info(std::format("Activated MainRenderTarget with viewport size {}x{}", m_Viewport.Width, m_Viewport.Height));
 	}
 
+	GLuint MainRenderTarget::GetFramebufferId() const
+	{
+		return 0;
+	}
+
+	Math::Uint2 MainRenderTarget::GetSize() const
+	{
+		return { m_Viewport.Left + m_Viewport.Width, m_Viewport.Top + m_Viewport.Height };
+	}
+
 	MainRenderTarget::MainRenderTarget(const Math::UintBoundary viewport):
 		m_Viewport(viewport)
 	{
@@ -43,7 +53,13 @@ namespace DGL::Renderer
 
 namespace DGL::Renderer
 {
-	std::unique_ptr<OffscreenRenderTarget> OffscreenRenderTarget::Create(const Math::Uint2 viewportSize)
+	/// GL_DEPTH24_STENCIL8 occupies 4 bytes per texel
+	static int64_t GetDepthStencilByteSize(const Math::Uint2 size)
+	{
+		return static_cast<int64_t>(size.X) * size.Y * 4;
+	}
+
+	std::unique_ptr<OffscreenRenderTarget> OffscreenRenderTarget::Create(const Math::Uint2 viewportSize, const RenderTargetAttachments attachments)
 	{
 		if (viewportSize.X == 0 or viewportSize.Y == 0)
 		{
@@ -58,30 +74,50 @@ namespace DGL::Renderer
 			return nullptr;
 		}
 
-		GLuint renderbufferId = 0;
-		glCreateRenderbuffers(1, &renderbufferId);
-		glNamedRenderbufferStorage(renderbufferId, GL_DEPTH24_STENCIL8, viewportSize.X, viewportSize.Y);
+		renderTexture->SetCategory(Texture::TextureCategory::RenderTarget);
 
 		GLuint framebufferId = 0;
 		glCreateFramebuffers(1, &framebufferId);
 		glNamedFramebufferTexture(framebufferId, GL_COLOR_ATTACHMENT0, renderTexture->GetRendererId(), 0);
-		glNamedFramebufferRenderbuffer(framebufferId, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderbufferId);
+
+		GLuint renderbufferId = 0;
+		if (attachments == RenderTargetAttachments::ColorDepthStencil)
+		{
+			glCreateRenderbuffers(1, &renderbufferId);
+			glNamedRenderbufferStorage(renderbufferId, GL_DEPTH24_STENCIL8, viewportSize.X, viewportSize.Y);
+			glNamedFramebufferRenderbuffer(framebufferId, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderbufferId);
+		}
 
 		if (glCheckNamedFramebufferStatus(framebufferId, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		{
-			glDeleteRenderbuffers(1, &renderbufferId);
+			if (renderbufferId != 0) glDeleteRenderbuffers(1, &renderbufferId);
 			glDeleteFramebuffers(1, &framebufferId);
 			Logging::Error("Failed to create complete framebuffer for OffscreenRenderTarget.");
 			return nullptr;
 		}
 
-		return std::unique_ptr<OffscreenRenderTarget>(new OffscreenRenderTarget(viewportSize, framebufferId, renderbufferId, std::move(renderTexture)));
+		if (renderbufferId != 0)
+		{
+			Texture::TrackTextureMemory(Texture::TextureCategory::DepthStencil, GetDepthStencilByteSize(viewportSize));
+		}
+
+		return std::unique_ptr<OffscreenRenderTarget>(new OffscreenRenderTarget(viewportSize, framebufferId, renderbufferId, std::move(renderTexture), attachments));
+	}
+
+	size_t OffscreenRenderTarget::CalculateByteSize(const Math::Uint2 viewportSize, const RenderTargetAttachments attachments)
+	{
+		const size_t colorByteSize = static_cast<size_t>(viewportSize.X) * viewportSize.Y * 4;
+		return attachments == RenderTargetAttachments::ColorDepthStencil ? colorByteSize + static_cast<size_t>(GetDepthStencilByteSize(viewportSize)) : colorByteSize;
 	}
 
 	OffscreenRenderTarget::~OffscreenRenderTarget()
 	{
 		if (m_FramebufferId != 0) glDeleteFramebuffers(1, &m_FramebufferId);
-		if (m_RenderbufferId != 0) glDeleteRenderbuffers(1, &m_RenderbufferId);
+		if (m_RenderbufferId != 0)
+		{
+			glDeleteRenderbuffers(1, &m_RenderbufferId);
+			Texture::TrackTextureMemory(Texture::TextureCategory::DepthStencil, -GetDepthStencilByteSize(m_ViewportSize));
+		}
 	}
 
 	void OffscreenRenderTarget::Activate()
@@ -91,16 +127,32 @@ namespace DGL::Renderer
 	//	Logging::Info(std::format("Activated OffscreenRenderTarget with viewport size {}x{}", m_ViewportSize.X, m_ViewportSize.Y));
 	}
 
+	GLuint OffscreenRenderTarget::GetFramebufferId() const
+	{
+		return m_FramebufferId;
+	}
+
+	Math::Uint2 OffscreenRenderTarget::GetSize() const
+	{
+		return m_ViewportSize;
+	}
+
 	const Texture::Texture& OffscreenRenderTarget::GetRenderTexture() const
 	{
 		return *m_RenderTexture;
 	}
 
-	OffscreenRenderTarget::OffscreenRenderTarget(const Math::Uint2 viewportSize, const GLuint framebufferId, const GLuint renderbufferId, std::unique_ptr<Texture::Texture> renderTexture):
+	RenderTargetAttachments OffscreenRenderTarget::GetAttachments() const
+	{
+		return m_Attachments;
+	}
+
+	OffscreenRenderTarget::OffscreenRenderTarget(const Math::Uint2 viewportSize, const GLuint framebufferId, const GLuint renderbufferId, std::unique_ptr<Texture::Texture> renderTexture, const RenderTargetAttachments attachments):
 		m_FramebufferId(framebufferId),
 		m_RenderbufferId(renderbufferId),
 		m_RenderTexture(std::move(renderTexture)),
-		m_ViewportSize(viewportSize)
+		m_ViewportSize(viewportSize),
+		m_Attachments(attachments)
 	{
 	}
 }
\ No newline at end of file
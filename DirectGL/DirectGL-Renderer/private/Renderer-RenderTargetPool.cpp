@@ -0,0 +1,108 @@
+﻿module;
+
+#include <algorithm>
+#include <memory>
+
+module DirectGL.Renderer;
+
+namespace DGL::Renderer
+{
+	std::unique_ptr<RenderTargetPool> RenderTargetPool::Create(const RenderTargetPoolSettings& settings)
+	{
+		return std::unique_ptr<RenderTargetPool>(new RenderTargetPool(settings));
+	}
+
+	std::unique_ptr<OffscreenRenderTarget> RenderTargetPool::Acquire(const Math::Uint2 size, const RenderTargetAttachments attachments)
+	{
+		++m_Statistics.Acquisitions;
+
+		// Prefer the target released longest ago, the GPU is least likely to still use it
+		const auto it = std::ranges::find_if(m_Entries, [&](const Entry& entry)
+		{
+			return entry.AvailableFrame <= m_FrameIndex
+				and entry.RenderTarget->GetSize() == size
+				and entry.RenderTarget->GetAttachments() == attachments;
+		});
+
+		if (it != m_Entries.end())
+		{
+			std::unique_ptr<OffscreenRenderTarget> renderTarget = std::move(it->RenderTarget);
+			m_Entries.erase(it);
+
+			++m_Statistics.Hits;
+			++m_Statistics.ActiveTargets;
+			--m_Statistics.PooledTargets;
+			m_Statistics.PooledBytes -= OffscreenRenderTarget::CalculateByteSize(size, attachments);
+			return renderTarget;
+		}
+
+		auto renderTarget = OffscreenRenderTarget::Create(size, attachments);
+		if (renderTarget != nullptr)
+		{
+			++m_Statistics.ActiveTargets;
+		}
+
+		return renderTarget;
+	}
+
+	void RenderTargetPool::Release(std::unique_ptr<OffscreenRenderTarget> renderTarget)
+	{
+		Insert(std::move(renderTarget), m_FrameIndex + m_Settings.ReleaseDelay);
+	}
+
+	void RenderTargetPool::ReleaseImmediately(std::unique_ptr<OffscreenRenderTarget> renderTarget)
+	{
+		Insert(std::move(renderTarget), m_FrameIndex);
+	}
+
+	void RenderTargetPool::EndFrame()
+	{
+		++m_FrameIndex;
+
+		// The entries are ordered by release frame, so the expired ones are at the front
+		const auto expired = std::ranges::find_if(m_Entries, [this](const Entry& entry)
+		{
+			return entry.ReleaseFrame + m_Settings.MaxIdleFrames > m_FrameIndex;
+		});
+
+		for (auto it = m_Entries.begin(); it != expired; ++it)
+		{
+			--m_Statistics.PooledTargets;
+			m_Statistics.PooledBytes -= OffscreenRenderTarget::CalculateByteSize(it->RenderTarget->GetSize(), it->RenderTarget->GetAttachments());
+		}
+
+		m_Entries.erase(m_Entries.begin(), expired);
+	}
+
+	void RenderTargetPool::Trim()
+	{
+		m_Entries.clear();
+		m_Statistics.PooledTargets = 0;
+		m_Statistics.PooledBytes = 0;
+	}
+
+	RenderTargetPoolStatistics RenderTargetPool::GetStatistics() const
+	{
+		return m_Statistics;
+	}
+
+	RenderTargetPool::RenderTargetPool(const RenderTargetPoolSettings& settings):
+		m_Settings(settings),
+		m_FrameIndex(0)
+	{
+	}
+
+	void RenderTargetPool::Insert(std::unique_ptr<OffscreenRenderTarget> renderTarget, const uint64_t availableFrame)
+	{
+		if (renderTarget == nullptr)
+		{
+			return;
+		}
+
+		--m_Statistics.ActiveTargets;
+		++m_Statistics.PooledTargets;
+		m_Statistics.PooledBytes += OffscreenRenderTarget::CalculateByteSize(renderTarget->GetSize(), renderTarget->GetAttachments());
+
+		m_Entries.push_back({ .RenderTarget = std::move(renderTarget), .ReleaseFrame = m_FrameIndex, .AvailableFrame = availableFrame });
+	}
+}
\ No newline at end of file
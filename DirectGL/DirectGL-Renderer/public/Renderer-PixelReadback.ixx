@@ -0,0 +1,113 @@
+﻿// Project Name : DirectGL-Renderer
+// File Name    : Renderer-PixelReadback.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <glad/gl.h>
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+export module DirectGL.Renderer:PixelReadback;
+
+import DirectGL.Math;
+
+import :RenderTarget;
+
+export namespace DGL::Renderer
+{
+	struct PixelData
+	{
+		Math::UintBoundary Region;		//!< The region of the render target in pixels, measured from the top-left corner
+		std::vector<uint8_t> Pixels;	//!< Tightly packed RGBA8 pixels, starting with the top row
+	};
+
+	struct PixelView
+	{
+		Math::UintBoundary Region;		//!< The region of the render target in pixels, measured from the top-left corner
+		const uint8_t* Pixels;			//!< Tightly packed RGBA8 pixels as stored by OpenGL, starting with the bottom row
+
+		/// @brief Get a row of the region.
+		/// @param row The row, counted from the top.
+		/// @return The RGBA8 pixels of the row.
+		const uint8_t* GetRow(const uint32_t row) const
+		{
+			return Pixels + static_cast<size_t>(Region.Height - 1 - row) * GetStride();
+		}
+
+		/// @return The size of a row in bytes.
+		size_t GetStride() const
+		{
+			return static_cast<size_t>(Region.Width) * 4;
+		}
+	};
+
+	using PixelCallback = std::function<void(PixelData&&)>;
+	using PixelViewCallback = std::function<void(const PixelView&)>;
+
+	/// Copies pixels of render targets into a pool of pixel pack buffers. Each copy
+	/// gets guarded by a fence and is only delivered by Poll() once the GPU finished
+	/// it, which usually takes one or two frames. Neither side ever waits for the other.
+	class PixelReadback
+	{
+	public:
+
+		static std::unique_ptr<PixelReadback> Create();
+
+		~PixelReadback();
+
+		/// @brief Queue a copy of a region of a render target. Pending draw calls must have
+		///		   been submitted, as only the commands issued so far end up in the copy.
+		/// @param renderTarget The render target to read from.
+		/// @param region The region in pixels, measured from the top-left corner. Gets clamped to the render target.
+		/// @param callback Receives the pixels on the GL thread during a later call to Poll().
+		void Request(const RenderTarget& renderTarget, const Math::UintBoundary& region, PixelCallback callback);
+
+		/// @brief Queue a copy of a region of a render target.
+		/// @return A future that becomes ready during a later call to Poll().
+		std::future<PixelData> Request(const RenderTarget& renderTarget, const Math::UintBoundary& region);
+
+		/// @brief Queue a copy of a region of a render target without copying it into client memory.
+		/// @param callback Receives a view of the mapped buffer on the GL thread during a later call to Poll().
+		///		   The view is only valid until the callback returns.
+		void RequestView(const RenderTarget& renderTarget, const Math::UintBoundary& region, PixelViewCallback callback);
+
+		/// @brief Deliver every copy the GPU has finished, in the order they were requested. Never blocks.
+		/// @return The number of delivered copies.
+		size_t Poll();
+
+		/// @brief Wait for the GPU to finish every pending copy and deliver them, including
+		///		   those requested by the callbacks meanwhile. Stalls the pipeline, so only use
+		///		   it when the pixels are needed right away.
+		void Finish();
+
+		/// @return The number of copies that haven't been delivered yet.
+		size_t GetPendingCount() const;
+
+	private:
+
+		struct Slot
+		{
+			GLuint BufferId = 0;
+			uint8_t* MappedData = nullptr;
+			size_t Capacity = 0;
+			GLsync Fence = nullptr;
+			Math::UintBoundary Region;
+			PixelViewCallback Callback;
+		};
+
+		PixelReadback() = default;
+
+		size_t AcquireSlot(size_t byteCount);
+
+		std::vector<Slot> m_Slots;
+		std::vector<size_t> m_FreeSlots;
+		std::deque<size_t> m_PendingSlots;
+
+	};
+}
\ No newline at end of file
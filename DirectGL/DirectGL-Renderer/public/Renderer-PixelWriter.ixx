@@ -0,0 +1,47 @@
+﻿// Project Name : DirectGL-Renderer
+// File Name    : Renderer-PixelWriter.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <glad/gl.h>
+
+#include <memory>
+
+export module DirectGL.Renderer:PixelWriter;
+
+import DirectGL.Math;
+import DirectGL.Texture;
+
+import :RenderTarget;
+
+export namespace DGL::Renderer
+{
+	/// Copies pixels from system memory into render targets. The rows get streamed into
+	/// a texture and blitted from there, which replaces the pixels without blending and
+	/// leaves the depth buffer and every bound state untouched.
+	class PixelWriter
+	{
+	public:
+
+		static std::unique_ptr<PixelWriter> Create();
+
+		~PixelWriter();
+
+		/// @brief Replace a band of rows of a render target.
+		/// @param renderTarget The render target to write to.
+		/// @param pixels The tightly packed RGBA8 pixels of the whole render target, starting with the top row.
+		/// @param firstRow The first row to write, counted from the top.
+		/// @param rowCount The number of rows to write. Rows outside the render target are ignored.
+		void Write(const RenderTarget& renderTarget, const uint8_t* pixels, uint32_t firstRow, uint32_t rowCount);
+
+	private:
+
+		PixelWriter();
+
+		std::unique_ptr<Texture::Texture> m_Texture;
+		GLuint m_FramebufferId;
+
+	};
+}
\ No newline at end of file
@@ -26,6 +26,12 @@ export namespace DGL::Renderer
 
 		/// Activates this render target for drawing.
 		virtual void Activate() = 0;
+
+		/// The framebuffer holding the pixels of this render target.
+		virtual GLuint GetFramebufferId() const = 0;
+
+		/// The size of the framebuffer in pixels.
+		virtual Math::Uint2 GetSize() const = 0;
 	};
 }
 
@@ -42,6 +48,8 @@ export namespace DGL::Renderer
 		const Math::UintBoundary& GetViewport() const;
 
 		void Activate() override;
+		GLuint GetFramebufferId() const override;
+		Math::Uint2 GetSize() const override;
 
 	private:
 
@@ -54,17 +62,35 @@ export namespace DGL::Renderer
 
 export namespace DGL::Renderer
 {
+	/// The images attached to an offscreen framebuffer.
+	enum class RenderTargetAttachments
+	{
+		Color,				//!< Only a RGBA8 color texture
+		ColorDepthStencil,	//!< A RGBA8 color texture and a GL_DEPTH24_STENCIL8 renderbuffer
+	};
+
 	/// This implementation renders to an offscreen framebuffer.
 	class OffscreenRenderTarget : public RenderTarget
 	{
 	public:
 
-		static std::unique_ptr<OffscreenRenderTarget> Create(Math::Uint2 viewportSize);
+		/// @brief Create a new offscreen render target.
+		/// @param viewportSize The size of the attachments.
+		/// @param attachments The images to attach. Omitting the depth/stencil buffer halves the memory.
+		/// @return The render target or nullptr if the framebuffer is incomplete.
+		static std::unique_ptr<OffscreenRenderTarget> Create(Math::Uint2 viewportSize, RenderTargetAttachments attachments = RenderTargetAttachments::ColorDepthStencil);
+
+		/// @brief Calculate the video memory occupied by a render target.
+		static size_t CalculateByteSize(Math::Uint2 viewportSize, RenderTargetAttachments attachments);
 
 		~OffscreenRenderTarget() override;
 
 		void Activate() override;
+		GLuint GetFramebufferId() const override;
+		Math::Uint2 GetSize() const override;
+
 		const Texture::Texture& GetRenderTexture() const;
+		RenderTargetAttachments GetAttachments() const;
 
 	private:
 
@@ -72,7 +98,8 @@ export namespace DGL::Renderer
 			Math::Uint2 viewportSize,
 			GLuint framebufferId,
 			GLuint renderbufferId,
-			std::unique_ptr<Texture::Texture> renderTexture
+			std::unique_ptr<Texture::Texture> renderTexture,
+			RenderTargetAttachments attachments
 		);
 
 		GLuint m_FramebufferId;
@@ -80,6 +107,7 @@ export namespace DGL::Renderer
 		std::unique_ptr<Texture::Texture> m_RenderTexture;
 
 		Math::Uint2 m_ViewportSize;
+		RenderTargetAttachments m_Attachments;
 
 	};
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+﻿// Project Name : DirectGL-Renderer
+// File Name    : Renderer-RenderTargetPool.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+export module DirectGL.Renderer:RenderTargetPool;
+
+import DirectGL.Math;
+
+import :RenderTarget;
+
+export namespace DGL::Renderer
+{
+	struct RenderTargetPoolSettings
+	{
+		uint32_t ReleaseDelay = 2;		//!< The frames a released target waits before it can be acquired again, so the GPU finished reading it
+		uint32_t MaxIdleFrames = 120;	//!< The frames an unused target stays in the pool before it gets destroyed
+	};
+
+	struct RenderTargetPoolStatistics
+	{
+		uint64_t Acquisitions = 0;		//!< The number of acquired targets
+		uint64_t Hits = 0;				//!< The number of acquisitions served by a pooled target
+		size_t ActiveTargets = 0;		//!< The targets acquired and not yet released
+		size_t PooledTargets = 0;		//!< The released targets waiting for reuse
+		size_t PooledBytes = 0;			//!< The video memory held by the pooled targets
+
+		/// @return The share of acquisitions that didn't allocate a new target.
+		float GetHitRate() const
+		{
+			return Acquisitions == 0 ? 0.0f : static_cast<float>(Hits) / static_cast<float>(Acquisitions);
+		}
+	};
+
+	/// Recycles offscreen render targets, so layers and passes created every frame don't
+	/// allocate new framebuffers each time. Released targets are reused for acquisitions
+	/// of the same size and attachments once a few frames have passed.
+	class RenderTargetPool
+	{
+	public:
+
+		static std::unique_ptr<RenderTargetPool> Create(const RenderTargetPoolSettings& settings = {});
+
+		/// @brief Get a render target, reusing a released one if possible. Its contents are undefined.
+		/// @return The render target or nullptr if it couldn't be created.
+		std::unique_ptr<OffscreenRenderTarget> Acquire(Math::Uint2 size, RenderTargetAttachments attachments = RenderTargetAttachments::ColorDepthStencil);
+
+		/// @brief Hand a render target back to the pool. It becomes available after the release delay.
+		void Release(std::unique_ptr<OffscreenRenderTarget> renderTarget);
+
+		/// @brief Hand back a render target that only the commands issued so far refer to, such as
+		///		   an intermediate target of a pass. It can be acquired again right away, since the
+		///		   context runs later commands writing to it after the earlier ones reading it.
+		void ReleaseImmediately(std::unique_ptr<OffscreenRenderTarget> renderTarget);
+
+		/// @brief Advance the frame counter, which makes released targets available
+		///		   and destroys those that have been idle for too long. Call once per frame.
+		void EndFrame();
+
+		/// @brief Destroy every pooled target.
+		void Trim();
+
+		RenderTargetPoolStatistics GetStatistics() const;
+
+	private:
+
+		struct Entry
+		{
+			std::unique_ptr<OffscreenRenderTarget> RenderTarget;
+			uint64_t ReleaseFrame;
+			uint64_t AvailableFrame;	//!< The frame from which on the target may be acquired again
+		};
+
+		explicit RenderTargetPool(const RenderTargetPoolSettings& settings);
+
+		void Insert(std::unique_ptr<OffscreenRenderTarget> renderTarget, uint64_t availableFrame);
+
+		RenderTargetPoolSettings m_Settings;
+		std::vector<Entry> m_Entries;	//!< Ordered by release frame, the oldest first
+		uint64_t m_FrameIndex;
+
+		RenderTargetPoolStatistics m_Statistics;
+
+	};
+}
\ No newline at end of file
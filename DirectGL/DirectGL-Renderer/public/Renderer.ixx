@@ -6,4 +6,7 @@
 export module DirectGL.Renderer;
 
 export import :Color;
-export import :RenderTarget;
\ No newline at end of file
+export import :RenderTarget;
+export import :RenderTargetPool;
+export import :PixelReadback;
+export import :PixelWriter;
\ No newline at end of file
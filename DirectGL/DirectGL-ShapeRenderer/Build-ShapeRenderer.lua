@@ -18,6 +18,7 @@ project("DirectGL-ShapeRenderer")
 		"Preconditions",
 		"DirectGL-Math",
 		"Glad",
+		"Jobs",
 	})
 
 	filter("system:windows")
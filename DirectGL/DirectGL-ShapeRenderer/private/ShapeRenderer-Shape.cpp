@@ -0,0 +1,56 @@
+﻿module;
+
+#include <cstdint>
+
+module DirectGL.ShapeRenderer;
+
+namespace DGL::ShapeRenderer
+{
+	Shape Shape::FilledRectangle(const Math::FloatBoundary& boundary, const float depth)
+	{
+		Shape shape = {};
+		shape.Kind = ShapeKind::FilledRectangle;
+		shape.Points[0] = Math::Float2{ boundary.Left, boundary.Top };
+		shape.Points[1] = Math::Float2{ boundary.Width, boundary.Height };
+		shape.Depth = depth;
+		return shape;
+	}
+
+	Shape Shape::OutlinedRectangle(const Math::FloatBoundary& boundary, const float strokeWeight, const float depth)
+	{
+		Shape shape = FilledRectangle(boundary, depth);
+		shape.Kind = ShapeKind::OutlinedRectangle;
+		shape.StrokeWeight = strokeWeight;
+		return shape;
+	}
+
+	Shape Shape::FilledEllipse(const Math::Float2 center, const Math::Radius radius, const uint32_t segments, const float depth)
+	{
+		Shape shape = {};
+		shape.Kind = ShapeKind::FilledEllipse;
+		shape.Points[0] = center;
+		shape.Points[1] = Math::Float2{ radius.X, radius.Y };
+		shape.Segments = segments;
+		shape.Depth = depth;
+		return shape;
+	}
+
+	Shape Shape::OutlinedEllipse(const Math::Float2 center, const Math::Radius radius, const uint32_t segments, const float strokeWeight, const float depth)
+	{
+		Shape shape = FilledEllipse(center, radius, segments, depth);
+		shape.Kind = ShapeKind::OutlinedEllipse;
+		shape.StrokeWeight = strokeWeight;
+		return shape;
+	}
+
+	Shape Shape::FilledTriangle(const Math::Float2 a, const Math::Float2 b, const Math::Float2 c, const float depth)
+	{
+		Shape shape = {};
+		shape.Kind = ShapeKind::FilledTriangle;
+		shape.Points[0] = a;
+		shape.Points[1] = b;
+		shape.Points[2] = c;
+		shape.Depth = depth;
+		return shape;
+	}
+}
\ No newline at end of file
@@ -1,96 +1,72 @@
 ﻿module;
 
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
+#include <span>
 
 module DirectGL.ShapeRenderer;
 
-namespace DGL::ShapeRenderer
+namespace
 {
-	Vertices ShapeFactory::GetFilledRectangle(const Math::FloatBoundary& boundary, const float depth)
-	{
-		Vertices vertices;
-		vertices.Type = PrimitiveType::TriangleFan;
+	using namespace DGL;
+	using namespace DGL::ShapeRenderer;
 
-		vertices.Positions.reserve(4);
-		vertices.Positions.emplace_back(boundary.Left, boundary.Top, depth);
-		vertices.Positions.emplace_back(boundary.Right(), boundary.Top, depth);
-		vertices.Positions.emplace_back(boundary.Right(), boundary.Bottom(), depth);
-		vertices.Positions.emplace_back(boundary.Left, boundary.Bottom(), depth);
-
-		return vertices;
+	void WriteFilledRectangle(const Math::FloatBoundary& boundary, const float depth, const std::span<Math::Float3> positions)
+	{
+		positions[0] = Math::Float3{ boundary.Left, boundary.Top, depth };
+		positions[1] = Math::Float3{ boundary.Right(), boundary.Top, depth };
+		positions[2] = Math::Float3{ boundary.Right(), boundary.Bottom(), depth };
+		positions[3] = Math::Float3{ boundary.Left, boundary.Bottom(), depth };
 	}
 
-	Vertices ShapeFactory::GetOutlinedRectangle(const Math::FloatBoundary& boundary, const float strokeWeight, const float depth)
+	void WriteOutlinedRectangle(const Math::FloatBoundary& boundary, const float strokeWeight, const float depth, const std::span<Math::Float3> positions, const std::span<uint32_t> indices)
 	{
-		Vertices vertices;
-		vertices.Type = PrimitiveType::Triangles;
-
 		const float halfStroke = strokeWeight * 0.5f;
 		const auto innerBoundary = Math::FloatBoundary::FromLTWH(boundary.Left + halfStroke, boundary.Top + halfStroke, boundary.Width - strokeWeight, boundary.Height - strokeWeight);
 		const auto outerBoundary = Math::FloatBoundary::FromLTWH(boundary.Left - halfStroke, boundary.Top - halfStroke, boundary.Width + strokeWeight, boundary.Height + strokeWeight);
 
-		vertices.Positions.reserve(8); // Each corner has an inner and outer vertex
-
-		// Inner rectangle vertices
-		vertices.Positions.emplace_back(innerBoundary.Left, innerBoundary.Top, depth);			// 0: Top-left
-		vertices.Positions.emplace_back(innerBoundary.Right(), innerBoundary.Top, depth);		// 1: Top-right
-		vertices.Positions.emplace_back(innerBoundary.Right(), innerBoundary.Bottom(), depth);	// 2: Bottom-right
-		vertices.Positions.emplace_back(innerBoundary.Left, innerBoundary.Bottom(), depth);		// 3: Bottom-left
-
-		// Outer rectangle vertices
-		vertices.Positions.emplace_back(outerBoundary.Left, outerBoundary.Top, depth);			// 4: Top-left
-		vertices.Positions.emplace_back(outerBoundary.Right(), outerBoundary.Top, depth);		// 5: Top-right
-		vertices.Positions.emplace_back(outerBoundary.Right(), outerBoundary.Bottom(), depth);	// 6: Bottom-right
-		vertices.Positions.emplace_back(outerBoundary.Left, outerBoundary.Bottom(), depth);		// 7: Bottom-left
+		// Each corner has an inner and outer vertex
+		WriteFilledRectangle(innerBoundary, depth, positions.first(4));	// 0 - 3: Top-left, top-right, bottom-right, bottom-left
+		WriteFilledRectangle(outerBoundary, depth, positions.subspan(4));	// 4 - 7: Top-left, top-right, bottom-right, bottom-left
 
 		// Generate the indices for the outline (two triangles per side)
-		vertices.Indices.reserve(24); // 4 sides * 2 triangles * 3 indices
 		for (uint32_t i = 0; i < 4; i++)
 		{
 			const uint32_t innerCurrent = i;
 			const uint32_t innerNext = (i + 1) % 4;
 			const uint32_t outerCurrent = i + 4;
 			const uint32_t outerNext = ((i + 1) % 4) + 4;
+			const std::span<uint32_t> quad = indices.subspan(i * 6, 6);
 			// First triangle of the quad
-			vertices.Indices.emplace_back(innerCurrent);
-			vertices.Indices.emplace_back(outerCurrent);
-			vertices.Indices.emplace_back(innerNext);
+			quad[0] = innerCurrent;
+			quad[1] = outerCurrent;
+			quad[2] = innerNext;
 			// Second triangle of the quad
-			vertices.Indices.emplace_back(outerCurrent);
-			vertices.Indices.emplace_back(outerNext);
-			vertices.Indices.emplace_back(innerNext);
+			quad[3] = outerCurrent;
+			quad[4] = outerNext;
+			quad[5] = innerNext;
 		}
-
-		return vertices;
 	}
 
-	Vertices ShapeFactory::GetFilledEllipse(const Math::Float2 center, const Math::Radius radius, const size_t segments, const float depth)
+	void WriteFilledEllipse(const Math::Float2 center, const Math::Radius radius, const size_t segments, const float depth, const std::span<Math::Float3> positions)
 	{
-		Vertices vertices;
-		vertices.Type = PrimitiveType::TriangleFan;
-		vertices.Positions.reserve(segments);
-
 		for (size_t i = 0; i <= segments; i++)
 		{
 			const float angle = (static_cast<float>(i) / static_cast<float>(segments)) * Math::TAU;
 			const float x = center.X + radius.X * std::cos(angle);
 			const float y = center.Y + radius.Y * std::sin(angle);
-			vertices.Positions.emplace_back(x, y, depth);
+			positions[i] = Math::Float3{ x, y, depth };
 		}
-
-		return vertices;
 	}
 
-	Vertices ShapeFactory::GetOutlinedEllipse(const Math::Float2 center, const Math::Radius radius, const size_t segments, const float strokeWeight, const float depth)
+	void WriteOutlinedEllipse(const Math::Float2 center, const Math::Radius radius, const size_t segments, const float strokeWeight, const float depth, const std::span<Math::Float3> positions, const std::span<uint32_t> indices)
 	{
-		Vertices vertices;
-		vertices.Type = PrimitiveType::Triangles;
-		vertices.Positions.reserve(segments * 2); // Each segment has an inner and outer vertex
 		const float halfStroke = strokeWeight * 0.5f;
 		const auto innerRadius = Math::Radius::Elliptical(radius.X - halfStroke, radius.Y - halfStroke);
 		const auto outerRadius = Math::Radius::Elliptical(radius.X + halfStroke, radius.Y + halfStroke);
 
+		// Each segment has an inner and outer vertex
 		for (size_t i = 0; i < segments; i++)
 		{
 			const float angle = (static_cast<float>(i) / static_cast<float>(segments)) * Math::TAU;
@@ -100,55 +76,126 @@ namespace DGL::ShapeRenderer
 			// Inner vertex
 			const float innerX = center.X + innerRadius.X * cosAngle;
 			const float innerY = center.Y + innerRadius.Y * sinAngle;
-			vertices.Positions.emplace_back(innerX, innerY, depth);
+			positions[i * 2] = Math::Float3{ innerX, innerY, depth };
 
 			// Outer vertex
 			const float outerX = center.X + outerRadius.X * cosAngle;
 			const float outerY = center.Y + outerRadius.Y * sinAngle;
-			vertices.Positions.emplace_back(outerX, outerY, depth);
+			positions[i * 2 + 1] = Math::Float3{ outerX, outerY, depth };
 		}
 
-		// Generate the indices
-		vertices.Indices.reserve(segments * 6); // Each segment forms two triangles
+		// Generate the indices, each segment forms two triangles
 		for (size_t i = 0; i < segments; i++)
 		{
-			const size_t innerCurrent = i * 2;
-			const size_t outerCurrent = innerCurrent + 1;
+			const auto innerCurrent = static_cast<uint32_t>(i * 2);
+			const auto outerCurrent = innerCurrent + 1;
 
-			const size_t innerNext = (i * 2 + 2) % (segments * 2);
-			const size_t outerNext = (i * 2 + 3) % (segments * 2);
+			const auto innerNext = static_cast<uint32_t>((i * 2 + 2) % (segments * 2));
+			const auto outerNext = static_cast<uint32_t>((i * 2 + 3) % (segments * 2));
+			const std::span<uint32_t> quad = indices.subspan(i * 6, 6);
 
 			// First triangle of the quad
-			vertices.Indices.emplace_back(innerCurrent);
-			vertices.Indices.emplace_back(outerCurrent);
-			vertices.Indices.emplace_back(innerNext);
+			quad[0] = innerCurrent;
+			quad[1] = outerCurrent;
+			quad[2] = innerNext;
 
 			// Second triangle of the quad
-			vertices.Indices.emplace_back(outerCurrent);
-			vertices.Indices.emplace_back(outerNext);
-			vertices.Indices.emplace_back(innerNext);
+			quad[3] = outerCurrent;
+			quad[4] = outerNext;
+			quad[5] = innerNext;
 		}
+	}
 
-		return vertices;
+	void WriteFilledTriangle(const Math::Float2 a, const Math::Float2 b, const Math::Float2 c, const float depth, const std::span<Math::Float3> positions)
+	{
+		positions[0] = Math::Float3{ a.X, a.Y, depth };
+		positions[1] = Math::Float3{ b.X, b.Y, depth };
+		positions[2] = Math::Float3{ c.X, c.Y, depth };
+	}
+}
+
+namespace DGL::ShapeRenderer
+{
+	Vertices ShapeFactory::GetFilledRectangle(const Math::FloatBoundary& boundary, const float depth)
+	{
+		return Tessellate(Shape::FilledRectangle(boundary, depth));
+	}
+
+	Vertices ShapeFactory::GetOutlinedRectangle(const Math::FloatBoundary& boundary, const float strokeWeight, const float depth)
+	{
+		return Tessellate(Shape::OutlinedRectangle(boundary, strokeWeight, depth));
+	}
+
+	Vertices ShapeFactory::GetFilledEllipse(const Math::Float2 center, const Math::Radius radius, const size_t segments, const float depth)
+	{
+		return Tessellate(Shape::FilledEllipse(center, radius, static_cast<uint32_t>(segments), depth));
+	}
+
+	Vertices ShapeFactory::GetOutlinedEllipse(const Math::Float2 center, const Math::Radius radius, const size_t segments, const float strokeWeight, const float depth)
+	{
+		return Tessellate(Shape::OutlinedEllipse(center, radius, static_cast<uint32_t>(segments), strokeWeight, depth));
 	}
 
 	Vertices ShapeFactory::GetFilledTriangle(const Math::Float2 a, const Math::Float2 b, const Math::Float2 c, const float depth)
 	{
-		Vertices vertices;
-		vertices.Type = PrimitiveType::Triangles;
+		return Tessellate(Shape::FilledTriangle(a, b, c, depth));
+	}
 
-		vertices.Positions.reserve(3);
-		vertices.Positions.emplace_back(a.X, a.Y, depth);
-		vertices.Positions.emplace_back(b.X, b.Y, depth);
-		vertices.Positions.emplace_back(c.X, c.Y, depth);
+	Vertices ShapeFactory::GetLine(const Math::Float2 start, const Math::Float2 end, const float strokeWeight, LineCapStyle startCap, LineCapStyle endCap, const float depth)
+	{
+		Vertices vertices;
 
 		return vertices;
 	}
 
-	Vertices ShapeFactory::GetLine(const Math::Float2 start, const Math::Float2 end, const float strokeWeight, LineCapStyle startCap, LineCapStyle endCap, const float depth)
+	ShapeSize ShapeFactory::GetSize(const Shape& shape)
+	{
+		switch (shape.Kind)
+		{
+			case ShapeKind::FilledRectangle: return ShapeSize{ 4, 0, PrimitiveType::TriangleFan };
+			case ShapeKind::OutlinedRectangle: return ShapeSize{ 8, 24, PrimitiveType::Triangles };
+			case ShapeKind::FilledEllipse: return ShapeSize{ shape.Segments + 1, 0, PrimitiveType::TriangleFan };
+			case ShapeKind::OutlinedEllipse: return ShapeSize{ shape.Segments * 2, shape.Segments * 6, PrimitiveType::Triangles };
+			case ShapeKind::FilledTriangle: return ShapeSize{ 3, 0, PrimitiveType::Triangles };
+		}
+
+		return ShapeSize{ 0, 0, PrimitiveType::Triangles };
+	}
+
+	void ShapeFactory::Tessellate(const Shape& shape, const std::span<Math::Float3> positions, const std::span<uint32_t> indices)
 	{
+		const auto& points = shape.Points;
+
+		switch (shape.Kind)
+		{
+			case ShapeKind::FilledRectangle:
+				WriteFilledRectangle(Math::FloatBoundary::FromLTWH(points[0].X, points[0].Y, points[1].X, points[1].Y), shape.Depth, positions);
+				break;
+			case ShapeKind::OutlinedRectangle:
+				WriteOutlinedRectangle(Math::FloatBoundary::FromLTWH(points[0].X, points[0].Y, points[1].X, points[1].Y), shape.StrokeWeight, shape.Depth, positions, indices);
+				break;
+			case ShapeKind::FilledEllipse:
+				WriteFilledEllipse(points[0], Math::Radius::Elliptical(points[1].X, points[1].Y), shape.Segments, shape.Depth, positions);
+				break;
+			case ShapeKind::OutlinedEllipse:
+				WriteOutlinedEllipse(points[0], Math::Radius::Elliptical(points[1].X, points[1].Y), shape.Segments, shape.StrokeWeight, shape.Depth, positions, indices);
+				break;
+			case ShapeKind::FilledTriangle:
+				WriteFilledTriangle(points[0], points[1], points[2], shape.Depth, positions);
+				break;
+		}
+	}
+
+	Vertices ShapeFactory::Tessellate(const Shape& shape)
+	{
+		const ShapeSize size = GetSize(shape);
+
 		Vertices vertices;
+		vertices.Type = size.Type;
+		vertices.Positions.resize(size.VertexCount);
+		vertices.Indices.resize(size.IndexCount);
 
+		Tessellate(shape, vertices.Positions, vertices.Indices);
 		return vertices;
 	}
 }
\ No newline at end of file
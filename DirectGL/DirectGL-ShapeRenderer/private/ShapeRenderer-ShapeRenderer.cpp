@@ -1,6 +1,6 @@
 module;
 
-#include <Glad/gl.h>
+#include <glad/gl.h>
 
 #include <algorithm>
 #include <bit>
@@ -45,7 +45,7 @@ namespace DGL::ShapeRenderer
 		glVertexArrayAttribFormat(vao, 0, 3, GL_FLOAT, GL_FALSE, 0);
 		glVertexArrayAttribBinding(vao, 0, 0);
 
-		return std::unique_ptr<ShapeRenderer>(new ShapeRenderer(vao, buffers[1], buffers[0]));
+		return std::unique_ptr<ShapeRenderer>(new ShapeRenderer(vao, buffers[1], buffers[0], maxVertices, maxIndices));
 	}
 
 	ShapeRenderer::~ShapeRenderer()
@@ -60,6 +60,8 @@ namespace DGL::ShapeRenderer
 		// Convert the primitive type to the corresponding OpenGL draw mode id
 		const GLenum drawMode = PrimitiveTypeToGlId(type);
 
+		Reserve(positions.size() / 3, indices.size());
+
 		// Upload the vertex positions to the GPU
 		glNamedBufferSubData(m_PositionBufferId, 0, positions.size_bytes(), positions.data());
 
@@ -94,10 +96,65 @@ namespace DGL::ShapeRenderer
 		);
 	}
 
-	ShapeRenderer::ShapeRenderer(const GLuint vertexArrayId, const GLuint positionBufferId, const GLuint indexBufferId):
+	void ShapeRenderer::Upload(const std::span<const float>& positions, const std::span<const uint32_t>& indices)
+	{
+		Reserve(positions.size() / 3, indices.size());
+
+		glNamedBufferSubData(m_PositionBufferId, 0, static_cast<GLsizeiptr>(positions.size_bytes()), positions.data());
+
+		if (not indices.empty())
+		{
+			glNamedBufferSubData(m_IndexBufferId, 0, static_cast<GLsizeiptr>(indices.size_bytes()), indices.data());
+		}
+	}
+
+	void ShapeRenderer::Draw(const size_t firstVertex, const size_t vertexCount, const size_t firstIndex, const size_t indexCount, const PrimitiveType type)
+	{
+		const GLenum drawMode = PrimitiveTypeToGlId(type);
+		glBindVertexArray(m_VertexArrayId);
+
+		if (indexCount > 0)
+		{
+			// The indices of every shape start at zero, the base vertex moves them to the shape
+			const auto indexOffset = reinterpret_cast<const void*>(firstIndex * sizeof(GLuint));
+			glDrawElementsBaseVertex(drawMode, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, indexOffset, static_cast<GLint>(firstVertex));
+		} else
+		{
+			glDrawArrays(drawMode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount));
+		}
+	}
+
+	ShapeRenderer::ShapeRenderer(const GLuint vertexArrayId, const GLuint positionBufferId, const GLuint indexBufferId, const size_t maxVertices, const size_t maxIndices):
 		m_VertexArrayId(vertexArrayId),
 		m_PositionBufferId(positionBufferId),
-		m_IndexBufferId(indexBufferId)
+		m_IndexBufferId(indexBufferId),
+		m_MaxVertices(maxVertices),
+		m_MaxIndices(maxIndices)
+	{
+	}
+
+	void ShapeRenderer::Reserve(const size_t vertexCount, const size_t indexCount)
 	{
+		// The storage of the buffers is immutable, so larger ones replace them. Draw calls
+		// issued before keep reading the previous buffers until the GPU is done with them.
+		if (vertexCount > m_MaxVertices)
+		{
+			m_MaxVertices = std::bit_ceil(vertexCount);
+
+			glDeleteBuffers(1, &m_PositionBufferId);
+			glCreateBuffers(1, &m_PositionBufferId);
+			glNamedBufferStorage(m_PositionBufferId, static_cast<GLsizeiptr>(m_MaxVertices * 3 * sizeof(GLfloat)), nullptr, GL_DYNAMIC_STORAGE_BIT);
+			glVertexArrayVertexBuffer(m_VertexArrayId, 0, m_PositionBufferId, 0, sizeof(GLfloat) * 3);
+		}
+
+		if (indexCount > m_MaxIndices)
+		{
+			m_MaxIndices = std::bit_ceil(indexCount);
+
+			glDeleteBuffers(1, &m_IndexBufferId);
+			glCreateBuffers(1, &m_IndexBufferId);
+			glNamedBufferStorage(m_IndexBufferId, static_cast<GLsizeiptr>(m_MaxIndices * sizeof(GLuint)), nullptr, GL_DYNAMIC_STORAGE_BIT);
+			glVertexArrayElementBuffer(m_VertexArrayId, m_IndexBufferId);
+		}
 	}
 }
\ No newline at end of file
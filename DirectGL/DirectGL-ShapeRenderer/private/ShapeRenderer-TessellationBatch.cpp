@@ -0,0 +1,119 @@
+﻿module;
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+module DirectGL.ShapeRenderer;
+
+namespace DGL::ShapeRenderer
+{
+	size_t TessellationBatch::Add(const Shape& shape)
+	{
+		const ShapeSize size = ShapeFactory::GetSize(shape);
+
+		m_Shapes.push_back(shape);
+		m_Ranges.push_back(Range{
+			.FirstVertex = m_VertexCount,
+			.FirstIndex = m_IndexCount,
+			.Size = size,
+		});
+
+		m_VertexCount += size.VertexCount;
+		m_IndexCount += size.IndexCount;
+		return m_Shapes.size() - 1;
+	}
+
+	void TessellationBatch::Tessellate(Jobs::JobSystem* jobSystem)
+	{
+		// The memory is never shrunk, so a batch of the same size doesn't touch the allocator again
+		if (m_Positions.size() < m_VertexCount)
+		{
+			m_Positions.resize(m_VertexCount);
+		}
+
+		if (m_Indices.size() < m_IndexCount)
+		{
+			m_Indices.resize(m_IndexCount);
+		}
+
+		const auto tessellate = [this](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Range& range = m_Ranges[i];
+				const std::span positions(m_Positions.data() + range.FirstVertex, range.Size.VertexCount);
+				const std::span indices(m_Indices.data() + range.FirstIndex, range.Size.IndexCount);
+				ShapeFactory::Tessellate(m_Shapes[i], positions, indices);
+			}
+		};
+
+		if (jobSystem == nullptr or m_Shapes.size() <= ShapesPerChunk)
+		{
+			tessellate(0, m_Shapes.size());
+			return;
+		}
+
+		jobSystem->ParallelFor(m_Shapes.size(), ShapesPerChunk, tessellate);
+	}
+
+	std::span<const Math::Float3> TessellationBatch::GetPositions(const size_t shape) const
+	{
+		const Range& range = m_Ranges[shape];
+		return { m_Positions.data() + range.FirstVertex, range.Size.VertexCount };
+	}
+
+	std::span<const uint32_t> TessellationBatch::GetIndices(const size_t shape) const
+	{
+		const Range& range = m_Ranges[shape];
+		return { m_Indices.data() + range.FirstIndex, range.Size.IndexCount };
+	}
+
+	std::span<const Math::Float3> TessellationBatch::GetPositions() const
+	{
+		return { m_Positions.data(), m_VertexCount };
+	}
+
+	std::span<const uint32_t> TessellationBatch::GetIndices() const
+	{
+		return { m_Indices.data(), m_IndexCount };
+	}
+
+	size_t TessellationBatch::GetFirstVertex(const size_t shape) const
+	{
+		return m_Ranges[shape].FirstVertex;
+	}
+
+	size_t TessellationBatch::GetFirstIndex(const size_t shape) const
+	{
+		return m_Ranges[shape].FirstIndex;
+	}
+
+	PrimitiveType TessellationBatch::GetType(const size_t shape) const
+	{
+		return m_Ranges[shape].Size.Type;
+	}
+
+	size_t TessellationBatch::GetShapeCount() const
+	{
+		return m_Shapes.size();
+	}
+
+	size_t TessellationBatch::GetVertexCount() const
+	{
+		return m_VertexCount;
+	}
+
+	bool TessellationBatch::IsEmpty() const
+	{
+		return m_Shapes.empty();
+	}
+
+	void TessellationBatch::Clear()
+	{
+		m_Shapes.clear();
+		m_Ranges.clear();
+		m_VertexCount = 0;
+		m_IndexCount = 0;
+	}
+}
\ No newline at end of file
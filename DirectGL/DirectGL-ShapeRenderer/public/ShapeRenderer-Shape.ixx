@@ -0,0 +1,50 @@
+﻿// Project Name : DirectGL-ShapeRenderer
+// File Name    : ShapeRenderer-Shape.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+
+export module DirectGL.ShapeRenderer:Shape;
+
+import DirectGL.Math;
+
+import :PrimitiveType;
+
+export namespace DGL::ShapeRenderer
+{
+	enum class ShapeKind : uint8_t
+	{
+		FilledRectangle,
+		OutlinedRectangle,
+		FilledEllipse,
+		OutlinedEllipse,
+		FilledTriangle,
+	};
+
+	/// The parameters of a shape, which allow tessellating it later on and on any thread.
+	struct Shape
+	{
+		static Shape FilledRectangle(const Math::FloatBoundary& boundary, float depth);
+		static Shape OutlinedRectangle(const Math::FloatBoundary& boundary, float strokeWeight, float depth);
+		static Shape FilledEllipse(Math::Float2 center, Math::Radius radius, uint32_t segments, float depth);
+		static Shape OutlinedEllipse(Math::Float2 center, Math::Radius radius, uint32_t segments, float strokeWeight, float depth);
+		static Shape FilledTriangle(Math::Float2 a, Math::Float2 b, Math::Float2 c, float depth);
+
+		ShapeKind Kind;
+		Math::Float2 Points[3];		//!< Rectangles: position and size, ellipses: center and radius, triangles: the corners
+		uint32_t Segments = 0;		//!< Ellipses only
+		float StrokeWeight = 0.0f;	//!< Outlines only
+		float Depth = 0.0f;
+	};
+
+	/// The amount of memory a shape gets tessellated into.
+	struct ShapeSize
+	{
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+		PrimitiveType Type;
+	};
+}
\ No newline at end of file
@@ -3,8 +3,14 @@
 // Author       : Felix Busch
 // Created Date : 2025/10/15
 
+module;
+
+#include <cstdint>
+#include <span>
+
 export module DirectGL.ShapeRenderer:ShapeFactory;
 
+import :Shape;
 import :Vertices;
 
 export namespace DGL::ShapeRenderer
@@ -17,5 +23,12 @@ export namespace DGL::ShapeRenderer
 		Vertices GetOutlinedEllipse(Math::Float2 center, Math::Radius radius, size_t segments, float strokeWeight, float depth);
 		Vertices GetFilledTriangle(Math::Float2 a, Math::Float2 b, Math::Float2 c, float depth);
 		Vertices GetLine(Math::Float2 start, Math::Float2 end, float strokeWeight, LineCapStyle startCap, LineCapStyle endCap, float depth);
+
+		/// @return The number of vertices and indices the shape gets tessellated into.
+		static ShapeSize GetSize(const Shape& shape);
+
+		/// @brief Tessellate a shape into memory sized by GetSize(). Safe to call from any thread.
+		static void Tessellate(const Shape& shape, std::span<Math::Float3> positions, std::span<uint32_t> indices);
+		static Vertices Tessellate(const Shape& shape);
 	};
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 module;
 
-#include <Glad/gl.h>
+#include <glad/gl.h>
 
 #include <memory>
 #include <span>
@@ -39,17 +39,35 @@ export namespace DGL::ShapeRenderer
 		/// @param vertices The vertices to be submitted to the GPU
 		void Render(const Vertices& vertices);
 
+		/// @brief Upload the vertices of many shapes with a single copy per buffer, replacing the
+		///		   ones submitted before. The buffers grow if the vertices don't fit.
+		/// @param positions A contiguous array of positions (x, y, z) of all shapes
+		/// @param indices The indices of all shapes, each shape counting from its first vertex
+		void Upload(const std::span<const float>& positions, const std::span<const uint32_t>& indices);
+
+		/// @brief Render a part of the vertices passed to Upload().
+		/// @param firstVertex The vertex the indices of the part count from
+		/// @param indexCount The number of indices, zero to draw vertexCount vertices in order
+		void Draw(size_t firstVertex, size_t vertexCount, size_t firstIndex, size_t indexCount, PrimitiveType type);
+
 	private:
 
 		explicit ShapeRenderer(
 			GLuint vertexArrayId,
 			GLuint positionBufferId,
-			GLuint indexBufferId
+			GLuint indexBufferId,
+			size_t maxVertices,
+			size_t maxIndices
 		);
 
+		/// @brief Reallocate the buffers if they are smaller than the given number of vertices and indices.
+		void Reserve(size_t vertexCount, size_t indexCount);
+
 		GLuint m_VertexArrayId;
 		GLuint m_PositionBufferId;
 		GLuint m_IndexBufferId;
+		size_t m_MaxVertices;
+		size_t m_MaxIndices;
 
 	};
 }
\ No newline at end of file
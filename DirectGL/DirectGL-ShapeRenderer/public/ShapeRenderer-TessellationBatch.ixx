@@ -0,0 +1,84 @@
+﻿// Project Name : DirectGL-ShapeRenderer
+// File Name    : ShapeRenderer-TessellationBatch.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module DirectGL.ShapeRenderer:TessellationBatch;
+
+import DirectGL.Math;
+import Jobs;
+
+import :PrimitiveType;
+import :Shape;
+
+export namespace DGL::ShapeRenderer
+{
+	/// Collects shapes and tessellates all of them at once. Every shape gets its range of
+	/// the shared vertex and index memory as soon as it's added, so the shapes can be
+	/// tessellated in any order and on any thread without further synchronization, and
+	/// still end up in the order they have been added in.
+	class TessellationBatch
+	{
+	public:
+
+		/// @brief Queue a shape behind the ones added before.
+		/// @return The index of the shape within the batch.
+		size_t Add(const Shape& shape);
+
+		/// @brief Tessellate the queued shapes. Chunks of shapes run in parallel on the job system.
+		/// @param jobSystem The workers to spread the shapes across, or nullptr to tessellate on the calling thread.
+		void Tessellate(Jobs::JobSystem* jobSystem);
+
+		/// @brief Get the tessellated vertices of a shape.
+		std::span<const Math::Float3> GetPositions(size_t shape) const;
+
+		/// @brief Get the tessellated indices of a shape. They start with zero at its first vertex.
+		std::span<const uint32_t> GetIndices(size_t shape) const;
+
+		/// @brief Get the tessellated vertices of all shapes, in the order they have been added in.
+		std::span<const Math::Float3> GetPositions() const;
+
+		/// @brief Get the tessellated indices of all shapes. Each shape counts from its first vertex.
+		std::span<const uint32_t> GetIndices() const;
+
+		/// @return Where the vertices of a shape start within GetPositions().
+		size_t GetFirstVertex(size_t shape) const;
+
+		/// @return Where the indices of a shape start within GetIndices().
+		size_t GetFirstIndex(size_t shape) const;
+
+		PrimitiveType GetType(size_t shape) const;
+
+		size_t GetShapeCount() const;
+		size_t GetVertexCount() const;
+		bool IsEmpty() const;
+
+		/// @brief Remove every shape but keep the memory for the next batch.
+		void Clear();
+
+	private:
+
+		struct Range
+		{
+			size_t FirstVertex;
+			size_t FirstIndex;
+			ShapeSize Size;
+		};
+
+		static constexpr size_t ShapesPerChunk = 256;
+
+		std::vector<Shape> m_Shapes;
+		std::vector<Range> m_Ranges;				//!< The running sums of the vertex and index counts of the shapes in front
+		std::vector<Math::Float3> m_Positions;
+		std::vector<uint32_t> m_Indices;
+		size_t m_VertexCount = 0;
+		size_t m_IndexCount = 0;
+
+	};
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 export module DirectGL.ShapeRenderer;
 
 export import :PrimitiveType;
+export import :Shape;
 export import :ShapeFactory;
 export import :ShapeRenderer;
+export import :TessellationBatch;
 export import :Vertices;
\ No newline at end of file
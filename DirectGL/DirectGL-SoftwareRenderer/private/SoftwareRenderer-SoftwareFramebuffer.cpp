@@ -0,0 +1,91 @@
+﻿module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+module DirectGL.SoftwareRenderer;
+
+namespace DGL::SoftwareRenderer
+{
+	std::unique_ptr<SoftwareFramebuffer> SoftwareFramebuffer::Create(const Math::Uint2 size)
+	{
+		// Pad the rows, so every group of four pixels stays within one row
+		const uint32_t stride = (size.X + 3) & ~3u;
+		return std::unique_ptr<SoftwareFramebuffer>(new SoftwareFramebuffer(size, stride));
+	}
+
+	SoftwareFramebuffer::SoftwareFramebuffer(const Math::Uint2 size, const uint32_t stride):
+		m_Size(size),
+		m_Stride(stride),
+		m_Colors(static_cast<size_t>(stride) * size.Y, 0),
+		m_Depths(static_cast<size_t>(stride) * size.Y, 1.0f)
+	{
+	}
+
+	void SoftwareFramebuffer::Clear(const Renderer::Color color, const float depth)
+	{
+		std::ranges::fill(m_Colors, std::bit_cast<uint32_t>(std::array { color.R, color.G, color.B, color.A }));
+		ClearDepth(depth);
+	}
+
+	void SoftwareFramebuffer::ClearDepth(const float depth)
+	{
+		std::ranges::fill(m_Depths, depth);
+	}
+
+	Renderer::PixelData SoftwareFramebuffer::ReadPixels(const Math::UintBoundary& region) const
+	{
+		const uint32_t left = std::min(region.Left, m_Size.X);
+		const uint32_t top = std::min(region.Top, m_Size.Y);
+		const uint32_t width = std::min(region.Width, m_Size.X - left);
+		const uint32_t height = std::min(region.Height, m_Size.Y - top);
+
+		Renderer::PixelData data = {
+			.Region = Math::UintBoundary::FromLTWH(left, top, width, height),
+			.Pixels = std::vector<uint8_t>(static_cast<size_t>(width) * height * 4),
+		};
+
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			const uint32_t* row = m_Colors.data() + static_cast<size_t>(top + y) * m_Stride + left;
+			std::memcpy(data.Pixels.data() + static_cast<size_t>(y) * width * 4, row, static_cast<size_t>(width) * 4);
+		}
+
+		return data;
+	}
+
+	Math::Uint2 SoftwareFramebuffer::GetSize() const
+	{
+		return m_Size;
+	}
+
+	uint32_t SoftwareFramebuffer::GetStride() const
+	{
+		return m_Stride;
+	}
+
+	uint32_t* SoftwareFramebuffer::GetColors()
+	{
+		return m_Colors.data();
+	}
+
+	const uint32_t* SoftwareFramebuffer::GetColors() const
+	{
+		return m_Colors.data();
+	}
+
+	float* SoftwareFramebuffer::GetDepths()
+	{
+		return m_Depths.data();
+	}
+
+	const float* SoftwareFramebuffer::GetDepths() const
+	{
+		return m_Depths.data();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+﻿module;
+
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <span>
+#include <vector>
+
+module DirectGL.SoftwareRenderer;
+
+import DirectGL.Logging;
+
+namespace DGL::SoftwareRenderer
+{
+	std::unique_ptr<SoftwareTexture> SoftwareTexture::Create(const Math::Uint2 size, const std::span<const uint8_t> pixels, const Texture::TextureOrigin origin)
+	{
+		const size_t texelCount = static_cast<size_t>(size.X) * size.Y;
+		if (texelCount == 0 or pixels.size() != texelCount * 4)
+		{
+			Logging::Error(std::format("Cannot create a {}x{} software texture from {} bytes", size.X, size.Y, pixels.size()));
+			return nullptr;
+		}
+
+		std::vector<uint32_t> texels(texelCount);
+		std::memcpy(texels.data(), pixels.data(), pixels.size());
+
+		return std::unique_ptr<SoftwareTexture>(new SoftwareTexture(size, std::move(texels), origin));
+	}
+
+	std::unique_ptr<SoftwareTexture> SoftwareTexture::Create(const Texture::TextureImage& image)
+	{
+		if (image.Format != Texture::TextureFormat::RGBA8 or image.Levels.empty())
+		{
+			Logging::Error("Software textures require an uncompressed RGBA8 image");
+			return nullptr;
+		}
+
+		return Create(image.Size, image.Levels.front(), image.Origin);
+	}
+
+	SoftwareTexture::SoftwareTexture(const Math::Uint2 size, std::vector<uint32_t> texels, const Texture::TextureOrigin origin):
+		m_Size(size),
+		m_Texels(std::move(texels)),
+		m_Origin(origin)
+	{
+	}
+
+	Math::Uint2 SoftwareTexture::GetSize() const
+	{
+		return m_Size;
+	}
+
+	Texture::TextureOrigin SoftwareTexture::GetOrigin() const
+	{
+		return m_Origin;
+	}
+
+	const uint32_t* SoftwareTexture::GetTexels() const
+	{
+		return m_Texels.data();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,771 @@
+﻿module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+
+#if defined(_M_X64) || defined(__SSE2__)
+	#include <emmintrin.h>
+	#define DGL_SOFTWARERENDERER_SSE2 1
+#endif
+
+module DirectGL.SoftwareRenderer;
+
+namespace DGL::SoftwareRenderer
+{
+	namespace
+	{
+#ifdef DGL_SOFTWARERENDERER_SSE2
+		struct Float4 { __m128 Value; };
+		struct Mask4 { __m128 Value; };
+
+		Float4 Splat(const float value) { return { _mm_set1_ps(value) }; }
+		Float4 MakeFloat4(const float x, const float y, const float z, const float w) { return { _mm_setr_ps(x, y, z, w) }; }
+		Float4 LoadFloat4(const float* values) { return { _mm_loadu_ps(values) }; }
+		void StoreFloat4(float* target, const Float4 value) { _mm_storeu_ps(target, value.Value); }
+
+		Float4 operator + (const Float4 a, const Float4 b) { return { _mm_add_ps(a.Value, b.Value) }; }
+		Float4 operator - (const Float4 a, const Float4 b) { return { _mm_sub_ps(a.Value, b.Value) }; }
+		Float4 operator * (const Float4 a, const Float4 b) { return { _mm_mul_ps(a.Value, b.Value) }; }
+		Float4 Min(const Float4 a, const Float4 b) { return { _mm_min_ps(a.Value, b.Value) }; }
+		Float4 Max(const Float4 a, const Float4 b) { return { _mm_max_ps(a.Value, b.Value) }; }
+
+		Mask4 Less(const Float4 a, const Float4 b) { return { _mm_cmplt_ps(a.Value, b.Value) }; }
+		Mask4 LessEqual(const Float4 a, const Float4 b) { return { _mm_cmple_ps(a.Value, b.Value) }; }
+		Mask4 Greater(const Float4 a, const Float4 b) { return { _mm_cmpgt_ps(a.Value, b.Value) }; }
+		Mask4 GreaterEqual(const Float4 a, const Float4 b) { return { _mm_cmpge_ps(a.Value, b.Value) }; }
+		Mask4 operator & (const Mask4 a, const Mask4 b) { return { _mm_and_ps(a.Value, b.Value) }; }
+		uint32_t ToBits(const Mask4 mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask.Value)); }
+
+		/// Picks a where the mask is set and b everywhere else.
+		Float4 Select(const Mask4 mask, const Float4 a, const Float4 b)
+		{
+			return { _mm_or_ps(_mm_and_ps(mask.Value, a.Value), _mm_andnot_ps(mask.Value, b.Value)) };
+		}
+
+		Float4 BroadcastAlpha(const Float4 value) { return { _mm_shuffle_ps(value.Value, value.Value, _MM_SHUFFLE(3, 3, 3, 3)) }; }
+
+		Float4 UnpackColor(const uint32_t packed)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i channels = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int32_t>(packed)), zero), zero);
+			return { _mm_mul_ps(_mm_cvtepi32_ps(channels), _mm_set1_ps(1.0f / 255.0f)) };
+		}
+
+		uint32_t PackColor(const Float4 color)
+		{
+			const __m128 clamped = _mm_min_ps(_mm_max_ps(color.Value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+			const __m128i rounded = _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)));
+			const __m128i words = _mm_packs_epi32(rounded, rounded);
+			return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(words, words)));
+		}
+
+		void StoreMasked(float* target, const Float4 values, const Mask4 mask)
+		{
+			_mm_storeu_ps(target, _mm_or_ps(_mm_and_ps(mask.Value, values.Value), _mm_andnot_ps(mask.Value, _mm_loadu_ps(target))));
+		}
+
+		void StoreMasked(uint32_t* target, const uint32_t pixel, const Mask4 mask)
+		{
+			const __m128i select = _mm_castps_si128(mask.Value);
+			const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target));
+			const __m128i value = _mm_set1_epi32(static_cast<int32_t>(pixel));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_or_si128(_mm_and_si128(select, value), _mm_andnot_si128(select, current)));
+		}
+#else
+		struct Float4 { std::array<float, 4> Value; };
+		struct Mask4 { std::array<bool, 4> Value; };
+
+		template <typename TOperation>
+		Float4 Map(const Float4 a, const Float4 b, TOperation operation)
+		{
+			return { { operation(a.Value[0], b.Value[0]), operation(a.Value[1], b.Value[1]), operation(a.Value[2], b.Value[2]), operation(a.Value[3], b.Value[3]) } };
+		}
+
+		template <typename TOperation>
+		Mask4 Compare(const Float4 a, const Float4 b, TOperation operation)
+		{
+			return { { operation(a.Value[0], b.Value[0]), operation(a.Value[1], b.Value[1]), operation(a.Value[2], b.Value[2]), operation(a.Value[3], b.Value[3]) } };
+		}
+
+		Float4 Splat(const float value) { return { { value, value, value, value } }; }
+		Float4 MakeFloat4(const float x, const float y, const float z, const float w) { return { { x, y, z, w } }; }
+		Float4 LoadFloat4(const float* values) { return { { values[0], values[1], values[2], values[3] } }; }
+		void StoreFloat4(float* target, const Float4 value) { std::memcpy(target, value.Value.data(), sizeof(float) * 4); }
+
+		Float4 operator + (const Float4 a, const Float4 b) { return Map(a, b, [](const float x, const float y) { return x + y; }); }
+		Float4 operator - (const Float4 a, const Float4 b) { return Map(a, b, [](const float x, const float y) { return x - y; }); }
+		Float4 operator * (const Float4 a, const Float4 b) { return Map(a, b, [](const float x, const float y) { return x * y; }); }
+		Float4 Min(const Float4 a, const Float4 b) { return Map(a, b, [](const float x, const float y) { return x < y ? x : y; }); }
+		Float4 Max(const Float4 a, const Float4 b) { return Map(a, b, [](const float x, const float y) { return x > y ? x : y; }); }
+
+		Mask4 Less(const Float4 a, const Float4 b) { return Compare(a, b, [](const float x, const float y) { return x < y; }); }
+		Mask4 LessEqual(const Float4 a, const Float4 b) { return Compare(a, b, [](const float x, const float y) { return x <= y; }); }
+		Mask4 Greater(const Float4 a, const Float4 b) { return Compare(a, b, [](const float x, const float y) { return x > y; }); }
+		Mask4 GreaterEqual(const Float4 a, const Float4 b) { return Compare(a, b, [](const float x, const float y) { return x >= y; }); }
+
+		Mask4 operator & (const Mask4 a, const Mask4 b)
+		{
+			return { { a.Value[0] and b.Value[0], a.Value[1] and b.Value[1], a.Value[2] and b.Value[2], a.Value[3] and b.Value[3] } };
+		}
+
+		uint32_t ToBits(const Mask4 mask)
+		{
+			return static_cast<uint32_t>(mask.Value[0]) | static_cast<uint32_t>(mask.Value[1]) << 1 | static_cast<uint32_t>(mask.Value[2]) << 2 | static_cast<uint32_t>(mask.Value[3]) << 3;
+		}
+
+		Float4 Select(const Mask4 mask, const Float4 a, const Float4 b)
+		{
+			Float4 result = b;
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				if (mask.Value[lane]) result.Value[lane] = a.Value[lane];
+			}
+
+			return result;
+		}
+
+		Float4 BroadcastAlpha(const Float4 value) { return Splat(value.Value[3]); }
+
+		Float4 UnpackColor(const uint32_t packed)
+		{
+			const auto bytes = std::bit_cast<std::array<uint8_t, 4>>(packed);
+			return { { bytes[0] / 255.0f, bytes[1] / 255.0f, bytes[2] / 255.0f, bytes[3] / 255.0f } };
+		}
+
+		uint32_t PackColor(const Float4 color)
+		{
+			std::array<uint8_t, 4> bytes;
+			for (uint32_t channel = 0; channel < 4; ++channel)
+			{
+				bytes[channel] = static_cast<uint8_t>(std::nearbyint(std::clamp(color.Value[channel], 0.0f, 1.0f) * 255.0f));
+			}
+
+			return std::bit_cast<uint32_t>(bytes);
+		}
+
+		void StoreMasked(float* target, const Float4 values, const Mask4 mask)
+		{
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				if (mask.Value[lane]) target[lane] = values.Value[lane];
+			}
+		}
+
+		void StoreMasked(uint32_t* target, const uint32_t pixel, const Mask4 mask)
+		{
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				if (mask.Value[lane]) target[lane] = pixel;
+			}
+		}
+#endif
+
+		Mask4 GetAlphaLane()
+		{
+			return Greater(MakeFloat4(0.0f, 0.0f, 0.0f, 1.0f), Splat(0.0f));
+		}
+
+		Float4 Lerp(const Float4 a, const Float4 b, const float t)
+		{
+			return a + (b - a) * Splat(t);
+		}
+
+		Float4 GetBlendFactor(const Blending::BlendMode::Factor factor, const Float4 source, const Float4 destination)
+		{
+			using enum Blending::BlendMode::Factor;
+
+			const Float4 one = Splat(1.0f);
+
+			switch (factor)
+			{
+				case Zero: return Splat(0.0f);
+				case One: return one;
+				case SrcColor: return source;
+				case OneMinusSrcColor: return one - source;
+				case DstColor: return destination;
+				case OneMinusDstColor: return one - destination;
+				case SrcAlpha: return BroadcastAlpha(source);
+				case OneMinusSrcAlpha: return one - BroadcastAlpha(source);
+				case DstAlpha: return BroadcastAlpha(destination);
+				case OneMinusDstAlpha: return one - BroadcastAlpha(destination);
+				// The BlendModeActivator never sets a blend color, which leaves OpenGL's default of transparent black
+				case ConstantColor:
+				case ConstantAlpha: return Splat(0.0f);
+				case OneMinusConstantColor:
+				case OneMinusConstantAlpha: return one;
+				case SrcAlphaSaturate: return Select(GetAlphaLane(), one, Min(BroadcastAlpha(source), one - BroadcastAlpha(destination)));
+				default: return one;
+			}
+		}
+
+		Float4 ApplyBlendEquation(const Blending::BlendMode::Equation equation, const Float4 source, const Float4 destination, const Float4 sourceFactor, const Float4 destinationFactor)
+		{
+			using Equation = Blending::BlendMode::Equation;
+
+			switch (equation)
+			{
+				case Equation::Subtract: return source * sourceFactor - destination * destinationFactor;
+				case Equation::ReverseSubtract: return destination * destinationFactor - source * sourceFactor;
+				case Equation::Min: return Min(source, destination);
+				case Equation::Max: return Max(source, destination);
+				default: return source * sourceFactor + destination * destinationFactor;
+			}
+		}
+
+		/// Blends all four channels of a single pixel at once, exactly like glBlendFuncSeparate
+		/// and glBlendEquationSeparate would with a normalised fixed point render target.
+		Float4 Blend(const Blending::BlendMode& mode, const Float4 source, const Float4 destination)
+		{
+			const Float4 rgb = ApplyBlendEquation(
+				mode.BlendEquationRGB, source, destination,
+				GetBlendFactor(mode.SourceFactorRGB, source, destination),
+				GetBlendFactor(mode.DestinationFactorRGB, source, destination)
+			);
+
+			if (mode.SourceFactorRGB == mode.SourceFactorAlpha and mode.DestinationFactorRGB == mode.DestinationFactorAlpha and mode.BlendEquationRGB == mode.BlendEquationAlpha)
+			{
+				return rgb;
+			}
+
+			const Float4 alpha = ApplyBlendEquation(
+				mode.BlendEquationAlpha, source, destination,
+				GetBlendFactor(mode.SourceFactorAlpha, source, destination),
+				GetBlendFactor(mode.DestinationFactorAlpha, source, destination)
+			);
+
+			return Select(GetAlphaLane(), alpha, rgb);
+		}
+
+		/// Samples with clamp to edge addressing, matching the samplers of the TextureBrush.
+		Float4 SampleTexture(const SoftwareTexture& texture, const Texture::TextureFilterModeId filter, const float u, const float v)
+		{
+			const Math::Uint2 size = texture.GetSize();
+			const uint32_t* texels = texture.GetTexels();
+
+			// fmin and fmax also turn NaN into a valid coordinate
+			const float x = std::fmax(0.0f, std::fmin(u, 1.0f)) * static_cast<float>(size.X);
+			const float y = std::fmax(0.0f, std::fmin(v, 1.0f)) * static_cast<float>(size.Y);
+			const int32_t maxX = static_cast<int32_t>(size.X) - 1;
+			const int32_t maxY = static_cast<int32_t>(size.Y) - 1;
+
+			if (filter == Texture::TextureFilterModeId::Nearest)
+			{
+				const int32_t texelX = std::min(static_cast<int32_t>(x), maxX);
+				const int32_t texelY = std::min(static_cast<int32_t>(y), maxY);
+				return UnpackColor(texels[static_cast<size_t>(texelY) * size.X + texelX]);
+			}
+
+			const float left = std::floor(x - 0.5f);
+			const float top = std::floor(y - 0.5f);
+			const float weightX = x - 0.5f - left;
+			const float weightY = y - 0.5f - top;
+
+			const int32_t x0 = std::clamp(static_cast<int32_t>(left), 0, maxX);
+			const int32_t x1 = std::clamp(static_cast<int32_t>(left) + 1, 0, maxX);
+			const uint32_t* row0 = texels + static_cast<size_t>(std::clamp(static_cast<int32_t>(top), 0, maxY)) * size.X;
+			const uint32_t* row1 = texels + static_cast<size_t>(std::clamp(static_cast<int32_t>(top) + 1, 0, maxY)) * size.X;
+
+			const Float4 upper = Lerp(UnpackColor(row0[x0]), UnpackColor(row0[x1]), weightX);
+			const Float4 lower = Lerp(UnpackColor(row1[x0]), UnpackColor(row1[x1]), weightX);
+			return Lerp(upper, lower, weightY);
+		}
+
+		Mask4 TestDepth(const DepthFunction function, const Float4 depth, const Float4 stored)
+		{
+			switch (function)
+			{
+				case DepthFunction::Less: return Less(depth, stored);
+				case DepthFunction::LessEqual: return LessEqual(depth, stored);
+				case DepthFunction::Greater: return Greater(depth, stored);
+				case DepthFunction::GreaterEqual: return GreaterEqual(depth, stored);
+				default: return GreaterEqual(depth, depth);
+			}
+		}
+
+		Float4 EvaluatePlane(const std::array<float, 3>& plane, const Float4 x, const Float4 y)
+		{
+			return Splat(plane[0]) * x + Splat(plane[1]) * y + Splat(plane[2]);
+		}
+
+		std::array<float, 4> NormalizeColor(const Renderer::Color color)
+		{
+			return { color.R / 255.0f, color.G / 255.0f, color.B / 255.0f, color.A / 255.0f };
+		}
+	}
+
+	std::unique_ptr<TileRasterizer> TileRasterizer::Create(Jobs::JobSystem* jobSystem, const RasterizerSettings& settings)
+	{
+		const uint32_t tileSize = std::max((settings.TileSize + 3) & ~3u, 4u);
+		return std::unique_ptr<TileRasterizer>(new TileRasterizer(jobSystem, tileSize));
+	}
+
+	TileRasterizer::TileRasterizer(Jobs::JobSystem* jobSystem, const uint32_t tileSize):
+		m_JobSystem(jobSystem),
+		m_TileSize(tileSize),
+		m_TileCountX(0),
+		m_TileCountY(0),
+		m_Framebuffer(nullptr),
+		m_BinnedTriangles(0)
+	{
+	}
+
+	void TileRasterizer::SetFramebuffer(SoftwareFramebuffer* framebuffer)
+	{
+		if (framebuffer == m_Framebuffer)
+		{
+			return;
+		}
+
+		Flush();
+
+		m_Framebuffer = framebuffer;
+		if (framebuffer == nullptr)
+		{
+			return;
+		}
+
+		const Math::Uint2 size = framebuffer->GetSize();
+		m_TileCountX = (size.X + m_TileSize - 1) / m_TileSize;
+		m_TileCountY = (size.Y + m_TileSize - 1) / m_TileSize;
+		m_Bins.resize(static_cast<size_t>(m_TileCountX) * m_TileCountY);
+	}
+
+	void TileRasterizer::DrawShape(const ShapeRenderer::Vertices& vertices, const Renderer::Color color, const DrawState& state)
+	{
+		DrawShape(vertices.Positions, vertices.Indices, vertices.Type, color, state);
+	}
+
+	void TileRasterizer::DrawShape(const std::span<const Math::Float3> positions, const std::span<const uint32_t> indices, const ShapeRenderer::PrimitiveType type, const Renderer::Color color, const DrawState& state)
+	{
+		if (m_Framebuffer == nullptr or positions.empty())
+		{
+			return;
+		}
+
+		const uint32_t drawIndex = AddDrawCall(state, nullptr, Texture::TextureFilterModeId::Nearest);
+		const std::array<float, 4> normalizedColor = NormalizeColor(color);
+		const size_t count = indices.empty() ? positions.size() : indices.size();
+
+		const auto addTriangle = [&](const size_t a, const size_t b, const size_t c)
+		{
+			std::array<WindowVertex, 3> corners;
+			const std::array<size_t, 3> elements = { a, b, c };
+
+			for (size_t i = 0; i < 3; ++i)
+			{
+				const size_t index = indices.empty() ? elements[i] : indices[elements[i]];
+				if (index >= positions.size())
+				{
+					return;
+				}
+
+				const Math::Float3& position = positions[index];
+				if (not ToWindow(state.Transform, position.X, position.Y, position.Z, corners[i]))
+				{
+					return;
+				}
+			}
+
+			AddTriangle(corners[0], corners[1], corners[2], normalizedColor, drawIndex);
+		};
+
+		switch (type)
+		{
+			case ShapeRenderer::PrimitiveType::Triangles:
+				for (size_t i = 0; i + 2 < count; i += 3) addTriangle(i, i + 1, i + 2);
+				break;
+
+			case ShapeRenderer::PrimitiveType::TriangleStrip:
+				for (size_t i = 2; i < count; ++i)
+				{
+					// Keep the winding of odd triangles consistent, like OpenGL does
+					if (i % 2 == 0) addTriangle(i - 2, i - 1, i);
+					else addTriangle(i - 1, i - 2, i);
+				}
+				break;
+
+			case ShapeRenderer::PrimitiveType::TriangleFan:
+				for (size_t i = 2; i < count; ++i) addTriangle(0, i - 1, i);
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	void TileRasterizer::DrawSprites(const std::span<const TextureRenderer::SpriteInstance> sprites, const SoftwareTexture& texture, const Texture::TextureFilterModeId filter, const DrawState& state)
+	{
+		if (m_Framebuffer == nullptr or sprites.empty())
+		{
+			return;
+		}
+
+		const uint32_t drawIndex = AddDrawCall(state, &texture, filter);
+
+		for (const TextureRenderer::SpriteInstance& sprite : sprites)
+		{
+			// Expand the unit quad the same way the vertex shader of the TextureBrush does
+			std::array<WindowVertex, 4> corners;
+			bool isVisible = true;
+
+			for (uint32_t i = 0; i < 4; ++i)
+			{
+				const float cornerX = static_cast<float>(i & 1);
+				const float cornerY = static_cast<float>(i >> 1);
+				const float x = sprite.M00 * cornerX + sprite.M01 * cornerY + sprite.M02;
+				const float y = sprite.M10 * cornerX + sprite.M11 * cornerY + sprite.M12;
+
+				isVisible = isVisible and ToWindow(state.Transform, x, y, sprite.Depth, corners[i]);
+				corners[i].U = sprite.U0 + (sprite.U1 - sprite.U0) * cornerX;
+				corners[i].V = sprite.V0 + (sprite.V1 - sprite.V0) * cornerY;
+			}
+
+			if (not isVisible)
+			{
+				continue;
+			}
+
+			const std::array<float, 4> tint = NormalizeColor(Renderer::Color(sprite.R, sprite.G, sprite.B, sprite.A));
+			AddTriangle(corners[0], corners[1], corners[2], tint, drawIndex);
+			AddTriangle(corners[2], corners[1], corners[3], tint, drawIndex);
+		}
+	}
+
+	void TileRasterizer::Flush()
+	{
+		if (m_Framebuffer == nullptr or m_Triangles.empty())
+		{
+			m_DrawCalls.clear();
+			m_Triangles.clear();
+			return;
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+
+		const auto rasterizeTiles = [this](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				RasterizeTile(m_ActiveTiles[i]);
+			}
+		};
+
+		// Waking the workers isn't worth it for a single tile
+		if (m_JobSystem == nullptr or m_ActiveTiles.size() < 2)
+		{
+			rasterizeTiles(0, m_ActiveTiles.size());
+		} else
+		{
+			// The tiles differ a lot in cost, so every one is a chunk of its own for the workers to steal
+			m_JobSystem->ParallelFor(m_ActiveTiles.size(), 1, rasterizeTiles);
+		}
+
+		m_Statistics = {
+			.Triangles = m_Triangles.size(),
+			.BinnedTriangles = m_BinnedTriangles,
+			.ActiveTiles = m_ActiveTiles.size(),
+			.RasterMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+		};
+
+		for (const uint32_t tileIndex : m_ActiveTiles)
+		{
+			m_Bins[tileIndex].clear();
+		}
+
+		m_ActiveTiles.clear();
+		m_DrawCalls.clear();
+		m_Triangles.clear();
+		m_BinnedTriangles = 0;
+	}
+
+	RasterizerStatistics TileRasterizer::GetStatistics() const
+	{
+		return m_Statistics;
+	}
+
+	uint32_t TileRasterizer::GetWorkerCount() const
+	{
+		return m_JobSystem != nullptr ? static_cast<uint32_t>(m_JobSystem->GetWorkerCount()) : 0;
+	}
+
+	uint32_t TileRasterizer::AddDrawCall(const DrawState& state, const SoftwareTexture* texture, const Texture::TextureFilterModeId filter)
+	{
+		m_DrawCalls.push_back(DrawCall {
+			.BlendMode = state.BlendMode,
+			.DepthTest = state.DepthTest,
+			.DepthWrite = state.DepthWrite,
+			.IsOpaque = state.BlendMode == Blending::BlendModes::Opaque,
+			.Texture = texture,
+			.Filter = filter,
+		});
+
+		return static_cast<uint32_t>(m_DrawCalls.size() - 1);
+	}
+
+	bool TileRasterizer::ToWindow(const Math::Matrix4x4& transform, const float x, const float y, const float z, WindowVertex& vertex) const
+	{
+		const float* m = transform.GetData();
+		const float clipX = m[0] * x + m[4] * y + m[8] * z + m[12];
+		const float clipY = m[1] * x + m[5] * y + m[9] * z + m[13];
+		const float clipZ = m[2] * x + m[6] * y + m[10] * z + m[14];
+		const float clipW = m[3] * x + m[7] * y + m[11] * z + m[15];
+
+		// Also rejects NaN
+		if (not (clipW > 0.0f))
+		{
+			return false;
+		}
+
+		const Math::Uint2 size = m_Framebuffer->GetSize();
+
+		// Same as the default viewport transform and depth range of OpenGL, except that the rows run top to bottom
+		vertex.X = (clipX / clipW + 1.0f) * 0.5f * static_cast<float>(size.X);
+		vertex.Y = (1.0f - clipY / clipW) * 0.5f * static_cast<float>(size.Y);
+		vertex.Z = clipZ / clipW * 0.5f + 0.5f;
+		vertex.U = 0.0f;
+		vertex.V = 0.0f;
+		return true;
+	}
+
+	void TileRasterizer::AddTriangle(WindowVertex a, WindowVertex b, WindowVertex c, const std::array<float, 4>& color, const uint32_t drawIndex)
+	{
+		float area = (b.X - a.X) * (c.Y - a.Y) - (b.Y - a.Y) * (c.X - a.X);
+
+		// There is no culling, so bring every triangle into the same winding order
+		if (area < 0.0f)
+		{
+			std::swap(b, c);
+			area = -area;
+		}
+
+		// Rejects degenerate triangles and NaN
+		if (not (area > 0.0f) or area == std::numeric_limits<float>::infinity())
+		{
+			return;
+		}
+
+		const Math::Uint2 size = m_Framebuffer->GetSize();
+		const auto toPixel = [](const float value, const uint32_t limit)
+		{
+			return static_cast<int32_t>(std::clamp(value, 0.0f, static_cast<float>(limit)));
+		};
+
+		Triangle triangle;
+		triangle.MinX = toPixel(std::floor(std::min({ a.X, b.X, c.X })), size.X);
+		triangle.MinY = toPixel(std::floor(std::min({ a.Y, b.Y, c.Y })), size.Y);
+		triangle.MaxX = toPixel(std::ceil(std::max({ a.X, b.X, c.X })), size.X);
+		triangle.MaxY = toPixel(std::ceil(std::max({ a.Y, b.Y, c.Y })), size.Y);
+
+		if (triangle.MinX >= triangle.MaxX or triangle.MinY >= triangle.MaxY)
+		{
+			return;
+		}
+
+		// Edge i lies opposite of vertex i and evaluates to the area at that vertex
+		const std::array<WindowVertex, 3> vertices = { a, b, c };
+		triangle.TopLeftEdges = 0;
+
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const WindowVertex& from = vertices[(i + 1) % 3];
+			const WindowVertex& to = vertices[(i + 2) % 3];
+
+			triangle.EdgeA[i] = from.Y - to.Y;
+			triangle.EdgeB[i] = to.X - from.X;
+			triangle.EdgeC[i] = from.X * to.Y - from.Y * to.X;
+
+			// With rows running downwards, left edges rise with x and top edges are horizontal and rise with y
+			if (triangle.EdgeA[i] > 0.0f or (triangle.EdgeA[i] == 0.0f and triangle.EdgeB[i] > 0.0f))
+			{
+				triangle.TopLeftEdges |= 1u << i;
+			}
+		}
+
+		// The normalised edge functions are the barycentric coordinates, so weighting the
+		// attributes of the vertices with them yields the plane of each attribute
+		const float inverseArea = 1.0f / area;
+		const auto makePlane = [&](const float value0, const float value1, const float value2)
+		{
+			return std::array {
+				(triangle.EdgeA[0] * value0 + triangle.EdgeA[1] * value1 + triangle.EdgeA[2] * value2) * inverseArea,
+				(triangle.EdgeB[0] * value0 + triangle.EdgeB[1] * value1 + triangle.EdgeB[2] * value2) * inverseArea,
+				(triangle.EdgeC[0] * value0 + triangle.EdgeC[1] * value1 + triangle.EdgeC[2] * value2) * inverseArea,
+			};
+		};
+
+		triangle.Depth = makePlane(a.Z, b.Z, c.Z);
+		triangle.U = makePlane(a.U, b.U, c.U);
+		triangle.V = makePlane(a.V, b.V, c.V);
+		triangle.Color = color;
+		triangle.DrawIndex = drawIndex;
+
+		const auto triangleIndex = static_cast<uint32_t>(m_Triangles.size());
+		m_Triangles.push_back(triangle);
+
+		// Bin the triangle into every tile its bounding box overlaps, unless one of its
+		// edges is negative at every pixel of the tile
+		const uint32_t firstTileX = static_cast<uint32_t>(triangle.MinX) / m_TileSize;
+		const uint32_t firstTileY = static_cast<uint32_t>(triangle.MinY) / m_TileSize;
+		const uint32_t lastTileX = static_cast<uint32_t>(triangle.MaxX - 1) / m_TileSize;
+		const uint32_t lastTileY = static_cast<uint32_t>(triangle.MaxY - 1) / m_TileSize;
+
+		for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+		{
+			const float top = static_cast<float>(tileY * m_TileSize) + 0.5f;
+			const float bottom = static_cast<float>(std::min((tileY + 1) * m_TileSize, size.Y)) - 0.5f;
+
+			for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+			{
+				const float left = static_cast<float>(tileX * m_TileSize) + 0.5f;
+				const float right = static_cast<float>(std::min((tileX + 1) * m_TileSize, size.X)) - 0.5f;
+
+				bool isOutside = false;
+				for (uint32_t i = 0; i < 3 and not isOutside; ++i)
+				{
+					const float x = triangle.EdgeA[i] > 0.0f ? right : left;
+					const float y = triangle.EdgeB[i] > 0.0f ? bottom : top;
+					isOutside = triangle.EdgeA[i] * x + triangle.EdgeB[i] * y + triangle.EdgeC[i] < 0.0f;
+				}
+
+				if (isOutside)
+				{
+					continue;
+				}
+
+				const uint32_t tileIndex = tileY * m_TileCountX + tileX;
+				std::vector<uint32_t>& bin = m_Bins[tileIndex];
+
+				if (bin.empty())
+				{
+					m_ActiveTiles.push_back(tileIndex);
+				}
+
+				bin.push_back(triangleIndex);
+				++m_BinnedTriangles;
+			}
+		}
+	}
+
+	void TileRasterizer::RasterizeTile(const uint32_t tileIndex)
+	{
+		const Math::Uint2 size = m_Framebuffer->GetSize();
+		const uint32_t tileX = tileIndex % m_TileCountX;
+		const uint32_t tileY = tileIndex / m_TileCountX;
+
+		const auto minX = static_cast<int32_t>(tileX * m_TileSize);
+		const auto minY = static_cast<int32_t>(tileY * m_TileSize);
+		const auto maxX = static_cast<int32_t>(std::min((tileX + 1) * m_TileSize, size.X));
+		const auto maxY = static_cast<int32_t>(std::min((tileY + 1) * m_TileSize, size.Y));
+
+		for (const uint32_t triangleIndex : m_Bins[tileIndex])
+		{
+			const Triangle& triangle = m_Triangles[triangleIndex];
+			RasterizeTriangle(triangle, m_DrawCalls[triangle.DrawIndex], minX, minY, maxX, maxY);
+		}
+	}
+
+	void TileRasterizer::RasterizeTriangle(const Triangle& triangle, const DrawCall& drawCall, const int32_t tileMinX, const int32_t tileMinY, const int32_t tileMaxX, const int32_t tileMaxY)
+	{
+		// Tiles start at a multiple of four, so aligning down never leaves the tile
+		const int32_t minX = std::max(triangle.MinX, tileMinX) & ~3;
+		const int32_t minY = std::max(triangle.MinY, tileMinY);
+		const int32_t maxX = std::min(triangle.MaxX, tileMaxX);
+		const int32_t maxY = std::min(triangle.MaxY, tileMaxY);
+
+		const size_t stride = m_Framebuffer->GetStride();
+		uint32_t* colors = m_Framebuffer->GetColors();
+		float* depths = m_Framebuffer->GetDepths();
+
+		const Float4 pixelCenters = MakeFloat4(0.5f, 1.5f, 2.5f, 3.5f);
+		const Float4 zero = Splat(0.0f);
+		const Float4 one = Splat(1.0f);
+		const Float4 right = Splat(static_cast<float>(maxX));
+		const Float4 color = LoadFloat4(triangle.Color.data());
+		const uint32_t packedColor = PackColor(color);
+		const bool isSolidFill = drawCall.IsOpaque and drawCall.Texture == nullptr;
+
+		for (int32_t y = minY; y < maxY; ++y)
+		{
+			const Float4 centerY = Splat(static_cast<float>(y) + 0.5f);
+			uint32_t* colorRow = colors + static_cast<size_t>(y) * stride;
+			float* depthRow = depths + static_cast<size_t>(y) * stride;
+
+			for (int32_t x = minX; x < maxX; x += 4)
+			{
+				const Float4 centerX = Splat(static_cast<float>(x)) + pixelCenters;
+				Mask4 coverage = Less(centerX, right);
+
+				// A pixel centred exactly on an edge belongs to the triangle only if the edge is a top or left edge
+				for (uint32_t i = 0; i < 3; ++i)
+				{
+					const Float4 edge = Splat(triangle.EdgeA[i]) * centerX + Splat(triangle.EdgeB[i]) * centerY + Splat(triangle.EdgeC[i]);
+					coverage = coverage & ((triangle.TopLeftEdges & (1u << i)) != 0 ? GreaterEqual(edge, zero) : Greater(edge, zero));
+				}
+
+				if (ToBits(coverage) == 0)
+				{
+					continue;
+				}
+
+				// Fragments beyond the near and far plane are clipped, like OpenGL would clip the primitive
+				const Float4 depth = EvaluatePlane(triangle.Depth, centerX, centerY);
+				coverage = coverage & GreaterEqual(depth, zero) & LessEqual(depth, one);
+
+				if (drawCall.DepthTest != DepthFunction::Always)
+				{
+					coverage = coverage & TestDepth(drawCall.DepthTest, depth, LoadFloat4(depthRow + x));
+				}
+
+				const uint32_t lanes = ToBits(coverage);
+				if (lanes == 0)
+				{
+					continue;
+				}
+
+				if (drawCall.DepthWrite)
+				{
+					StoreMasked(depthRow + x, depth, coverage);
+				}
+
+				if (isSolidFill)
+				{
+					StoreMasked(colorRow + x, packedColor, coverage);
+					continue;
+				}
+
+				std::array<float, 4> u = {};
+				std::array<float, 4> v = {};
+
+				if (drawCall.Texture != nullptr)
+				{
+					StoreFloat4(u.data(), EvaluatePlane(triangle.U, centerX, centerY));
+					StoreFloat4(v.data(), EvaluatePlane(triangle.V, centerX, centerY));
+				}
+
+				for (uint32_t lane = 0; lane < 4; ++lane)
+				{
+					if ((lanes & (1u << lane)) == 0)
+					{
+						continue;
+					}
+
+					const Float4 source = drawCall.Texture != nullptr
+						? SampleTexture(*drawCall.Texture, drawCall.Filter, u[lane], v[lane]) * color
+						: color;
+
+					uint32_t& pixel = colorRow[x + lane];
+					pixel = drawCall.IsOpaque ? PackColor(source) : PackColor(Blend(drawCall.BlendMode, source, UnpackColor(pixel)));
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+﻿// Project Name : DirectGL-SoftwareRenderer
+// File Name    : SoftwareRenderer-DrawState.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL.SoftwareRenderer:DrawState;
+
+import DirectGL.Blending;
+import DirectGL.Math;
+
+export namespace DGL::SoftwareRenderer
+{
+	/// Compares the depth of an incoming fragment with the depth stored in the framebuffer.
+	enum class DepthFunction
+	{
+		Always,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+	};
+
+	/// The fixed function state a primitive gets rasterised with. It mirrors what
+	/// the brushes and the BlendModeActivator configure for the OpenGL renderers.
+	struct DrawState
+	{
+		Math::Matrix4x4 Transform = Math::Matrix4x4::Identity;			//!< The projection, view and model matrix combined
+		Blending::BlendMode BlendMode = Blending::BlendModes::Alpha;	//!< How fragments get combined with the framebuffer
+		DepthFunction DepthTest = DepthFunction::Always;				//!< Always keeps the painter's order of the OpenGL renderers
+		bool DepthWrite = false;										//!< Whether passing fragments store their depth
+	};
+}
\ No newline at end of file
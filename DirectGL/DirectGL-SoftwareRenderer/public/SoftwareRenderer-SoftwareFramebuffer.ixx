@@ -0,0 +1,64 @@
+﻿// Project Name : DirectGL-SoftwareRenderer
+// File Name    : SoftwareRenderer-SoftwareFramebuffer.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+export module DirectGL.SoftwareRenderer:SoftwareFramebuffer;
+
+import DirectGL.Math;
+import DirectGL.Renderer;
+
+export namespace DGL::SoftwareRenderer
+{
+	/// A render target in system memory holding RGBA8 colors and float depth values.
+	/// Rows are stored top to bottom and padded to a multiple of four pixels, so the
+	/// rasteriser can always process four pixels at once without crossing into the
+	/// next row.
+	class SoftwareFramebuffer
+	{
+	public:
+
+		/// @brief Create a new framebuffer cleared to transparent black and the far plane.
+		/// @param size The size in pixels.
+		static std::unique_ptr<SoftwareFramebuffer> Create(Math::Uint2 size);
+
+		/// @brief Set every pixel to the same color and depth.
+		void Clear(Renderer::Color color, float depth = 1.0f);
+
+		/// @brief Set the depth of every pixel without touching the colors.
+		void ClearDepth(float depth = 1.0f);
+
+		/// @brief Copy a region of the colors.
+		/// @param region The region in pixels, measured from the top-left corner. Gets clamped to the framebuffer.
+		Renderer::PixelData ReadPixels(const Math::UintBoundary& region) const;
+
+		Math::Uint2 GetSize() const;
+
+		/// @brief Get the distance between two rows in pixels.
+		uint32_t GetStride() const;
+
+		/// @brief Get the packed RGBA8 colors. The bytes of every pixel are stored in R, G, B, A order.
+		uint32_t* GetColors();
+		const uint32_t* GetColors() const;
+
+		/// @brief Get the depth values in window space, ranging from 0 at the near plane to 1 at the far plane.
+		float* GetDepths();
+		const float* GetDepths() const;
+
+	private:
+
+		SoftwareFramebuffer(Math::Uint2 size, uint32_t stride);
+
+		Math::Uint2 m_Size;
+		uint32_t m_Stride;
+		std::vector<uint32_t> m_Colors;
+		std::vector<float> m_Depths;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+﻿// Project Name : DirectGL-SoftwareRenderer
+// File Name    : SoftwareRenderer-SoftwareTexture.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+export module DirectGL.SoftwareRenderer:SoftwareTexture;
+
+import DirectGL.Math;
+import DirectGL.Texture;
+
+export namespace DGL::SoftwareRenderer
+{
+	/// An RGBA8 texture in system memory, sampled by the tile rasteriser. Like the
+	/// OpenGL textures, the first row of the pixels is addressed by v = 0 and
+	/// coordinates outside [0, 1] get clamped to the edge.
+	class SoftwareTexture
+	{
+	public:
+
+		/// @brief Create a texture from tightly packed RGBA8 pixels.
+		/// @param size The size in pixels.
+		/// @param pixels The pixels. Must hold size.X * size.Y * 4 bytes.
+		/// @param origin Which row of the pixels is the top of the image.
+		/// @return The texture or nullptr if the size doesn't match the pixels.
+		static std::unique_ptr<SoftwareTexture> Create(Math::Uint2 size, std::span<const uint8_t> pixels, Texture::TextureOrigin origin = Texture::TextureOrigin::TopLeft);
+
+		/// @brief Create a texture from the base level of a decoded image.
+		/// @return The texture or nullptr if the image is block compressed.
+		static std::unique_ptr<SoftwareTexture> Create(const Texture::TextureImage& image);
+
+		Math::Uint2 GetSize() const;
+		Texture::TextureOrigin GetOrigin() const;
+		const uint32_t* GetTexels() const;
+
+	private:
+
+		SoftwareTexture(Math::Uint2 size, std::vector<uint32_t> texels, Texture::TextureOrigin origin);
+
+		Math::Uint2 m_Size;
+		std::vector<uint32_t> m_Texels;		//!< Packed RGBA8, the bytes of every texel in R, G, B, A order
+		Texture::TextureOrigin m_Origin;
+
+	};
+}
\ No newline at end of file
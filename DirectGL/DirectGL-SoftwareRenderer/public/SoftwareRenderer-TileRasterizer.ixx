@@ -0,0 +1,150 @@
+﻿// Project Name : DirectGL-SoftwareRenderer
+// File Name    : SoftwareRenderer-TileRasterizer.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+export module DirectGL.SoftwareRenderer:TileRasterizer;
+
+import DirectGL.Blending;
+import DirectGL.Math;
+import DirectGL.Renderer;
+import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
+import DirectGL.TextureRenderer;
+import Jobs;
+
+import :DrawState;
+import :SoftwareFramebuffer;
+import :SoftwareTexture;
+
+export namespace DGL::SoftwareRenderer
+{
+	struct RasterizerSettings
+	{
+		uint32_t TileSize = 64;		//!< The width and height of a tile in pixels. Gets rounded up to a multiple of four
+	};
+
+	struct RasterizerStatistics
+	{
+		uint64_t Triangles = 0;			//!< The triangles that survived the setup
+		uint64_t BinnedTriangles = 0;	//!< The triangles summed over all tiles. Exceeds Triangles when they cover several tiles
+		uint64_t ActiveTiles = 0;		//!< The tiles touched by at least one triangle
+		double RasterMilliseconds = 0;	//!< The time spent rasterising the tiles
+	};
+
+	/// Rasterises the triangles of the ShapeRenderer and the sprites of the TextureRenderer
+	/// on the CPU. Primitives get set up and sorted into square screen tiles as they are
+	/// submitted. Flush() then rasterises the tiles in parallel on the workers of a job
+	/// system, one thread per tile at a time. Every tile walks its primitives in submission order, so the result keeps the
+	/// painter's order of the OpenGL renderers without the workers ever synchronising.
+	///
+	/// Coverage, depth test and the fill of opaque primitives process four pixels per
+	/// step using SSE2 where available; blending runs on all four channels of a pixel at
+	/// once. Every other platform falls back to scalar code producing the same results.
+	class TileRasterizer
+	{
+	public:
+
+		/// @brief Create a new rasteriser.
+		/// @param jobSystem The workers rasterising the tiles, or nullptr to rasterise them on the calling thread.
+		///		   Must outlive the rasteriser.
+		static std::unique_ptr<TileRasterizer> Create(Jobs::JobSystem* jobSystem, const RasterizerSettings& settings = {});
+
+		/// @brief Select the framebuffer following primitives get drawn into.
+		///		   Pending primitives get flushed into the previous one first.
+		void SetFramebuffer(SoftwareFramebuffer* framebuffer);
+
+		/// @brief Queue a shape, as produced by the ShapeFactory.
+		/// @param color The color of every fragment, like the color of a SolidColorBrush.
+		/// @param state The transform, blend mode and depth test.
+		void DrawShape(const ShapeRenderer::Vertices& vertices, Renderer::Color color, const DrawState& state);
+
+		/// @brief Queue a shape. Points and lines are ignored; the ShapeFactory expands them into triangles.
+		/// @param positions The positions of the vertices.
+		/// @param indices The indices into the positions. An empty span draws the positions in order.
+		void DrawShape(std::span<const Math::Float3> positions, std::span<const uint32_t> indices, ShapeRenderer::PrimitiveType type, Renderer::Color color, const DrawState& state);
+
+		/// @brief Queue textured quads. The texture slot of the sprites is ignored.
+		/// @param sprites The sprites, as built by the RendererFacade.
+		/// @param texture The texture to sample from. Must stay alive until the next Flush().
+		/// @param filter How texels get filtered.
+		/// @param state The transform, blend mode and depth test. The transform takes the place of u_ProjectionViewMatrix.
+		void DrawSprites(std::span<const TextureRenderer::SpriteInstance> sprites, const SoftwareTexture& texture, Texture::TextureFilterModeId filter, const DrawState& state);
+
+		/// @brief Rasterise every queued primitive and wait until all tiles are done.
+		void Flush();
+
+		/// @brief Get the statistics of the latest Flush().
+		RasterizerStatistics GetStatistics() const;
+
+		/// @return The number of threads helping the calling thread.
+		uint32_t GetWorkerCount() const;
+
+	private:
+
+		/// The state shared by every triangle of one draw call.
+		struct DrawCall
+		{
+			Blending::BlendMode BlendMode;
+			DepthFunction DepthTest;
+			bool DepthWrite;
+			bool IsOpaque;						//!< The blend mode replaces the destination, so fragments can be stored as is
+			const SoftwareTexture* Texture;		//!< nullptr for solid shapes
+			Texture::TextureFilterModeId Filter;
+		};
+
+		/// A triangle in window space. Every attribute is stored as a plane a * x + b * y + c
+		/// over the pixel coordinates, so it can be evaluated at any pixel of any tile.
+		struct Triangle
+		{
+			int32_t MinX, MinY, MaxX, MaxY;		//!< The pixels covered by the bounding box, the maximum exclusive
+			std::array<float, 3> EdgeA;			//!< The edge functions, positive inside the triangle
+			std::array<float, 3> EdgeB;
+			std::array<float, 3> EdgeC;
+			uint32_t TopLeftEdges;				//!< One bit per edge owning the pixels centred exactly on it
+			std::array<float, 3> Depth;
+			std::array<float, 3> U;
+			std::array<float, 3> V;
+			std::array<float, 4> Color;			//!< The color or the tint, normalised to [0, 1]
+			uint32_t DrawIndex;
+		};
+
+		struct WindowVertex
+		{
+			float X, Y, Z;
+			float U, V;
+		};
+
+		explicit TileRasterizer(Jobs::JobSystem* jobSystem, uint32_t tileSize);
+
+		uint32_t AddDrawCall(const DrawState& state, const SoftwareTexture* texture, Texture::TextureFilterModeId filter);
+		bool ToWindow(const Math::Matrix4x4& transform, float x, float y, float z, WindowVertex& vertex) const;
+		void AddTriangle(WindowVertex a, WindowVertex b, WindowVertex c, const std::array<float, 4>& color, uint32_t drawIndex);
+
+		void RasterizeTile(uint32_t tileIndex);
+		void RasterizeTriangle(const Triangle& triangle, const DrawCall& drawCall, int32_t tileMinX, int32_t tileMinY, int32_t tileMaxX, int32_t tileMaxY);
+
+		Jobs::JobSystem* m_JobSystem;
+		uint32_t m_TileSize;
+		uint32_t m_TileCountX;
+		uint32_t m_TileCountY;
+		SoftwareFramebuffer* m_Framebuffer;
+
+		std::vector<DrawCall> m_DrawCalls;
+		std::vector<Triangle> m_Triangles;
+		std::vector<std::vector<uint32_t>> m_Bins;		//!< The indices of the triangles overlapping each tile, in submission order
+		std::vector<uint32_t> m_ActiveTiles;			//!< The tiles with a non-empty bin
+
+		RasterizerStatistics m_Statistics;
+		uint64_t m_BinnedTriangles;
+
+	};
+}
\ No newline at end of file
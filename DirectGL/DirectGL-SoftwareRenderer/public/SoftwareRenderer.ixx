@@ -0,0 +1,11 @@
+﻿// Project Name : DirectGL-SoftwareRenderer
+// File Name    : SoftwareRenderer.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL.SoftwareRenderer;
+
+export import :DrawState;
+export import :SoftwareFramebuffer;
+export import :SoftwareTexture;
+export import :TileRasterizer;
\ No newline at end of file
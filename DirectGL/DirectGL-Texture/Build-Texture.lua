@@ -15,10 +15,12 @@ project("DirectGL-Texture")
 
 		"Glad",
 		"Preconditions",
+		"Stb",
 	})
 
 	includedirs({
-		"%{wks.location}/Libraries/Glad/include"
+		"%{wks.location}/Libraries/Glad/include",
+		"%{wks.location}/Libraries/Stb/include",
 	})
 
 	filter("system:windows")
@@ -0,0 +1,242 @@
+﻿module;
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+module DirectGL.Texture;
+
+import Preconditions;
+
+namespace DGL::Texture
+{
+	namespace
+	{
+		using Block = std::array<uint8_t, 64>;
+
+		void FetchBlock(const Math::Uint2 size, const uint8_t* pixels, const uint32_t blockX, const uint32_t blockY, Block& block)
+		{
+			for (uint32_t y = 0; y < 4; ++y)
+			{
+				const uint32_t sourceY = std::min(blockY * 4 + y, size.Y - 1);
+
+				for (uint32_t x = 0; x < 4; ++x)
+				{
+					const uint32_t sourceX = std::min(blockX * 4 + x, size.X - 1);
+					std::memcpy(block.data() + (y * 4 + x) * 4, pixels + (static_cast<size_t>(sourceY) * size.X + sourceX) * 4, 4);
+				}
+			}
+		}
+
+		uint16_t PackRgb565(const uint32_t r, const uint32_t g, const uint32_t b)
+		{
+			return static_cast<uint16_t>((r * 31 + 127) / 255 << 11 | (g * 63 + 127) / 255 << 5 | (b * 31 + 127) / 255);
+		}
+
+		std::array<int32_t, 3> UnpackRgb565(const uint16_t color)
+		{
+			const int32_t r = color >> 11 & 31, g = color >> 5 & 63, b = color & 31;
+			return { r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2 };
+		}
+
+		void EncodeColorBlock(const Block& block, uint8_t* target)
+		{
+			std::array<int32_t, 3> minimum = { 255, 255, 255 };
+			std::array<int32_t, 3> maximum = { 0, 0, 0 };
+
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				for (uint32_t channel = 0; channel < 3; ++channel)
+				{
+					minimum[channel] = std::min<int32_t>(minimum[channel], block[i * 4 + channel]);
+					maximum[channel] = std::max<int32_t>(maximum[channel], block[i * 4 + channel]);
+				}
+			}
+
+			// Inset the bounding box by 1/16, as its corners rarely match an actual texel
+			for (uint32_t channel = 0; channel < 3; ++channel)
+			{
+				const int32_t inset = (maximum[channel] - minimum[channel]) / 16;
+				minimum[channel] += inset;
+				maximum[channel] -= inset;
+			}
+
+			// Pick the diagonal of the box that follows the colors: red and blue channels
+			// that fall while green rises get their endpoints swapped
+			std::array<int32_t, 3> mean = { 0, 0, 0 };
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				for (uint32_t channel = 0; channel < 3; ++channel)
+				{
+					mean[channel] += block[i * 4 + channel];
+				}
+			}
+
+			for (uint32_t channel : { 0u, 2u })
+			{
+				int32_t covariance = 0;
+				for (uint32_t i = 0; i < 16; ++i)
+				{
+					covariance += (block[i * 4 + channel] * 16 - mean[channel]) * (block[i * 4 + 1] * 16 - mean[1]);
+				}
+
+				if (covariance < 0)
+				{
+					std::swap(minimum[channel], maximum[channel]);
+				}
+			}
+
+			uint16_t color0 = PackRgb565(maximum[0], maximum[1], maximum[2]);
+			uint16_t color1 = PackRgb565(minimum[0], minimum[1], minimum[2]);
+
+			// color0 > color1 selects the four color mode, equal endpoints use a single color
+			if (color0 < color1)
+			{
+				std::swap(color0, color1);
+			}
+
+			uint32_t indices = 0;
+
+			if (color0 != color1)
+			{
+				const auto endpoint0 = UnpackRgb565(color0);
+				const auto endpoint1 = UnpackRgb565(color1);
+
+				std::array<std::array<int32_t, 3>, 4> palette = {};
+				for (uint32_t channel = 0; channel < 3; ++channel)
+				{
+					palette[0][channel] = endpoint0[channel];
+					palette[1][channel] = endpoint1[channel];
+					palette[2][channel] = (2 * endpoint0[channel] + endpoint1[channel]) / 3;
+					palette[3][channel] = (endpoint0[channel] + 2 * endpoint1[channel]) / 3;
+				}
+
+				for (uint32_t i = 0; i < 16; ++i)
+				{
+					uint32_t bestIndex = 0;
+					int32_t bestDistance = std::numeric_limits<int32_t>::max();
+
+					for (uint32_t index = 0; index < 4; ++index)
+					{
+						int32_t distance = 0;
+						for (uint32_t channel = 0; channel < 3; ++channel)
+						{
+							const int32_t delta = block[i * 4 + channel] - palette[index][channel];
+							distance += delta * delta;
+						}
+
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							bestIndex = index;
+						}
+					}
+
+					indices |= bestIndex << (i * 2);
+				}
+			}
+
+			std::memcpy(target + 0, &color0, 2);
+			std::memcpy(target + 2, &color1, 2);
+			std::memcpy(target + 4, &indices, 4);
+		}
+
+		void EncodeAlphaBlock(const Block& block, uint8_t* target)
+		{
+			int32_t minimum = 255, maximum = 0;
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				minimum = std::min<int32_t>(minimum, block[i * 4 + 3]);
+				maximum = std::max<int32_t>(maximum, block[i * 4 + 3]);
+			}
+
+			// alpha0 > alpha1 selects the mode with six interpolated values
+			std::array<int32_t, 8> palette = { maximum, minimum };
+			for (int32_t i = 1; i < 7; ++i)
+			{
+				palette[i + 1] = ((7 - i) * maximum + i * minimum) / 7;
+			}
+
+			uint64_t indices = 0;
+
+			if (maximum != minimum)
+			{
+				for (uint32_t i = 0; i < 16; ++i)
+				{
+					const int32_t alpha = block[i * 4 + 3];
+					uint64_t bestIndex = 0;
+
+					for (uint64_t index = 1; index < 8; ++index)
+					{
+						if (std::abs(alpha - palette[index]) < std::abs(alpha - palette[bestIndex]))
+						{
+							bestIndex = index;
+						}
+					}
+
+					indices |= bestIndex << (i * 3);
+				}
+			}
+
+			target[0] = static_cast<uint8_t>(maximum);
+			target[1] = static_cast<uint8_t>(minimum);
+			std::memcpy(target + 2, &indices, 6);
+		}
+	}
+
+	std::vector<uint8_t> EncodeBlocks(const TextureFormat format, const Math::Uint2 size, const uint8_t* pixels)
+	{
+		if (format != TextureFormat::BC1 and format != TextureFormat::BC3)
+		{
+			System::Error("Only BC1 and BC3 can be encoded");
+		}
+
+		const uint32_t blocksX = (size.X + 3) / 4;
+		const uint32_t blocksY = (size.Y + 3) / 4;
+		const size_t blockSize = format == TextureFormat::BC1 ? 8 : 16;
+
+		std::vector<uint8_t> blocks(CalculateImageSize(format, size));
+		Block block = {};
+
+		for (uint32_t blockY = 0; blockY < blocksY; ++blockY)
+		{
+			for (uint32_t blockX = 0; blockX < blocksX; ++blockX)
+			{
+				uint8_t* target = blocks.data() + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize;
+				FetchBlock(size, pixels, blockX, blockY, block);
+
+				// BC3 stores the alpha block in front of a BC1 color block
+				if (format == TextureFormat::BC3)
+				{
+					EncodeAlphaBlock(block, target);
+					target += 8;
+				}
+
+				EncodeColorBlock(block, target);
+			}
+		}
+
+		return blocks;
+	}
+
+	TextureImage CompressImage(const TextureImage& image, const TextureFormat format)
+	{
+		TextureImage compressed = {
+			.Size = image.Size,
+			.Format = format,
+			.Origin = image.Origin,
+			.Levels = {}
+		};
+
+		for (uint32_t level = 0; level < image.Levels.size(); ++level)
+		{
+			compressed.Levels.push_back(EncodeBlocks(format, GetMipLevelSize(image.Size, level), image.Levels[level].data()));
+		}
+
+		return compressed;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,503 @@
+﻿module;
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+module DirectGL.Texture;
+
+import Preconditions;
+
+namespace DGL::Texture
+{
+	namespace
+	{
+		void WriteUint32BigEndian(std::vector<uint8_t>& output, const uint32_t value)
+		{
+			output.push_back(static_cast<uint8_t>(value >> 24));
+			output.push_back(static_cast<uint8_t>(value >> 16));
+			output.push_back(static_cast<uint8_t>(value >> 8));
+			output.push_back(static_cast<uint8_t>(value));
+		}
+
+		/////////////////////////////////// - PNG - ///////////////////////////////////
+
+		constexpr std::array<uint32_t, 256> CreateCrcTable()
+		{
+			std::array<uint32_t, 256> table = {};
+
+			for (uint32_t i = 0; i < 256; ++i)
+			{
+				uint32_t crc = i;
+				for (uint32_t bit = 0; bit < 8; ++bit)
+				{
+					crc = crc & 1 ? 0xEDB88320u ^ crc >> 1 : crc >> 1;
+				}
+
+				table[i] = crc;
+			}
+
+			return table;
+		}
+
+		constexpr std::array<uint32_t, 256> CrcTable = CreateCrcTable();
+
+		uint32_t CalculateCrc(const uint8_t* data, const size_t size)
+		{
+			uint32_t crc = 0xFFFFFFFFu;
+			for (size_t i = 0; i < size; ++i)
+			{
+				crc = CrcTable[(crc ^ data[i]) & 0xFF] ^ crc >> 8;
+			}
+
+			return crc ^ 0xFFFFFFFFu;
+		}
+
+		uint32_t CalculateAdler32(const uint8_t* data, const size_t size)
+		{
+			constexpr uint32_t Modulus = 65521;
+			constexpr size_t MaxRunLength = 5552; // Largest run that can't overflow the sums
+
+			uint32_t a = 1;
+			uint32_t b = 0;
+
+			for (size_t offset = 0; offset < size; offset += MaxRunLength)
+			{
+				const size_t end = std::min(offset + MaxRunLength, size);
+				for (size_t i = offset; i < end; ++i)
+				{
+					a += data[i];
+					b += a;
+				}
+
+				a %= Modulus;
+				b %= Modulus;
+			}
+
+			return b << 16 | a;
+		}
+
+		void WriteChunk(std::vector<uint8_t>& output, const char (&type)[5], const uint8_t* data, const size_t size)
+		{
+			WriteUint32BigEndian(output, static_cast<uint32_t>(size));
+
+			const size_t start = output.size();
+			output.insert(output.end(), type, type + 4);
+			output.insert(output.end(), data, data + size);
+
+			WriteUint32BigEndian(output, CalculateCrc(output.data() + start, output.size() - start));
+		}
+
+		class BitWriter
+		{
+		public:
+
+			explicit BitWriter(std::vector<uint8_t>& output):
+				m_Output(&output),
+				m_Buffer(0),
+				m_BitCount(0)
+			{
+			}
+
+			/// Write the lowest bits of the value, least significant bit first.
+			void Write(const uint32_t value, const uint32_t bitCount)
+			{
+				m_Buffer |= static_cast<uint64_t>(value) << m_BitCount;
+				m_BitCount += bitCount;
+
+				while (m_BitCount >= 8)
+				{
+					m_Output->push_back(static_cast<uint8_t>(m_Buffer));
+					m_Buffer >>= 8;
+					m_BitCount -= 8;
+				}
+			}
+
+			/// Write a huffman code, which is stored most significant bit first.
+			void WriteCode(const uint32_t code, const uint32_t bitCount)
+			{
+				uint32_t reversed = 0;
+				for (uint32_t i = 0; i < bitCount; ++i)
+				{
+					reversed |= (code >> i & 1) << (bitCount - 1 - i);
+				}
+
+				Write(reversed, bitCount);
+			}
+
+			void Flush()
+			{
+				if (m_BitCount > 0)
+				{
+					m_Output->push_back(static_cast<uint8_t>(m_Buffer));
+					m_Buffer = 0;
+					m_BitCount = 0;
+				}
+			}
+
+		private:
+
+			std::vector<uint8_t>* m_Output;
+			uint64_t m_Buffer;
+			uint32_t m_BitCount;
+
+		};
+
+		constexpr std::array<uint16_t, 29> LengthBases = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+		constexpr std::array<uint8_t, 29> LengthExtraBits = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+		constexpr std::array<uint16_t, 30> DistanceBases = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+		constexpr std::array<uint8_t, 30> DistanceExtraBits = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+		void WriteLiteralOrLength(BitWriter& writer, const uint32_t symbol)
+		{
+			if (symbol < 144)		writer.WriteCode(0x30 + symbol, 8);
+			else if (symbol < 256)	writer.WriteCode(0x190 + symbol - 144, 9);
+			else if (symbol < 280)	writer.WriteCode(symbol - 256, 7);
+			else					writer.WriteCode(0xC0 + symbol - 280, 8);
+		}
+
+		void WriteMatch(BitWriter& writer, const uint32_t length, const uint32_t distance)
+		{
+			const size_t lengthCode = std::upper_bound(LengthBases.begin(), LengthBases.end(), length) - LengthBases.begin() - 1;
+			WriteLiteralOrLength(writer, 257 + static_cast<uint32_t>(lengthCode));
+			writer.Write(length - LengthBases[lengthCode], LengthExtraBits[lengthCode]);
+
+			const size_t distanceCode = std::upper_bound(DistanceBases.begin(), DistanceBases.end(), distance) - DistanceBases.begin() - 1;
+			writer.WriteCode(static_cast<uint32_t>(distanceCode), 5);
+			writer.Write(distance - DistanceBases[distanceCode], DistanceExtraBits[distanceCode]);
+		}
+
+		/// Compress the data into a zlib stream. Matches are found through hash chains
+		/// of limited depth and emitted greedily with the fixed huffman codes.
+		std::vector<uint8_t> Deflate(const uint8_t* data, const size_t size)
+		{
+			constexpr uint32_t WindowSize = 32768;
+			constexpr uint32_t HashBits = 15;
+			constexpr uint32_t MinMatchLength = 3;
+			constexpr uint32_t MaxMatchLength = 258;
+			constexpr uint32_t MaxChainLength = 16;
+			constexpr uint32_t NoPosition = UINT32_MAX;
+
+			std::vector<uint8_t> output;
+			output.reserve(size / 2 + 64);
+
+			// CMF / FLG: deflate with a 32K window, no dictionary, fastest level
+			output.push_back(0x78);
+			output.push_back(0x01);
+
+			BitWriter writer(output);
+			writer.Write(1, 1); // BFINAL
+			writer.Write(1, 2); // BTYPE: fixed huffman codes
+
+			std::vector<uint32_t> head(1u << HashBits, NoPosition);
+			std::vector<uint32_t> previous(WindowSize, NoPosition);
+
+			const auto hash = [data](const size_t position)
+			{
+				const uint32_t value = data[position] | data[position + 1] << 8 | data[position + 2] << 16;
+				return value * 2654435761u >> (32 - HashBits);
+			};
+
+			const auto insert = [&](const size_t position)
+			{
+				const uint32_t key = hash(position);
+				previous[position % WindowSize] = head[key];
+				head[key] = static_cast<uint32_t>(position);
+			};
+
+			size_t position = 0;
+			while (position < size)
+			{
+				uint32_t bestLength = 0;
+				uint32_t bestDistance = 0;
+
+				if (position + MinMatchLength <= size)
+				{
+					const uint32_t maxLength = static_cast<uint32_t>(std::min<size_t>(MaxMatchLength, size - position));
+					uint32_t candidate = head[hash(position)];
+
+					for (uint32_t chain = 0; chain < MaxChainLength and candidate != NoPosition and position - candidate <= WindowSize; ++chain)
+					{
+						uint32_t length = 0;
+						while (length < maxLength and data[candidate + length] == data[position + length])
+						{
+							++length;
+						}
+
+						if (length > bestLength)
+						{
+							bestLength = length;
+							bestDistance = static_cast<uint32_t>(position - candidate);
+
+							if (length == maxLength)
+							{
+								break;
+							}
+						}
+
+						candidate = previous[candidate % WindowSize];
+					}
+				}
+
+				if (bestLength >= MinMatchLength)
+				{
+					WriteMatch(writer, bestLength, bestDistance);
+
+					for (size_t i = 0; i < bestLength and position + i + MinMatchLength <= size; ++i)
+					{
+						insert(position + i);
+					}
+
+					position += bestLength;
+				}
+				else
+				{
+					WriteLiteralOrLength(writer, data[position]);
+
+					if (position + MinMatchLength <= size)
+					{
+						insert(position);
+					}
+
+					++position;
+				}
+			}
+
+			WriteLiteralOrLength(writer, 256);
+			writer.Flush();
+
+			WriteUint32BigEndian(output, CalculateAdler32(data, size));
+			return output;
+		}
+
+		uint8_t PredictPaeth(const int32_t left, const int32_t up, const int32_t upLeft)
+		{
+			const int32_t estimate = left + up - upLeft;
+			const int32_t distanceLeft = std::abs(estimate - left);
+			const int32_t distanceUp = std::abs(estimate - up);
+			const int32_t distanceUpLeft = std::abs(estimate - upLeft);
+
+			if (distanceLeft <= distanceUp and distanceLeft <= distanceUpLeft) return static_cast<uint8_t>(left);
+			if (distanceUp <= distanceUpLeft) return static_cast<uint8_t>(up);
+			return static_cast<uint8_t>(upLeft);
+		}
+
+		/// Filter every row with the filter yielding the smallest sum of absolute
+		/// differences, which is the heuristic suggested by the png specification.
+		std::vector<uint8_t> FilterRows(const Math::Uint2 size, const uint8_t* pixels)
+		{
+			constexpr size_t BytesPerPixel = 4;
+			constexpr size_t FilterCount = 5;
+
+			const size_t stride = static_cast<size_t>(size.X) * BytesPerPixel;
+			std::vector<uint8_t> filtered((stride + 1) * size.Y);
+
+			std::array<std::vector<uint8_t>, FilterCount> candidates;
+			for (std::vector<uint8_t>& candidate : candidates)
+			{
+				candidate.resize(stride);
+			}
+
+			const std::vector<uint8_t> zeroRow(stride, 0);
+
+			for (uint32_t y = 0; y < size.Y; ++y)
+			{
+				const uint8_t* row = pixels + y * stride;
+				const uint8_t* above = y > 0 ? row - stride : zeroRow.data();
+
+				for (size_t i = 0; i < stride; ++i)
+				{
+					const uint8_t left = i >= BytesPerPixel ? row[i - BytesPerPixel] : 0;
+					const uint8_t upLeft = i >= BytesPerPixel ? above[i - BytesPerPixel] : 0;
+
+					candidates[0][i] = row[i];
+					candidates[1][i] = static_cast<uint8_t>(row[i] - left);
+					candidates[2][i] = static_cast<uint8_t>(row[i] - above[i]);
+					candidates[3][i] = static_cast<uint8_t>(row[i] - (left + above[i]) / 2);
+					candidates[4][i] = static_cast<uint8_t>(row[i] - PredictPaeth(left, above[i], upLeft));
+				}
+
+				size_t bestFilter = 0;
+				uint64_t bestCost = UINT64_MAX;
+
+				for (size_t filter = 0; filter < FilterCount; ++filter)
+				{
+					uint64_t cost = 0;
+					for (const uint8_t value : candidates[filter])
+					{
+						cost += static_cast<uint64_t>(std::abs(static_cast<int8_t>(value)));
+					}
+
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						bestFilter = filter;
+					}
+				}
+
+				uint8_t* destination = filtered.data() + y * (stride + 1);
+				destination[0] = static_cast<uint8_t>(bestFilter);
+				std::memcpy(destination + 1, candidates[bestFilter].data(), stride);
+			}
+
+			return filtered;
+		}
+
+		/////////////////////////////////// - QOI - ///////////////////////////////////
+
+		constexpr uint8_t QoiIndex = 0x00;
+		constexpr uint8_t QoiDiff = 0x40;
+		constexpr uint8_t QoiLuma = 0x80;
+		constexpr uint8_t QoiRun = 0xC0;
+		constexpr uint8_t QoiRgb = 0xFE;
+		constexpr uint8_t QoiRgba = 0xFF;
+
+		struct QoiPixel
+		{
+			uint8_t R = 0;
+			uint8_t G = 0;
+			uint8_t B = 0;
+			uint8_t A = 0;
+
+			bool operator==(const QoiPixel&) const = default;
+
+			uint32_t Hash() const
+			{
+				return (R * 3u + G * 5u + B * 7u + A * 11u) % 64;
+			}
+		};
+	}
+
+	std::string_view GetFileExtension(const ImageFileFormat format)
+	{
+		switch (format)
+		{
+			case ImageFileFormat::Png: return ".png";
+			case ImageFileFormat::Qoi: return ".qoi";
+			default: System::Error("Unknown image file format"); return {};
+		}
+	}
+
+	std::vector<uint8_t> EncodePng(const Math::Uint2 size, const uint8_t* pixels)
+	{
+		const std::vector<uint8_t> filtered = FilterRows(size, pixels);
+		const std::vector<uint8_t> compressed = Deflate(filtered.data(), filtered.size());
+
+		std::vector<uint8_t> output = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		output.reserve(compressed.size() + 64);
+
+		std::vector<uint8_t> header;
+		WriteUint32BigEndian(header, size.X);
+		WriteUint32BigEndian(header, size.Y);
+		header.insert(header.end(), {
+			8, // Bit depth
+			6, // Color type: RGBA
+			0, // Compression method: deflate
+			0, // Filter method: adaptive
+			0, // Interlace method: none
+		});
+
+		WriteChunk(output, "IHDR", header.data(), header.size());
+		WriteChunk(output, "IDAT", compressed.data(), compressed.size());
+		WriteChunk(output, "IEND", nullptr, 0);
+
+		return output;
+	}
+
+	std::vector<uint8_t> EncodeQoi(const Math::Uint2 size, const uint8_t* pixels)
+	{
+		const size_t pixelCount = static_cast<size_t>(size.X) * size.Y;
+
+		std::vector<uint8_t> output = { 'q', 'o', 'i', 'f' };
+		output.reserve(14 + pixelCount * 5 + 8);
+
+		WriteUint32BigEndian(output, size.X);
+		WriteUint32BigEndian(output, size.Y);
+		output.push_back(4); // Channels: RGBA
+		output.push_back(0); // Colorspace: sRGB with linear alpha
+
+		std::array<QoiPixel, 64> index = {};
+		QoiPixel previous = { .R = 0, .G = 0, .B = 0, .A = 255 };
+		uint32_t run = 0;
+
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			const uint8_t* source = pixels + i * 4;
+			const QoiPixel pixel = { .R = source[0], .G = source[1], .B = source[2], .A = source[3] };
+
+			if (pixel == previous)
+			{
+				if (++run == 62 or i + 1 == pixelCount)
+				{
+					output.push_back(static_cast<uint8_t>(QoiRun | (run - 1)));
+					run = 0;
+				}
+
+				continue;
+			}
+
+			if (run > 0)
+			{
+				output.push_back(static_cast<uint8_t>(QoiRun | (run - 1)));
+				run = 0;
+			}
+
+			const uint32_t hash = pixel.Hash();
+			if (index[hash] == pixel)
+			{
+				output.push_back(static_cast<uint8_t>(QoiIndex | hash));
+			}
+			else
+			{
+				index[hash] = pixel;
+
+				if (pixel.A == previous.A)
+				{
+					const int8_t dr = static_cast<int8_t>(pixel.R - previous.R);
+					const int8_t dg = static_cast<int8_t>(pixel.G - previous.G);
+					const int8_t db = static_cast<int8_t>(pixel.B - previous.B);
+					const int8_t drg = static_cast<int8_t>(dr - dg);
+					const int8_t dbg = static_cast<int8_t>(db - dg);
+
+					if (dr >= -2 and dr <= 1 and dg >= -2 and dg <= 1 and db >= -2 and db <= 1)
+					{
+						output.push_back(static_cast<uint8_t>(QoiDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+					}
+					else if (dg >= -32 and dg <= 31 and drg >= -8 and drg <= 7 and dbg >= -8 and dbg <= 7)
+					{
+						output.push_back(static_cast<uint8_t>(QoiLuma | (dg + 32)));
+						output.push_back(static_cast<uint8_t>((drg + 8) << 4 | (dbg + 8)));
+					}
+					else
+					{
+						output.insert(output.end(), { QoiRgb, pixel.R, pixel.G, pixel.B });
+					}
+				}
+				else
+				{
+					output.insert(output.end(), { QoiRgba, pixel.R, pixel.G, pixel.B, pixel.A });
+				}
+			}
+
+			previous = pixel;
+		}
+
+		// End marker
+		output.insert(output.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+		return output;
+	}
+
+	std::vector<uint8_t> EncodeImage(const ImageFileFormat format, const Math::Uint2 size, const uint8_t* pixels)
+	{
+		switch (format)
+		{
+			case ImageFileFormat::Png: return EncodePng(size, pixels);
+			case ImageFileFormat::Qoi: return EncodeQoi(size, pixels);
+			default: System::Error("Unknown image file format"); return {};
+		}
+	}
+}
\ No newline at end of file
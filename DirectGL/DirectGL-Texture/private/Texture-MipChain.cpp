@@ -0,0 +1,123 @@
+﻿module;
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__)
+	#include <emmintrin.h>
+	#define DGL_MIPCHAIN_SSE2 1
+#endif
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	namespace
+	{
+		void DownsampleRowScalar(const uint8_t* top, const uint8_t* bottom, uint8_t* target, const uint32_t sourceWidth, const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t x = begin; x < end; ++x)
+			{
+				const uint32_t left = std::min(x * 2, sourceWidth - 1) * 4;
+				const uint32_t right = std::min(x * 2 + 1, sourceWidth - 1) * 4;
+
+				for (uint32_t channel = 0; channel < 4; ++channel)
+				{
+					const uint32_t sum = top[left + channel] + top[right + channel] + bottom[left + channel] + bottom[right + channel];
+					target[x * 4 + channel] = static_cast<uint8_t>((sum + 2) / 4);
+				}
+			}
+		}
+
+#ifdef DGL_MIPCHAIN_SSE2
+		/// Produces two target texels per iteration from 4x2 source texels.
+		/// Requires every target texel to have two distinct source columns.
+		uint32_t DownsampleRowSse2(const uint8_t* top, const uint8_t* bottom, uint8_t* target, const uint32_t targetWidth)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rounding = _mm_set1_epi16(2);
+
+			uint32_t x = 0;
+			for (; x + 2 <= targetWidth; x += 2)
+			{
+				const __m128i upper = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + x * 8));
+				const __m128i lower = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + x * 8));
+
+				// Vertical sums of the texels 0/1 and 2/3 in 16 bit per channel
+				const __m128i first = _mm_add_epi16(_mm_unpacklo_epi8(upper, zero), _mm_unpacklo_epi8(lower, zero));
+				const __m128i second = _mm_add_epi16(_mm_unpackhi_epi8(upper, zero), _mm_unpackhi_epi8(lower, zero));
+
+				// Horizontal sums of neighbouring texels end up in the lower halves
+				const __m128i firstSum = _mm_add_epi16(first, _mm_srli_si128(first, 8));
+				const __m128i secondSum = _mm_add_epi16(second, _mm_srli_si128(second, 8));
+
+				const __m128i average = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(firstSum, secondSum), rounding), 2);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(target + x * 4), _mm_packus_epi16(average, zero));
+			}
+
+			return x;
+		}
+#endif
+	}
+
+	Math::Uint2 GetMipLevelSize(const Math::Uint2 size, const uint32_t level)
+	{
+		const uint32_t shift = std::min(level, 31u);
+		return { std::max(size.X >> shift, 1u), std::max(size.Y >> shift, 1u) };
+	}
+
+	void DownsampleBox(const Math::Uint2 sourceSize, const uint8_t* source, uint8_t* target)
+	{
+		const Math::Uint2 targetSize = GetMipLevelSize(sourceSize, 1);
+		const size_t sourceStride = static_cast<size_t>(sourceSize.X) * 4;
+		const size_t targetStride = static_cast<size_t>(targetSize.X) * 4;
+
+		for (uint32_t y = 0; y < targetSize.Y; ++y)
+		{
+			const uint8_t* top = source + std::min(y * 2, sourceSize.Y - 1) * sourceStride;
+			const uint8_t* bottom = source + std::min(y * 2 + 1, sourceSize.Y - 1) * sourceStride;
+			uint8_t* row = target + y * targetStride;
+
+			uint32_t x = 0;
+
+#ifdef DGL_MIPCHAIN_SSE2
+			if (sourceSize.X >= 2)
+			{
+				x = DownsampleRowSse2(top, bottom, row, targetSize.X);
+			}
+#endif
+
+			DownsampleRowScalar(top, bottom, row, sourceSize.X, x, targetSize.X);
+		}
+	}
+
+	std::vector<MipLevel> BuildMipChain(const Math::Uint2 size, const uint8_t* pixels)
+	{
+		const auto levelCount = static_cast<uint32_t>(std::bit_width(std::max({ size.X, size.Y, 1u })));
+
+		std::vector<MipLevel> levels;
+		levels.reserve(levelCount - 1);
+
+		Math::Uint2 sourceSize = size;
+		const uint8_t* source = pixels;
+
+		for (uint32_t level = 1; level < levelCount; ++level)
+		{
+			const Math::Uint2 levelSize = GetMipLevelSize(size, level);
+
+			MipLevel& mipLevel = levels.emplace_back(MipLevel{
+				.Size = levelSize,
+				.Pixels = std::vector<uint8_t>(static_cast<size_t>(levelSize.X) * levelSize.Y * 4)
+			});
+
+			DownsampleBox(sourceSize, source, mipLevel.Pixels.data());
+
+			sourceSize = levelSize;
+			source = mipLevel.Pixels.data();
+		}
+
+		return levels;
+	}
+}
\ No newline at end of file
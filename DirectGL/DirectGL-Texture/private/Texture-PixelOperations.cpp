@@ -0,0 +1,228 @@
+﻿module;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if defined(_M_X64) || defined(__SSE2__)
+	#include <emmintrin.h>
+	#define DGL_PIXELOPERATIONS_SSE2 1
+#endif
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	namespace
+	{
+		/// Exact rounded division by 255 for values up to 255 * 255.
+		constexpr uint32_t Divide255(const uint32_t value)
+		{
+			return (value + 128 + ((value + 128) >> 8)) >> 8;
+		}
+
+		void BlendPixelScalar(uint8_t* destination, const uint8_t* source, const Rgba8& tint)
+		{
+			const uint32_t sourceAlpha = Divide255(source[3] * tint[3]);
+
+			for (uint32_t channel = 0; channel < 3; ++channel)
+			{
+				const uint32_t color = Divide255(source[channel] * tint[channel]);
+				destination[channel] = static_cast<uint8_t>(Divide255(color * sourceAlpha + destination[channel] * (255 - sourceAlpha)));
+			}
+
+			destination[3] = static_cast<uint8_t>(Divide255(sourceAlpha * 255 + destination[3] * (255 - sourceAlpha)));
+		}
+
+		uint32_t CalculateLuminance(const uint8_t* pixel)
+		{
+			// Rec. 601 weights scaled to a sum of 256
+			return pixel[0] * 77u + pixel[1] * 150u + pixel[2] * 29u;
+		}
+
+#ifdef DGL_PIXELOPERATIONS_SSE2
+		__m128i Divide255Sse2(const __m128i value)
+		{
+			const __m128i rounded = _mm_add_epi16(value, _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(rounded, _mm_srli_epi16(rounded, 8)), 8);
+		}
+
+		/// Blends two pixels held in 16 bit lanes.
+		__m128i BlendTwoPixelsSse2(const __m128i destination, const __m128i source, const __m128i tint, const __m128i alphaLanes)
+		{
+			const __m128i tinted = Divide255Sse2(_mm_mullo_epi16(source, tint));
+
+			// Broadcast the alpha of each pixel to its four lanes
+			const __m128i sourceAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(tinted, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			const __m128i inverseAlpha = _mm_sub_epi16(_mm_set1_epi16(255), sourceAlpha);
+
+			// The alpha channel is weighted by one instead of by itself
+			const __m128i sourceFactor = _mm_or_si128(_mm_andnot_si128(alphaLanes, sourceAlpha), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+
+			return Divide255Sse2(_mm_add_epi16(_mm_mullo_epi16(tinted, sourceFactor), _mm_mullo_epi16(destination, inverseAlpha)));
+		}
+#endif
+	}
+
+	void FillPixels(const std::span<uint8_t> pixels, const Rgba8 color)
+	{
+		const size_t pixelCount = pixels.size() / 4;
+		uint8_t* data = pixels.data();
+		size_t i = 0;
+
+#ifdef DGL_PIXELOPERATIONS_SSE2
+		uint32_t packed = 0;
+		std::memcpy(&packed, color.data(), 4);
+
+		const __m128i value = _mm_set1_epi32(static_cast<int32_t>(packed));
+		for (; i + 4 <= pixelCount; i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4), value);
+		}
+#endif
+
+		for (; i < pixelCount; ++i)
+		{
+			std::memcpy(data + i * 4, color.data(), 4);
+		}
+	}
+
+	void BlendPixels(const std::span<uint8_t> destination, const std::span<const uint8_t> source)
+	{
+		BlendPixelsTinted(destination, source, { 255, 255, 255, 255 });
+	}
+
+	void BlendPixelsTinted(const std::span<uint8_t> destination, const std::span<const uint8_t> source, const Rgba8 tint)
+	{
+		const size_t pixelCount = std::min(destination.size(), source.size()) / 4;
+		uint8_t* target = destination.data();
+		const uint8_t* pixels = source.data();
+		size_t i = 0;
+
+#ifdef DGL_PIXELOPERATIONS_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i tint16 = _mm_setr_epi16(tint[0], tint[1], tint[2], tint[3], tint[0], tint[1], tint[2], tint[3]);
+		const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+		for (; i + 4 <= pixelCount; i += 4)
+		{
+			const __m128i sourceBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+			const __m128i targetBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i * 4));
+
+			const __m128i low = BlendTwoPixelsSse2(_mm_unpacklo_epi8(targetBytes, zero), _mm_unpacklo_epi8(sourceBytes, zero), tint16, alphaLanes);
+			const __m128i high = BlendTwoPixelsSse2(_mm_unpackhi_epi8(targetBytes, zero), _mm_unpackhi_epi8(sourceBytes, zero), tint16, alphaLanes);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(target + i * 4), _mm_packus_epi16(low, high));
+		}
+#endif
+
+		for (; i < pixelCount; ++i)
+		{
+			BlendPixelScalar(target + i * 4, pixels + i * 4, tint);
+		}
+	}
+
+	void ThresholdPixels(const std::span<uint8_t> pixels, const uint8_t threshold)
+	{
+		const size_t pixelCount = pixels.size() / 4;
+		const uint32_t scaledThreshold = threshold * 256u;
+		uint8_t* data = pixels.data();
+		size_t i = 0;
+
+#ifdef DGL_PIXELOPERATIONS_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i weights = _mm_setr_epi16(77, 150, 29, 0, 77, 150, 29, 0);
+		const __m128i limit = _mm_set1_epi32(static_cast<int32_t>(scaledThreshold) - 1);
+		const __m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+		const __m128i alphaMask = _mm_set1_epi32(static_cast<int32_t>(0xFF000000));
+
+		for (; i + 4 <= pixelCount; i += 4)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4));
+
+			// Partial sums r*77 + g*150 and b*29 per pixel
+			const __m128i low = _mm_madd_epi16(_mm_unpacklo_epi8(bytes, zero), weights);
+			const __m128i high = _mm_madd_epi16(_mm_unpackhi_epi8(bytes, zero), weights);
+
+			// Transpose, so the partial sums of each pixel can be added lane by lane
+			const __m128i mixedLow = _mm_unpacklo_epi32(low, high);
+			const __m128i mixedHigh = _mm_unpackhi_epi32(low, high);
+			const __m128i luminance = _mm_add_epi32(_mm_unpacklo_epi32(mixedLow, mixedHigh), _mm_unpackhi_epi32(mixedLow, mixedHigh));
+
+			const __m128i white = _mm_cmpgt_epi32(luminance, limit);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4), _mm_or_si128(_mm_and_si128(white, colorMask), _mm_and_si128(bytes, alphaMask)));
+		}
+#endif
+
+		for (; i < pixelCount; ++i)
+		{
+			uint8_t* pixel = data + i * 4;
+			const uint8_t value = CalculateLuminance(pixel) >= scaledThreshold ? 255 : 0;
+			pixel[0] = pixel[1] = pixel[2] = value;
+		}
+	}
+
+	void ConvolvePixels(const Math::Uint2 size, const uint8_t* source, uint8_t* destination, const std::span<const float> kernel, const uint32_t kernelSize, const uint32_t firstRow, const uint32_t rowCount)
+	{
+		const int32_t radius = static_cast<int32_t>(kernelSize / 2);
+		const int32_t maxX = static_cast<int32_t>(size.X) - 1;
+		const int32_t maxY = static_cast<int32_t>(size.Y) - 1;
+		const size_t stride = static_cast<size_t>(size.X) * 4;
+
+		for (uint32_t y = firstRow; y < std::min(firstRow + rowCount, size.Y); ++y)
+		{
+			for (uint32_t x = 0; x < size.X; ++x)
+			{
+#ifdef DGL_PIXELOPERATIONS_SSE2
+				const __m128i zero = _mm_setzero_si128();
+				__m128 sum = _mm_setzero_ps();
+#else
+				std::array<float, 4> sum = {};
+#endif
+
+				for (int32_t ky = -radius; ky <= radius; ++ky)
+				{
+					const uint8_t* row = source + std::clamp(static_cast<int32_t>(y) + ky, 0, maxY) * stride;
+					const float* weights = kernel.data() + (ky + radius) * kernelSize;
+
+					for (int32_t kx = -radius; kx <= radius; ++kx)
+					{
+						const uint8_t* pixel = row + std::clamp(static_cast<int32_t>(x) + kx, 0, maxX) * 4;
+						const float weight = weights[kx + radius];
+
+#ifdef DGL_PIXELOPERATIONS_SSE2
+						int32_t packed = 0;
+						std::memcpy(&packed, pixel, 4);
+
+						const __m128i channels = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(channels), _mm_set1_ps(weight)));
+#else
+						for (uint32_t channel = 0; channel < 4; ++channel)
+						{
+							sum[channel] += static_cast<float>(pixel[channel]) * weight;
+						}
+#endif
+					}
+				}
+
+				uint8_t* target = destination + y * stride + x * 4;
+
+#ifdef DGL_PIXELOPERATIONS_SSE2
+				// Rounds to nearest and saturates to [0, 255] while packing
+				const __m128i rounded = _mm_cvtps_epi32(sum);
+				const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(rounded, zero), zero);
+				const int32_t result = _mm_cvtsi128_si32(packed);
+				std::memcpy(target, &result, 4);
+#else
+				for (uint32_t channel = 0; channel < 4; ++channel)
+				{
+					target[channel] = static_cast<uint8_t>(std::clamp(std::nearbyint(sum[channel]), 0.0f, 255.0f));
+				}
+#endif
+			}
+		}
+	}
+}
\ No newline at end of file
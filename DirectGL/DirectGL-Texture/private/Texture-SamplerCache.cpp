@@ -0,0 +1,41 @@
+﻿module;
+
+#include <algorithm>
+#include <memory>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	std::unique_ptr<SamplerCache> SamplerCache::Create()
+	{
+		return std::unique_ptr<SamplerCache>(new SamplerCache(TextureSampler::GetMaxAnisotropy()));
+	}
+
+	const TextureSampler& SamplerCache::Get(const SamplerState& state)
+	{
+		// Clamp the same way the sampler does, so the lookup compares what actually ends up on the GPU
+		SamplerState key = state;
+		key.Anisotropy = std::clamp(state.Anisotropy, 1.0f, m_MaxAnisotropy);
+
+		for (const auto& sampler : m_Samplers)
+		{
+			if (sampler->GetState() == key)
+			{
+				return *sampler;
+			}
+		}
+
+		return *m_Samplers.emplace_back(TextureSampler::Create(key));
+	}
+
+	size_t SamplerCache::GetSamplerCount() const
+	{
+		return m_Samplers.size();
+	}
+
+	SamplerCache::SamplerCache(const float maxAnisotropy):
+		m_MaxAnisotropy(maxAnisotropy)
+	{
+	}
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+﻿module;
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	SkylinePacker::SkylinePacker(const Math::Uint2 size):
+		m_Skyline({ Segment{ .X = 0, .Y = 0, .Width = size.X } }),
+		m_Size(size),
+		m_UsedArea(0)
+	{
+	}
+
+	std::optional<Math::Uint2> SkylinePacker::Insert(const Math::Uint2 size)
+	{
+		if (size.X == 0 or size.Y == 0)
+		{
+			return std::nullopt;
+		}
+
+		size_t bestIndex = m_Skyline.size();
+		uint32_t bestBottom = std::numeric_limits<uint32_t>::max();
+		uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+		uint32_t bestY = 0;
+
+		// Pick the position with the lowest bottom edge, preferring narrow segments to reduce waste
+		for (size_t i = 0; i < m_Skyline.size(); ++i)
+		{
+			const std::optional<uint32_t> y = Fit(i, size);
+			if (not y.has_value())
+			{
+				continue;
+			}
+
+			const uint32_t bottom = *y + size.Y;
+			if (bottom < bestBottom or (bottom == bestBottom and m_Skyline[i].Width < bestWidth))
+			{
+				bestIndex = i;
+				bestBottom = bottom;
+				bestWidth = m_Skyline[i].Width;
+				bestY = *y;
+			}
+		}
+
+		if (bestIndex == m_Skyline.size())
+		{
+			return std::nullopt;
+		}
+
+		const uint32_t x = m_Skyline[bestIndex].X;
+		m_Skyline.insert(m_Skyline.begin() + static_cast<ptrdiff_t>(bestIndex), Segment{ .X = x, .Y = bestBottom, .Width = size.X });
+
+		// Cut away the segments that are now covered by the new one
+		for (size_t i = bestIndex + 1; i < m_Skyline.size();)
+		{
+			const Segment& previous = m_Skyline[i - 1];
+			Segment& segment = m_Skyline[i];
+
+			const uint32_t previousRight = previous.X + previous.Width;
+			if (segment.X >= previousRight)
+			{
+				break;
+			}
+
+			const uint32_t overlap = previousRight - segment.X;
+			if (segment.Width <= overlap)
+			{
+				m_Skyline.erase(m_Skyline.begin() + static_cast<ptrdiff_t>(i));
+				continue;
+			}
+
+			segment.X += overlap;
+			segment.Width -= overlap;
+			break;
+		}
+
+		Merge();
+
+		m_UsedArea += static_cast<uint64_t>(size.X) * size.Y;
+		return Math::Uint2{ x, bestY };
+	}
+
+	void SkylinePacker::Grow(const Math::Uint2 size)
+	{
+		if (size.X > m_Size.X)
+		{
+			const uint32_t extension = size.X - m_Size.X;
+
+			if (Segment& last = m_Skyline.back(); last.Y == 0)
+			{
+				last.Width += extension;
+			}
+			else
+			{
+				m_Skyline.push_back(Segment{ .X = m_Size.X, .Y = 0, .Width = extension });
+			}
+		}
+
+		m_Size = Math::Uint2{ std::max(size.X, m_Size.X), std::max(size.Y, m_Size.Y) };
+	}
+
+	Math::Uint2 SkylinePacker::GetSize() const
+	{
+		return m_Size;
+	}
+
+	uint64_t SkylinePacker::GetUsedArea() const
+	{
+		return m_UsedArea;
+	}
+
+	uint64_t SkylinePacker::GetWastedArea() const
+	{
+		uint64_t areaBelowSkyline = 0;
+		for (const Segment& segment : m_Skyline)
+		{
+			areaBelowSkyline += static_cast<uint64_t>(segment.Width) * segment.Y;
+		}
+
+		return areaBelowSkyline - m_UsedArea;
+	}
+
+	std::optional<uint32_t> SkylinePacker::Fit(const size_t index, const Math::Uint2 size) const
+	{
+		if (m_Skyline[index].X + size.X > m_Size.X)
+		{
+			return std::nullopt;
+		}
+
+		// The rectangle rests on the highest segment it spans
+		uint32_t y = 0;
+		uint32_t remainingWidth = size.X;
+
+		for (size_t i = index; remainingWidth > 0 and i < m_Skyline.size(); ++i)
+		{
+			y = std::max(y, m_Skyline[i].Y);
+			if (y + size.Y > m_Size.Y)
+			{
+				return std::nullopt;
+			}
+
+			remainingWidth -= std::min(remainingWidth, m_Skyline[i].Width);
+		}
+
+		return y;
+	}
+
+	void SkylinePacker::Merge()
+	{
+		for (size_t i = 1; i < m_Skyline.size();)
+		{
+			if (m_Skyline[i - 1].Y == m_Skyline[i].Y)
+			{
+				m_Skyline[i - 1].Width += m_Skyline[i].Width;
+				m_Skyline.erase(m_Skyline.begin() + static_cast<ptrdiff_t>(i));
+				continue;
+			}
+
+			++i;
+		}
+	}
+}
\ No newline at end of file
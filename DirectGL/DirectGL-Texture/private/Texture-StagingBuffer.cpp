@@ -0,0 +1,166 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <optional>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	/// Keeping every allocation aligned allows any pixel format to be unpacked from it.
+	inline static constexpr size_t ALLOCATION_ALIGNMENT = 256;
+
+	std::unique_ptr<StagingBuffer> StagingBuffer::Create(const size_t capacity)
+	{
+		constexpr GLbitfield mappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		GLuint bufferId = 0;
+		glCreateBuffers(1, &bufferId);
+		glNamedBufferStorage(bufferId, static_cast<GLsizeiptr>(capacity), nullptr, mappingFlags);
+
+		const auto mappedData = static_cast<uint8_t*>(glMapNamedBufferRange(bufferId, 0, static_cast<GLsizeiptr>(capacity), mappingFlags));
+		if (mappedData == nullptr)
+		{
+			glDeleteBuffers(1, &bufferId);
+			return nullptr;
+		}
+
+		return std::unique_ptr<StagingBuffer>(new StagingBuffer(bufferId, mappedData, capacity));
+	}
+
+	StagingBuffer::~StagingBuffer()
+	{
+		while (not m_Ranges.empty())
+		{
+			// Ranges submitted together share their fence, which must only be deleted once
+			const GLsync fence = m_Ranges.front().Fence;
+			m_Ranges.pop_front();
+
+			if (fence != nullptr and (m_Ranges.empty() or m_Ranges.front().Fence != fence))
+			{
+				glDeleteSync(fence);
+			}
+		}
+
+		if (m_BufferId != 0)
+		{
+			glUnmapNamedBuffer(m_BufferId);
+			glDeleteBuffers(1, &m_BufferId);
+		}
+	}
+
+	std::optional<StagingBuffer::Allocation> StagingBuffer::Allocate(const size_t size)
+	{
+		const size_t alignedSize = (size + ALLOCATION_ALIGNMENT - 1) / ALLOCATION_ALIGNMENT * ALLOCATION_ALIGNMENT;
+		if (alignedSize > m_Capacity)
+		{
+			return std::nullopt;
+		}
+
+		// Release everything the GPU is already done with
+		while (RetireOldest(false))
+		{
+		}
+
+		std::optional<size_t> offset = FindSpace(alignedSize);
+		while (not offset.has_value())
+		{
+			// Allocations that haven't been submitted yet can't be waited for
+			if (m_Ranges.back().Fence == nullptr)
+			{
+				Submit();
+			}
+
+			RetireOldest(true);
+			offset = FindSpace(alignedSize);
+		}
+
+		m_Ranges.push_back(Range{ .Offset = *offset, .Size = alignedSize, .Fence = nullptr });
+		return Allocation{ .Data = m_MappedData + *offset, .Offset = *offset };
+	}
+
+	void StagingBuffer::Submit()
+	{
+		if (m_Ranges.empty() or m_Ranges.back().Fence != nullptr)
+		{
+			return;
+		}
+
+		const GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		for (auto it = m_Ranges.rbegin(); it != m_Ranges.rend() and it->Fence == nullptr; ++it)
+		{
+			it->Fence = fence;
+		}
+	}
+
+	GLuint StagingBuffer::GetRendererId() const
+	{
+		return m_BufferId;
+	}
+
+	size_t StagingBuffer::GetCapacity() const
+	{
+		return m_Capacity;
+	}
+
+	StagingBuffer::StagingBuffer(const GLuint bufferId, uint8_t* mappedData, const size_t capacity):
+		m_BufferId(bufferId),
+		m_MappedData(mappedData),
+		m_Capacity(capacity)
+	{
+	}
+
+	std::optional<size_t> StagingBuffer::FindSpace(const size_t size) const
+	{
+		if (m_Ranges.empty())
+		{
+			return 0;
+		}
+
+		const size_t tail = m_Ranges.front().Offset;
+		const size_t head = m_Ranges.back().Offset + m_Ranges.back().Size;
+
+		// The ranges in use either form one block [tail, head) or wrap around the end of the buffer
+		if (tail < head)
+		{
+			if (m_Capacity - head >= size) return head;
+			if (tail >= size) return 0;
+			return std::nullopt;
+		}
+
+		if (tail - head >= size) return head;
+		return std::nullopt;
+	}
+
+	bool StagingBuffer::RetireOldest(const bool wait)
+	{
+		if (m_Ranges.empty() or m_Ranges.front().Fence == nullptr)
+		{
+			return false;
+		}
+
+		const GLsync fence = m_Ranges.front().Fence;
+		const GLuint64 timeout = wait ? 1'000'000 : 0;
+
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+		while (wait and result == GL_TIMEOUT_EXPIRED)
+		{
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+		}
+
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			return false;
+		}
+
+		// All ranges sharing the fence are released at once
+		while (not m_Ranges.empty() and m_Ranges.front().Fence == fence)
+		{
+			m_Ranges.pop_front();
+		}
+
+		glDeleteSync(fence);
+		return true;
+	}
+}
\ No newline at end of file
@@ -2,23 +2,273 @@
 
 #include <glad/gl.h>
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <vector>
+
 module DirectGL.Texture;
 
+import Preconditions;
+
 namespace DGL::Texture
 {
-	std::unique_ptr<Texture> Texture::Create(const Math::Uint2 size, const uint8_t* data)
+	// The S3TC extension is supported by every desktop driver, but not part of the core profile
+	constexpr GLenum GL_COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+	constexpr GLenum GL_COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+
+	/// The number of full-size updates the upload buffer of a texture can hold before
+	/// an update has to wait for the GPU, which covers the frames the driver queues up.
+	inline static constexpr size_t UPDATES_IN_FLIGHT = 3;
+
+	constexpr GLenum FormatToGlId(const TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::RGBA8: return GL_RGBA8;
+			case TextureFormat::BC1: return GL_COMPRESSED_RGBA_S3TC_DXT1;
+			case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5;
+			case TextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+			default: System::Error("Invalid TextureFormat");
+		}
+	}
+
+	std::unique_ptr<Texture> Texture::Create(const Math::Uint2 size, const uint8_t* data, const bool mipmapped)
+	{
+		auto texture = Create(size, TextureFormat::RGBA8, mipmapped ? CalculateMipLevelCount(size) : 1);
+
+		if (data != nullptr)
+		{
+			texture->UploadLevel(0, data, CalculateImageSize(TextureFormat::RGBA8, size));
+			texture->GenerateMipmaps();
+		}
+
+		return texture;
+	}
+
+	std::unique_ptr<Texture> Texture::Create(const Math::Uint2 size, const TextureFormat format, const uint32_t mipLevelCount, const TextureOrigin origin)
 	{
+		const uint32_t levelCount = std::clamp(mipLevelCount, 1u, CalculateMipLevelCount(size));
+
 		GLuint textureId = 0;
 		glCreateTextures(GL_TEXTURE_2D, 1, &textureId);
-		glTextureStorage2D(textureId, 1, GL_RGBA8, size.X, size.Y);
-		glTextureSubImage2D(textureId, 0, 0, 0, size.X, size.Y, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		glTextureStorage2D(textureId, static_cast<GLsizei>(levelCount), FormatToGlId(format), size.X, size.Y);
+
+		return std::unique_ptr<Texture>(new Texture(size, format, levelCount, origin, textureId));
+	}
+
+	std::unique_ptr<Texture> Texture::Create(const TextureImage& image)
+	{
+		auto texture = Create(image.Size, image.Format, static_cast<uint32_t>(image.Levels.size()), image.Origin);
+
+		const auto levelCount = std::min(static_cast<uint32_t>(image.Levels.size()), texture->GetMipLevelCount());
+		for (uint32_t level = 0; level < levelCount; ++level)
+		{
+			texture->UploadLevel(level, image.Levels[level].data(), image.Levels[level].size());
+		}
 
-		return std::unique_ptr<Texture>(new Texture(size, textureId));
+		return texture;
+	}
+
+	uint32_t Texture::CalculateMipLevelCount(const Math::Uint2 size)
+	{
+		return static_cast<uint32_t>(std::bit_width(std::max({ size.X, size.Y, 1u })));
 	}
 
 	Texture::~Texture()
 	{
-		if (m_TextureId != 0) glDeleteTextures(1, &m_TextureId);
+		if (m_TextureId != 0) DeleteTexture(m_TextureId);
+		TrackTextureMemory(m_Category, -static_cast<int64_t>(GetByteSize()));
+	}
+
+	void Texture::Resize(const Math::Uint2 size)
+	{
+		System::Require(not m_IsUpdating, [] { return "The texture can't be resized while an update is open"; });
+
+		const size_t previousByteSize = GetByteSize();
+
+		const uint32_t mipLevelCount = m_MipLevelCount > 1 ? CalculateMipLevelCount(size) : 1;
+
+		GLuint textureId = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &textureId);
+		glTextureStorage2D(textureId, static_cast<GLsizei>(mipLevelCount), FormatToGlId(m_Format), size.X, size.Y);
+
+		uint32_t width = std::min(size.X, m_Size.X);
+		uint32_t height = std::min(size.Y, m_Size.Y);
+
+		// Compressed copies have to cover whole blocks
+		if (IsCompressed(m_Format))
+		{
+			width &= ~3u;
+			height &= ~3u;
+		}
+
+		if (width > 0 and height > 0)
+		{
+			glCopyImageSubData(
+				m_TextureId, GL_TEXTURE_2D, 0, 0, 0, 0,
+				textureId, GL_TEXTURE_2D, 0, 0, 0, 0,
+				static_cast<GLsizei>(width), static_cast<GLsizei>(height), 1
+			);
+		}
+
+		// Frames still in flight may sample the previous storage
+		DeleteTexture(m_TextureId);
+		m_TextureId = textureId;
+		m_Size = size;
+		m_MipLevelCount = mipLevelCount;
+		++m_Revision;
+
+		// The upload buffer gets recreated for the new size by the next update
+		m_UpdateBuffer.reset();
+
+		TrackTextureMemory(m_Category, static_cast<int64_t>(GetByteSize()) - static_cast<int64_t>(previousByteSize));
+		GenerateMipmaps();
+	}
+
+	void Texture::UploadLevel(const uint32_t level, const void* data, const size_t byteCount)
+	{
+		const Math::Uint2 size = GetMipLevelSize(m_Size, level);
+
+		if (IsCompressed(m_Format))
+		{
+			glCompressedTextureSubImage2D(
+				m_TextureId, static_cast<GLint>(level), 0, 0,
+				static_cast<GLsizei>(size.X), static_cast<GLsizei>(size.Y),
+				FormatToGlId(m_Format), static_cast<GLsizei>(byteCount), data
+			);
+		}
+		else
+		{
+			glTextureSubImage2D(
+				m_TextureId, static_cast<GLint>(level), 0, 0,
+				static_cast<GLsizei>(size.X), static_cast<GLsizei>(size.Y),
+				GL_RGBA, GL_UNSIGNED_BYTE, data
+			);
+		}
+
+		if (level == 0)
+		{
+			++m_Revision;
+		}
+	}
+
+	void Texture::UploadRegion(const Math::UintBoundary& region, const uint8_t* pixels)
+	{
+		System::Require(m_Format == TextureFormat::RGBA8, [] { return "Only RGBA8 textures can be updated"; });
+
+		glTextureSubImage2D(
+			m_TextureId, 0,
+			static_cast<GLint>(region.Left), static_cast<GLint>(region.Top),
+			static_cast<GLsizei>(region.Width), static_cast<GLsizei>(region.Height),
+			GL_RGBA, GL_UNSIGNED_BYTE, pixels
+		);
+
+		++m_Revision;
+		GenerateMipmaps();
+	}
+
+	void Texture::Update(const Math::UintBoundary& region, const uint8_t* pixels, const size_t stride)
+	{
+		const TextureUpdate update = BeginUpdate(region);
+		const size_t rowSize = static_cast<size_t>(region.Width) * 4;
+
+		for (uint32_t row = 0; row < region.Height; ++row)
+		{
+			std::memcpy(update.Pixels + row * update.Stride, pixels + row * stride, rowSize);
+		}
+
+		EndUpdate(update);
+	}
+
+	TextureUpdate Texture::BeginUpdate(const Math::UintBoundary& region)
+	{
+		System::Require(m_Format == TextureFormat::RGBA8, [] { return "Only RGBA8 textures can be updated"; });
+		System::Require(not m_IsUpdating, [] { return "Only one update of a texture can be open at a time"; });
+
+		// Written so the sums can't wrap around
+		System::Require(
+			region.Left <= m_Size.X and region.Width <= m_Size.X - region.Left and
+			region.Top <= m_Size.Y and region.Height <= m_Size.Y - region.Top,
+			[] { return "The region exceeds the texture"; }
+		);
+
+		const size_t stride = static_cast<size_t>(region.Width) * 4;
+		const size_t byteCount = stride * region.Height;
+
+		if (byteCount == 0)
+		{
+			return TextureUpdate{ .Region = region, .Pixels = nullptr, .Stride = stride, .BufferOffset = 0 };
+		}
+
+		if (m_UpdateBuffer == nullptr)
+		{
+			m_UpdateBuffer = StagingBuffer::Create(UPDATES_IN_FLIGHT * CalculateImageSize(m_Format, m_Size));
+			System::Check(m_UpdateBuffer != nullptr, [] { return "Failed to map the upload buffer of the texture"; });
+		}
+
+		// Waits for the GPU only if it hasn't consumed the updates of the last few frames yet
+		const StagingBuffer::Allocation allocation = *m_UpdateBuffer->Allocate(byteCount);
+		m_IsUpdating = true;
+		return TextureUpdate{ .Region = region, .Pixels = allocation.Data, .Stride = stride, .BufferOffset = allocation.Offset };
+	}
+
+	void Texture::EndUpdate(const TextureUpdate& update)
+	{
+		if (update.Pixels == nullptr)
+		{
+			return;
+		}
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_UpdateBuffer->GetRendererId());
+		glTextureSubImage2D(
+			m_TextureId, 0,
+			static_cast<GLint>(update.Region.Left), static_cast<GLint>(update.Region.Top),
+			static_cast<GLsizei>(update.Region.Width), static_cast<GLsizei>(update.Region.Height),
+			GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(update.BufferOffset)
+		);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		// Fence the upload, so the memory gets recycled once the GPU is done with it
+		m_UpdateBuffer->Submit();
+		m_IsUpdating = false;
+		++m_Revision;
+		GenerateMipmaps();
+	}
+
+	TextureImage Texture::Download() const
+	{
+		TextureImage image = {
+			.Size = m_Size,
+			.Format = m_Format,
+			.Origin = m_Origin,
+			.Levels = {}
+		};
+
+		for (uint32_t level = 0; level < m_MipLevelCount; ++level)
+		{
+			const Math::Uint2 size = GetMipLevelSize(m_Size, level);
+			std::vector<uint8_t>& pixels = image.Levels.emplace_back(CalculateImageSize(m_Format, size));
+
+			if (IsCompressed(m_Format))
+			{
+				glGetCompressedTextureImage(m_TextureId, static_cast<GLint>(level), static_cast<GLsizei>(pixels.size()), pixels.data());
+			}
+			else
+			{
+				glGetTextureImage(m_TextureId, static_cast<GLint>(level), GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLsizei>(pixels.size()), pixels.data());
+			}
+		}
+
+		return image;
+	}
+
+	void Texture::GenerateMipmaps()
+	{
+		if (m_MipLevelCount > 1 and not IsCompressed(m_Format))
+		{
+			glGenerateTextureMipmap(m_TextureId);
+		}
 	}
 
 	Math::Uint2 Texture::GetSize() const
@@ -26,14 +276,71 @@ namespace DGL::Texture
 		return m_Size;
 	}
 
+	uint32_t Texture::GetMipLevelCount() const
+	{
+		return m_MipLevelCount;
+	}
+
+	TextureFormat Texture::GetFormat() const
+	{
+		return m_Format;
+	}
+
+	TextureOrigin Texture::GetOrigin() const
+	{
+		return m_Origin;
+	}
+
+	size_t Texture::GetByteSize() const
+	{
+		size_t byteSize = 0;
+
+		for (uint32_t level = 0; level < m_MipLevelCount; ++level)
+		{
+			byteSize += CalculateImageSize(m_Format, GetMipLevelSize(m_Size, level));
+		}
+
+		return byteSize;
+	}
+
+	void Texture::SetCategory(const TextureCategory category)
+	{
+		if (m_Category == category)
+		{
+			return;
+		}
+
+		const auto byteSize = static_cast<int64_t>(GetByteSize());
+		TrackTextureMemory(m_Category, -byteSize);
+		TrackTextureMemory(category, byteSize);
+		m_Category = category;
+	}
+
+	TextureCategory Texture::GetCategory() const
+	{
+		return m_Category;
+	}
+
+	uint64_t Texture::GetRevision() const
+	{
+		return m_Revision;
+	}
+
 	GLuint Texture::GetRendererId() const
 	{
 		return m_TextureId;
 	}
 
-	Texture::Texture(const Math::Uint2 size, const GLuint textureId):
+	Texture::Texture(const Math::Uint2 size, const TextureFormat format, const uint32_t mipLevelCount, const TextureOrigin origin, const GLuint textureId):
 		m_TextureId(textureId),
-		m_Size(size)
+		m_Size(size),
+		m_Format(format),
+		m_MipLevelCount(mipLevelCount),
+		m_Origin(origin),
+		m_Category(TextureCategory::Image),
+		m_Revision(0),
+		m_IsUpdating(false)
 	{
+		TrackTextureMemory(m_Category, static_cast<int64_t>(GetByteSize()));
 	}
 }
@@ -0,0 +1,184 @@
+﻿module;
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	/// Copy the image into a buffer with the padding filled by the edge texels,
+	/// so linear filtering never picks up texels of neighbouring images.
+	static std::vector<uint8_t> ExtrudeImage(const Math::Uint2 size, const uint8_t* pixels, const uint32_t padding)
+	{
+		const uint32_t paddedWidth = size.X + 2 * padding;
+		const uint32_t paddedHeight = size.Y + 2 * padding;
+
+		std::vector<uint8_t> result(static_cast<size_t>(paddedWidth) * paddedHeight * 4);
+
+		for (uint32_t y = 0; y < paddedHeight; ++y)
+		{
+			const uint32_t sourceY = std::clamp(y, padding, padding + size.Y - 1) - padding;
+			const uint8_t* sourceRow = pixels + static_cast<size_t>(sourceY) * size.X * 4;
+			uint8_t* targetRow = result.data() + static_cast<size_t>(y) * paddedWidth * 4;
+
+			for (uint32_t x = 0; x < padding; ++x)
+			{
+				std::memcpy(targetRow + x * 4, sourceRow, 4);
+				std::memcpy(targetRow + (padding + size.X + x) * 4, sourceRow + (size.X - 1) * 4, 4);
+			}
+
+			std::memcpy(targetRow + padding * 4, sourceRow, static_cast<size_t>(size.X) * 4);
+		}
+
+		return result;
+	}
+
+	std::unique_ptr<TextureAtlas> TextureAtlas::Create(const TextureAtlasSettings& settings)
+	{
+		return std::unique_ptr<TextureAtlas>(new TextureAtlas(settings));
+	}
+
+	std::optional<TextureRegion> TextureAtlas::Add(const Math::Uint2 size, const uint8_t* pixels)
+	{
+		if (size.X == 0 or size.Y == 0 or pixels == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		const Math::Uint2 paddedSize = { size.X + 2 * m_Settings.Padding, size.Y + 2 * m_Settings.Padding };
+		if (paddedSize.X > m_Settings.MaxPageSize.X or paddedSize.Y > m_Settings.MaxPageSize.Y)
+		{
+			return std::nullopt;
+		}
+
+		// Fill the existing pages first. Only the most recent page is allowed to grow,
+		// older pages have already been grown to the maximum size.
+		Page* page = nullptr;
+		std::optional<Math::Uint2> position;
+
+		for (size_t i = 0; i < m_Pages.size() and not position.has_value(); ++i)
+		{
+			page = &m_Pages[i];
+			position = Insert(*page, paddedSize, i + 1 == m_Pages.size());
+		}
+
+		if (not position.has_value())
+		{
+			page = &AddPage(paddedSize);
+			position = Insert(*page, paddedSize, true);
+		}
+
+		const std::vector<uint8_t> extruded = ExtrudeImage(size, pixels, m_Settings.Padding);
+		page->Storage->UploadRegion(Math::UintBoundary::FromLTWH(position->X, position->Y, paddedSize.X, paddedSize.Y), extruded.data());
+
+		++m_RegionCount;
+		m_UsedArea += static_cast<uint64_t>(size.X) * size.Y;
+
+		return TextureRegion{
+			.Source = page->Storage.get(),
+			.Bounds = Math::UintBoundary::FromLTWH(position->X + m_Settings.Padding, position->Y + m_Settings.Padding, size.X, size.Y),
+		};
+	}
+
+	size_t TextureAtlas::GetPageCount() const
+	{
+		return m_Pages.size();
+	}
+
+	const Texture& TextureAtlas::GetPage(const size_t index) const
+	{
+		return *m_Pages[index].Storage;
+	}
+
+	TextureAtlasStatistics TextureAtlas::GetStatistics() const
+	{
+		TextureAtlasStatistics statistics = {
+			.PageCount = m_Pages.size(),
+			.RegionCount = m_RegionCount,
+			.PageArea = 0,
+			.UsedArea = m_UsedArea,
+			.PaddingArea = 0,
+			.WastedArea = 0,
+			.Occupancy = 0.0f,
+		};
+
+		uint64_t packedArea = 0;
+		for (const Page& page : m_Pages)
+		{
+			const Math::Uint2 size = page.Packer.GetSize();
+			statistics.PageArea += static_cast<uint64_t>(size.X) * size.Y;
+			statistics.WastedArea += page.Packer.GetWastedArea();
+			packedArea += page.Packer.GetUsedArea();
+		}
+
+		statistics.PaddingArea = packedArea - m_UsedArea;
+
+		if (statistics.PageArea > 0)
+		{
+			statistics.Occupancy = static_cast<float>(static_cast<double>(m_UsedArea) / static_cast<double>(statistics.PageArea));
+		}
+
+		return statistics;
+	}
+
+	TextureAtlas::TextureAtlas(const TextureAtlasSettings& settings):
+		m_Settings(settings),
+		m_RegionCount(0),
+		m_UsedArea(0)
+	{
+	}
+
+	std::optional<Math::Uint2> TextureAtlas::Insert(Page& page, const Math::Uint2 size, const bool allowGrowth)
+	{
+		std::optional<Math::Uint2> position = page.Packer.Insert(size);
+
+		// Grow the shorter side until the image fits or the page reached its maximum size
+		while (not position.has_value() and allowGrowth)
+		{
+			const Math::Uint2 currentSize = page.Packer.GetSize();
+			Math::Uint2 grownSize = currentSize;
+
+			if (currentSize.X <= currentSize.Y and currentSize.X < m_Settings.MaxPageSize.X)
+			{
+				grownSize.X = std::min(currentSize.X * 2, m_Settings.MaxPageSize.X);
+			}
+			else if (currentSize.Y < m_Settings.MaxPageSize.Y)
+			{
+				grownSize.Y = std::min(currentSize.Y * 2, m_Settings.MaxPageSize.Y);
+			}
+			else if (currentSize.X < m_Settings.MaxPageSize.X)
+			{
+				grownSize.X = std::min(currentSize.X * 2, m_Settings.MaxPageSize.X);
+			}
+			else
+			{
+				break;
+			}
+
+			page.Packer.Grow(grownSize);
+			page.Storage->Resize(grownSize);
+			position = page.Packer.Insert(size);
+		}
+
+		return position;
+	}
+
+	TextureAtlas::Page& TextureAtlas::AddPage(const Math::Uint2 minimumSize)
+	{
+		const Math::Uint2 size = {
+			std::clamp(minimumSize.X, m_Settings.InitialPageSize.X, m_Settings.MaxPageSize.X),
+			std::clamp(minimumSize.Y, m_Settings.InitialPageSize.Y, m_Settings.MaxPageSize.Y),
+		};
+
+		Page& page = m_Pages.emplace_back(Page{
+			.Storage = Texture::Create(size, nullptr),
+			.Packer = SkylinePacker(size),
+		});
+
+		page.Storage->SetCategory(TextureCategory::Atlas);
+		return page;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+﻿module;
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	const Texture* CachedTexture::Use()
+	{
+		m_LastUsedFrame = m_Cache->m_Frame;
+
+		if (GetResidency() == TextureResidency::Evicted)
+		{
+			if (m_SystemCopy)
+			{
+				m_Restored = Texture::Create(*m_SystemCopy);
+				m_SystemCopy.reset();
+			}
+			else
+			{
+				m_Load = m_Cache->m_Loader->LoadAsync(m_Path, m_Settings);
+			}
+		}
+
+		return GetResidentTexture();
+	}
+
+	TextureResidency CachedTexture::GetResidency() const
+	{
+		if (m_Restored != nullptr)
+		{
+			return TextureResidency::Resident;
+		}
+
+		if (m_Load == nullptr)
+		{
+			return TextureResidency::Evicted;
+		}
+
+		switch (m_Load->GetState())
+		{
+			case TextureLoadState::Ready: return TextureResidency::Resident;
+			case TextureLoadState::Failed: return TextureResidency::Failed;
+			default: return TextureResidency::Loading;
+		}
+	}
+
+	const std::filesystem::path& CachedTexture::GetPath() const
+	{
+		return m_Path;
+	}
+
+	const std::string& CachedTexture::GetError() const
+	{
+		static const std::string NoError;
+		return m_Load != nullptr ? m_Load->GetError() : NoError;
+	}
+
+	CachedTexture::CachedTexture(TextureCache& cache, std::filesystem::path path, const TextureLoadSettings& settings):
+		m_Cache(&cache),
+		m_Path(std::move(path)),
+		m_Settings(settings),
+		m_LastUsedFrame(cache.m_Frame)
+	{
+	}
+
+	const Texture* CachedTexture::GetResidentTexture() const
+	{
+		if (m_Restored != nullptr)
+		{
+			return m_Restored.get();
+		}
+
+		return m_Load != nullptr ? m_Load->GetTexture() : nullptr;
+	}
+
+	void CachedTexture::Evict(const TextureEvictionTarget target)
+	{
+		const Texture* texture = GetResidentTexture();
+		if (texture == nullptr)
+		{
+			return;
+		}
+
+		if (target == TextureEvictionTarget::SystemMemory)
+		{
+			m_SystemCopy = texture->Download();
+		}
+
+		m_Load.reset();
+		m_Restored.reset();
+	}
+
+	std::unique_ptr<TextureCache> TextureCache::Create(TextureLoader& loader, const TextureCacheSettings& settings)
+	{
+		return std::unique_ptr<TextureCache>(new TextureCache(loader, settings));
+	}
+
+	std::shared_ptr<CachedTexture> TextureCache::Acquire(const std::filesystem::path& path, const TextureLoadSettings& settings)
+	{
+		std::shared_ptr<CachedTexture>& entry = m_Entries[MakeKey(path, settings)];
+
+		if (entry == nullptr)
+		{
+			entry = std::shared_ptr<CachedTexture>(new CachedTexture(*this, path, settings));
+			entry->m_Load = m_Loader->LoadAsync(path, settings);
+		}
+
+		return entry;
+	}
+
+	void TextureCache::Update()
+	{
+		++m_Frame;
+
+		// Nobody can reload textures that aren't referenced anymore, so their copies are dropped
+		std::erase_if(m_Entries, [](const auto& entry)
+		{
+			const TextureResidency residency = entry.second->GetResidency();
+			return entry.second.use_count() == 1 and (residency == TextureResidency::Evicted or residency == TextureResidency::Failed);
+		});
+
+		struct Candidate
+		{
+			std::unordered_map<std::string, std::shared_ptr<CachedTexture>>::iterator Entry;
+			bool IsReferenced;
+			uint64_t LastUsedFrame;
+		};
+
+		size_t residentBytes = 0;
+		std::vector<Candidate> candidates;
+
+		for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+		{
+			const Texture* texture = it->second->GetResidentTexture();
+			if (texture == nullptr)
+			{
+				continue;
+			}
+
+			residentBytes += texture->GetByteSize();
+
+			// Textures used during the previous frame are likely used again right away,
+			// textures used by the frames in flight are still going to be drawn
+			if (it->second->m_LastUsedFrame + 1 + m_Settings.FramesInFlight < m_Frame)
+			{
+				candidates.push_back({ .Entry = it, .IsReferenced = it->second.use_count() > 1, .LastUsedFrame = it->second->m_LastUsedFrame });
+			}
+		}
+
+		if (residentBytes <= m_Settings.Budget)
+		{
+			return;
+		}
+
+		// Unreferenced textures go first, then the least recently used ones
+		std::ranges::sort(candidates, [](const Candidate& lhs, const Candidate& rhs)
+		{
+			if (lhs.IsReferenced != rhs.IsReferenced) return rhs.IsReferenced;
+			return lhs.LastUsedFrame < rhs.LastUsedFrame;
+		});
+
+		for (const Candidate& candidate : candidates)
+		{
+			if (residentBytes <= m_Settings.Budget)
+			{
+				break;
+			}
+
+			CachedTexture& texture = *candidate.Entry->second;
+			residentBytes -= texture.GetResidentTexture()->GetByteSize();
+
+			if (candidate.IsReferenced)
+			{
+				texture.Evict(m_Settings.EvictionTarget);
+			}
+			else
+			{
+				m_Entries.erase(candidate.Entry);
+			}
+		}
+	}
+
+	void TextureCache::SetBudget(const size_t budget)
+	{
+		m_Settings.Budget = budget;
+	}
+
+	size_t TextureCache::GetBudget() const
+	{
+		return m_Settings.Budget;
+	}
+
+	void TextureCache::SetFramesInFlight(const uint32_t framesInFlight)
+	{
+		m_Settings.FramesInFlight = framesInFlight;
+	}
+
+	TextureCacheStatistics TextureCache::GetStatistics() const
+	{
+		TextureCacheStatistics statistics = {
+			.EntryCount = m_Entries.size(),
+			.ResidentCount = 0,
+			.ResidentBytes = 0,
+			.EvictedBytes = 0,
+			.Budget = m_Settings.Budget,
+		};
+
+		for (const auto& [key, entry] : m_Entries)
+		{
+			if (const Texture* texture = entry->GetResidentTexture())
+			{
+				++statistics.ResidentCount;
+				statistics.ResidentBytes += texture->GetByteSize();
+			}
+
+			if (entry->m_SystemCopy)
+			{
+				for (const std::vector<uint8_t>& level : entry->m_SystemCopy->Levels)
+				{
+					statistics.EvictedBytes += level.size();
+				}
+			}
+		}
+
+		return statistics;
+	}
+
+	TextureCache::TextureCache(TextureLoader& loader, const TextureCacheSettings& settings):
+		m_Loader(&loader),
+		m_Settings(settings),
+		m_Frame(0)
+	{
+	}
+
+	std::string TextureCache::MakeKey(const std::filesystem::path& path, const TextureLoadSettings& settings)
+	{
+		std::error_code error;
+		std::filesystem::path absolutePath = std::filesystem::absolute(path, error);
+		if (error)
+		{
+			absolutePath = path;
+		}
+
+		return std::format("{}|{}|{}", absolutePath.lexically_normal().generic_string(), settings.Mipmapped, static_cast<int>(settings.Compression));
+	}
+}
\ No newline at end of file
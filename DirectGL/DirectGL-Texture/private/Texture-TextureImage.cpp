@@ -0,0 +1,300 @@
+﻿module;
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	namespace
+	{
+		template <typename T>
+		T Read(const std::span<const uint8_t> data, const size_t offset)
+		{
+			T value = {};
+			std::memcpy(&value, data.data() + offset, sizeof(T));
+			return value;
+		}
+
+		constexpr uint32_t MakeFourCC(const char a, const char b, const char c, const char d)
+		{
+			return static_cast<uint32_t>(a) | static_cast<uint32_t>(b) << 8 | static_cast<uint32_t>(c) << 16 | static_cast<uint32_t>(d) << 24;
+		}
+
+		/// Split the payload of a container into its levels, validating their sizes.
+		bool CopyLevel(TextureImage& image, const std::span<const uint8_t> data, const size_t offset, const uint32_t level, std::string& error)
+		{
+			const size_t byteCount = CalculateImageSize(image.Format, GetMipLevelSize(image.Size, level));
+			if (offset > data.size() or data.size() - offset < byteCount)
+			{
+				error = std::format("Mip level {} exceeds the end of the file", level);
+				return false;
+			}
+
+			image.Levels.emplace_back(data.begin() + offset, data.begin() + offset + byteCount);
+			return true;
+		}
+
+		std::optional<TextureFormat> DxgiFormatToTextureFormat(const uint32_t dxgiFormat)
+		{
+			// sRGB variants are sampled like their UNORM counterparts, matching how RGBA8 images are treated
+			switch (dxgiFormat)
+			{
+				case 28: case 29: return TextureFormat::RGBA8;	// DXGI_FORMAT_R8G8B8A8_UNORM(_SRGB)
+				case 71: case 72: return TextureFormat::BC1;	// DXGI_FORMAT_BC1_UNORM(_SRGB)
+				case 77: case 78: return TextureFormat::BC3;	// DXGI_FORMAT_BC3_UNORM(_SRGB)
+				case 98: case 99: return TextureFormat::BC7;	// DXGI_FORMAT_BC7_UNORM(_SRGB)
+				default: return std::nullopt;
+			}
+		}
+
+		std::optional<TextureFormat> VkFormatToTextureFormat(const uint32_t vkFormat)
+		{
+			switch (vkFormat)
+			{
+				case 37: case 43: return TextureFormat::RGBA8;							// VK_FORMAT_R8G8B8A8_UNORM/SRGB
+				case 131: case 132: case 133: case 134: return TextureFormat::BC1;		// VK_FORMAT_BC1_RGB(A)_UNORM/SRGB_BLOCK
+				case 137: case 138: return TextureFormat::BC3;							// VK_FORMAT_BC3_UNORM/SRGB_BLOCK
+				case 145: case 146: return TextureFormat::BC7;							// VK_FORMAT_BC7_UNORM/SRGB_BLOCK
+				default: return std::nullopt;
+			}
+		}
+
+		std::optional<TextureImage> DecodeWithStb(const std::filesystem::path& path, std::string& error)
+		{
+			// Textures are sampled bottom-up, so the rows get flipped to keep images upright
+			stbi_set_flip_vertically_on_load_thread(1);
+
+			int width = 0, height = 0, channels = 0;
+			const std::string pathString = path.string();
+			stbi_uc* pixels = stbi_load(pathString.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+			if (pixels == nullptr)
+			{
+				error = std::format("Failed to load '{}': {}", pathString, stbi_failure_reason());
+				return std::nullopt;
+			}
+
+			TextureImage image = {
+				.Size = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) },
+				.Format = TextureFormat::RGBA8,
+				.Origin = TextureOrigin::BottomLeft,
+				.Levels = {}
+			};
+
+			image.Levels.emplace_back(pixels, pixels + CalculateImageSize(image.Format, image.Size));
+			stbi_image_free(pixels);
+			return image;
+		}
+	}
+
+	std::optional<TextureImage> LoadTextureImage(const std::filesystem::path& path, std::string& error)
+	{
+		std::string extension = path.extension().string();
+		std::ranges::transform(extension, extension.begin(), [](const char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+		if (extension != ".dds" and extension != ".ktx2")
+		{
+			return DecodeWithStb(path, error);
+		}
+
+		std::ifstream stream(path, std::ios::binary | std::ios::ate);
+		if (not stream)
+		{
+			error = std::format("Failed to open '{}'", path.string());
+			return std::nullopt;
+		}
+
+		std::vector<uint8_t> data(static_cast<size_t>(stream.tellg()));
+		stream.seekg(0);
+		stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+		auto image = extension == ".dds" ? ParseDds(data, error) : ParseKtx2(data, error);
+		if (not image)
+		{
+			error = std::format("Failed to load '{}': {}", path.string(), error);
+		}
+
+		return image;
+	}
+
+	std::optional<TextureImage> ParseDds(const std::span<const uint8_t> data, std::string& error)
+	{
+		constexpr size_t HeaderSize = 128;
+		constexpr size_t Dx10HeaderSize = 20;
+		constexpr uint32_t FlagMipMapCount = 0x20000;
+		constexpr uint32_t PixelFormatFourCC = 0x4;
+		constexpr uint32_t PixelFormatRgb = 0x40;
+
+		if (data.size() < HeaderSize or Read<uint32_t>(data, 0) != MakeFourCC('D', 'D', 'S', ' '))
+		{
+			error = "Not a DDS file";
+			return std::nullopt;
+		}
+
+		const uint32_t flags = Read<uint32_t>(data, 8);
+		const uint32_t height = Read<uint32_t>(data, 12);
+		const uint32_t width = Read<uint32_t>(data, 16);
+		const uint32_t depth = Read<uint32_t>(data, 24);
+		const uint32_t mipMapCount = Read<uint32_t>(data, 28);
+		const uint32_t pixelFormatFlags = Read<uint32_t>(data, 80);
+		const uint32_t fourCC = Read<uint32_t>(data, 84);
+
+		std::optional<TextureFormat> format;
+		size_t offset = HeaderSize;
+
+		if (pixelFormatFlags & PixelFormatFourCC)
+		{
+			if (fourCC == MakeFourCC('D', 'X', 'T', '1')) format = TextureFormat::BC1;
+			else if (fourCC == MakeFourCC('D', 'X', 'T', '5')) format = TextureFormat::BC3;
+			else if (fourCC == MakeFourCC('D', 'X', '1', '0') and data.size() >= HeaderSize + Dx10HeaderSize)
+			{
+				// Only plain 2D textures (D3D10_RESOURCE_DIMENSION_TEXTURE2D) without array slices are supported
+				if (Read<uint32_t>(data, HeaderSize + 4) != 3 or Read<uint32_t>(data, HeaderSize + 12) > 1)
+				{
+					error = "Only 2D textures are supported";
+					return std::nullopt;
+				}
+
+				format = DxgiFormatToTextureFormat(Read<uint32_t>(data, HeaderSize));
+				offset += Dx10HeaderSize;
+			}
+		}
+		else if (pixelFormatFlags & PixelFormatRgb)
+		{
+			const bool isRgba8 = Read<uint32_t>(data, 88) == 32
+				and Read<uint32_t>(data, 92) == 0x000000FF
+				and Read<uint32_t>(data, 96) == 0x0000FF00
+				and Read<uint32_t>(data, 100) == 0x00FF0000;
+
+			if (isRgba8) format = TextureFormat::RGBA8;
+		}
+
+		if (not format)
+		{
+			error = "Unsupported DDS pixel format";
+			return std::nullopt;
+		}
+
+		if (width == 0 or height == 0 or depth > 1)
+		{
+			error = "Only 2D textures are supported";
+			return std::nullopt;
+		}
+
+		TextureImage image = {
+			.Size = { width, height },
+			.Format = *format,
+			.Origin = TextureOrigin::TopLeft,
+			.Levels = {}
+		};
+
+		const uint32_t levelCount = std::clamp((flags & FlagMipMapCount) ? mipMapCount : 1u, 1u, Texture::CalculateMipLevelCount(image.Size));
+
+		// Levels are stored back to back, starting with the base level
+		for (uint32_t level = 0; level < levelCount; ++level)
+		{
+			if (not CopyLevel(image, data, offset, level, error))
+			{
+				return std::nullopt;
+			}
+
+			offset += image.Levels.back().size();
+		}
+
+		return image;
+	}
+
+	std::optional<TextureImage> ParseKtx2(const std::span<const uint8_t> data, std::string& error)
+	{
+		constexpr std::array<uint8_t, 12> Identifier = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+		constexpr size_t HeaderSize = 80;
+		constexpr size_t LevelIndexEntrySize = 24;
+
+		if (data.size() < HeaderSize or not std::ranges::equal(data.first(Identifier.size()), Identifier))
+		{
+			error = "Not a KTX2 file";
+			return std::nullopt;
+		}
+
+		const uint32_t vkFormat = Read<uint32_t>(data, 12);
+		const uint32_t width = Read<uint32_t>(data, 20);
+		const uint32_t height = Read<uint32_t>(data, 24);
+		const uint32_t depth = Read<uint32_t>(data, 28);
+		const uint32_t layerCount = Read<uint32_t>(data, 32);
+		const uint32_t faceCount = Read<uint32_t>(data, 36);
+		const uint32_t levelCount = std::max(Read<uint32_t>(data, 40), 1u);
+		const uint32_t supercompressionScheme = Read<uint32_t>(data, 44);
+		const uint32_t keyValueOffset = Read<uint32_t>(data, 56);
+		const uint32_t keyValueLength = Read<uint32_t>(data, 60);
+
+		const std::optional<TextureFormat> format = VkFormatToTextureFormat(vkFormat);
+		if (not format)
+		{
+			error = std::format("Unsupported KTX2 format {}", vkFormat);
+			return std::nullopt;
+		}
+
+		if (supercompressionScheme != 0)
+		{
+			error = "Supercompressed KTX2 files are not supported";
+			return std::nullopt;
+		}
+
+		if (width == 0 or height == 0 or depth > 0 or layerCount > 1 or faceCount != 1)
+		{
+			error = "Only 2D textures are supported";
+			return std::nullopt;
+		}
+
+		if (data.size() < HeaderSize + levelCount * LevelIndexEntrySize or keyValueOffset > data.size() or data.size() - keyValueOffset < keyValueLength)
+		{
+			error = "Truncated KTX2 file";
+			return std::nullopt;
+		}
+
+		TextureImage image = {
+			.Size = { width, height },
+			.Format = *format,
+			.Origin = TextureOrigin::TopLeft,
+			.Levels = {}
+		};
+
+		// The orientation defaults to "rd", which means the first row is the top of the image
+		for (size_t entry = keyValueOffset; entry + 4 <= keyValueOffset + keyValueLength;)
+		{
+			const uint32_t length = Read<uint32_t>(data, entry);
+			const auto keyValue = std::string_view(reinterpret_cast<const char*>(data.data() + entry + 4), std::min<size_t>(length, keyValueOffset + keyValueLength - entry - 4));
+
+			if (keyValue.starts_with(std::string_view("KTXorientation\0", 15)) and keyValue.size() > 16 and keyValue[16] == 'u')
+			{
+				image.Origin = TextureOrigin::BottomLeft;
+			}
+
+			entry += 4 + (length + 3) / 4 * 4;
+		}
+
+		for (uint32_t level = 0; level < std::min(levelCount, Texture::CalculateMipLevelCount(image.Size)); ++level)
+		{
+			const auto byteOffset = Read<uint64_t>(data, HeaderSize + level * LevelIndexEntrySize);
+			if (not CopyLevel(image, data, static_cast<size_t>(byteOffset), level, error))
+			{
+				return std::nullopt;
+			}
+		}
+
+		return image;
+	}
+}
\ No newline at end of file
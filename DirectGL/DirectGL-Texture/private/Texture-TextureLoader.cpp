@@ -0,0 +1,227 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	AsyncTexture::AsyncTexture(std::filesystem::path path, const TextureLoadSettings settings):
+		m_Path(std::move(path)),
+		m_Settings(settings),
+		m_State(TextureLoadState::Loading)
+	{
+	}
+
+	TextureLoadState AsyncTexture::GetState() const
+	{
+		return m_State.load(std::memory_order_acquire);
+	}
+
+	bool AsyncTexture::IsReady() const
+	{
+		return GetState() == TextureLoadState::Ready;
+	}
+
+	const Texture* AsyncTexture::GetTexture() const
+	{
+		return IsReady() ? m_Texture.get() : nullptr;
+	}
+
+	const std::filesystem::path& AsyncTexture::GetPath() const
+	{
+		return m_Path;
+	}
+
+	const std::string& AsyncTexture::GetError() const
+	{
+		return m_Error;
+	}
+
+	std::unique_ptr<TextureLoader> TextureLoader::Create(const size_t workerCount, const size_t stagingCapacity)
+	{
+		auto stagingBuffer = StagingBuffer::Create(stagingCapacity);
+		if (stagingBuffer == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto loader = std::unique_ptr<TextureLoader>(new TextureLoader(std::move(stagingBuffer)));
+
+		for (size_t i = 0; i < std::max<size_t>(workerCount, 1); ++i)
+		{
+			loader->m_Workers.emplace_back([raw = loader.get()](const std::stop_token stopToken) { raw->RunWorker(stopToken); });
+		}
+
+		return loader;
+	}
+
+	TextureLoader::~TextureLoader()
+	{
+		for (std::jthread& worker : m_Workers)
+		{
+			worker.request_stop();
+		}
+
+		m_Workers.clear();
+	}
+
+	std::shared_ptr<AsyncTexture> TextureLoader::LoadAsync(std::filesystem::path path, const TextureLoadSettings& settings)
+	{
+		auto texture = std::make_shared<AsyncTexture>(std::move(path), settings);
+
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Requests.push_back(texture);
+			m_PendingCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		m_RequestAvailable.notify_one();
+		return texture;
+	}
+
+	size_t TextureLoader::ProcessUploads(const std::chrono::microseconds budget)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		size_t processed = 0;
+
+		do
+		{
+			DecodedImage image = {};
+
+			{
+				std::scoped_lock lock(m_Mutex);
+				if (m_DecodedImages.empty())
+				{
+					break;
+				}
+
+				image = std::move(m_DecodedImages.front());
+				m_DecodedImages.pop_front();
+			}
+
+			Upload(image);
+			++processed;
+		}
+		while (std::chrono::steady_clock::now() - start < budget);
+
+		// Fence the uploads of this frame, so their staging memory can be recycled
+		m_StagingBuffer->Submit();
+		return processed;
+	}
+
+	size_t TextureLoader::GetPendingCount() const
+	{
+		return m_PendingCount.load(std::memory_order_relaxed);
+	}
+
+	TextureLoader::TextureLoader(std::unique_ptr<StagingBuffer> stagingBuffer):
+		m_StagingBuffer(std::move(stagingBuffer)),
+		m_PendingCount(0)
+	{
+	}
+
+	void TextureLoader::RunWorker(const std::stop_token stopToken)
+	{
+		while (true)
+		{
+			std::shared_ptr<AsyncTexture> request;
+
+			{
+				std::unique_lock lock(m_Mutex);
+				if (not m_RequestAvailable.wait(lock, stopToken, [this] { return not m_Requests.empty(); }))
+				{
+					return;
+				}
+
+				request = std::move(m_Requests.front());
+				m_Requests.pop_front();
+			}
+
+			DecodedImage image = { .Target = request, .Image = std::nullopt, .Error = {} };
+			image.Image = LoadTextureImage(request->GetPath(), image.Error);
+
+			const TextureLoadSettings& settings = request->m_Settings;
+			if (image.Image and image.Image->Format == TextureFormat::RGBA8 and IsCompressed(settings.Compression))
+			{
+				// Compressed levels can't be generated by the GPU, so the chain is built before encoding
+				if (settings.Mipmapped and image.Image->Levels.size() == 1)
+				{
+					for (MipLevel& level : BuildMipChain(image.Image->Size, image.Image->Levels.front().data()))
+					{
+						image.Image->Levels.push_back(std::move(level.Pixels));
+					}
+				}
+
+				image.Image = CompressImage(*image.Image, settings.Compression);
+			}
+
+			std::scoped_lock lock(m_Mutex);
+			m_DecodedImages.push_back(std::move(image));
+		}
+	}
+
+	void TextureLoader::Upload(DecodedImage& image)
+	{
+		AsyncTexture& target = *image.Target;
+		m_PendingCount.fetch_sub(1, std::memory_order_relaxed);
+
+		if (not image.Image)
+		{
+			target.m_Error = std::move(image.Error);
+			target.m_State.store(TextureLoadState::Failed, std::memory_order_release);
+			return;
+		}
+
+		const TextureImage& decoded = *image.Image;
+
+		// Uncompressed images with a single level get their mip chain from the GPU
+		const bool generateMipmaps = target.m_Settings.Mipmapped and decoded.Levels.size() == 1 and not IsCompressed(decoded.Format);
+		const uint32_t mipLevelCount = generateMipmaps ? Texture::CalculateMipLevelCount(decoded.Size) : static_cast<uint32_t>(decoded.Levels.size());
+		std::unique_ptr<Texture> texture = Texture::Create(decoded.Size, decoded.Format, mipLevelCount, decoded.Origin);
+
+		size_t byteCount = 0;
+		for (const std::vector<uint8_t>& level : decoded.Levels)
+		{
+			byteCount += level.size();
+		}
+
+		// Images larger than the staging buffer are uploaded straight from client memory
+		if (const auto allocation = m_StagingBuffer->Allocate(byteCount))
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_StagingBuffer->GetRendererId());
+
+			size_t offset = 0;
+			for (uint32_t level = 0; level < decoded.Levels.size(); ++level)
+			{
+				const std::vector<uint8_t>& pixels = decoded.Levels[level];
+				std::memcpy(allocation->Data + offset, pixels.data(), pixels.size());
+				texture->UploadLevel(level, reinterpret_cast<const void*>(allocation->Offset + offset), pixels.size());
+				offset += pixels.size();
+			}
+
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+		else
+		{
+			for (uint32_t level = 0; level < decoded.Levels.size(); ++level)
+			{
+				texture->UploadLevel(level, decoded.Levels[level].data(), decoded.Levels[level].size());
+			}
+		}
+
+		if (generateMipmaps)
+		{
+			texture->GenerateMipmaps();
+		}
+
+		image.Image.reset();
+
+		target.m_Texture = std::move(texture);
+		target.m_State.store(TextureLoadState::Ready, std::memory_order_release);
+	}
+}
\ No newline at end of file
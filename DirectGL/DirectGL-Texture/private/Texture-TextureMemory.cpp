@@ -0,0 +1,64 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+module DirectGL.Texture;
+
+namespace DGL::Texture
+{
+	static std::array<std::atomic<int64_t>, TextureCategoryCount> TrackedBytes = {};
+
+	static std::mutex DeleterMutex;
+	static TextureDeleter Deleter;
+
+	size_t TextureMemoryStatistics::GetTotal() const
+	{
+		return std::accumulate(Bytes.begin(), Bytes.end(), size_t(0));
+	}
+
+	void TrackTextureMemory(const TextureCategory category, const int64_t byteCount)
+	{
+		TrackedBytes[static_cast<size_t>(category)].fetch_add(byteCount, std::memory_order_relaxed);
+	}
+
+	TextureMemoryStatistics GetTextureMemoryStatistics()
+	{
+		TextureMemoryStatistics statistics = {};
+
+		for (size_t i = 0; i < TextureCategoryCount; ++i)
+		{
+			statistics.Bytes[i] = static_cast<size_t>(std::max<int64_t>(TrackedBytes[i].load(std::memory_order_relaxed), 0));
+		}
+
+		return statistics;
+	}
+
+	TextureDeleter SetTextureDeleter(TextureDeleter deleter)
+	{
+		std::scoped_lock lock(DeleterMutex);
+		return std::exchange(Deleter, std::move(deleter));
+	}
+
+	void DeleteTexture(const uint32_t textureId)
+	{
+		{
+			std::scoped_lock lock(DeleterMutex);
+			if (Deleter)
+			{
+				Deleter(textureId);
+				return;
+			}
+		}
+
+		const GLuint id = textureId;
+		glDeleteTextures(1, &id);
+	}
+}
\ No newline at end of file
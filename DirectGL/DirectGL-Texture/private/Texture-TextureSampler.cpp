@@ -2,6 +2,8 @@
 
 #include <glad/gl.h>
 
+#include <algorithm>
+
 module DirectGL.Texture;
 
 import Preconditions;
@@ -18,6 +20,19 @@ namespace DGL::Texture
 		}
 	}
 
+	constexpr GLenum MinificationFilterToGlId(const TextureFilterMode filterMode)
+	{
+		const bool linear = filterMode.Minification == TextureFilterModeId::Linear;
+
+		switch (filterMode.Mipmap)
+		{
+			case TextureMipmapFilterId::None: return FilterModeToGlId(filterMode.Minification);
+			case TextureMipmapFilterId::Nearest: return linear ? GL_LINEAR_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_NEAREST;
+			case TextureMipmapFilterId::Linear: return linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+			default: System::Error("Invalid TextureMipmapFilterId");
+		}
+	}
+
 	constexpr GLenum WrapModeToGlId(const TextureWrapModeId wrapMode)
 	{
 		switch (wrapMode)
@@ -30,16 +45,30 @@ namespace DGL::Texture
 		}
 	}
 
-	std::unique_ptr<TextureSampler> TextureSampler::Create(const TextureFilterMode filterMode, const TextureWrapMode wrapMode)
+	std::unique_ptr<TextureSampler> TextureSampler::Create(const SamplerState& state)
 	{
+		SamplerState clampedState = state;
+		clampedState.Anisotropy = std::clamp(state.Anisotropy, 1.0f, GetMaxAnisotropy());
+
+		const GLfloat borderColor[] = { state.BorderColor.X, state.BorderColor.Y, state.BorderColor.Z, state.BorderColor.W };
+
 		GLuint samplerId = 0;
 		glCreateSamplers(1, &samplerId);
-		glSamplerParameteri(samplerId, GL_TEXTURE_MIN_FILTER, FilterModeToGlId(filterMode.Minification));
-		glSamplerParameteri(samplerId, GL_TEXTURE_MAG_FILTER, FilterModeToGlId(filterMode.Magnification));
-		glSamplerParameteri(samplerId, GL_TEXTURE_WRAP_S, WrapModeToGlId(wrapMode.Horizontal));
-		glSamplerParameteri(samplerId, GL_TEXTURE_WRAP_T, WrapModeToGlId(wrapMode.Vertical));
+		glSamplerParameteri(samplerId, GL_TEXTURE_MIN_FILTER, MinificationFilterToGlId(state.FilterMode));
+		glSamplerParameteri(samplerId, GL_TEXTURE_MAG_FILTER, FilterModeToGlId(state.FilterMode.Magnification));
+		glSamplerParameteri(samplerId, GL_TEXTURE_WRAP_S, WrapModeToGlId(state.WrapMode.Horizontal));
+		glSamplerParameteri(samplerId, GL_TEXTURE_WRAP_T, WrapModeToGlId(state.WrapMode.Vertical));
+		glSamplerParameterf(samplerId, GL_TEXTURE_MAX_ANISOTROPY, clampedState.Anisotropy);
+		glSamplerParameterfv(samplerId, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+		return std::unique_ptr<TextureSampler>(new TextureSampler(clampedState, samplerId));
+	}
 
-		return std::unique_ptr<TextureSampler>(new TextureSampler(filterMode, wrapMode, samplerId));
+	float TextureSampler::GetMaxAnisotropy()
+	{
+		GLfloat maxAnisotropy = 1.0f;
+		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+		return std::max(maxAnisotropy, 1.0f);
 	}
 
 	TextureSampler::~TextureSampler()
@@ -47,38 +76,29 @@ namespace DGL::Texture
 		if (m_SamplerId != 0) glDeleteSamplers(1, &m_SamplerId);
 	}
 
-	void TextureSampler::SetFilterMode(const TextureFilterMode mode)
+	const SamplerState& TextureSampler::GetState() const
 	{
-		if (m_FilterMode == mode)
-		{
-			return;
-		}
-
-		m_FilterMode = mode;
-		glSamplerParameteri(m_SamplerId, GL_TEXTURE_MIN_FILTER, FilterModeToGlId(mode.Minification));
-		glSamplerParameteri(m_SamplerId, GL_TEXTURE_MAG_FILTER, FilterModeToGlId(mode.Magnification));
+		return m_State;
 	}
 
 	TextureFilterMode TextureSampler::GetFilterMode() const
 	{
-		return m_FilterMode;
+		return m_State.FilterMode;
 	}
 
-	void TextureSampler::SetWrapMode(const TextureWrapMode mode)
+	TextureWrapMode TextureSampler::GetWrapMode() const
 	{
-		if (m_WrapMode == mode)
-		{
-			return;
-		}
+		return m_State.WrapMode;
+	}
 
-		m_WrapMode = mode;
-		glSamplerParameteri(m_SamplerId, GL_TEXTURE_WRAP_S, WrapModeToGlId(mode.Horizontal));
-		glSamplerParameteri(m_SamplerId, GL_TEXTURE_WRAP_T, WrapModeToGlId(mode.Vertical));
+	float TextureSampler::GetAnisotropy() const
+	{
+		return m_State.Anisotropy;
 	}
 
-	TextureWrapMode TextureSampler::GetWrapMode() const
+	Math::Float4 TextureSampler::GetBorderColor() const
 	{
-		return m_WrapMode;
+		return m_State.BorderColor;
 	}
 
 	GLuint TextureSampler::GetRendererId() const
@@ -86,10 +106,9 @@ namespace DGL::Texture
 		return m_SamplerId;
 	}
 
-	TextureSampler::TextureSampler(const TextureFilterMode filterMode, const TextureWrapMode wrapMode, const GLuint samplerId):
-		m_FilterMode(filterMode),
-		m_WrapMode(wrapMode),
-		m_SamplerId(samplerId)
+	TextureSampler::TextureSampler(const SamplerState& state, const GLuint samplerId):
+		m_SamplerId(samplerId),
+		m_State(state)
 	{
 	}
 }
\ No newline at end of file
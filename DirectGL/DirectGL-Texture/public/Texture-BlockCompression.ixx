@@ -0,0 +1,36 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-BlockCompression.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <vector>
+
+export module DirectGL.Texture:BlockCompression;
+
+import DirectGL.Math;
+
+import :TextureFormat;
+import :TextureImage;
+
+export namespace DGL::Texture
+{
+	/// @brief Encode an RGBA8 image into BC1 or BC3 blocks. The encoder fits the
+	///		   endpoints to the bounding box of each block, which is fast enough to
+	///		   run on the loader threads while trading some quality for speed.
+	///		   Blocks exceeding the image are padded by clamping to its edge. BC1 blocks
+	///		   are always encoded as opaque, use BC3 for images with transparency.
+	/// @param format The target format. Must be TextureFormat::BC1 or TextureFormat::BC3.
+	/// @param size The size of the image.
+	/// @param pixels The RGBA8 texels of the image.
+	/// @return The encoded blocks, ordered row by row.
+	std::vector<uint8_t> EncodeBlocks(TextureFormat format, Math::Uint2 size, const uint8_t* pixels);
+
+	/// @brief Compress every level of an RGBA8 image.
+	/// @param image The image to compress.
+	/// @param format The target format. Must be TextureFormat::BC1 or TextureFormat::BC3.
+	/// @return The compressed image.
+	TextureImage CompressImage(const TextureImage& image, TextureFormat format);
+}
\ No newline at end of file
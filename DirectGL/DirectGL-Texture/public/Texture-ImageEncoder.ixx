@@ -0,0 +1,48 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-ImageEncoder.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+export module DirectGL.Texture:ImageEncoder;
+
+import DirectGL.Math;
+
+export namespace DGL::Texture
+{
+	enum class ImageFileFormat
+	{
+		Png,	//!< Lossless and widely supported, but slower to encode
+		Qoi,	//!< Lossless and several times faster to encode than png
+	};
+
+	/// @return The file extension of the format including the dot.
+	std::string_view GetFileExtension(ImageFileFormat format);
+
+	/// @brief Encode an image into a png file. Every row gets the filter that
+	///		   promises the smallest output and the result is deflated in a single
+	///		   block using the fixed huffman codes. This compresses worse than zlib
+	///		   at its default level, but is fast enough to keep up with recordings.
+	/// @param size The size of the image.
+	/// @param pixels The RGBA8 pixels of the image, top row first.
+	/// @return The contents of the png file.
+	std::vector<uint8_t> EncodePng(Math::Uint2 size, const uint8_t* pixels);
+
+	/// @brief Encode an image into a qoi file.
+	/// @param size The size of the image.
+	/// @param pixels The RGBA8 pixels of the image, top row first.
+	/// @return The contents of the qoi file.
+	std::vector<uint8_t> EncodeQoi(Math::Uint2 size, const uint8_t* pixels);
+
+	/// @brief Encode an image into the given file format.
+	/// @param format The format of the file.
+	/// @param size The size of the image.
+	/// @param pixels The RGBA8 pixels of the image, top row first.
+	/// @return The contents of the file.
+	std::vector<uint8_t> EncodeImage(ImageFileFormat format, Math::Uint2 size, const uint8_t* pixels);
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-MipChain.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <vector>
+
+export module DirectGL.Texture:MipChain;
+
+import DirectGL.Math;
+
+export namespace DGL::Texture
+{
+	struct MipLevel
+	{
+		Math::Uint2 Size;				//!< The size of the level in texels
+		std::vector<uint8_t> Pixels;	//!< Tightly packed RGBA8 texels
+	};
+
+	/// @brief Calculate the size of a mip level. Each level halves the previous one, but never drops below 1.
+	Math::Uint2 GetMipLevelSize(Math::Uint2 size, uint32_t level);
+
+	/// @brief Downsample an RGBA8 image to the next mip level using a 2x2 box filter.
+	///		   Texels outside the source get clamped to its edge, so images with a
+	///		   width or height of 1 are handled as well.
+	/// @param sourceSize The size of the source image.
+	/// @param source The texels of the source image.
+	/// @param target The texels of the target image. Must hold GetMipLevelSize(sourceSize, 1) texels.
+	void DownsampleBox(Math::Uint2 sourceSize, const uint8_t* source, uint8_t* target);
+
+	/// @brief Build the mip chain of an RGBA8 image on the CPU. Used where no GPU
+	///		   is available to generate mip maps, e.g. by software rendering paths.
+	/// @param size The size of the base level.
+	/// @param pixels The texels of the base level.
+	/// @return All levels below the base level, down to 1x1.
+	std::vector<MipLevel> BuildMipChain(Math::Uint2 size, const uint8_t* pixels);
+}
\ No newline at end of file
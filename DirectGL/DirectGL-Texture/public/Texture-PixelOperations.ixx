@@ -0,0 +1,48 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-PixelOperations.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+export module DirectGL.Texture:PixelOperations;
+
+import DirectGL.Math;
+
+/// Operations on tightly packed RGBA8 pixels with straight alpha. Each one processes
+/// four pixels per iteration using SSE2 where available and falls back to scalar
+/// code otherwise; both paths produce identical results.
+export namespace DGL::Texture
+{
+	using Rgba8 = std::array<uint8_t, 4>;
+
+	/// @brief Set every pixel to the same color.
+	void FillPixels(std::span<uint8_t> pixels, Rgba8 color);
+
+	/// @brief Blend the source over the destination, matching BlendModes::Alpha.
+	/// @param destination The pixels to blend onto.
+	/// @param source The pixels to blend. Must be as large as the destination.
+	void BlendPixels(std::span<uint8_t> destination, std::span<const uint8_t> source);
+
+	/// @brief Multiply the source by a tint and blend it over the destination, matching
+	///		   how images are drawn with RenderState::ImageTint and RenderState::ImageAlpha.
+	/// @param tint The tint, whose alpha channel holds the combined tint alpha and image alpha.
+	void BlendPixelsTinted(std::span<uint8_t> destination, std::span<const uint8_t> source, Rgba8 tint);
+
+	/// @brief Turn pixels white if their luminance reaches the threshold and black otherwise. Alpha is preserved.
+	void ThresholdPixels(std::span<uint8_t> pixels, uint8_t threshold);
+
+	/// @brief Convolve the rows of an image with a square kernel. Pixels outside the image get clamped to its edge.
+	/// @param size The size of the image.
+	/// @param source The pixels of the image.
+	/// @param destination The convolved pixels. Must not overlap the source.
+	/// @param kernel The weights of the kernel, row by row. Must hold kernelSize * kernelSize values.
+	/// @param kernelSize The width and height of the kernel. Must be odd.
+	/// @param firstRow The first row to convolve.
+	/// @param rowCount The number of rows to convolve.
+	void ConvolvePixels(Math::Uint2 size, const uint8_t* source, uint8_t* destination, std::span<const float> kernel, uint32_t kernelSize, uint32_t firstRow, uint32_t rowCount);
+}
\ No newline at end of file
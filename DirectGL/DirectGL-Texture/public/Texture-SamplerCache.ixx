@@ -0,0 +1,42 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-SamplerCache.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <memory>
+#include <vector>
+
+export module DirectGL.Texture:SamplerCache;
+
+import :TextureSampler;
+
+export namespace DGL::Texture
+{
+	/// Hands out one immutable sampler per distinct SamplerState. Switching the sampling
+	/// of a draw call picks another prebuilt sampler instead of changing the parameters
+	/// of a sampler that may still be in use. Samplers live as long as the cache.
+	class SamplerCache
+	{
+	public:
+
+		static std::unique_ptr<SamplerCache> Create();
+
+		/// @brief Get the sampler for a state, creating it on the first request.
+		///		   States differing only by anisotropy above the driver limit share a sampler.
+		const TextureSampler& Get(const SamplerState& state);
+
+		/// @return The number of samplers created so far.
+		size_t GetSamplerCount() const;
+
+	private:
+
+		explicit SamplerCache(float maxAnisotropy);
+
+		/// Programs only use a handful of states, which makes a linear search faster than hashing
+		std::vector<std::unique_ptr<TextureSampler>> m_Samplers;
+		float m_MaxAnisotropy;
+
+	};
+}
\ No newline at end of file
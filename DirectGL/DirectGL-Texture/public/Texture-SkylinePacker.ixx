@@ -0,0 +1,61 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-SkylinePacker.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <optional>
+#include <vector>
+
+export module DirectGL.Texture:SkylinePacker;
+
+import DirectGL.Math;
+
+export namespace DGL::Texture
+{
+	/// Packs rectangles into a fixed area using the skyline bottom-left
+	/// heuristic. Rectangles are placed incrementally, so previously packed
+	/// rectangles never move, and the area can be grown at any time.
+	class SkylinePacker
+	{
+	public:
+
+		explicit SkylinePacker(Math::Uint2 size);
+
+		/// @brief Find a place for a rectangle and reserve it.
+		/// @param size The size of the rectangle.
+		/// @return The top-left corner of the rectangle or std::nullopt if it doesn't fit.
+		std::optional<Math::Uint2> Insert(Math::Uint2 size);
+
+		/// @brief Grow the packing area. Already packed rectangles keep their position.
+		/// @param size The new size, which must not be smaller than the current size.
+		void Grow(Math::Uint2 size);
+
+		Math::Uint2 GetSize() const;
+
+		/// @return The number of texels covered by packed rectangles.
+		uint64_t GetUsedArea() const;
+
+		/// @return The number of texels below the skyline that no rectangle can be placed in anymore.
+		uint64_t GetWastedArea() const;
+
+	private:
+
+		/// A horizontal segment of the skyline, spanning [X, X + Width) with the free space starting at Y.
+		struct Segment
+		{
+			uint32_t X;
+			uint32_t Y;
+			uint32_t Width;
+		};
+
+		std::optional<uint32_t> Fit(size_t index, Math::Uint2 size) const;
+		void Merge();
+
+		std::vector<Segment> m_Skyline;
+		Math::Uint2 m_Size;
+		uint64_t m_UsedArea;
+
+	};
+}
\ No newline at end of file
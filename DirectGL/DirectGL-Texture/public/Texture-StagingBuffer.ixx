@@ -0,0 +1,71 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-StagingBuffer.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <glad/gl.h>
+
+#include <deque>
+#include <memory>
+#include <optional>
+
+export module DirectGL.Texture:StagingBuffer;
+
+export namespace DGL::Texture
+{
+	/// A persistently mapped pixel unpack buffer used as a ring allocator.
+	/// Pixels are copied into an allocation and uploaded from there, which
+	/// lets the driver transfer them asynchronously. Allocations are only
+	/// reused once the GPU signalled the fence placed by Submit().
+	class StagingBuffer
+	{
+	public:
+
+		struct Allocation
+		{
+			uint8_t* Data;		//!< The mapped memory to write the pixels to
+			size_t Offset;		//!< The offset of the allocation within the buffer, used as the pixel pointer while the buffer is bound
+		};
+
+		/// @brief Create a new staging buffer.
+		/// @param capacity The size of the buffer in bytes.
+		/// @return The staging buffer or nullptr if the buffer couldn't be mapped.
+		static std::unique_ptr<StagingBuffer> Create(size_t capacity);
+
+		~StagingBuffer();
+
+		/// @brief Reserve memory for an upload. Blocks until the GPU released enough memory.
+		/// @param size The number of bytes to reserve.
+		/// @return The allocation or std::nullopt if the size exceeds the capacity of the buffer.
+		std::optional<Allocation> Allocate(size_t size);
+
+		/// @brief Place a fence behind all commands that read from the allocations made since the last call.
+		void Submit();
+
+		GLuint GetRendererId() const;
+		size_t GetCapacity() const;
+
+	private:
+
+		struct Range
+		{
+			size_t Offset;
+			size_t Size;
+			GLsync Fence;
+		};
+
+		explicit StagingBuffer(GLuint bufferId, uint8_t* mappedData, size_t capacity);
+
+		std::optional<size_t> FindSpace(size_t size) const;
+		bool RetireOldest(bool wait);
+
+		GLuint m_BufferId;
+		uint8_t* m_MappedData;
+		size_t m_Capacity;
+
+		std::deque<Range> m_Ranges;
+
+	};
+}
\ No newline at end of file
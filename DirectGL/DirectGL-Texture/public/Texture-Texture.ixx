@@ -13,25 +13,127 @@ export module DirectGL.Texture:Texture;
 
 import DirectGL.Math;
 
+import :StagingBuffer;
+import :TextureFormat;
+import :TextureImage;
+import :TextureMemory;
+
 export namespace DGL::Texture
 {
+	struct TextureUpdate
+	{
+		Math::UintBoundary Region;	//!< The texels being updated
+		uint8_t* Pixels;			//!< The mapped memory to write the RGBA8 texels of the region to
+		size_t Stride;				//!< The distance between two rows in bytes
+		size_t BufferOffset;		//!< The offset of the texels within the upload buffer
+	};
+
 	class Texture
 	{
 	public:
 
-		static std::unique_ptr<Texture> Create(Math::Uint2 size, const uint8_t* data);
+		/// @brief Create a new RGBA8 texture.
+		/// @param size The size of the base level.
+		/// @param data The texels of the base level or nullptr to leave the texture undefined.
+		/// @param mipmapped Whether to allocate a full mip chain. The chain gets generated
+		///		   from data, if present; otherwise call GenerateMipmaps() after uploading.
+		static std::unique_ptr<Texture> Create(Math::Uint2 size, const uint8_t* data, bool mipmapped = false);
+
+		/// @brief Create a texture without uploading any data. Use UploadLevel() to fill the levels.
+		/// @param size The size of the base level.
+		/// @param format The format of the texels in video memory.
+		/// @param mipLevelCount The number of levels to allocate.
+		/// @param origin Which row of the data is the top of the image.
+		static std::unique_ptr<Texture> Create(Math::Uint2 size, TextureFormat format, uint32_t mipLevelCount, TextureOrigin origin = TextureOrigin::BottomLeft);
+
+		/// @brief Create a texture from a decoded image, uploading every level as is.
+		///		   Block compressed images are passed to the GPU without decompression.
+		static std::unique_ptr<Texture> Create(const TextureImage& image);
+
+		/// @brief Calculate the number of levels of a full mip chain down to 1x1.
+		static uint32_t CalculateMipLevelCount(Math::Uint2 size);
 
 		~Texture();
 
+		/// @brief Reallocate the storage of the texture. Texels that are part of both
+		///		   the old and the new size are preserved, new texels are undefined.
+		///		   A mipmapped texture keeps a full mip chain which gets regenerated.
+		///		   Compressed textures only preserve whole blocks of their base level.
+		///		   The texture gets a new renderer id, the previous storage is released
+		///		   through DeleteTexture(), so draw calls queued before still sample it.
+		/// @param size The new size of the texture.
+		void Resize(Math::Uint2 size);
+
+		/// @brief Upload the texels of a single level.
+		/// @param level The level to upload.
+		/// @param data The texels in the format of the texture. Interpreted as an offset
+		///		   while a buffer is bound to GL_PIXEL_UNPACK_BUFFER.
+		/// @param byteCount The number of bytes of the level, see CalculateImageSize().
+		void UploadLevel(uint32_t level, const void* data, size_t byteCount);
+
+		/// @brief Upload the texels of a region of the base level straight from system memory. Unlike
+		///		   Update(), no upload buffer gets allocated, which suits textures written rarely.
+		///		   Mipmapped textures regenerate their mip chain afterwards.
+		/// @param region The region to replace. Must be part of the texture, which must be RGBA8.
+		/// @param pixels The tightly packed RGBA8 texels of the region.
+		void UploadRegion(const Math::UintBoundary& region, const uint8_t* pixels);
+
+		/// @brief Replace the texels of a region of the base level. The texels are copied into a ring of
+		///		   pixel unpack buffers and uploaded from there, so the call returns without waiting for the
+		///		   transfer. The ring holds a few frames worth of updates, only once the GPU falls further
+		///		   behind, the call waits for it instead of reallocating memory still in use.
+		///		   Rows are counted in the same order as the data passed to Create().
+		///		   Mipmapped textures regenerate their mip chain after each update.
+		/// @param region The region to replace. Must be part of the texture, which must be RGBA8.
+		/// @param pixels The RGBA8 texels of the region.
+		/// @param stride The distance between two rows of pixels in bytes.
+		void Update(const Math::UintBoundary& region, const uint8_t* pixels, size_t stride);
+
+		/// @brief Like Update(), but the texels are written into the upload buffer directly, which
+		///		   saves a copy. The memory stays mapped until EndUpdate() uploads the region.
+		///		   Only one update can be open per texture: neither another update nor Resize()
+		///		   may be called before EndUpdate(), they could recycle the memory being written.
+		/// @param region The region to replace. Must be part of the texture, which must be RGBA8.
+		TextureUpdate BeginUpdate(const Math::UintBoundary& region);
+		void EndUpdate(const TextureUpdate& update);
+
+		/// @brief Read every level back into system memory. Stalls until the GPU finished writing the texture.
+		TextureImage Download() const;
+
+		/// @brief Regenerate all mip levels from the base level. Does nothing if the
+		///		   texture has been created without a mip chain or is block compressed.
+		void GenerateMipmaps();
+
 		Math::Uint2 GetSize() const;
+		uint32_t GetMipLevelCount() const;
+		TextureFormat GetFormat() const;
+		TextureOrigin GetOrigin() const;
+
+		/// @return The number of bytes occupied by all levels of the texture.
+		size_t GetByteSize() const;
+
+		/// @brief Set the category the memory of the texture is accounted to. Defaults to TextureCategory::Image.
+		void SetCategory(TextureCategory category);
+		TextureCategory GetCategory() const;
+
+		/// @return A counter incremented whenever the texels of the base level change, e.g. to tell copies of them in system memory apart.
+		uint64_t GetRevision() const;
+
 		GLuint GetRendererId() const;
 
 	private:
 
-		explicit Texture(Math::Uint2 size, GLuint textureId);
+		explicit Texture(Math::Uint2 size, TextureFormat format, uint32_t mipLevelCount, TextureOrigin origin, GLuint textureId);
 
 		GLuint m_TextureId;
 		Math::Uint2 m_Size;
+		TextureFormat m_Format;
+		uint32_t m_MipLevelCount;
+		TextureOrigin m_Origin;
+		TextureCategory m_Category;
+		uint64_t m_Revision;
+		std::unique_ptr<StagingBuffer> m_UpdateBuffer;	//!< Created by the first update
+		bool m_IsUpdating;								//!< Whether BeginUpdate() handed out memory EndUpdate() hasn't uploaded yet
 
 	};
 }
\ No newline at end of file
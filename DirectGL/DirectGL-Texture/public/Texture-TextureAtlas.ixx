@@ -0,0 +1,81 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-TextureAtlas.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+export module DirectGL.Texture:TextureAtlas;
+
+import DirectGL.Math;
+
+import :Texture;
+import :TextureRegion;
+import :SkylinePacker;
+
+export namespace DGL::Texture
+{
+	struct TextureAtlasSettings
+	{
+		Math::Uint2 InitialPageSize = { 512, 512 };		//!< The size a new page starts with
+		Math::Uint2 MaxPageSize = { 4096, 4096 };		//!< The size a page may grow to before another page gets created
+		uint32_t Padding = 1;							//!< The number of texels around every image, filled with its edge texels
+	};
+
+	struct TextureAtlasStatistics
+	{
+		size_t PageCount;				//!< The number of pages
+		size_t RegionCount;				//!< The number of images added to the atlas
+		uint64_t PageArea;				//!< The number of texels across all pages
+		uint64_t UsedArea;				//!< The number of texels covered by images, excluding padding
+		uint64_t PaddingArea;			//!< The number of texels covered by padding
+		uint64_t WastedArea;			//!< The number of texels that can no longer be used by any image
+		float Occupancy;				//!< The fraction of the page area covered by images
+	};
+
+	/// Packs many small RGBA images into a few large textures, so images
+	/// drawn one after another can share a batch. Pages grow up to the
+	/// maximum page size and further pages get created once a page is full.
+	/// Images are packed incrementally and never move once added.
+	class TextureAtlas
+	{
+	public:
+
+		static std::unique_ptr<TextureAtlas> Create(const TextureAtlasSettings& settings = {});
+
+		/// @brief Add an image to the atlas.
+		/// @param size The size of the image in pixels.
+		/// @param pixels The tightly packed RGBA8 pixels of the image.
+		/// @return The region of the image or std::nullopt if the image exceeds the maximum page size.
+		std::optional<TextureRegion> Add(Math::Uint2 size, const uint8_t* pixels);
+
+		size_t GetPageCount() const;
+		const Texture& GetPage(size_t index) const;
+
+		TextureAtlasStatistics GetStatistics() const;
+
+	private:
+
+		struct Page
+		{
+			std::unique_ptr<Texture> Storage;
+			SkylinePacker Packer;
+		};
+
+		explicit TextureAtlas(const TextureAtlasSettings& settings);
+
+		std::optional<Math::Uint2> Insert(Page& page, Math::Uint2 size, bool allowGrowth);
+		Page& AddPage(Math::Uint2 minimumSize);
+
+		TextureAtlasSettings m_Settings;
+		std::vector<Page> m_Pages;
+
+		size_t m_RegionCount;
+		uint64_t m_UsedArea;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-TextureCache.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+export module DirectGL.Texture:TextureCache;
+
+import :Texture;
+import :TextureImage;
+import :TextureLoader;
+
+export namespace DGL::Texture
+{
+	/// Where the texels of a texture go when it gets evicted from video memory.
+	enum class TextureEvictionTarget
+	{
+		Disk,			//!< Drop the texture and reload it from its file on the next use
+		SystemMemory,	//!< Read the texture back and keep a copy in system memory
+	};
+
+	enum class TextureResidency
+	{
+		Loading,		//!< The texture is being loaded or reloaded
+		Resident,		//!< The texture lives in video memory
+		Evicted,		//!< The texture has been evicted and gets reloaded on the next use
+		Failed,			//!< The texture couldn't be loaded
+	};
+
+	struct TextureCacheSettings
+	{
+		size_t Budget = 512ull * 1024 * 1024;								//!< The video memory in bytes the cached textures may occupy
+		TextureEvictionTarget EvictionTarget = TextureEvictionTarget::Disk;	//!< Where evicted textures are kept
+		uint32_t FramesInFlight = 0;										//!< The frames a render thread may still draw after they have been recorded
+	};
+
+	struct TextureCacheStatistics
+	{
+		size_t EntryCount;		//!< The number of distinct textures known to the cache
+		size_t ResidentCount;	//!< The number of textures living in video memory
+		size_t ResidentBytes;	//!< The video memory occupied by resident textures
+		size_t EvictedBytes;	//!< The system memory occupied by evicted copies
+		size_t Budget;			//!< The video memory budget
+	};
+
+	class TextureCache;
+
+	/// A texture owned by the TextureCache. The texture may be evicted whenever
+	/// it hasn't been used for a frame and gets reloaded transparently by Use().
+	class CachedTexture
+	{
+	public:
+
+		/// @brief Mark the texture as used in the current frame. Evicted textures
+		///		   get reloaded, either immediately from system memory or in the
+		///		   background from disk.
+		/// @return The texture or nullptr while it is not resident.
+		const Texture* Use();
+
+		TextureResidency GetResidency() const;
+		const std::filesystem::path& GetPath() const;
+
+		/// @return The reason the load failed. Only valid while the residency is Failed.
+		const std::string& GetError() const;
+
+	private:
+
+		friend class TextureCache;
+
+		explicit CachedTexture(TextureCache& cache, std::filesystem::path path, const TextureLoadSettings& settings);
+
+		const Texture* GetResidentTexture() const;
+		void Evict(TextureEvictionTarget target);
+
+		TextureCache* m_Cache;
+		std::filesystem::path m_Path;
+		TextureLoadSettings m_Settings;
+
+		std::shared_ptr<AsyncTexture> m_Load;		//!< The texture loaded from disk
+		std::unique_ptr<Texture> m_Restored;		//!< The texture restored from system memory
+		std::optional<TextureImage> m_SystemCopy;	//!< The texels kept while the texture is evicted
+
+		uint64_t m_LastUsedFrame;
+
+	};
+
+	/// Deduplicates textures by their path and keeps the video memory of the
+	/// cached textures below a budget by evicting the least recently used ones.
+	class TextureCache
+	{
+	public:
+
+		/// @brief Create a new texture cache.
+		/// @param loader The loader used to load and reload textures from disk.
+		/// @param settings The budget and eviction behavior of the cache.
+		static std::unique_ptr<TextureCache> Create(TextureLoader& loader, const TextureCacheSettings& settings = {});
+
+		/// @brief Get the texture of a file, loading it unless it is already known to the cache.
+		/// @param path The path of the image.
+		/// @param settings Controls the mip chain and compression of the texture.
+		/// @return The shared handle of the texture.
+		std::shared_ptr<CachedTexture> Acquire(const std::filesystem::path& path, const TextureLoadSettings& settings = {});
+
+		/// @brief Advance to the next frame, forget textures that are no longer referenced
+		///		   and evict textures until the budget is met. Must be called on the GL
+		///		   thread while no draw calls referencing cached textures are pending.
+		void Update();
+
+		void SetBudget(size_t budget);
+		size_t GetBudget() const;
+
+		/// @brief Keep textures used by the given number of frames recorded ahead of the one being drawn.
+		void SetFramesInFlight(uint32_t framesInFlight);
+
+		TextureCacheStatistics GetStatistics() const;
+
+	private:
+
+		friend class CachedTexture;
+
+		explicit TextureCache(TextureLoader& loader, const TextureCacheSettings& settings);
+
+		static std::string MakeKey(const std::filesystem::path& path, const TextureLoadSettings& settings);
+
+		TextureLoader* m_Loader;
+		TextureCacheSettings m_Settings;
+		std::unordered_map<std::string, std::shared_ptr<CachedTexture>> m_Entries;
+		uint64_t m_Frame;
+
+	};
+}
\ No newline at end of file
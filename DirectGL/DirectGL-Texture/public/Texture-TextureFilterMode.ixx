@@ -13,16 +13,28 @@ export namespace DGL::Texture
 		Linear,
 	};
 
+	/// Describes how texels get blended between mip levels when a texture is minified.
+	/// Textures without a mip chain always sample their base level.
+	enum class TextureMipmapFilterId
+	{
+		None,		//!< Only sample the base level
+		Nearest,	//!< Sample the closest mip level
+		Linear,		//!< Blend between the two closest mip levels
+	};
+
 	struct TextureFilterMode
 	{
 		TextureFilterModeId Minification;
 		TextureFilterModeId Magnification;
+		TextureMipmapFilterId Mipmap = TextureMipmapFilterId::None;
 
 		constexpr bool operator == (const TextureFilterMode&) const = default;
 		constexpr bool operator != (const TextureFilterMode&) const = default;
 
 		static const TextureFilterMode Nearest;
 		static const TextureFilterMode Linear;
+		static const TextureFilterMode Bilinear;
+		static const TextureFilterMode Trilinear;
 	};
 }
 
@@ -30,4 +42,6 @@ namespace DGL::Texture
 {
 	inline constexpr TextureFilterMode TextureFilterMode::Nearest = { .Minification = TextureFilterModeId::Nearest, .Magnification = TextureFilterModeId::Nearest };
 	inline constexpr TextureFilterMode TextureFilterMode::Linear = { .Minification = TextureFilterModeId::Linear, .Magnification = TextureFilterModeId::Linear };
+	inline constexpr TextureFilterMode TextureFilterMode::Bilinear = { .Minification = TextureFilterModeId::Linear, .Magnification = TextureFilterModeId::Linear, .Mipmap = TextureMipmapFilterId::Nearest };
+	inline constexpr TextureFilterMode TextureFilterMode::Trilinear = { .Minification = TextureFilterModeId::Linear, .Magnification = TextureFilterModeId::Linear, .Mipmap = TextureMipmapFilterId::Linear };
 }
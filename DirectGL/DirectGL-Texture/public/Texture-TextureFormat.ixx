@@ -0,0 +1,53 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-TextureFormat.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstddef>
+#include <cstdint>
+
+export module DirectGL.Texture:TextureFormat;
+
+import DirectGL.Math;
+
+export namespace DGL::Texture
+{
+	/// The layout of the texels in video memory. Block compressed formats encode
+	/// 4x4 texels at once and are sampled by the GPU without decompression.
+	enum class TextureFormat
+	{
+		RGBA8,		//!< 4 bytes per texel
+		BC1,		//!< 8 bytes per 4x4 block, 1 bit alpha (DXT1)
+		BC3,		//!< 16 bytes per 4x4 block, interpolated alpha (DXT5)
+		BC7,		//!< 16 bytes per 4x4 block, high quality RGBA
+	};
+
+	/// Describes which row of the texture data appears at the top of the image.
+	enum class TextureOrigin
+	{
+		BottomLeft,	//!< The first row is the bottom row of the image, as expected by OpenGL
+		TopLeft,	//!< The first row is the top row of the image, as stored by DDS and KTX2
+	};
+
+	constexpr bool IsCompressed(const TextureFormat format)
+	{
+		return format != TextureFormat::RGBA8;
+	}
+
+	/// @brief Calculate the number of bytes required to store an image of the given size.
+	constexpr size_t CalculateImageSize(const TextureFormat format, const Math::Uint2 size)
+	{
+		const size_t blocksX = (static_cast<size_t>(size.X) + 3) / 4;
+		const size_t blocksY = (static_cast<size_t>(size.Y) + 3) / 4;
+
+		switch (format)
+		{
+			case TextureFormat::BC1: return blocksX * blocksY * 8;
+			case TextureFormat::BC3:
+			case TextureFormat::BC7: return blocksX * blocksY * 16;
+			default: return static_cast<size_t>(size.X) * size.Y * 4;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-TextureImage.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+export module DirectGL.Texture:TextureImage;
+
+import DirectGL.Math;
+
+import :TextureFormat;
+
+export namespace DGL::Texture
+{
+	/// A decoded image living in system memory, ready to be uploaded as is.
+	struct TextureImage
+	{
+		Math::Uint2 Size;							//!< The size of the base level
+		TextureFormat Format;						//!< The format of every level
+		TextureOrigin Origin;						//!< Which row of the data is the top of the image
+		std::vector<std::vector<uint8_t>> Levels;	//!< The mip levels, starting with the base level
+	};
+
+	/// @brief Load an image from disk. DDS and KTX2 containers are read without
+	///		   decompressing their blocks, every other file gets decoded by stb_image.
+	/// @param path The path of the image.
+	/// @param error Receives the reason if the image couldn't be loaded.
+	/// @return The image or std::nullopt on failure.
+	std::optional<TextureImage> LoadTextureImage(const std::filesystem::path& path, std::string& error);
+
+	/// @brief Parse a DDS container holding a 2D RGBA8, BC1, BC3 or BC7 texture.
+	std::optional<TextureImage> ParseDds(std::span<const uint8_t> data, std::string& error);
+
+	/// @brief Parse a KTX2 container holding a 2D RGBA8, BC1, BC3 or BC7 texture without supercompression.
+	std::optional<TextureImage> ParseKtx2(std::span<const uint8_t> data, std::string& error);
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-TextureLoader.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+export module DirectGL.Texture:TextureLoader;
+
+import DirectGL.Math;
+
+import :Texture;
+import :TextureFormat;
+import :TextureImage;
+import :StagingBuffer;
+
+export namespace DGL::Texture
+{
+	enum class TextureLoadState
+	{
+		Loading,	//!< The image is being decoded or waits for its upload
+		Ready,		//!< The texture has been uploaded and can be drawn
+		Failed,		//!< The image couldn't be read or decoded
+	};
+
+	struct TextureLoadSettings
+	{
+		bool Mipmapped = false;								//!< Whether to generate a mip chain for images that don't provide one
+		TextureFormat Compression = TextureFormat::RGBA8;	//!< BC1 or BC3 to compress decoded images on the worker threads
+	};
+
+	/// A texture that is being loaded in the background. The handle becomes
+	/// ready once the TextureLoader uploaded the decoded image on the GL thread.
+	class AsyncTexture
+	{
+	public:
+
+		explicit AsyncTexture(std::filesystem::path path, TextureLoadSettings settings = {});
+
+		TextureLoadState GetState() const;
+		bool IsReady() const;
+
+		/// @return The texture or nullptr while the texture is not ready.
+		const Texture* GetTexture() const;
+
+		const std::filesystem::path& GetPath() const;
+
+		/// @return The reason the load failed. Only valid in the Failed state.
+		const std::string& GetError() const;
+
+	private:
+
+		friend class TextureLoader;
+
+		std::filesystem::path m_Path;
+		TextureLoadSettings m_Settings;
+		std::atomic<TextureLoadState> m_State;
+		std::unique_ptr<Texture> m_Texture;
+		std::string m_Error;
+
+	};
+
+	/// Decodes images on a pool of worker threads and uploads them through a
+	/// staging buffer. Uploads only happen when ProcessUploads() gets called
+	/// on the GL thread, which lets the caller limit the time spent per frame.
+	class TextureLoader
+	{
+	public:
+
+		/// @brief Create a new texture loader.
+		/// @param workerCount The number of decoding threads.
+		/// @param stagingCapacity The size of the staging buffer in bytes.
+		/// @return The texture loader or nullptr if the staging buffer couldn't be created.
+		static std::unique_ptr<TextureLoader> Create(size_t workerCount, size_t stagingCapacity);
+
+		~TextureLoader();
+
+		/// @brief Queue an image for decoding. Can be called from any thread.
+		/// @param path The path of the image. DDS, KTX2 and every format supported by stb_image is accepted.
+		/// @param settings Controls the mip chain and compression of the texture.
+		/// @return The handle of the texture.
+		std::shared_ptr<AsyncTexture> LoadAsync(std::filesystem::path path, const TextureLoadSettings& settings = {});
+
+		/// @brief Upload decoded images until the budget is used up. Must be called on the GL thread.
+		///		   At least one image gets uploaded per call, so loading always makes progress.
+		/// @param budget The time that may be spent uploading.
+		/// @return The number of textures that became ready or failed.
+		size_t ProcessUploads(std::chrono::microseconds budget);
+
+		/// @return The number of images that are still being decoded or waiting for their upload.
+		size_t GetPendingCount() const;
+
+	private:
+
+		struct DecodedImage
+		{
+			std::shared_ptr<AsyncTexture> Target;
+			std::optional<TextureImage> Image;	//!< std::nullopt if decoding failed
+			std::string Error;
+		};
+
+		explicit TextureLoader(std::unique_ptr<StagingBuffer> stagingBuffer);
+
+		void RunWorker(std::stop_token stopToken);
+		void Upload(DecodedImage& image);
+
+		std::unique_ptr<StagingBuffer> m_StagingBuffer;
+
+		mutable std::mutex m_Mutex;
+		std::condition_variable_any m_RequestAvailable;
+		std::deque<std::shared_ptr<AsyncTexture>> m_Requests;
+		std::deque<DecodedImage> m_DecodedImages;
+		std::atomic<size_t> m_PendingCount;
+
+		std::vector<std::jthread> m_Workers;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-TextureMemory.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+export module DirectGL.Texture:TextureMemory;
+
+export namespace DGL::Texture
+{
+	/// The purpose video memory has been allocated for.
+	enum class TextureCategory
+	{
+		Image,			//!< Textures created by the user or loaded from files
+		Atlas,			//!< Pages of texture atlases
+		RenderTarget,	//!< Color attachments of offscreen render targets
+		DepthStencil,	//!< Depth/stencil renderbuffers of offscreen render targets
+	};
+
+	inline constexpr size_t TextureCategoryCount = 4;
+
+	struct TextureMemoryStatistics
+	{
+		std::array<size_t, TextureCategoryCount> Bytes;	//!< The live bytes, indexed by TextureCategory
+
+		size_t Get(TextureCategory category) const { return Bytes[static_cast<size_t>(category)]; }
+		size_t GetTotal() const;
+	};
+
+	/// @brief Account for allocated or released video memory.
+	/// @param category The category the memory belongs to.
+	/// @param byteCount The number of bytes allocated (positive) or released (negative).
+	void TrackTextureMemory(TextureCategory category, int64_t byteCount);
+
+	/// @brief Get a snapshot of the live video memory per category.
+	TextureMemoryStatistics GetTextureMemoryStatistics();
+
+	/// Deletes a GL texture object on behalf of DeleteTexture().
+	using TextureDeleter = std::function<void(uint32_t textureId)>;
+
+	/// @brief Route the deletion of textures through a deleter, which may keep them alive until
+	///		   the draw calls queued for them have been submitted. Without a deleter textures
+	///		   get deleted right away.
+	/// @return The deleter installed before, to be restored once the new one goes away.
+	TextureDeleter SetTextureDeleter(TextureDeleter deleter);
+
+	/// @brief Delete a GL texture object through the installed deleter. May be called from any thread.
+	void DeleteTexture(uint32_t textureId);
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+﻿// Project Name : DirectGL-Texture
+// File Name    : Texture-TextureRegion.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module DirectGL.Texture:TextureRegion;
+
+import DirectGL.Math;
+
+import :Texture;
+
+export namespace DGL::Texture
+{
+	/// A lightweight handle to a rectangular part of a texture, most
+	/// commonly an image that has been packed into a TextureAtlas.
+	/// The region stays valid while the atlas grows its pages, but the
+	/// renderer id of a page changes whenever its storage gets reallocated.
+	struct TextureRegion
+	{
+		const Texture* Source = nullptr;		//!< The texture the region is part of
+		Math::UintBoundary Bounds;				//!< The region in texels, measured from the first row of the texture data
+	};
+}
\ No newline at end of file
@@ -11,41 +11,54 @@ module;
 
 export module DirectGL.Texture:TextureSampler;
 
+import DirectGL.Math;
+
 import :TextureFilterMode;
 import :TextureWrapMode;
 
 export namespace DGL::Texture
 {
+	struct SamplerState
+	{
+		TextureFilterMode FilterMode = TextureFilterMode::Linear;
+		TextureWrapMode WrapMode = TextureWrapMode::ClampToEdge;
+		float Anisotropy = 1.0f;					//!< The number of samples taken along the axis of anisotropy, 1 disables anisotropic filtering
+		Math::Float4 BorderColor = Math::Float4();	//!< The normalized RGBA color sampled outside of the texture with TextureWrapModeId::ClampToBorder
+
+		constexpr bool operator == (const SamplerState&) const = default;
+		constexpr bool operator != (const SamplerState&) const = default;
+	};
+
+	/// An immutable sampler object. Its parameters are set once on creation, so it can
+	/// stay bound while other samplers are used for different states. Prefer obtaining
+	/// samplers from a SamplerCache, which shares them among every user of the same state.
 	class TextureSampler
 	{
 	public:
 
-		static std::unique_ptr<TextureSampler> Create(
-			TextureFilterMode filterMode = TextureFilterMode::Linear,
-			TextureWrapMode wrapMode = TextureWrapMode::ClampToEdge
-		);
+		/// @brief Create a new sampler.
+		/// @param state The parameters of the sampler. The anisotropy gets clamped into [1, GetMaxAnisotropy()].
+		static std::unique_ptr<TextureSampler> Create(const SamplerState& state = {});
+
+		/// @brief Query the highest anisotropy supported by the driver.
+		static float GetMaxAnisotropy();
 
 		~TextureSampler();
 
-		void SetFilterMode(TextureFilterMode mode);
+		const SamplerState& GetState() const;
 		TextureFilterMode GetFilterMode() const;
-
-		void SetWrapMode(TextureWrapMode mode);
 		TextureWrapMode GetWrapMode() const;
+		float GetAnisotropy() const;
+		Math::Float4 GetBorderColor() const;
 
 		GLuint GetRendererId() const;
 
 	private:
 
-		explicit TextureSampler(
-			TextureFilterMode filterMode,
-			TextureWrapMode wrapMode,
-			GLuint samplerId
-		);
+		explicit TextureSampler(const SamplerState& state, GLuint samplerId);
 
 		GLuint m_SamplerId;
-		TextureFilterMode m_FilterMode;
-		TextureWrapMode m_WrapMode;
+		SamplerState m_State;
 
 	};
 }
\ No newline at end of file
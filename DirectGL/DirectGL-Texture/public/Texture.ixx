@@ -6,6 +6,20 @@
 export module DirectGL.Texture;
 
 export import :Texture;
+export import :TextureFormat;
+export import :TextureImage;
 export import :TextureFilterMode;
 export import :TextureWrapMode;
-export import :TextureSampler;
\ No newline at end of file
+export import :TextureSampler;
+export import :SamplerCache;
+export import :TextureRegion;
+export import :SkylinePacker;
+export import :TextureAtlas;
+export import :StagingBuffer;
+export import :TextureLoader;
+export import :TextureCache;
+export import :TextureMemory;
+export import :MipChain;
+export import :BlockCompression;
+export import :ImageEncoder;
+export import :PixelOperations;
\ No newline at end of file
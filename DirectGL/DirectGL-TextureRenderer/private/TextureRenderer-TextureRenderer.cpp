@@ -1,77 +1,162 @@
 module;
 
-#include <Glad/gl.h>
+#include <glad/gl.h>
+
+#include <cstddef>
+#include <optional>
 
 module DirectGL.TextureRenderer;
 
 namespace DGL::TextureRenderer
 {
-	std::unique_ptr<TextureRenderer> TextureRenderer::Create()
+	std::unique_ptr<TextureRenderer> TextureRenderer::Create(const size_t maxSprites, const size_t maxTextureSlots)
 	{
-		constexpr GLuint indices[] = { 0, 1, 2, 2, 3, 0 };
-		constexpr GLfloat texCoords[] = {
-			0.0f, 1.0f,
-			1.0f, 1.0f,
-			1.0f, 0.0f,
-			0.0f, 0.0f
-		};
-
-		GLuint positionBufferId = 0;
-		glCreateBuffers(1, &positionBufferId);
-		glNamedBufferStorage(positionBufferId, 4 * 3 * sizeof(GLfloat), nullptr, GL_DYNAMIC_STORAGE_BIT);
-
-		GLuint texCoordBufferId = 0;
-		glCreateBuffers(1, &texCoordBufferId);
-		glNamedBufferStorage(texCoordBufferId, 4 * 2 * sizeof(GLfloat), texCoords, GL_DYNAMIC_STORAGE_BIT);
-
-		GLuint indexBufferId = 0;
-		glCreateBuffers(1, &indexBufferId);
-		glNamedBufferStorage(indexBufferId, 6 * sizeof(GLuint), indices, GL_DYNAMIC_STORAGE_BIT);
+		constexpr GLbitfield mappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		const auto bufferSize = static_cast<GLsizeiptr>(SectionCount * maxSprites * sizeof(SpriteInstance));
+
+		GLuint instanceBufferId = 0;
+		glCreateBuffers(1, &instanceBufferId);
+		glNamedBufferStorage(instanceBufferId, bufferSize, nullptr, mappingFlags);
 
+		const auto mappedInstances = static_cast<SpriteInstance*>(glMapNamedBufferRange(instanceBufferId, 0, bufferSize, mappingFlags));
+		if (mappedInstances == nullptr)
+		{
+			glDeleteBuffers(1, &instanceBufferId);
+			return nullptr;
+		}
+
+		// Every attribute advances once per instance. The corners of the quad are derived from gl_VertexID.
 		GLuint vertexArrayId = 0;
 		glCreateVertexArrays(1, &vertexArrayId);
-		glVertexArrayElementBuffer(vertexArrayId, indexBufferId);
+		glVertexArrayVertexBuffer(vertexArrayId, 0, instanceBufferId, 0, sizeof(SpriteInstance));
+		glVertexArrayBindingDivisor(vertexArrayId, 0, 1);
 
-		glVertexArrayVertexBuffer(vertexArrayId, 0, positionBufferId, 0, 3 * sizeof(GLfloat));
 		glEnableVertexArrayAttrib(vertexArrayId, 0);
-		glVertexArrayAttribFormat(vertexArrayId, 0, 3, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribFormat(vertexArrayId, 0, 3, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, M00));
 		glVertexArrayAttribBinding(vertexArrayId, 0, 0);
 
-		glVertexArrayVertexBuffer(vertexArrayId, 1, texCoordBufferId, 0, 2 * sizeof(GLfloat));
 		glEnableVertexArrayAttrib(vertexArrayId, 1);
-		glVertexArrayAttribFormat(vertexArrayId, 1, 2, GL_FLOAT, GL_FALSE, 0);
-		glVertexArrayAttribBinding(vertexArrayId, 1, 1);
+		glVertexArrayAttribFormat(vertexArrayId, 1, 3, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, M10));
+		glVertexArrayAttribBinding(vertexArrayId, 1, 0);
+
+		glEnableVertexArrayAttrib(vertexArrayId, 2);
+		glVertexArrayAttribFormat(vertexArrayId, 2, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, U0));
+		glVertexArrayAttribBinding(vertexArrayId, 2, 0);
+
+		glEnableVertexArrayAttrib(vertexArrayId, 3);
+		glVertexArrayAttribFormat(vertexArrayId, 3, 1, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, Depth));
+		glVertexArrayAttribBinding(vertexArrayId, 3, 0);
+
+		glEnableVertexArrayAttrib(vertexArrayId, 4);
+		glVertexArrayAttribFormat(vertexArrayId, 4, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(SpriteInstance, R));
+		glVertexArrayAttribBinding(vertexArrayId, 4, 0);
+
+		glEnableVertexArrayAttrib(vertexArrayId, 5);
+		glVertexArrayAttribIFormat(vertexArrayId, 5, 1, GL_UNSIGNED_INT, offsetof(SpriteInstance, TextureSlot));
+		glVertexArrayAttribBinding(vertexArrayId, 5, 0);
 
-		return std::unique_ptr<TextureRenderer>(new TextureRenderer(vertexArrayId, positionBufferId, texCoordBufferId, indexBufferId));
+		return std::unique_ptr<TextureRenderer>(new TextureRenderer(vertexArrayId, instanceBufferId, mappedInstances, maxSprites, maxTextureSlots));
 	}
 
 	TextureRenderer::~TextureRenderer()
 	{
-		if (m_PositionBufferId != 0) glDeleteBuffers(1, &m_PositionBufferId);
-		if (m_TexCoordBufferId != 0) glDeleteBuffers(1, &m_TexCoordBufferId);
-		if (m_IndexBufferId != 0) glDeleteBuffers(1, &m_IndexBufferId);
+		for (const GLsync fence : m_SectionFences)
+		{
+			if (fence != nullptr) glDeleteSync(fence);
+		}
+
+		if (m_InstanceBufferId != 0)
+		{
+			glUnmapNamedBuffer(m_InstanceBufferId);
+			glDeleteBuffers(1, &m_InstanceBufferId);
+		}
+
 		if (m_VertexArrayId != 0) glDeleteVertexArrays(1, &m_VertexArrayId);
 	}
 
-	void TextureRenderer::Render(const float left, const float top, const float width, const float height, const float depth)
+	void TextureRenderer::Submit(const GLuint textureId, const SpriteInstance& instance)
+	{
+		if (m_Cursor == (m_Section + 1) * m_SectionCapacity)
+		{
+			AdvanceSection();
+		}
+
+		std::optional<uint32_t> slot = m_TextureSlots.Acquire(textureId);
+		if (not slot.has_value())
+		{
+			Flush();
+			slot = m_TextureSlots.Acquire(textureId);
+		}
+
+		SpriteInstance& target = m_MappedInstances[m_Cursor++];
+		target = instance;
+		target.TextureSlot = *slot;
+	}
+
+	void TextureRenderer::Flush()
 	{
-		const GLfloat positions[] = {
-			left, top, depth,
-			left + width, top, depth,
-			left + width, top + height, depth,
-			left, top + height, depth,
-		};
-
-		glNamedBufferSubData(m_PositionBufferId, 0, sizeof(positions), positions);
+		if (m_Cursor == m_BatchBegin)
+		{
+			return;
+		}
+
+		m_TextureSlots.Bind();
+
 		glBindVertexArray(m_VertexArrayId);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+		glDrawArraysInstancedBaseInstance(
+			GL_TRIANGLE_STRIP, 0, 4,
+			static_cast<GLsizei>(m_Cursor - m_BatchBegin),
+			static_cast<GLuint>(m_BatchBegin)
+		);
+
+		m_BatchBegin = m_Cursor;
+		m_TextureSlots.Clear();
+	}
+
+	size_t TextureRenderer::GetTextureSlotCount() const
+	{
+		return m_TextureSlots.GetCapacity();
+	}
+
+	void TextureRenderer::AdvanceSection()
+	{
+		// Draw what's left in the current section and mark the point at which the GPU is done reading it
+		Flush();
+		m_SectionFences[m_Section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_Section = (m_Section + 1) % SectionCount;
+
+		// Wait until the GPU is done with the section we're about to overwrite
+		if (GLsync& fence = m_SectionFences[m_Section]; fence != nullptr)
+		{
+			while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000) == GL_TIMEOUT_EXPIRED)
+			{
+			}
+
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		m_BatchBegin = m_Section * m_SectionCapacity;
+		m_Cursor = m_BatchBegin;
 	}
 
-	TextureRenderer::TextureRenderer(const GLuint vertexArrayId, const GLuint positionBufferId, const GLuint texCoordBufferId, const GLuint indexBufferId):
+	TextureRenderer::TextureRenderer(
+		const GLuint vertexArrayId,
+		const GLuint instanceBufferId,
+		SpriteInstance* mappedInstances,
+		const size_t maxSprites,
+		const size_t maxTextureSlots
+	):
 		m_VertexArrayId(vertexArrayId),
-		m_PositionBufferId(positionBufferId),
-		m_TexCoordBufferId(texCoordBufferId),
-		m_IndexBufferId(indexBufferId)
+		m_InstanceBufferId(instanceBufferId),
+		m_MappedInstances(mappedInstances),
+		m_SectionCapacity(maxSprites),
+		m_Section(0),
+		m_BatchBegin(0),
+		m_Cursor(0),
+		m_SectionFences{},
+		m_TextureSlots(maxTextureSlots)
 	{
 	}
 }
\ No newline at end of file
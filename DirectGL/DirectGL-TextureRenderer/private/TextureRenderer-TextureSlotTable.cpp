@@ -0,0 +1,67 @@
+﻿module;
+
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <optional>
+
+module DirectGL.TextureRenderer;
+
+namespace DGL::TextureRenderer
+{
+	TextureSlotTable::TextureSlotTable(const size_t capacity):
+		m_Capacity(std::clamp<size_t>(capacity, 1, MaxSlotCount))
+	{
+		m_TextureIds.reserve(m_Capacity);
+	}
+
+	std::optional<uint32_t> TextureSlotTable::Acquire(const GLuint textureId)
+	{
+		// Most batches reuse the texture of the previous quad, so we search backwards
+		for (size_t i = m_TextureIds.size(); i-- > 0;)
+		{
+			if (m_TextureIds[i] == textureId)
+			{
+				return static_cast<uint32_t>(i);
+			}
+		}
+
+		if (m_TextureIds.size() == m_Capacity)
+		{
+			return std::nullopt;
+		}
+
+		m_TextureIds.push_back(textureId);
+		return static_cast<uint32_t>(m_TextureIds.size() - 1);
+	}
+
+	void TextureSlotTable::Bind() const
+	{
+		if (not m_TextureIds.empty())
+		{
+			glBindTextures(0, static_cast<GLsizei>(m_TextureIds.size()), m_TextureIds.data());
+		}
+	}
+
+	void TextureSlotTable::Clear()
+	{
+		m_TextureIds.clear();
+	}
+
+	size_t TextureSlotTable::GetSize() const
+	{
+		return m_TextureIds.size();
+	}
+
+	size_t TextureSlotTable::GetCapacity() const
+	{
+		return m_Capacity;
+	}
+
+	size_t TextureSlotTable::QueryMaxCapacity()
+	{
+		GLint maxTextureImageUnits = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureImageUnits);
+		return std::clamp<size_t>(static_cast<size_t>(std::max(maxTextureImageUnits, 1)), 1, MaxSlotCount);
+	}
+}
\ No newline at end of file
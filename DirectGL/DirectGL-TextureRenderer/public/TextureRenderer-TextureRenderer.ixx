@@ -5,38 +5,81 @@
 
 module;
 
-#include <Glad/gl.h>
+#include <glad/gl.h>
 
+#include <array>
 #include <memory>
 
 export module DirectGL.TextureRenderer:TextureRenderer;
 
+import :TextureSlotTable;
+
 export namespace DGL::TextureRenderer
 {
+	/// A single textured quad. The vertex shader expands every instance into
+	/// a unit quad which is mapped onto the screen using the affine transform.
+	struct SpriteInstance
+	{
+		float M00, M01, M02;		//!< First row of the affine transform applied to the unit quad
+		float M10, M11, M12;		//!< Second row of the affine transform applied to the unit quad
+		float U0, V0, U1, V1;		//!< The texture coordinates of the top-left and bottom-right corner
+		float Depth;				//!< The depth of the sprite
+		uint8_t R, G, B, A;			//!< The color every texel gets multiplied with
+		uint32_t TextureSlot;		//!< The texture unit to sample from (assigned by the renderer)
+	};
+
 	class TextureRenderer
 	{
 	public:
 
-		static std::unique_ptr<TextureRenderer> Create();
+		/// @brief Create a new texture renderer.
+		/// @param maxSprites The maximum number of sprites per section of the streaming buffer.
+		/// @param maxTextureSlots The maximum number of distinct textures per batch.
+		/// @return The texture renderer or nullptr if the streaming buffer couldn't be mapped.
+		static std::unique_ptr<TextureRenderer> Create(size_t maxSprites, size_t maxTextureSlots);
 
 		~TextureRenderer();
 
-		void Render(float left, float top, float width, float height, float depth);
+		/// @brief Queue a sprite. Sprites are written straight into a persistently mapped
+		///		   buffer and accumulated until Flush() gets called, a section of the buffer
+		///		   is full or the batch runs out of texture slots. In the latter cases the
+		///		   pending sprites get drawn using the currently bound shader program.
+		/// @param textureId The renderer id of the texture to sample from.
+		/// @param instance The sprite to draw.
+		void Submit(GLuint textureId, const SpriteInstance& instance);
+
+		/// @brief Draw all pending sprites using a single instanced draw call.
+		void Flush();
+
+		size_t GetTextureSlotCount() const;
 
 	private:
 
+		/// The streaming buffer gets split into sections, each guarded by a fence,
+		/// so the CPU can fill one section while the GPU still reads the others.
+		static constexpr size_t SectionCount = 3;
+
 		explicit TextureRenderer(
 			GLuint vertexArrayId,
-			GLuint positionBufferId,
-			GLuint texCoordBufferId,
-			GLuint indexBufferId
+			GLuint instanceBufferId,
+			SpriteInstance* mappedInstances,
+			size_t maxSprites,
+			size_t maxTextureSlots
 		);
 
+		void AdvanceSection();
 
 		GLuint m_VertexArrayId;
-		GLuint m_PositionBufferId;
-		GLuint m_TexCoordBufferId;
-		GLuint m_IndexBufferId;
+		GLuint m_InstanceBufferId;
+		SpriteInstance* m_MappedInstances;
+
+		size_t m_SectionCapacity;
+		size_t m_Section;
+		size_t m_BatchBegin;
+		size_t m_Cursor;
+		std::array<GLsync, SectionCount> m_SectionFences;
+
+		TextureSlotTable m_TextureSlots;
 
 	};
 }
\ No newline at end of file
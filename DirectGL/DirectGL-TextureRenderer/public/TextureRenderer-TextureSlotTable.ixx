@@ -0,0 +1,58 @@
+﻿// Project Name : DirectGL-TextureRenderer
+// File Name    : TextureRenderer-TextureSlotTable.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <glad/gl.h>
+
+#include <optional>
+#include <vector>
+
+export module DirectGL.TextureRenderer:TextureSlotTable;
+
+export namespace DGL::TextureRenderer
+{
+	/// The TextureSlotTable assigns the textures of a single batch to
+	/// consecutive texture units. A texture that is already part of the
+	/// table keeps its slot, so any number of quads may share a texture
+	/// without consuming additional units.
+	class TextureSlotTable
+	{
+	public:
+
+		/// The maximum number of slots a table can hold. This matches the
+		/// size of the sampler array declared by the texture brush shader.
+		static constexpr size_t MaxSlotCount = 32;
+
+		/// @brief Create a new table with the given number of slots.
+		/// @param capacity The number of texture units available per batch.
+		explicit TextureSlotTable(size_t capacity);
+
+		/// @brief Get the slot of a texture, assigning the next free slot if the
+		///		   texture is not yet part of the table.
+		/// @param textureId The renderer id of the texture.
+		/// @return The slot index of the texture or std::nullopt if the table is full.
+		std::optional<uint32_t> Acquire(GLuint textureId);
+
+		/// @brief Bind all textures of the table to their texture units.
+		void Bind() const;
+
+		/// @brief Remove all textures from the table.
+		void Clear();
+
+		size_t GetSize() const;
+		size_t GetCapacity() const;
+
+		/// @brief Query the number of texture units usable by the fragment shader.
+		/// @return GL_MAX_TEXTURE_IMAGE_UNITS clamped to MaxSlotCount.
+		static size_t QueryMaxCapacity();
+
+	private:
+
+		std::vector<GLuint> m_TextureIds;
+		size_t m_Capacity;
+
+	};
+}
\ No newline at end of file
@@ -5,4 +5,5 @@
 
 export module DirectGL.TextureRenderer;
 
-export import :TextureRenderer;
\ No newline at end of file
+export import :TextureRenderer;
+export import :TextureSlotTable;
\ No newline at end of file
@@ -30,6 +30,14 @@ project("Context")
 			"private/Win32/Context-WGLContext.cpp",
 		})
 
+	filter("system:linux")
+		defines({ "CONTEXT_PLATFORM_HEADLESS" })
+		files({
+			"public/Headless/Context-HeadlessEGLContext.ixx",
+			"private/Headless/Context-HeadlessEGLContext.cpp",
+		})
+		links({ "EGL" })
+
 	filter("configurations:Debug")
 		runtime("Debug")
 		symbols("On")
@@ -3,8 +3,9 @@
 #ifdef CONTEXT_PLATFORM_WINDOWS
 import :WGLContext;
 using ContextImpl = System::WGLContext;
-#else
-// TODO(Felix): Add other platform implementations
+#elif defined(CONTEXT_PLATFORM_HEADLESS)
+import :HeadlessEGLContext;
+using ContextImpl = System::HeadlessEGLContext;
 #endif
 
 namespace System
@@ -0,0 +1,225 @@
+﻿module;
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <glad/gl.h>
+
+#include <array>
+#include <format>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+module System.Context;
+
+namespace System
+{
+	static EGLDisplay GetHeadlessDisplay()
+	{
+		// The surfaceless platform works without X11, Wayland or a DRM device
+		const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		if (getPlatformDisplay != nullptr)
+		{
+			if (const EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr); display != EGL_NO_DISPLAY)
+			{
+				return display;
+			}
+		}
+
+		return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+
+	std::unique_ptr<HeadlessEGLContext> HeadlessEGLContext::Create(const ContextSettings& settings)
+	{
+		// Lambda to log errors if a callback is provided
+		const auto logError = [&settings](const std::string_view message)
+		{
+			if (settings.OnError)
+			{
+				settings.OnError(message);
+			}
+		};
+
+		if (settings.FramebufferSize.X == 0 or settings.FramebufferSize.Y == 0)
+		{
+			logError("A headless OpenGL context requires a framebuffer size of at least 1x1 pixels.");
+			return nullptr;
+		}
+
+		const EGLDisplay display = GetHeadlessDisplay();
+		if (display == EGL_NO_DISPLAY)
+		{
+			logError("Failed to get an EGL display.");
+			return nullptr;
+		}
+
+		EGLint majorVersion = 0, minorVersion = 0;
+		if (not eglInitialize(display, &majorVersion, &minorVersion))
+		{
+			logError(std::format("Failed to initialize the EGL display (error 0x{:X}).", eglGetError()));
+			return nullptr;
+		}
+
+		// From here on the destructor releases whatever has been created
+		auto context = std::unique_ptr<HeadlessEGLContext>(new HeadlessEGLContext(display, settings.OnError));
+
+		if (not eglBindAPI(EGL_OPENGL_API))
+		{
+			logError("The EGL implementation doesn't support desktop OpenGL.");
+			return nullptr;
+		}
+
+		constexpr std::array configAttributes = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE, 8,
+			EGL_GREEN_SIZE, 8,
+			EGL_BLUE_SIZE, 8,
+			EGL_ALPHA_SIZE, 8,
+			EGL_DEPTH_SIZE, 24,
+			EGL_STENCIL_SIZE, 8,
+			EGL_NONE
+		};
+
+		EGLConfig config = nullptr;
+		EGLint numConfigs = 0;
+		if (not eglChooseConfig(display, configAttributes.data(), &config, 1, &numConfigs) or numConfigs == 0)
+		{
+			logError("No suitable EGL config found for a pbuffer surface.");
+			return nullptr;
+		}
+
+		const std::array surfaceAttributes = {
+			EGL_WIDTH, static_cast<EGLint>(settings.FramebufferSize.X),
+			EGL_HEIGHT, static_cast<EGLint>(settings.FramebufferSize.Y),
+			EGL_NONE
+		};
+
+		context->m_Surface = eglCreatePbufferSurface(display, config, surfaceAttributes.data());
+		if (context->m_Surface == EGL_NO_SURFACE)
+		{
+			logError(std::format("Failed to create a {}x{} pbuffer surface.", settings.FramebufferSize.X, settings.FramebufferSize.Y));
+			return nullptr;
+		}
+
+		std::vector<EGLint> contextAttributes;
+		contextAttributes.append_range(std::array{ EGL_CONTEXT_MAJOR_VERSION, settings.MajorVersion });
+		contextAttributes.append_range(std::array{ EGL_CONTEXT_MINOR_VERSION, settings.MinorVersion });
+		contextAttributes.append_range(std::array{ EGL_CONTEXT_OPENGL_PROFILE_MASK, settings.IsCompatibilityContext ? EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT : EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT });
+		if (settings.IsDebuggingContext) { contextAttributes.append_range(std::array{ EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE }); }
+		contextAttributes.push_back(EGL_NONE);
+
+		context->m_Config = config;
+		context->m_ContextAttributes = contextAttributes;
+		context->m_RenderingContext = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes.data());
+		if (context->m_RenderingContext == EGL_NO_CONTEXT)
+		{
+			logError(std::format("Failed to create an OpenGL {}.{} rendering context.", settings.MajorVersion, settings.MinorVersion));
+			return nullptr;
+		}
+
+		if (not eglMakeCurrent(display, context->m_Surface, context->m_Surface, context->m_RenderingContext))
+		{
+			logError("Failed to activate the OpenGL rendering context.");
+			return nullptr;
+		}
+
+		return context;
+	}
+
+	HeadlessEGLContext::~HeadlessEGLContext()
+	{
+		if (m_RenderingContext != EGL_NO_CONTEXT)
+		{
+			// Only release the context if it's the current one
+			if (eglGetCurrentContext() == m_RenderingContext)
+			{
+				if (not eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT))
+				{
+					LogError("Failed to release the current OpenGL rendering context.");
+				}
+			}
+
+			if (not eglDestroyContext(m_Display, m_RenderingContext))
+			{
+				LogError("Failed to delete the OpenGL rendering context.");
+			}
+		}
+
+		if (m_Surface != EGL_NO_SURFACE)
+		{
+			eglDestroySurface(m_Display, m_Surface);
+		}
+
+		if (m_OwnsDisplay)
+		{
+			eglTerminate(m_Display);
+		}
+	}
+
+	void HeadlessEGLContext::SetVerticalSyncEnabled(bool)
+	{
+		// A pbuffer is never presented, so there is no refresh to wait for
+	}
+
+	void HeadlessEGLContext::Flush()
+	{
+		// Swapping a pbuffer has no effect, this only submits the commands of the frame
+		glFlush();
+	}
+
+	std::unique_ptr<Context> HeadlessEGLContext::CreateSharedContext()
+	{
+		auto context = std::unique_ptr<HeadlessEGLContext>(new HeadlessEGLContext(m_Display, m_OnError));
+		context->m_OwnsDisplay = false;
+		context->m_Config = m_Config;
+		context->m_ContextAttributes = m_ContextAttributes;
+
+		context->m_RenderingContext = eglCreateContext(m_Display, m_Config, m_RenderingContext, m_ContextAttributes.data());
+		if (context->m_RenderingContext == EGL_NO_CONTEXT)
+		{
+			LogError(std::format("Failed to create a shared OpenGL rendering context (error 0x{:X}).", eglGetError()));
+			return nullptr;
+		}
+
+		return context;
+	}
+
+	bool HeadlessEGLContext::MakeCurrent()
+	{
+		// The bound API is a state of the calling thread
+		if (not eglBindAPI(EGL_OPENGL_API) or not eglMakeCurrent(m_Display, m_Surface, m_Surface, m_RenderingContext))
+		{
+			LogError(std::format("Failed to activate the OpenGL rendering context (error 0x{:X}).", eglGetError()));
+			return false;
+		}
+
+		return true;
+	}
+
+	void HeadlessEGLContext::ReleaseCurrent()
+	{
+		if (eglGetCurrentContext() == m_RenderingContext and not eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT))
+		{
+			LogError("Failed to release the current OpenGL rendering context.");
+		}
+	}
+
+	HeadlessEGLContext::HeadlessEGLContext(const EGLDisplay display, const std::function<void(std::string_view)>& onError):
+		m_Display(display),
+		m_Surface(EGL_NO_SURFACE),
+		m_RenderingContext(EGL_NO_CONTEXT),
+		m_Config(nullptr),
+		m_OwnsDisplay(true),
+		m_OnError(onError)
+	{
+	}
+
+	void HeadlessEGLContext::LogError(const std::string_view message) const
+	{
+		if (m_OnError)
+		{
+			m_OnError(message);
+		}
+	}
+}
\ No newline at end of file
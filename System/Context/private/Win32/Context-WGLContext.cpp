@@ -203,7 +203,7 @@ namespace System
 			return nullptr;
 		}
 
-		return std::unique_ptr<WGLContext>(new WGLContext(deviceContext, renderContext, windowHandle, settings.OnError));
+		return std::unique_ptr<WGLContext>(new WGLContext(deviceContext, renderContext, windowHandle, contextAttributes, settings.OnError));
 	}
 
 	WGLContext::~WGLContext()
@@ -251,10 +251,51 @@ namespace System
 		SwapBuffers(m_DeviceContext);
 	}
 
-	WGLContext::WGLContext(const HDC deviceContext, const HGLRC renderingContext, const NativeWindowHandle parentHandle, const std::function<void(std::string_view)>& onError):
+	std::unique_ptr<Context> WGLContext::CreateSharedContext()
+	{
+		// The pixel format of the window has been set already, every context of the window uses it
+		const HDC deviceContext = GetDC(m_ParentHandle);
+		if (deviceContext == nullptr)
+		{
+			LogError("Failed to get device context from parent window.");
+			return nullptr;
+		}
+
+		const HGLRC renderContext = wglCreateContextAttribsARB(deviceContext, m_RenderingContext, m_ContextAttributes.data());
+		if (renderContext == nullptr)
+		{
+			LogError("Failed to create a shared OpenGL rendering context.");
+			ReleaseDC(m_ParentHandle, deviceContext);
+			return nullptr;
+		}
+
+		return std::unique_ptr<WGLContext>(new WGLContext(deviceContext, renderContext, m_ParentHandle, m_ContextAttributes, m_OnError));
+	}
+
+	bool WGLContext::MakeCurrent()
+	{
+		if (not wglMakeCurrent(m_DeviceContext, m_RenderingContext))
+		{
+			LogError("Failed to activate the OpenGL rendering context.");
+			return false;
+		}
+
+		return true;
+	}
+
+	void WGLContext::ReleaseCurrent()
+	{
+		if (wglGetCurrentContext() == m_RenderingContext and not wglMakeCurrent(nullptr, nullptr))
+		{
+			LogError("Failed to release the current OpenGL rendering context.");
+		}
+	}
+
+	WGLContext::WGLContext(const HDC deviceContext, const HGLRC renderingContext, const NativeWindowHandle parentHandle, const std::vector<int>& contextAttributes, const std::function<void(std::string_view)>& onError):
 		m_DeviceContext(deviceContext),
 		m_RenderingContext(renderingContext),
 		m_ParentHandle(parentHandle),
+		m_ContextAttributes(contextAttributes),
 		m_OnError(onError)
 	{
 	}
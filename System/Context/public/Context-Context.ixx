@@ -6,6 +6,7 @@ module;
 
 export module System.Context:Context;
 
+import DirectGL.Math;
 import System.Window;
 
 namespace System
@@ -16,6 +17,14 @@ namespace System
 
 		virtual void SetVerticalSyncEnabled(bool enabled) = 0;
 		virtual void Flush() = 0;
+
+		/// @brief Create a context sharing the textures, buffers, samplers and shaders of this one.
+		///		   It isn't current on any thread and has no framebuffer of its own to present.
+		virtual std::unique_ptr<Context> CreateSharedContext() = 0;
+
+		/// @brief Make the context current on the calling thread. It must not be current on another thread.
+		virtual bool MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
 	};
 
 	export struct ContextSettings
@@ -25,6 +34,7 @@ namespace System
 		bool IsDebuggingContext;
 		bool IsCompatibilityContext;
 		NativeWindowHandle ParentWindow;
+		DGL::Math::Uint2 FramebufferSize;	//!< The size of the default framebuffer of contexts without a window
 
 		std::function<void(std::string_view)> OnError;
 	};
@@ -2,6 +2,8 @@ export module System.Context;
 
 #ifdef CONTEXT_PLATFORM_WINDOWS
 import :WGLContext;
+#elif defined(CONTEXT_PLATFORM_HEADLESS)
+import :HeadlessEGLContext;
 #endif
 
 export import :Context;
\ No newline at end of file
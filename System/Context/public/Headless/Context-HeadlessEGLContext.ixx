@@ -0,0 +1,58 @@
+﻿// Project Name : Context
+// File Name    : Context-HeadlessEGLContext.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <EGL/egl.h>
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+export module System.Context:HeadlessEGLContext;
+
+import :Context;
+
+namespace System
+{
+	/// An OpenGL context that needs neither a window nor a display server. It prefers
+	/// Mesa's surfaceless EGL platform, which falls back to the llvmpipe software
+	/// rasterizer on machines without a GPU. The default framebuffer is a pbuffer
+	/// with the fixed size requested in ContextSettings::FramebufferSize.
+	class HeadlessEGLContext : public Context
+	{
+	public:
+
+		static std::unique_ptr<HeadlessEGLContext> Create(const ContextSettings& settings);
+
+		~HeadlessEGLContext() override;
+
+		void SetVerticalSyncEnabled(bool enabled) override;
+		void Flush() override;
+
+		/// @brief Create a context sharing the objects of this one. It renders without
+		///		   a surface, which requires EGL_KHR_surfaceless_context.
+		std::unique_ptr<Context> CreateSharedContext() override;
+		bool MakeCurrent() override;
+		void ReleaseCurrent() override;
+
+	private:
+
+		explicit HeadlessEGLContext(EGLDisplay display, const std::function<void(std::string_view)>& onError);
+
+		void LogError(std::string_view message) const;
+
+		EGLDisplay m_Display;
+		EGLSurface m_Surface;
+		EGLContext m_RenderingContext;
+		EGLConfig m_Config;
+		std::vector<EGLint> m_ContextAttributes;	//!< The attributes the context has been created with, shared contexts reuse them
+		bool m_OwnsDisplay;							//!< Shared contexts leave the termination of the display to the context they share with
+
+		std::function<void(std::string_view)> m_OnError;
+
+	};
+}
\ No newline at end of file
@@ -8,6 +8,7 @@ module;
 #include <Windows.h>
 
 #include <string_view>
+#include <vector>
 
 export module System.Context:WGLContext;
 
@@ -28,15 +29,20 @@ namespace System
 		void SetVerticalSyncEnabled(bool enabled) override;
 		void Flush() override;
 
+		std::unique_ptr<Context> CreateSharedContext() override;
+		bool MakeCurrent() override;
+		void ReleaseCurrent() override;
+
 	private:
 
-		explicit WGLContext(HDC deviceContext, HGLRC renderingContext, NativeWindowHandle parentHandle, const std::function<void(std::string_view)>& onError);
+		explicit WGLContext(HDC deviceContext, HGLRC renderingContext, NativeWindowHandle parentHandle, const std::vector<int>& contextAttributes, const std::function<void(std::string_view)>& onError);
 
 		void LogError(std::string_view message) const;
 
 		HDC m_DeviceContext;
 		HGLRC m_RenderingContext;
 		NativeWindowHandle m_ParentHandle;
+		std::vector<int> m_ContextAttributes;	//!< The attributes the context has been created with, shared contexts reuse them
 
 		std::function<void(std::string_view)> m_OnError;
 
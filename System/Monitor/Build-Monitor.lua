@@ -28,6 +28,13 @@ project("Monitor")
 			"private/Win32/Monitor-Win32MonitorProvider.cpp",
 		})
 
+	filter("system:linux")
+		defines({ "PLATFORM_HEADLESS" })
+		files({
+			"public/Headless/Monitor-HeadlessMonitorProvider.ixx",
+			"private/Headless/Monitor-HeadlessMonitorProvider.cpp",
+		})
+
 	filter("configurations:Debug")
 		runtime("Debug")
 		symbols("On")
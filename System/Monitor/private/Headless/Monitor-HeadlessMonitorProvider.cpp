@@ -0,0 +1,31 @@
+module;
+
+#include <optional>
+#include <vector>
+
+module System.Monitor;
+
+namespace System
+{
+	static Monitor CreateVirtualMonitor()
+	{
+		const DGL::Math::IntBoundary area = DGL::Math::IntBoundary::FromLTWH(0, 0, 1920, 1080);
+
+		return Monitor{
+			.Name = "Headless",
+			.WorkArea = area,
+			.Area = area,
+			.IsPrimary = true
+		};
+	}
+
+	std::optional<Monitor> HeadlessMonitorProvider::GetPrimaryMonitor() const
+	{
+		return CreateVirtualMonitor();
+	}
+
+	std::vector<Monitor> HeadlessMonitorProvider::GetAvailableMonitors() const
+	{
+		return { CreateVirtualMonitor() };
+	}
+}
\ No newline at end of file
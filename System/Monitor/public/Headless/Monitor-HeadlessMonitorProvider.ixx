@@ -0,0 +1,14 @@
+export module System.Monitor:HeadlessMonitorProvider;
+
+import :MonitorProvider;
+
+namespace System
+{
+	/// Reports a single virtual full HD monitor on machines without a display server,
+	/// so code positioning windows relative to a monitor keeps working.
+	export struct HeadlessMonitorProvider : MonitorProvider
+	{
+		[[nodiscard]] std::optional<Monitor> GetPrimaryMonitor() const override;
+		[[nodiscard]] std::vector<Monitor> GetAvailableMonitors() const override;
+	};
+}
\ No newline at end of file
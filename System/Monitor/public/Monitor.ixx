@@ -6,4 +6,6 @@ export import :MonitorProviderCache;
 
 #ifdef PLATFORM_WINDOWS
 export import :Win32MonitorProvider;
+#elif defined(PLATFORM_HEADLESS)
+export import :HeadlessMonitorProvider;
 #endif
\ No newline at end of file
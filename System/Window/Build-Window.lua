@@ -26,6 +26,13 @@ project("Window")
 			"private/Win32/Window-Win32Window.cpp",
 		})
 
+	filter("system:linux")
+		defines({ "WINDOW_PLATFORM_HEADLESS" })
+		files({
+			"public/Headless/Window-HeadlessWindow.ixx",
+			"private/Headless/Window-HeadlessWindow.cpp",
+		})
+
 	filter("configurations:Debug")
 		runtime("Debug")
 		symbols("On")
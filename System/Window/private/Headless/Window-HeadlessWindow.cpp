@@ -0,0 +1,142 @@
+﻿module;
+
+#include <chrono>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+module System.Window;
+
+namespace System
+{
+	std::unique_ptr<HeadlessWindow> HeadlessWindow::Create(const CreateWindowProperties& properties)
+	{
+		if (properties.Size.X == 0 or properties.Size.Y == 0)
+		{
+			if (properties.OnError)
+			{
+				properties.OnError("A headless window requires a size of at least 1x1 pixels.");
+			}
+
+			return nullptr;
+		}
+
+		return std::unique_ptr<HeadlessWindow>(new HeadlessWindow(properties));
+	}
+
+	std::optional<WindowEvent> HeadlessWindow::PollEvent()
+	{
+		return std::nullopt;
+	}
+
+	std::optional<WindowEvent> HeadlessWindow::WaitEvent(const std::chrono::milliseconds timeout)
+	{
+		std::unique_lock lock(m_WakeMutex);
+		const auto isWakeRequested = [this] { return m_IsWakeRequested; };
+
+		if (timeout == std::chrono::milliseconds::max())
+		{
+			m_WakeUp.wait(lock, isWakeRequested);
+		}
+		else
+		{
+			m_WakeUp.wait_for(lock, timeout, isWakeRequested);
+		}
+
+		m_IsWakeRequested = false;
+		return std::nullopt;
+	}
+
+	void HeadlessWindow::Wake()
+	{
+		{
+			std::scoped_lock lock(m_WakeMutex);
+			m_IsWakeRequested = true;
+		}
+
+		m_WakeUp.notify_one();
+	}
+
+	void HeadlessWindow::SetPosition(const DGL::Math::Int2& position)
+	{
+		m_Position = position;
+	}
+
+	DGL::Math::Int2 HeadlessWindow::GetPosition() const
+	{
+		return m_Position;
+	}
+
+	void HeadlessWindow::SetSize(const DGL::Math::Uint2& size)
+	{
+		if (size != m_Size)
+		{
+			LogError(std::format("The size of a headless window is fixed at {}x{} pixels.", m_Size.X, m_Size.Y));
+		}
+	}
+
+	DGL::Math::Uint2 HeadlessWindow::GetSize() const
+	{
+		return m_Size;
+	}
+
+	void HeadlessWindow::SetTitle(const std::string_view title)
+	{
+		m_Title = title;
+	}
+
+	std::string HeadlessWindow::GetTitle() const
+	{
+		return m_Title;
+	}
+
+	void HeadlessWindow::SetVisible(const bool visibility)
+	{
+		m_IsVisible = visibility;
+	}
+
+	bool HeadlessWindow::IsVisible() const
+	{
+		return m_IsVisible;
+	}
+
+	void HeadlessWindow::SetResizable(bool)
+	{
+	}
+
+	bool HeadlessWindow::IsResizable() const
+	{
+		return false;
+	}
+
+	bool HeadlessWindow::RequestFocus() const
+	{
+		return false;
+	}
+
+	NativeWindowHandle HeadlessWindow::GetNativeHandle() const
+	{
+		return nullptr;
+	}
+
+	HeadlessWindow::HeadlessWindow(const CreateWindowProperties& properties):
+		m_Size(properties.Size),
+		m_Position(properties.Position),
+		m_Title(properties.Title),
+		m_IsVisible(properties.IsVisible),
+		m_OnError(properties.OnError),
+		m_IsWakeRequested(false)
+	{
+	}
+
+	void HeadlessWindow::LogError(const std::string_view error) const
+	{
+		if (m_OnError)
+		{
+			m_OnError(error);
+		}
+	}
+}
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <Windows.h>
 #include <windowsx.h>
 
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <string>
 #include <memory>
@@ -236,6 +238,38 @@ namespace System
 		return std::nullopt;
 	}
 
+	std::optional<WindowEvent> Win32Window::WaitEvent(const std::chrono::milliseconds timeout)
+	{
+		if (auto event = PollEvent())
+		{
+			return event;
+		}
+
+		// The message posted by Wake() may have been dispatched already
+		if (m_IsWakeRequested.exchange(false))
+		{
+			return std::nullopt;
+		}
+
+		const DWORD milliseconds = timeout == std::chrono::milliseconds::max()
+			? INFINITE
+			: static_cast<DWORD>(std::clamp<std::chrono::milliseconds::rep>(timeout.count(), 0, INFINITE - 1));
+
+		// Sleep until the thread receives any message. Messages that don't turn into
+		// an event, like the one posted by Wake(), end the wait as well.
+		MsgWaitForMultipleObjectsEx(0, nullptr, milliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+		return PollEvent();
+	}
+
+	void Win32Window::Wake()
+	{
+		m_IsWakeRequested = true;
+		if (not PostMessageW(m_Handle, WM_NULL, 0, 0))
+		{
+			LogError("Couldn't wake up the window.");
+		}
+	}
+
 	void Win32Window::SetPosition(const DGL::Math::Int2& size)
 	{
 		if (not SetWindowPos(m_Handle, nullptr, size.X, size.Y, 0, 0, SWP_NOSIZE | SWP_NOZORDER))
@@ -387,6 +421,7 @@ namespace System
 		m_OnError(properties.OnError),
 		m_IsResizing(false),
 		m_IsMouseInside(false),
+		m_IsWakeRequested(false),
 		m_HighSurrogate(0)
 	{
 		// Define window class
@@ -6,7 +6,8 @@ module System.Window;
 
 #ifdef WINDOW_PLATFORM_WINDOWS
 typedef System::Win32Window WindowImpl;
-#else
+#elif defined(WINDOW_PLATFORM_HEADLESS)
+typedef System::HeadlessWindow WindowImpl;
 #endif
 
 namespace System
@@ -0,0 +1,89 @@
+﻿// Project Name : Window
+// File Name    : Window-HeadlessWindow.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+export module System.Window:HeadlessWindow;
+
+import DirectGL.Math;
+
+import :NativeWindowHandle;
+import :Window;
+import :WindowEvent;
+
+namespace System
+{
+	/// Stands in for a window on machines without a display server. Nothing is
+	/// shown and no events arrive, the window only remembers its properties.
+	///
+	/// The default framebuffer of a headless context is created once with the size
+	/// of the window, which is why the size is fixed at creation. SetSize() only
+	/// reports an error instead of silently rendering into a smaller framebuffer.
+	class HeadlessWindow : public Window
+	{
+	public:
+
+		/// Create a new headless window with the specified properties.
+		///
+		/// @param properties Startup properties for the window.
+		/// 
+		/// @return A unique pointer to the created window.
+		static std::unique_ptr<HeadlessWindow> Create(const CreateWindowProperties& properties);
+
+		std::optional<WindowEvent> PollEvent() override;
+
+		/// No events arrive, so this only returns once the timeout expired or Wake() got called.
+		std::optional<WindowEvent> WaitEvent(std::chrono::milliseconds timeout) override;
+		void Wake() override;
+
+		void SetPosition(const DGL::Math::Int2& position) override;
+		DGL::Math::Int2 GetPosition() const override;
+
+		void SetSize(const DGL::Math::Uint2& size) override;
+		DGL::Math::Uint2 GetSize() const override;
+
+		void SetTitle(std::string_view title) override;
+		std::string GetTitle() const override;
+
+		void SetVisible(bool visibility) override;
+		bool IsVisible() const override;
+
+		void SetResizable(bool resizability) override;
+		bool IsResizable() const override;
+
+		bool RequestFocus() const override;
+
+		/// There is no native window, so this is always nullptr.
+		NativeWindowHandle GetNativeHandle() const override;
+
+	private:
+
+		explicit HeadlessWindow(const CreateWindowProperties& properties);
+
+		/// Log an error message
+		///
+		/// @param error The error message to log.
+		void LogError(std::string_view error) const;
+
+		DGL::Math::Uint2 m_Size;
+		DGL::Math::Int2 m_Position;
+		std::string m_Title;
+		bool m_IsVisible;
+		OnErrorCallback m_OnError;
+
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeUp;
+		bool m_IsWakeRequested;
+
+	};
+}
\ No newline at end of file
@@ -7,6 +7,8 @@ module;
 
 #include <Windows.h>
 
+#include <atomic>
+#include <chrono>
 #include <queue>
 
 export module System.Window:Win32Window;
@@ -36,6 +38,22 @@ namespace System
 		///			are pending.
 		std::optional<WindowEvent> PollEvent() override;
 
+		/// Wait for the next event of the window's event queue, putting the
+		/// calling thread to sleep until it arrives.
+		///
+		/// @param timeout The time after which to give up waiting,
+		///				   std::chrono::milliseconds::max() to wait without limit.
+		///
+		/// @return The next event, std::nullopt if the timeout expired or
+		///			Wake() has been called.
+		std::optional<WindowEvent> WaitEvent(std::chrono::milliseconds timeout) override;
+
+		/// End a running or the next call to WaitEvent() early by posting an
+		/// empty message to the window. May be called from any thread. The
+		/// request is remembered, as the message may be dispatched by a
+		/// PollEvent() before WaitEvent() starts sleeping.
+		void Wake() override;
+
 		/// Set the position of the window on the screen.
 		/// The coordinates are given in pixels, with
 		/// (0, 0) being the top-left corner of the screen.
@@ -141,6 +159,7 @@ namespace System
 
 		bool m_IsResizing;
 		bool m_IsMouseInside;
+		std::atomic<bool> m_IsWakeRequested;	//!< Set by Wake() until a WaitEvent() returns early because of it
 
 		WCHAR m_HighSurrogate;
 		DGL::Math::Uint2 m_LastSize;
@@ -5,6 +5,7 @@
 
 module;
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -38,6 +39,20 @@ namespace System
 		///			are pending.
 		virtual std::optional<WindowEvent> PollEvent() = 0;
 
+		/// Wait for the next event of the window's event queue, putting the
+		/// calling thread to sleep until it arrives.
+		///
+		/// @param timeout The time after which to give up waiting,
+		///				   std::chrono::milliseconds::max() to wait without limit.
+		///
+		/// @return The next event, std::nullopt if the timeout expired or
+		///			Wake() has been called.
+		virtual std::optional<WindowEvent> WaitEvent(std::chrono::milliseconds timeout) = 0;
+
+		/// End a running or the next call to WaitEvent() early. Unlike the other
+		/// functions this one may be called from any thread.
+		virtual void Wake() = 0;
+
 		/// Set the position of the window on the screen.
 		/// The coordinates are given in pixels, with
 		/// (0, 0) being the top-left corner of the screen.
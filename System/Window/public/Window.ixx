@@ -7,6 +7,8 @@ export module System.Window;
 
 #ifdef WINDOW_PLATFORM_WINDOWS
 import :Win32Window;
+#elif defined(WINDOW_PLATFORM_HEADLESS)
+import :HeadlessWindow;
 #endif
 
 export import :NativeWindowHandle;
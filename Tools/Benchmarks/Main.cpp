@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+import DirectGL;
+import DirectGL.Math;
+import DirectGL.RHI;
+import DirectGL.ShapeRenderer;
+import DirectGL.Texture;
+import DirectGL.TextureRenderer;
+import Jobs;
+
+/// Measures the numbers the renderer gets tuned by:
+///
+///  - The shapes and sprites per second the draw path tessellates and records, with
+///	   the GPU taken out by a recording device without a resource device.
+///  - How a parallel loop and small jobs scale with the workers of the job system.
+///  - The 4K texture updates per second streamed through Texture::BeginUpdate(),
+///	   for the whole texture and for a dirty band. This one opens a window.
+///
+/// Usage: Benchmarks [--cpu-only]
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t ShapesPerFrame = 100'000;
+
+	double GetSeconds(const Clock::duration duration)
+	{
+		return std::chrono::duration<double>(duration).count();
+	}
+
+	/// @brief Run a body repeatedly for a while, after running it once to warm the caches up.
+	/// @return The runs per second.
+	double MeasureRate(const std::function<void()>& body, const Clock::duration duration = std::chrono::milliseconds(500))
+	{
+		body();
+
+		uint64_t runs = 0;
+		const auto start = Clock::now();
+
+		do
+		{
+			body();
+			++runs;
+		} while (Clock::now() - start < duration);
+
+		return static_cast<double>(runs) / GetSeconds(Clock::now() - start);
+	}
+
+	/// A linear congruential generator, so every run draws the same shapes.
+	struct ShapeRandom
+	{
+		uint32_t State = 1;
+
+		float Next(const float maximum)
+		{
+			State = State * 1664525u + 1013904223u;
+			return static_cast<float>(State >> 8) / static_cast<float>(1u << 24) * maximum;
+		}
+	};
+
+	std::vector<DGL::ShapeRenderer::Shape> CreateShapes(const DGL::ShapeRenderer::ShapeKind kind)
+	{
+		using namespace DGL;
+
+		ShapeRandom random;
+		std::vector<ShapeRenderer::Shape> shapes;
+		shapes.reserve(ShapesPerFrame);
+
+		for (size_t i = 0; i < ShapesPerFrame; ++i)
+		{
+			const Math::FloatBoundary boundary = Math::FloatBoundary::FromLTWH(random.Next(1920.0f), random.Next(1080.0f), 4.0f + random.Next(60.0f), 4.0f + random.Next(60.0f));
+			const Math::Float2 center = { boundary.Left, boundary.Top };
+			const Math::Radius radius = Math::Radius::Elliptical(boundary.Width, boundary.Height);
+
+			switch (kind)
+			{
+				case ShapeRenderer::ShapeKind::FilledRectangle: shapes.push_back(ShapeRenderer::Shape::FilledRectangle(boundary, 0.0f)); break;
+				case ShapeRenderer::ShapeKind::OutlinedRectangle: shapes.push_back(ShapeRenderer::Shape::OutlinedRectangle(boundary, 2.0f, 0.0f)); break;
+				case ShapeRenderer::ShapeKind::FilledEllipse: shapes.push_back(ShapeRenderer::Shape::FilledEllipse(center, radius, 32, 0.0f)); break;
+				case ShapeRenderer::ShapeKind::OutlinedEllipse: shapes.push_back(ShapeRenderer::Shape::OutlinedEllipse(center, radius, 32, 2.0f, 0.0f)); break;
+				case ShapeRenderer::ShapeKind::FilledTriangle: shapes.push_back(ShapeRenderer::Shape::FilledTriangle(center, center + Math::Float2(radius.X, 0.0f), center + Math::Float2(0.0f, radius.Y), 0.0f)); break;
+			}
+		}
+
+		return shapes;
+	}
+
+	/// @brief Tessellate and record a frame of shapes the way the renderer facade flushes them.
+	/// @return The bytes a backend would have to upload for the frame.
+	uint64_t RecordShapes(DGL::RHI::RecordingDevice& device, DGL::ShapeRenderer::TessellationBatch& batch, const std::span<const DGL::ShapeRenderer::Shape> shapes, Jobs::JobSystem* jobSystem)
+	{
+		using namespace DGL;
+
+		device.BeginPass(device.GetDefaultRenderTarget());
+		device.SetPipeline(device.GetPipeline({ .Kind = RHI::PipelineKind::SolidColor }));
+		device.SetConstants({});
+
+		for (const ShapeRenderer::Shape& shape : shapes)
+		{
+			batch.Add(shape);
+		}
+
+		batch.Tessellate(jobSystem);
+		device.UploadVertices(batch.GetPositions(), batch.GetIndices());
+
+		for (size_t i = 0; i < batch.GetShapeCount(); ++i)
+		{
+			device.DrawVertexRange({
+				.FirstVertex = static_cast<uint32_t>(batch.GetFirstVertex(i)),
+				.VertexCount = static_cast<uint32_t>(batch.GetPositions(i).size()),
+				.FirstIndex = static_cast<uint32_t>(batch.GetFirstIndex(i)),
+				.IndexCount = static_cast<uint32_t>(batch.GetIndices(i).size()),
+				.Type = batch.GetType(i),
+			});
+		}
+
+		const uint64_t uploadedBytes = device.GetCommands().GetStatistics().UploadedBytes;
+
+		// Keep the memory of the batch and the list for the next frame, like the renderer does
+		batch.Clear();
+		device.Clear();
+		return uploadedBytes;
+	}
+
+	/// @brief Record a frame of sprites. They refer to a texture handle that never gets resolved.
+	/// @return The bytes a backend would have to upload for the frame.
+	uint64_t RecordSprites(DGL::RHI::RecordingDevice& device, const std::span<const DGL::TextureRenderer::SpriteInstance> sprites)
+	{
+		using namespace DGL;
+
+		device.BeginPass(device.GetDefaultRenderTarget());
+		device.SetPipeline(device.GetPipeline({ .Kind = RHI::PipelineKind::Sprite }));
+		device.SetConstants({});
+
+		for (const TextureRenderer::SpriteInstance& sprite : sprites)
+		{
+			device.DrawSprite({ 1 }, sprite);
+		}
+
+		device.FlushSprites();
+
+		const uint64_t uploadedBytes = device.GetCommands().GetStatistics().UploadedBytes;
+		device.Clear();
+		return uploadedBytes;
+	}
+
+	void RunDrawPathBenchmark(Jobs::JobSystem& jobSystem)
+	{
+		using namespace DGL;
+
+		std::cout << std::format("Draw path, {} shapes per frame recorded without a GPU\n", ShapesPerFrame);
+		std::cout << std::format("  {:<20} {:>16} {:>16} {:>14}\n", "Shape", "Serial/s", "Parallel/s", "Bytes/shape");
+
+		const auto device = RHI::RecordingDevice::Create(nullptr, { 1920, 1080 });
+		ShapeRenderer::TessellationBatch batch;
+
+		const auto measureShapes = [&](const std::string_view name, const ShapeRenderer::ShapeKind kind)
+		{
+			const std::vector<ShapeRenderer::Shape> shapes = CreateShapes(kind);
+			const uint64_t uploadedBytes = RecordShapes(*device, batch, shapes, nullptr);
+
+			const double serial = MeasureRate([&] { RecordShapes(*device, batch, shapes, nullptr); }) * static_cast<double>(shapes.size());
+			const double parallel = MeasureRate([&] { RecordShapes(*device, batch, shapes, &jobSystem); }) * static_cast<double>(shapes.size());
+			std::cout << std::format("  {:<20} {:>16.0f} {:>16.0f} {:>14.1f}\n", name, serial, parallel, static_cast<double>(uploadedBytes) / static_cast<double>(shapes.size()));
+		};
+
+		measureShapes("Rect", ShapeRenderer::ShapeKind::FilledRectangle);
+		measureShapes("Rect outline", ShapeRenderer::ShapeKind::OutlinedRectangle);
+		measureShapes("Ellipse", ShapeRenderer::ShapeKind::FilledEllipse);
+		measureShapes("Ellipse outline", ShapeRenderer::ShapeKind::OutlinedEllipse);
+		measureShapes("Triangle", ShapeRenderer::ShapeKind::FilledTriangle);
+
+		// Sprites don't get tessellated, so there is nothing to run in parallel
+		ShapeRandom random;
+		std::vector<TextureRenderer::SpriteInstance> sprites(ShapesPerFrame);
+
+		for (TextureRenderer::SpriteInstance& sprite : sprites)
+		{
+			sprite = {
+				.M00 = 32.0f, .M01 = 0.0f, .M02 = random.Next(1920.0f),
+				.M10 = 0.0f, .M11 = 32.0f, .M12 = random.Next(1080.0f),
+				.U0 = 0.0f, .V0 = 0.0f, .U1 = 1.0f, .V1 = 1.0f,
+				.Depth = 0.0f,
+				.R = 255, .G = 255, .B = 255, .A = 255,
+				.TextureSlot = 0,
+			};
+		}
+
+		const uint64_t uploadedBytes = RecordSprites(*device, sprites);
+		const double rate = MeasureRate([&] { RecordSprites(*device, sprites); }) * static_cast<double>(sprites.size());
+		std::cout << std::format("  {:<20} {:>16.0f} {:>16} {:>14.1f}\n\n", "Image", rate, "-", static_cast<double>(uploadedBytes) / static_cast<double>(sprites.size()));
+	}
+
+	void RunJobScalingBenchmark()
+	{
+		constexpr size_t ElementCount = size_t(1) << 22;
+		constexpr size_t GrainSize = 4096;
+		constexpr size_t JobsPerBurst = 1024;
+
+		const size_t maxWorkers = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+
+		std::cout << std::format("Job system, a parallel loop over {} elements and bursts of {} empty jobs\n", ElementCount, JobsPerBurst);
+		std::cout << std::format("  {:>8} {:>12} {:>10} {:>14} {:>12} {:>14}\n", "Threads", "Loops/s", "Speedup", "Jobs/s", "Stolen", "Failed steals");
+
+		// Double the workers up to what the machine has, and always measure the maximum
+		std::vector<size_t> workerCounts;
+		for (size_t workerCount = 1; workerCount < maxWorkers; workerCount *= 2)
+		{
+			workerCounts.push_back(workerCount);
+		}
+
+		workerCounts.push_back(maxWorkers);
+
+		std::vector<float> values(ElementCount);
+		double baseline = 0.0;
+
+		for (const size_t workerCount : workerCounts)
+		{
+			const auto jobSystem = Jobs::JobSystem::Create(workerCount);
+
+			const double loops = MeasureRate([&]
+			{
+				jobSystem->ParallelFor(values.size(), GrainSize, [&values](const size_t begin, const size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						const float x = static_cast<float>(i) * 0.001f;
+						values[i] = std::sin(x) * std::sqrt(x);
+					}
+				});
+			});
+
+			std::vector<Jobs::JobHandle> handles(JobsPerBurst);
+			const double jobs = MeasureRate([&]
+			{
+				for (Jobs::JobHandle& handle : handles)
+				{
+					handle = jobSystem->Schedule([] {});
+				}
+
+				jobSystem->Wait(handles);
+			}) * JobsPerBurst;
+
+			if (baseline == 0.0)
+			{
+				baseline = loops;
+			}
+
+			// The calling thread takes part in the loop as well
+			const Jobs::JobStatistics statistics = jobSystem->GetStatistics();
+			std::cout << std::format("  {:>8} {:>12.1f} {:>9.2f}x {:>14.0f} {:>12} {:>14}\n", workerCount + 1, loops, loops / baseline, jobs, statistics.StolenJobs, statistics.FailedSteals);
+		}
+
+		std::cout << '\n';
+	}
+
+	/// Streams a 4K texture for a number of frames, first replacing it as a whole,
+	/// then only a dirty band of it, and quits once both phases are done.
+	struct StreamingBenchmark : DGL::Sketch
+	{
+		static constexpr uint32_t Width = 3840;
+		static constexpr uint32_t Height = 2160;
+		static constexpr uint32_t BandHeight = Height / 8;
+		static constexpr uint32_t FramesPerPhase = 240;
+
+		struct Phase
+		{
+			const char* Name;
+			Clock::time_point Start;
+			Clock::duration UpdateTime = {};
+			uint64_t UploadedBytes = 0;
+		};
+
+		bool Setup() override
+		{
+			// Presenting shouldn't hold the updates back more than the swap interval does
+			DGL::SetFrameRate(0.0f);
+
+			texture = DGL::Texture::Texture::Create({ Width, Height }, nullptr);
+			if (texture == nullptr)
+			{
+				std::cerr << "Couldn't create the 4K texture\n";
+				return false;
+			}
+
+			std::cout << std::format("Texture streaming, {} frames per phase into a {}x{} texture\n", FramesPerPhase, Width, Height);
+			std::cout << std::format("  {:<14} {:>12} {:>14} {:>12} {:>8}\n", "Region", "Updates/s", "CPU ms/update", "GB/s", "4K@60");
+			return true;
+		}
+
+		void Event(const System::WindowEvent&) override
+		{
+		}
+
+		void Draw(float) override
+		{
+			const bool isFullPhase = frame < FramesPerPhase;
+			Phase& phase = isFullPhase ? full : band;
+
+			if (frame % FramesPerPhase == 0)
+			{
+				phase.Start = Clock::now();
+			}
+
+			const uint32_t bandTop = (frame * 16) % (Height - BandHeight);
+			const DGL::Math::UintBoundary region = isFullPhase
+				? DGL::Math::UintBoundary::FromLTWH(0, 0, Width, Height)
+				: DGL::Math::UintBoundary::FromLTWH(0, bandTop, Width, BandHeight);
+
+			// Write straight into the upload buffer, like a decoder or a CPU canvas would
+			const auto updateStart = Clock::now();
+			const DGL::Texture::TextureUpdate update = texture->BeginUpdate(region);
+
+			const uint32_t pixel = 0xFF000000u | frame * 0x010203u;
+			for (uint32_t row = 0; row < region.Height; ++row)
+			{
+				uint32_t* const texels = reinterpret_cast<uint32_t*>(update.Pixels + row * update.Stride);
+				std::fill_n(texels, region.Width, pixel);
+			}
+
+			texture->EndUpdate(update);
+			phase.UpdateTime += Clock::now() - updateStart;
+			phase.UploadedBytes += static_cast<uint64_t>(update.Stride) * region.Height;
+
+			const DGL::Math::FloatBoundary& viewport = DGL::GetViewport();
+			DGL::Image(*texture, 0.0f, 0.0f, viewport.Width, viewport.Height);
+
+			++frame;
+			if (frame % FramesPerPhase == 0)
+			{
+				Report(phase);
+			}
+
+			if (frame == 2 * FramesPerPhase)
+			{
+				DGL::Quit();
+			}
+		}
+
+		void Destroy() override
+		{
+			texture.reset();
+		}
+
+		static void Report(const Phase& phase)
+		{
+			// The wall time includes drawing and presenting, so it shows what a sketch would actually sustain
+			const double seconds = GetSeconds(Clock::now() - phase.Start);
+			const double updates = FramesPerPhase / seconds;
+			const double updateMilliseconds = GetSeconds(phase.UpdateTime) * 1000.0 / FramesPerPhase;
+			const double gigabytes = static_cast<double>(phase.UploadedBytes) / seconds / 1e9;
+
+			std::cout << std::format("  {:<14} {:>12.1f} {:>14.2f} {:>12.2f} {:>8}\n", phase.Name, updates, updateMilliseconds, gigabytes, updates >= 59.0 ? "yes" : "no");
+		}
+
+		std::unique_ptr<DGL::Texture::Texture> texture;
+		uint32_t frame = 0;
+		Phase full = { .Name = "Whole texture" };
+		Phase band = { .Name = "Dirty band" };
+	};
+}
+
+int main(const int argc, char** argv)
+{
+	const bool isCpuOnly = argc > 1 and std::string(argv[1]) == "--cpu-only";
+
+	{
+		// The main thread takes part in parallel loops, like in the library
+		const auto jobSystem = Jobs::JobSystem::Create(std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1);
+		RunDrawPathBenchmark(*jobSystem);
+	}
+
+	RunJobScalingBenchmark();
+
+	if (isCpuOnly)
+	{
+		return 0;
+	}
+
+	return DGL::Launch([]
+	{
+		return std::make_unique<StreamingBenchmark>();
+	});
+}
\ No newline at end of file
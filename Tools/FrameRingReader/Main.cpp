@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <span>
+#include <string>
+#include <thread>
+
+import FrameRing;
+
+/// Sample consumer of the frames a sketch publishes via DGL::OpenFrameOutput.
+/// It prints a checksum per frame, which makes it usable for tests, as well as
+/// the throughput and the number of skipped frames once per second.
+///
+/// Usage: FrameRingReader <name> [--latest]
+
+namespace
+{
+	uint64_t CalculateChecksum(const std::span<const uint8_t> pixels)
+	{
+		// FNV-1a
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (const uint8_t value : pixels)
+		{
+			hash = (hash ^ value) * 0x100000001B3ull;
+		}
+
+		return hash;
+	}
+}
+
+int main(const int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: FrameRingReader <name> [--latest]\n";
+		return 1;
+	}
+
+	const std::string name = argv[1];
+	const bool readLatest = argc > 2 and std::string(argv[2]) == "--latest";
+
+	auto reader = FrameRing::FrameRingReader::Open(name);
+	if (reader == nullptr)
+	{
+		std::cerr << std::format("No frame ring named {} has been found\n", name);
+		return 1;
+	}
+
+	uint64_t frameCount = 0;
+	uint64_t frameIndex = 0;
+	uint64_t checksum = 0;
+	auto lastReport = std::chrono::steady_clock::now();
+
+	const auto consumer = [&frameIndex, &checksum](const FrameRing::FrameView& frame)
+	{
+		// The checksum is the only thing that touches the pixels, so nothing gets copied
+		frameIndex = frame.FrameIndex;
+		checksum = CalculateChecksum(frame.Pixels);
+	};
+
+	while (true)
+	{
+		const FrameRing::ReadStatus status = readLatest ? reader->ReadLatest(consumer) : reader->ReadNext(consumer);
+
+		if (status == FrameRing::ReadStatus::Frame)
+		{
+			++frameCount;
+			std::cout << std::format("{} {:016x}\n", frameIndex, checksum);
+		}
+		else if (status == FrameRing::ReadStatus::NoFrame)
+		{
+			if (not reader->IsWriterAlive())
+			{
+				break;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		if (const auto now = std::chrono::steady_clock::now(); now - lastReport >= std::chrono::seconds(1))
+		{
+			std::cerr << std::format("{} frames read, {} skipped\n", frameCount, reader->GetSkippedFrames());
+			lastReport = now;
+		}
+	}
+
+	std::cerr << std::format("The writer closed the ring after {} frames, {} skipped\n", frameCount, reader->GetSkippedFrames());
+	return 0;
+}
\ No newline at end of file
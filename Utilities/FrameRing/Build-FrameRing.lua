@@ -0,0 +1,30 @@
+project("FrameRing")
+	kind("StaticLib")
+	language("C++")
+	cppdialect("C++23")
+	targetdir("%{wks.location}/build/bin/" .. OutputDir .. "/%{prj.name}")
+	objdir("%{wks.location}/build/bin-int/" .. OutputDir .. "/%{prj.name}")
+
+	files({
+		"private/FrameRing-FrameRingReader.cpp",
+		"private/FrameRing-FrameRingWriter.cpp",
+		"private/FrameRing-SharedMemory.cpp",
+
+		"public/FrameRing.ixx",
+		"public/FrameRing-FrameRingReader.ixx",
+		"public/FrameRing-FrameRingWriter.ixx",
+		"public/FrameRing-Layout.ixx",
+		"public/FrameRing-SharedMemory.ixx",
+	})
+
+	filter("system:windows")
+		systemversion("latest")
+		defines({ "PLATFORM_WINDOWS" })
+
+	filter("configurations:Debug")
+		runtime("Debug")
+		symbols("On")
+
+	filter("configurations:Release")
+		runtime("Release")
+		optimize("On")
\ No newline at end of file
@@ -0,0 +1,131 @@
+﻿module;
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+module FrameRing;
+
+namespace FrameRing
+{
+	std::unique_ptr<FrameRingReader> FrameRingReader::Open(const std::string_view name)
+	{
+		auto memory = SharedMemory::Open(name);
+		if (memory == nullptr or memory->GetSize() < sizeof(RingHeader))
+		{
+			return nullptr;
+		}
+
+		auto* header = static_cast<RingHeader*>(memory->GetData());
+
+		// The writer might still be initializing the ring or speak another version
+		if (std::atomic_ref(header->Magic).load(std::memory_order_acquire) != RingMagic or header->Version != RingVersion)
+		{
+			return nullptr;
+		}
+
+		if (memory->GetSize() < CalculateRingSize(header->SlotCount, header->SlotCapacity))
+		{
+			return nullptr;
+		}
+
+		return std::unique_ptr<FrameRingReader>(new FrameRingReader(std::move(memory)));
+	}
+
+	ReadStatus FrameRingReader::ReadNext(const FrameConsumer& consumer)
+	{
+		const uint64_t writtenFrames = m_Header->WrittenFrames.load(std::memory_order_acquire);
+		if (m_NextFrameIndex >= writtenFrames)
+		{
+			return ReadStatus::NoFrame;
+		}
+
+		// The slot of the oldest frame may already be claimed by the next one
+		const uint64_t oldestFrameIndex = writtenFrames >= m_Header->SlotCount ? writtenFrames - m_Header->SlotCount + 1 : 0;
+		if (m_NextFrameIndex < oldestFrameIndex)
+		{
+			m_SkippedFrames += oldestFrameIndex - m_NextFrameIndex;
+			m_NextFrameIndex = oldestFrameIndex;
+		}
+
+		return Read(m_NextFrameIndex++, consumer);
+	}
+
+	ReadStatus FrameRingReader::ReadLatest(const FrameConsumer& consumer)
+	{
+		const uint64_t writtenFrames = m_Header->WrittenFrames.load(std::memory_order_acquire);
+		if (m_NextFrameIndex >= writtenFrames)
+		{
+			return ReadStatus::NoFrame;
+		}
+
+		m_SkippedFrames += writtenFrames - 1 - m_NextFrameIndex;
+		m_NextFrameIndex = writtenFrames;
+
+		return Read(writtenFrames - 1, consumer);
+	}
+
+	uint64_t FrameRingReader::GetSkippedFrames() const
+	{
+		return m_SkippedFrames;
+	}
+
+	bool FrameRingReader::IsWriterAlive() const
+	{
+		return m_Header->WriterAlive.load(std::memory_order_acquire) != 0;
+	}
+
+	FrameRingReader::FrameRingReader(std::unique_ptr<SharedMemory> memory):
+		m_Memory(std::move(memory)),
+		m_Header(static_cast<const RingHeader*>(m_Memory->GetData())),
+		m_NextFrameIndex(m_Header->WrittenFrames.load(std::memory_order_acquire)),
+		m_SkippedFrames(0)
+	{
+	}
+
+	ReadStatus FrameRingReader::Read(const uint64_t frameIndex, const FrameConsumer& consumer)
+	{
+		const auto* data = reinterpret_cast<const std::byte*>(m_Header);
+		const auto& slot = *reinterpret_cast<const SlotHeader*>(data + sizeof(RingHeader) + frameIndex % m_Header->SlotCount * m_Header->SlotStride);
+
+		const uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+		if (sequence != GetCompletedSequence(frameIndex))
+		{
+			++m_SkippedFrames;
+			return ReadStatus::Overwritten;
+		}
+
+		const uint32_t width = slot.Width.load(std::memory_order_relaxed);
+		const uint32_t height = slot.Height.load(std::memory_order_relaxed);
+		const size_t byteCount = static_cast<size_t>(width) * height * 4;
+
+		// A torn size could point past the slot, the sequence check afterwards wouldn't help then
+		if (byteCount > m_Header->SlotCapacity)
+		{
+			++m_SkippedFrames;
+			return ReadStatus::Overwritten;
+		}
+
+		const FrameView view = {
+			.FrameIndex = slot.FrameIndex.load(std::memory_order_relaxed),
+			.Width = width,
+			.Height = height,
+			.Timestamp = slot.Timestamp.load(std::memory_order_relaxed),
+			.Pixels = { reinterpret_cast<const uint8_t*>(&slot + 1), byteCount },
+		};
+
+		consumer(view);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.Sequence.load(std::memory_order_relaxed) != sequence)
+		{
+			++m_SkippedFrames;
+			return ReadStatus::Overwritten;
+		}
+
+		return ReadStatus::Frame;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+﻿module;
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <string_view>
+
+module FrameRing;
+
+namespace FrameRing
+{
+	std::unique_ptr<FrameRingWriter> FrameRingWriter::Create(const std::string_view name, const uint32_t slotCount, const size_t slotCapacity)
+	{
+		// A single slot would always be overwritten while being read
+		const uint32_t count = std::max(slotCount, 2u);
+
+		auto memory = SharedMemory::Create(name, CalculateRingSize(count, slotCapacity));
+		if (memory == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto* data = static_cast<std::byte*>(memory->GetData());
+		auto* header = new (data) RingHeader();
+		header->Version = RingVersion;
+		header->SlotCount = count;
+		header->Reserved = 0;
+		header->SlotCapacity = slotCapacity;
+		header->SlotStride = CalculateSlotStride(slotCapacity);
+		header->WrittenFrames.store(0, std::memory_order_relaxed);
+		header->WriterAlive.store(1, std::memory_order_relaxed);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			auto* slot = new (data + sizeof(RingHeader) + i * header->SlotStride) SlotHeader();
+			slot->Sequence.store(0, std::memory_order_relaxed);
+		}
+
+		// Readers check the magic first, so it gets published once the ring is ready
+		std::atomic_ref(header->Magic).store(RingMagic, std::memory_order_release);
+
+		return std::unique_ptr<FrameRingWriter>(new FrameRingWriter(std::move(memory)));
+	}
+
+	FrameRingWriter::~FrameRingWriter()
+	{
+		m_Header->WriterAlive.store(0, std::memory_order_release);
+	}
+
+	std::span<uint8_t> FrameRingWriter::BeginFrame(const uint32_t width, const uint32_t height)
+	{
+		const size_t byteCount = static_cast<size_t>(width) * height * 4;
+		if (byteCount > m_Header->SlotCapacity)
+		{
+			return {};
+		}
+
+		SlotHeader& slot = GetSlot(m_NextFrameIndex);
+
+		// An odd sequence tells readers that the slot is being written
+		slot.Sequence.store(GetCompletedSequence(m_NextFrameIndex) - 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+		slot.FrameIndex.store(m_NextFrameIndex, std::memory_order_relaxed);
+		slot.Width.store(width, std::memory_order_relaxed);
+		slot.Height.store(height, std::memory_order_relaxed);
+		slot.Timestamp.store(timestamp.count(), std::memory_order_relaxed);
+
+		m_IsWriting = true;
+		return { reinterpret_cast<uint8_t*>(&slot + 1), byteCount };
+	}
+
+	void FrameRingWriter::EndFrame()
+	{
+		if (not m_IsWriting)
+		{
+			return;
+		}
+
+		GetSlot(m_NextFrameIndex).Sequence.store(GetCompletedSequence(m_NextFrameIndex), std::memory_order_release);
+		m_Header->WrittenFrames.store(++m_NextFrameIndex, std::memory_order_release);
+		m_IsWriting = false;
+	}
+
+	uint64_t FrameRingWriter::GetWrittenFrames() const
+	{
+		return m_NextFrameIndex;
+	}
+
+	size_t FrameRingWriter::GetSlotCapacity() const
+	{
+		return m_Header->SlotCapacity;
+	}
+
+	FrameRingWriter::FrameRingWriter(std::unique_ptr<SharedMemory> memory):
+		m_Memory(std::move(memory)),
+		m_Header(static_cast<RingHeader*>(m_Memory->GetData())),
+		m_NextFrameIndex(0),
+		m_IsWriting(false)
+	{
+	}
+
+	SlotHeader& FrameRingWriter::GetSlot(const uint64_t frameIndex) const
+	{
+		auto* data = reinterpret_cast<std::byte*>(m_Header);
+		return *reinterpret_cast<SlotHeader*>(data + sizeof(RingHeader) + frameIndex % m_Header->SlotCount * m_Header->SlotStride);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+﻿module;
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#ifdef PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+module FrameRing;
+
+namespace FrameRing
+{
+#ifdef PLATFORM_WINDOWS
+
+	std::unique_ptr<SharedMemory> SharedMemory::Create(const std::string_view name, const size_t size)
+	{
+		const std::string mappingName(name);
+		const uint64_t mappingSize = size;
+
+		const HANDLE mapping = CreateFileMappingA(
+			INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(mappingSize >> 32), static_cast<DWORD>(mappingSize),
+			mappingName.c_str()
+		);
+
+		if (mapping == nullptr)
+		{
+			return nullptr;
+		}
+
+		// Another writer already uses the name, its readers must not see our frames
+		if (GetLastError() == ERROR_ALREADY_EXISTS)
+		{
+			CloseHandle(mapping);
+			return nullptr;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			return nullptr;
+		}
+
+		return std::unique_ptr<SharedMemory>(new SharedMemory(mappingName, reinterpret_cast<intptr_t>(mapping), data, size, true));
+	}
+
+	std::unique_ptr<SharedMemory> SharedMemory::Open(const std::string_view name)
+	{
+		const std::string mappingName(name);
+
+		const HANDLE mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mappingName.c_str());
+		if (mapping == nullptr)
+		{
+			return nullptr;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			return nullptr;
+		}
+
+		// The view covers whole pages, so it's at least as large as the block
+		MEMORY_BASIC_INFORMATION information = {};
+		VirtualQuery(data, &information, sizeof(information));
+
+		return std::unique_ptr<SharedMemory>(new SharedMemory(mappingName, reinterpret_cast<intptr_t>(mapping), data, information.RegionSize, false));
+	}
+
+	SharedMemory::~SharedMemory()
+	{
+		// The page file backing gets released with the last handle
+		UnmapViewOfFile(m_Data);
+		CloseHandle(reinterpret_cast<HANDLE>(m_Handle));
+	}
+
+#else
+
+	std::unique_ptr<SharedMemory> SharedMemory::Create(const std::string_view name, const size_t size)
+	{
+		const std::string objectName = "/" + std::string(name);
+
+		const int descriptor = shm_open(objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (descriptor < 0)
+		{
+			return nullptr;
+		}
+
+		if (ftruncate(descriptor, static_cast<off_t>(size)) != 0)
+		{
+			close(descriptor);
+			shm_unlink(objectName.c_str());
+			return nullptr;
+		}
+
+		void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		if (data == MAP_FAILED)
+		{
+			close(descriptor);
+			shm_unlink(objectName.c_str());
+			return nullptr;
+		}
+
+		return std::unique_ptr<SharedMemory>(new SharedMemory(objectName, descriptor, data, size, true));
+	}
+
+	std::unique_ptr<SharedMemory> SharedMemory::Open(const std::string_view name)
+	{
+		const std::string objectName = "/" + std::string(name);
+
+		const int descriptor = shm_open(objectName.c_str(), O_RDWR, 0);
+		if (descriptor < 0)
+		{
+			return nullptr;
+		}
+
+		struct stat status = {};
+		if (fstat(descriptor, &status) != 0 or status.st_size <= 0)
+		{
+			close(descriptor);
+			return nullptr;
+		}
+
+		const size_t size = static_cast<size_t>(status.st_size);
+		void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		if (data == MAP_FAILED)
+		{
+			close(descriptor);
+			return nullptr;
+		}
+
+		return std::unique_ptr<SharedMemory>(new SharedMemory(objectName, descriptor, data, size, false));
+	}
+
+	SharedMemory::~SharedMemory()
+	{
+		munmap(m_Data, m_Size);
+		close(static_cast<int>(m_Handle));
+
+		// Readers that still have the block mapped keep their view
+		if (m_IsOwner)
+		{
+			shm_unlink(m_Name.c_str());
+		}
+	}
+
+#endif
+
+	void* SharedMemory::GetData() const
+	{
+		return m_Data;
+	}
+
+	size_t SharedMemory::GetSize() const
+	{
+		return m_Size;
+	}
+
+	SharedMemory::SharedMemory(std::string name, const intptr_t handle, void* data, const size_t size, const bool isOwner):
+		m_Name(std::move(name)),
+		m_Handle(handle),
+		m_Data(data),
+		m_Size(size),
+		m_IsOwner(isOwner)
+	{
+	}
+}
\ No newline at end of file
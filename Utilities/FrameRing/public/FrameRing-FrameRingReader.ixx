@@ -0,0 +1,79 @@
+﻿// Project Name : FrameRing
+// File Name    : FrameRing-FrameRingReader.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string_view>
+
+export module FrameRing:FrameRingReader;
+
+import :Layout;
+import :SharedMemory;
+
+export namespace FrameRing
+{
+	struct FrameView
+	{
+		uint64_t FrameIndex;				//!< The number of the frame since the writer created the ring
+		uint32_t Width;						//!< The width of the frame in pixels
+		uint32_t Height;					//!< The height of the frame in pixels
+		int64_t Timestamp;					//!< Nanoseconds since the epoch of the system clock
+		std::span<const uint8_t> Pixels;	//!< Tightly packed RGBA8 pixels, starting with the top row
+	};
+
+	enum class ReadStatus
+	{
+		Frame,			//!< The consumer received a complete frame
+		NoFrame,		//!< No new frame has been written yet
+		Overwritten,	//!< The writer overtook the reader while the consumer used the frame. Its results must be discarded
+	};
+
+	using FrameConsumer = std::function<void(const FrameView&)>;
+
+	/// Reads frames published by a FrameRingWriter in another process. The consumer
+	/// gets to see the pixels in the shared memory itself, so a frame never gets
+	/// copied unless the consumer does so. Reading never blocks the writer.
+	class FrameRingReader
+	{
+	public:
+
+		/// @brief Open a ring created by a writer.
+		/// @param name The name the writer created the ring with.
+		/// @return The reader or nullptr if no compatible ring with the name exists.
+		static std::unique_ptr<FrameRingReader> Open(std::string_view name);
+
+		/// @brief Pass the oldest unread frame to the consumer. Frames the writer has
+		///		   overwritten already are skipped.
+		/// @param consumer Receives the frame. The view is only valid until it returns.
+		/// @return Whether the consumer received a frame and if it stayed intact meanwhile.
+		ReadStatus ReadNext(const FrameConsumer& consumer);
+
+		/// @brief Pass the newest frame to the consumer and skip every older unread frame.
+		///		   Useful for consumers that care about latency rather than completeness.
+		ReadStatus ReadLatest(const FrameConsumer& consumer);
+
+		/// @return The number of frames that have been skipped or overwritten while being read.
+		uint64_t GetSkippedFrames() const;
+
+		/// @return Whether the writer still publishes frames.
+		bool IsWriterAlive() const;
+
+	private:
+
+		FrameRingReader(std::unique_ptr<SharedMemory> memory);
+
+		ReadStatus Read(uint64_t frameIndex, const FrameConsumer& consumer);
+
+		std::unique_ptr<SharedMemory> m_Memory;
+		const RingHeader* m_Header;
+		uint64_t m_NextFrameIndex;
+		uint64_t m_SkippedFrames;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+﻿// Project Name : FrameRing
+// File Name    : FrameRing-FrameRingWriter.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+export module FrameRing:FrameRingWriter;
+
+import :Layout;
+import :SharedMemory;
+
+export namespace FrameRing
+{
+	/// Publishes frames into a ring of slots in shared memory. The writer never
+	/// waits for its readers, it overwrites the oldest slot once the ring is full.
+	class FrameRingWriter
+	{
+	public:
+
+		/// @brief Create a new ring.
+		/// @param name The name readers open the ring with.
+		/// @param slotCount The number of frames the ring holds.
+		/// @param slotCapacity The maximum size of the pixels of a frame in bytes.
+		/// @return The writer or nullptr if the shared memory couldn't be created or the name is in use.
+		static std::unique_ptr<FrameRingWriter> Create(std::string_view name, uint32_t slotCount, size_t slotCapacity);
+
+		~FrameRingWriter();
+
+		/// @brief Claim the next slot. The pixels must be written into the returned
+		///		   memory directly, before the frame gets published via EndFrame().
+		/// @param width The width of the frame in pixels.
+		/// @param height The height of the frame in pixels.
+		/// @return The RGBA8 pixels of the frame, or an empty span if the frame exceeds the slot capacity.
+		std::span<uint8_t> BeginFrame(uint32_t width, uint32_t height);
+
+		/// Publish the frame claimed by BeginFrame().
+		void EndFrame();
+
+		/// @return The number of published frames.
+		uint64_t GetWrittenFrames() const;
+
+		size_t GetSlotCapacity() const;
+
+	private:
+
+		FrameRingWriter(std::unique_ptr<SharedMemory> memory);
+
+		SlotHeader& GetSlot(uint64_t frameIndex) const;
+
+		std::unique_ptr<SharedMemory> m_Memory;
+		RingHeader* m_Header;
+		uint64_t m_NextFrameIndex;
+		bool m_IsWriting;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+﻿// Project Name : FrameRing
+// File Name    : FrameRing-Layout.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+export module FrameRing:Layout;
+
+/// The shared memory starts with a RingHeader, followed by SlotCount slots of
+/// SlotStride bytes. Each slot starts with a SlotHeader, followed by the pixels.
+///
+/// Frames are written round robin. The sequence counter of a slot is odd while
+/// the writer fills it and 2 * (FrameIndex + 1) once the frame is complete. A reader
+/// reads the counter, uses the pixels and reads the counter again. If both values
+/// match, the frame hasn't been touched meanwhile. Otherwise the writer overtook
+/// the reader and the frame has to be discarded. Neither side ever waits.
+export namespace FrameRing
+{
+	inline constexpr uint32_t RingMagic = 0x464C4744;	//!< "DGLF"
+	inline constexpr uint32_t RingVersion = 1;
+	inline constexpr size_t CacheLineSize = 64;
+
+	struct alignas(CacheLineSize) RingHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t SlotCount;
+		uint32_t Reserved;
+		uint64_t SlotCapacity;					//!< The maximum size of the pixels of a frame in bytes
+		uint64_t SlotStride;					//!< The distance between two slots in bytes
+		std::atomic<uint64_t> WrittenFrames;	//!< The number of completed frames. The newest one is WrittenFrames - 1
+		std::atomic<uint32_t> WriterAlive;		//!< Cleared when the writer closes the ring
+	};
+
+	struct alignas(CacheLineSize) SlotHeader
+	{
+		std::atomic<uint64_t> Sequence;
+		std::atomic<uint64_t> FrameIndex;
+		std::atomic<uint32_t> Width;
+		std::atomic<uint32_t> Height;
+		std::atomic<int64_t> Timestamp;		//!< Nanoseconds since the epoch of the system clock
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "The ring requires lock-free atomics to work across processes");
+
+	constexpr size_t CalculateSlotStride(const size_t slotCapacity)
+	{
+		return (sizeof(SlotHeader) + slotCapacity + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+	}
+
+	constexpr size_t CalculateRingSize(const uint32_t slotCount, const size_t slotCapacity)
+	{
+		return sizeof(RingHeader) + slotCount * CalculateSlotStride(slotCapacity);
+	}
+
+	constexpr uint64_t GetCompletedSequence(const uint64_t frameIndex)
+	{
+		return 2 * (frameIndex + 1);
+	}
+}
\ No newline at end of file
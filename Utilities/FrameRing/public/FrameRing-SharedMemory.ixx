@@ -0,0 +1,51 @@
+﻿// Project Name : FrameRing
+// File Name    : FrameRing-SharedMemory.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+export module FrameRing:SharedMemory;
+
+export namespace FrameRing
+{
+	/// A named block of memory shared between processes. Backed by a file mapping
+	/// of the page file on Windows and by shm_open on POSIX systems.
+	class SharedMemory
+	{
+	public:
+
+		/// @brief Create a new block. The name gets removed once the block is destroyed.
+		/// @return The block or nullptr if it couldn't be created.
+		static std::unique_ptr<SharedMemory> Create(std::string_view name, size_t size);
+
+		/// @brief Open a block created by another process.
+		/// @return The block or nullptr if no block with the name exists.
+		static std::unique_ptr<SharedMemory> Open(std::string_view name);
+
+		~SharedMemory();
+
+		SharedMemory(const SharedMemory&) = delete;
+		SharedMemory& operator=(const SharedMemory&) = delete;
+
+		void* GetData() const;
+		size_t GetSize() const;
+
+	private:
+
+		SharedMemory(std::string name, intptr_t handle, void* data, size_t size, bool isOwner);
+
+		std::string m_Name;
+		intptr_t m_Handle;	//!< The file mapping on Windows, the file descriptor on POSIX systems
+		void* m_Data;
+		size_t m_Size;
+		bool m_IsOwner;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+﻿// Project Name : FrameRing
+// File Name    : FrameRing.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module FrameRing;
+
+export import :Layout;
+export import :SharedMemory;
+export import :FrameRingWriter;
+export import :FrameRingReader;
\ No newline at end of file
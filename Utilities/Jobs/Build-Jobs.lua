@@ -0,0 +1,27 @@
+project("Jobs")
+	kind("StaticLib")
+	language("C++")
+	cppdialect("C++23")
+	targetdir("%{wks.location}/build/bin/" .. OutputDir .. "/%{prj.name}")
+	objdir("%{wks.location}/build/bin-int/" .. OutputDir .. "/%{prj.name}")
+
+	files({
+		"private/Jobs-JobSystem.cpp",
+
+		"public/Jobs.ixx",
+		"public/Jobs-Job.ixx",
+		"public/Jobs-JobHandle.ixx",
+		"public/Jobs-JobSystem.ixx",
+		"public/Jobs-WorkStealingQueue.ixx",
+	})
+
+	filter("system:windows")
+		systemversion("latest")
+
+	filter("configurations:Debug")
+		runtime("Debug")
+		symbols("On")
+
+	filter("configurations:Release")
+		runtime("Release")
+		optimize("On")
\ No newline at end of file
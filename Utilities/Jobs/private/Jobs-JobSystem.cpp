@@ -0,0 +1,436 @@
+﻿module;
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+module Jobs;
+
+namespace Jobs
+{
+	namespace
+	{
+		/// The job system and the worker running the current thread, if it is one.
+		thread_local const JobSystem* CurrentSystem = nullptr;
+		thread_local size_t CurrentWorker = 0;
+	}
+
+	bool JobHandle::IsValid() const
+	{
+		return m_Job != nullptr;
+	}
+
+	bool JobHandle::IsDone() const
+	{
+		return m_Job == nullptr or m_Job->IsDone;
+	}
+
+	JobHandle::JobHandle(std::shared_ptr<Job> job)
+	:	m_Job(std::move(job))
+	{
+	}
+
+	std::unique_ptr<JobSystem> JobSystem::Create(const size_t workerCount)
+	{
+		return std::unique_ptr<JobSystem>(new JobSystem(std::max<size_t>(workerCount, 1)));
+	}
+
+	JobSystem::~JobSystem()
+	{
+		// The workers refer to the queues, so they have to stop first
+		m_Threads.clear();
+	}
+
+	JobHandle JobSystem::Schedule(std::function<void()> function, const std::span<const JobHandle> dependencies, const JobAffinity affinity)
+	{
+		auto job = std::make_shared<Job>();
+		job->Function = std::move(function);
+		job->Affinity = affinity;
+
+		for (const JobHandle& dependency : dependencies)
+		{
+			if (dependency.m_Job == nullptr)
+			{
+				continue;
+			}
+
+			// A dependency finishing meanwhile either sees the job or has already been marked as done
+			std::scoped_lock lock(dependency.m_Job->Mutex);
+			if (not dependency.m_Job->IsDone)
+			{
+				dependency.m_Job->Dependents.push_back(job);
+				++job->PendingDependencies;
+			}
+		}
+
+		Release(job);
+		return JobHandle(std::move(job));
+	}
+
+	void JobSystem::ParallelFor(const size_t count, const size_t grainSize, const std::function<void(size_t begin, size_t end)>& body)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		const size_t grain = std::max<size_t>(grainSize, 1);
+		const size_t chunkCount = (count + grain - 1) / grain;
+
+		// Rather than a job per chunk, a few jobs keep taking the next chunk until none is left
+		std::atomic<size_t> nextChunk = 0;
+		const auto processChunks = [&]
+		{
+			for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+			{
+				const size_t begin = chunk * grain;
+				body(begin, std::min(begin + grain, count));
+			}
+		};
+
+		const size_t helperCount = std::min(chunkCount - 1, m_Workers.size());
+		std::vector<JobHandle> helpers;
+		helpers.reserve(helperCount);
+
+		for (size_t i = 0; i < helperCount; ++i)
+		{
+			helpers.push_back(Schedule(processChunks));
+		}
+
+		processChunks();
+
+		// Helpers that start late find every chunk taken, but still refer to the counter
+		Wait(helpers);
+	}
+
+	void JobSystem::Wait(const JobHandle& job)
+	{
+		Wait(std::span(&job, 1));
+	}
+
+	void JobSystem::Wait(const std::span<const JobHandle> jobs)
+	{
+		const size_t workerIndex = GetCurrentWorker();
+		const bool isMainThread = IsMainThread();
+
+		const auto isDone = [jobs]
+		{
+			return std::ranges::all_of(jobs, [](const JobHandle& job) { return job.IsDone(); });
+		};
+
+		while (not isDone())
+		{
+			// The jobs waited for may need the main thread
+			if (isMainThread)
+			{
+				if (const auto job = PopMainThreadJob())
+				{
+					Execute(job);
+					++m_ExecutedMainThreadJobs;
+					continue;
+				}
+			}
+
+			if (const auto job = FindJob(workerIndex))
+			{
+				Execute(job);
+
+				if (workerIndex != NoWorker)
+				{
+					++m_Workers[workerIndex]->ExecutedJobs;
+				}
+				else
+				{
+					++m_HelpedJobs;
+				}
+
+				continue;
+			}
+
+			std::unique_lock lock(m_SleepMutex);
+			++m_Sleepers;
+			++m_Waiters;
+
+			m_WakeUp.wait(lock, [&]
+			{
+				return isDone() or m_QueuedJobs > 0 or (isMainThread and m_QueuedMainThreadJobs > 0);
+			});
+
+			--m_Waiters;
+			--m_Sleepers;
+		}
+	}
+
+	size_t JobSystem::RunMainThreadJobs(const std::chrono::microseconds budget)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		size_t count = 0;
+		while (const auto job = PopMainThreadJob())
+		{
+			Execute(job);
+			++m_ExecutedMainThreadJobs;
+			++count;
+
+			// The maximum means no budget, it would overflow in nanoseconds
+			if (budget != std::chrono::microseconds::max() and std::chrono::steady_clock::now() - start >= budget)
+			{
+				break;
+			}
+		}
+
+		return count;
+	}
+
+	void JobSystem::SetMainThreadNotification(std::function<void()> notification)
+	{
+		m_MainThreadNotification = std::move(notification);
+	}
+
+	bool JobSystem::HasMainThreadJobs() const
+	{
+		return m_QueuedMainThreadJobs > 0;
+	}
+
+	size_t JobSystem::GetWorkerCount() const
+	{
+		return m_Workers.size();
+	}
+
+	bool JobSystem::IsMainThread() const
+	{
+		return std::this_thread::get_id() == m_MainThreadId;
+	}
+
+	JobStatistics JobSystem::GetStatistics() const
+	{
+		JobStatistics statistics;
+		statistics.Workers.reserve(m_Workers.size());
+
+		for (const auto& worker : m_Workers)
+		{
+			const WorkerStatistics& workerStatistics = statistics.Workers.emplace_back(WorkerStatistics {
+				.ExecutedJobs = worker->ExecutedJobs,
+				.StolenJobs = worker->StolenJobs,
+				.FailedSteals = worker->FailedSteals,
+				.IdleTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(worker->IdleNanoseconds)),
+			});
+
+			statistics.ExecutedJobs += workerStatistics.ExecutedJobs;
+			statistics.StolenJobs += workerStatistics.StolenJobs;
+			statistics.FailedSteals += workerStatistics.FailedSteals;
+			statistics.IdleTime += workerStatistics.IdleTime;
+		}
+
+		statistics.HelpedJobs = m_HelpedJobs;
+		statistics.MainThreadJobs = m_ExecutedMainThreadJobs;
+		statistics.ExecutedJobs += statistics.HelpedJobs + statistics.MainThreadJobs;
+		return statistics;
+	}
+
+	JobSystem::JobSystem(const size_t workerCount)
+	:	m_MainThreadId(std::this_thread::get_id()),
+		m_NextWorker(0),
+		m_QueuedJobs(0),
+		m_QueuedMainThreadJobs(0),
+		m_Sleepers(0),
+		m_Waiters(0),
+		m_HelpedJobs(0),
+		m_ExecutedMainThreadJobs(0)
+	{
+		m_Workers.reserve(workerCount);
+		for (size_t i = 0; i < workerCount; ++i)
+		{
+			m_Workers.push_back(std::make_unique<Worker>());
+		}
+
+		// Every worker may steal from the others right away, so they all have to exist first
+		m_Threads.reserve(workerCount);
+		for (size_t i = 0; i < workerCount; ++i)
+		{
+			m_Threads.emplace_back([this, i](const std::stop_token stopToken) { Run(stopToken, i); });
+		}
+	}
+
+	void JobSystem::Run(const std::stop_token stopToken, const size_t workerIndex)
+	{
+		CurrentSystem = this;
+		CurrentWorker = workerIndex;
+
+		Worker& worker = *m_Workers[workerIndex];
+		while (not stopToken.stop_requested())
+		{
+			if (const auto job = FindJob(workerIndex))
+			{
+				Execute(job);
+				++worker.ExecutedJobs;
+				continue;
+			}
+
+			const auto idleStart = std::chrono::steady_clock::now();
+			{
+				std::unique_lock lock(m_SleepMutex);
+				++m_Sleepers;
+				m_WakeUp.wait(lock, stopToken, [this] { return m_QueuedJobs > 0; });
+				--m_Sleepers;
+			}
+
+			worker.IdleNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - idleStart).count();
+		}
+
+		CurrentSystem = nullptr;
+	}
+
+	void JobSystem::Release(const std::shared_ptr<Job>& job)
+	{
+		if (--job->PendingDependencies == 0)
+		{
+			Enqueue(job);
+		}
+	}
+
+	void JobSystem::Enqueue(std::shared_ptr<Job> job)
+	{
+		if (job->Affinity == JobAffinity::MainThread)
+		{
+			{
+				std::scoped_lock lock(m_MainThreadMutex);
+				m_MainThreadJobs.push_back(std::move(job));
+				++m_QueuedMainThreadJobs;
+			}
+
+			// The main thread may be waiting for something depending on the job
+			if (m_Waiters > 0)
+			{
+				{ std::scoped_lock lock(m_SleepMutex); }
+				m_WakeUp.notify_all();
+			}
+
+			if (m_MainThreadNotification)
+			{
+				m_MainThreadNotification();
+			}
+
+			return;
+		}
+
+		// Workers keep their jobs to themselves until somebody steals them
+		size_t workerIndex = GetCurrentWorker();
+		if (workerIndex == NoWorker)
+		{
+			workerIndex = m_NextWorker++ % m_Workers.size();
+		}
+
+		m_Workers[workerIndex]->Queue.Push(std::move(job));
+		++m_QueuedJobs;
+
+		if (m_Sleepers > 0)
+		{
+			// Taking the lock makes sure a thread about to sleep either sees the job or gets notified
+			{ std::scoped_lock lock(m_SleepMutex); }
+			m_WakeUp.notify_one();
+		}
+	}
+
+	void JobSystem::Execute(const std::shared_ptr<Job>& job)
+	{
+		job->Function();
+
+		// Free the captures right away, the handles may keep the job alive for a while
+		job->Function = nullptr;
+
+		std::vector<std::shared_ptr<Job>> dependents;
+		{
+			std::scoped_lock lock(job->Mutex);
+			job->IsDone = true;
+			dependents = std::move(job->Dependents);
+		}
+
+		for (const std::shared_ptr<Job>& dependent : dependents)
+		{
+			Release(dependent);
+		}
+
+		if (m_Waiters > 0)
+		{
+			{ std::scoped_lock lock(m_SleepMutex); }
+			m_WakeUp.notify_all();
+		}
+	}
+
+	std::shared_ptr<Job> JobSystem::FindJob(const size_t workerIndex)
+	{
+		if (workerIndex != NoWorker)
+		{
+			if (auto job = m_Workers[workerIndex]->Queue.Pop())
+			{
+				--m_QueuedJobs;
+				return std::move(*job);
+			}
+		}
+
+		// Start with a different victim every time, so the thieves don't all line up at the same queue
+		const size_t workerCount = m_Workers.size();
+		const size_t firstVictim = workerIndex != NoWorker ? workerIndex + 1 : m_NextWorker.load();
+
+		for (size_t i = 0; i < workerCount; ++i)
+		{
+			const size_t victim = (firstVictim + i) % workerCount;
+			if (victim == workerIndex)
+			{
+				continue;
+			}
+
+			if (auto job = m_Workers[victim]->Queue.Steal())
+			{
+				--m_QueuedJobs;
+
+				if (workerIndex != NoWorker)
+				{
+					++m_Workers[workerIndex]->StolenJobs;
+				}
+
+				return std::move(*job);
+			}
+		}
+
+		if (workerIndex != NoWorker)
+		{
+			++m_Workers[workerIndex]->FailedSteals;
+		}
+
+		return nullptr;
+	}
+
+	std::shared_ptr<Job> JobSystem::PopMainThreadJob()
+	{
+		if (m_QueuedMainThreadJobs == 0)
+		{
+			return nullptr;
+		}
+
+		std::scoped_lock lock(m_MainThreadMutex);
+		if (m_MainThreadJobs.empty())
+		{
+			return nullptr;
+		}
+
+		std::shared_ptr<Job> job = std::move(m_MainThreadJobs.front());
+		m_MainThreadJobs.pop_front();
+		--m_QueuedMainThreadJobs;
+		return job;
+	}
+
+	size_t JobSystem::GetCurrentWorker() const
+	{
+		return CurrentSystem == this ? CurrentWorker : NoWorker;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+﻿// Project Name : Jobs
+// File Name    : Jobs-Job.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+export module Jobs:Job;
+
+export namespace Jobs
+{
+	/// Where a job may run.
+	enum class JobAffinity
+	{
+		Worker,			//!< On any worker or any thread waiting for a job
+		MainThread,		//!< On the main thread, e.g. because it uses the OpenGL context
+	};
+}
+
+namespace Jobs
+{
+	/// A function waiting for its dependencies, waiting for a thread or running.
+	struct Job
+	{
+		std::function<void()> Function;
+		JobAffinity Affinity = JobAffinity::Worker;
+
+		std::atomic<uint32_t> PendingDependencies = 1;	//!< Starts with one held by the scheduler, which releases it after registering the dependencies
+		std::atomic<bool> IsDone = false;
+
+		std::mutex Mutex;
+		std::vector<std::shared_ptr<Job>> Dependents;	//!< The jobs waiting for this one, guarded by the mutex
+	};
+}
\ No newline at end of file
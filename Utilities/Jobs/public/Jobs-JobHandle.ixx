@@ -0,0 +1,38 @@
+﻿// Project Name : Jobs
+// File Name    : Jobs-JobHandle.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <memory>
+
+export module Jobs:JobHandle;
+
+import :Job;
+
+export namespace Jobs
+{
+	/// Refers to a scheduled job, e.g. to wait for it or to let other jobs depend on it.
+	class JobHandle
+	{
+	public:
+
+		JobHandle() = default;
+
+		/// @return Whether the handle refers to a job.
+		bool IsValid() const;
+
+		/// @return Whether the job finished. Handles without a job count as finished.
+		bool IsDone() const;
+
+	private:
+
+		friend class JobSystem;
+
+		explicit JobHandle(std::shared_ptr<Job> job);
+
+		std::shared_ptr<Job> m_Job;
+
+	};
+}
\ No newline at end of file
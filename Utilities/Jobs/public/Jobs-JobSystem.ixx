@@ -0,0 +1,170 @@
+﻿// Project Name : Jobs
+// File Name    : Jobs-JobSystem.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+export module Jobs:JobSystem;
+
+import :Job;
+import :JobHandle;
+import :WorkStealingQueue;
+
+export namespace Jobs
+{
+	struct WorkerStatistics
+	{
+		uint64_t ExecutedJobs = 0;
+		uint64_t StolenJobs = 0;					//!< The jobs taken from the queue of another worker
+		uint64_t FailedSteals = 0;					//!< The searches through the other queues that came back empty-handed
+		std::chrono::microseconds IdleTime = {};	//!< The time spent sleeping for lack of work
+	};
+
+	struct JobStatistics
+	{
+		std::vector<WorkerStatistics> Workers;
+		uint64_t ExecutedJobs = 0;					//!< Including the jobs run by waiting threads and on the main thread
+		uint64_t StolenJobs = 0;
+		uint64_t FailedSteals = 0;
+		uint64_t HelpedJobs = 0;					//!< The jobs run by threads that waited for a job and aren't workers
+		uint64_t MainThreadJobs = 0;
+		std::chrono::microseconds IdleTime = {};
+	};
+
+	/// Runs jobs on a fixed set of worker threads. Every worker has a queue of its own,
+	/// which the jobs it schedules end up in. Workers running out of work steal from
+	/// the others, so uneven jobs still keep every core busy.
+	///
+	/// A job may depend on other jobs and only gets queued once they finished. Jobs with
+	/// main thread affinity wait until the main thread calls RunMainThreadJobs(), which
+	/// allows scheduling OpenGL work from the workers. Threads waiting for a job run
+	/// other jobs in the meantime, so jobs may wait for each other without starving
+	/// the workers.
+	class JobSystem
+	{
+	public:
+
+		/// @brief Start the workers. The calling thread becomes the main thread.
+		/// @param workerCount The number of worker threads, at least one.
+		static std::unique_ptr<JobSystem> Create(size_t workerCount);
+
+		/// @brief Stop the workers once they finished their current jobs. Jobs still queued are discarded.
+		~JobSystem();
+
+		/// @brief Queue a function, which runs once its dependencies finished.
+		/// @param dependencies The jobs that have to finish first. Invalid handles are ignored.
+		/// @param affinity Where the function may run.
+		JobHandle Schedule(std::function<void()> function, std::span<const JobHandle> dependencies = {}, JobAffinity affinity = JobAffinity::Worker);
+
+		/// @brief Queue a function and get its result through a future.
+		template <typename Function>
+		auto Async(Function&& function, const std::span<const JobHandle> dependencies = {}, const JobAffinity affinity = JobAffinity::Worker) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+		{
+			using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+			// std::function requires copyable functions, the task isn't one
+			auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+			std::future<Result> result = task->get_future();
+
+			Schedule([task] { (*task)(); }, dependencies, affinity);
+			return result;
+		}
+
+		/// @brief Split a range into chunks and process them on the workers. The calling thread
+		///		   takes part and returns once every chunk has been processed.
+		/// @param count The number of indices.
+		/// @param grainSize The number of indices per chunk. Bigger chunks lower the overhead, smaller ones spread the work more evenly.
+		/// @param body Called with the first and one past the last index of every chunk.
+		void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body);
+
+		/// @brief Wait for jobs to finish, running other jobs meanwhile.
+		void Wait(const JobHandle& job);
+		void Wait(std::span<const JobHandle> jobs);
+
+		/// @brief Run the jobs with main thread affinity that are ready. Call on the main thread.
+		/// @param budget The time after which the remaining jobs are left to the next call.
+		/// @return The number of jobs run.
+		size_t RunMainThreadJobs(std::chrono::microseconds budget = std::chrono::microseconds::max());
+
+		/// @brief Set a function to call whenever a job with main thread affinity gets ready, e.g. to wake up
+		///		   a main thread sleeping until its next event. It runs on the thread queuing the job.
+		///		   Set it before jobs get scheduled.
+		void SetMainThreadNotification(std::function<void()> notification);
+
+		/// @return Whether jobs with main thread affinity wait for RunMainThreadJobs().
+		bool HasMainThreadJobs() const;
+
+		size_t GetWorkerCount() const;
+		bool IsMainThread() const;
+		JobStatistics GetStatistics() const;
+
+	private:
+
+		/// Aligned to a cache line, so the counters of the workers don't share one.
+		struct alignas(64) Worker
+		{
+			WorkStealingQueue<std::shared_ptr<Job>> Queue;
+			std::atomic<uint64_t> ExecutedJobs = 0;
+			std::atomic<uint64_t> StolenJobs = 0;
+			std::atomic<uint64_t> FailedSteals = 0;
+			std::atomic<int64_t> IdleNanoseconds = 0;
+		};
+
+		explicit JobSystem(size_t workerCount);
+
+		void Run(std::stop_token stopToken, size_t workerIndex);
+
+		/// @brief Drop the reference a dependency or the scheduler holds and queue the job once none is left.
+		void Release(const std::shared_ptr<Job>& job);
+		void Enqueue(std::shared_ptr<Job> job);
+		void Execute(const std::shared_ptr<Job>& job);
+
+		/// @brief Take a job from the queue of the given worker or steal one from the others.
+		/// @param workerIndex The worker looking for a job, or NoWorker for other threads.
+		std::shared_ptr<Job> FindJob(size_t workerIndex);
+		std::shared_ptr<Job> PopMainThreadJob();
+
+		/// @return The index of the worker running the calling thread, or NoWorker.
+		size_t GetCurrentWorker() const;
+
+		static constexpr size_t NoWorker = static_cast<size_t>(-1);
+
+		std::thread::id m_MainThreadId;
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+		std::atomic<size_t> m_NextWorker;				//!< Spreads the jobs scheduled by other threads across the workers
+		std::atomic<size_t> m_QueuedJobs;				//!< The jobs in the queues of the workers
+
+		std::mutex m_MainThreadMutex;
+		std::deque<std::shared_ptr<Job>> m_MainThreadJobs;
+		std::atomic<size_t> m_QueuedMainThreadJobs;
+		std::function<void()> m_MainThreadNotification;
+
+		std::mutex m_SleepMutex;
+		std::condition_variable_any m_WakeUp;
+		std::atomic<uint32_t> m_Sleepers;				//!< The threads waiting for the condition, workers and waiters alike
+		std::atomic<uint32_t> m_Waiters;				//!< The threads waiting for a job to finish
+
+		std::atomic<uint64_t> m_HelpedJobs;
+		std::atomic<uint64_t> m_ExecutedMainThreadJobs;
+
+		std::vector<std::jthread> m_Threads;
+
+	};
+}
\ No newline at end of file
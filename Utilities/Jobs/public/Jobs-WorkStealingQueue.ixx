@@ -0,0 +1,74 @@
+﻿// Project Name : Jobs
+// File Name    : Jobs-WorkStealingQueue.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+module;
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+export module Jobs:WorkStealingQueue;
+
+export namespace Jobs
+{
+	/// A queue owned by a single worker. The owner pushes and pops at the back, so
+	/// it keeps working on its most recent and most likely cache-warm items, while
+	/// other workers steal the oldest items from the front.
+	///
+	/// Every queue has a lock of its own. As long as its owner has enough to do,
+	/// nobody else touches it, so the lock is hardly ever contended.
+	template <typename T>
+	class WorkStealingQueue
+	{
+	public:
+
+		void Push(T item)
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Items.push_back(std::move(item));
+		}
+
+		/// @brief Take the newest item. Called by the owner.
+		std::optional<T> Pop()
+		{
+			std::scoped_lock lock(m_Mutex);
+			if (m_Items.empty())
+			{
+				return std::nullopt;
+			}
+
+			T item = std::move(m_Items.back());
+			m_Items.pop_back();
+			return item;
+		}
+
+		/// @brief Take the oldest item. Called by other workers, gives up if the queue is busy.
+		std::optional<T> Steal()
+		{
+			std::unique_lock lock(m_Mutex, std::try_to_lock);
+			if (not lock.owns_lock() or m_Items.empty())
+			{
+				return std::nullopt;
+			}
+
+			T item = std::move(m_Items.front());
+			m_Items.pop_front();
+			return item;
+		}
+
+		bool IsEmpty() const
+		{
+			std::scoped_lock lock(m_Mutex);
+			return m_Items.empty();
+		}
+
+	private:
+
+		mutable std::mutex m_Mutex;
+		std::deque<T> m_Items;
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+﻿// Project Name : Jobs
+// File Name    : Jobs.ixx
+// Author       : Felix Busch
+// Created Date : 2026/10/19
+
+export module Jobs;
+
+export import :Job;
+export import :JobHandle;
+export import :JobSystem;
+export import :WorkStealingQueue;
\ No newline at end of file